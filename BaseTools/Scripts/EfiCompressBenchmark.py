@@ -0,0 +1,144 @@
+## @file
+# Compare the compression ratio and throughput of the EFI and Tiano encoders
+# in BaseTools/Source/C/Common/Compress.c with the suffix tree encoder of the
+# standalone TianoCompress tool, and check that every output decompresses.
+#
+# The Common encoders are called through the EfiCompressor Python extension
+# built from BaseTools/Source/C/PyEfiCompressor.
+#
+# Copyright (c) 2026 Baikal Electronics JSC
+# This program and the accompanying materials
+# are licensed and made available under the terms and conditions of the BSD License
+# which accompanies this distribution.  The full text of the license may be found at
+# http://opensource.org/licenses/bsd-license.php
+#
+# THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+# WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+'''
+EfiCompressBenchmark
+'''
+
+import os
+import sys
+import argparse
+import subprocess
+import tempfile
+import time
+
+#
+# Globals for help information
+#
+__prog__        = 'EfiCompressBenchmark'
+__version__     = '%s Version %s' % (__prog__, '0.1 ')
+__copyright__   = 'Copyright (c) 2026 Baikal Electronics JSC'
+__description__ = 'Compare the EFI/Tiano compression ratio and throughput of the BaseTools encoders.\n'
+
+#
+# Run Function Repeat times and return the fastest time and the last result
+#
+def Measure(Function, Repeat):
+  Best = None
+  for Index in range(max(Repeat, 1)):
+    Start = time.time()
+    Result = Function()
+    Elapsed = time.time() - Start
+    if Best == None or Elapsed < Best:
+      Best = Elapsed
+  return Best, Result
+
+def Report(Name, InputSize, OutputSize, Seconds):
+  print '  %-28s %12d %8.2f%% %10.3f %10.2f' % (
+    Name,
+    OutputSize,
+    100.0 * OutputSize / max(InputSize, 1),
+    Seconds,
+    InputSize / max(Seconds, 1e-6) / (1024 * 1024)
+    )
+
+if __name__ == '__main__':
+  #
+  # Create command line argument parser object
+  #
+  parser = argparse.ArgumentParser(prog = __prog__, version = __version__,
+                                   description = __description__ + __copyright__,
+                                   conflict_handler = 'resolve')
+  parser.add_argument("-i", "--input", dest = 'InputFiles', nargs = '+', required = True,
+                      help = "Files to compress, for example Build/<Platform>/<Target>_<Tool>/<Arch>/*.efi")
+  parser.add_argument("-r", "--repeat", dest = 'Repeat', type = int, default = 3,
+                      help = "Number of runs per encoder.  The fastest one is reported.  Default is 3.")
+  parser.add_argument("--tool", dest = 'Tool', default = 'TianoCompress',
+                      help = "TianoCompress executable used as the reference encoder.  Default is TianoCompress from PATH.")
+
+  #
+  # Parse command line arguments
+  #
+  args = parser.parse_args()
+
+  try:
+    import EfiCompressor
+  except ImportError:
+    print >> sys.stderr, 'The EfiCompressor extension is not available.  Build it with'
+    print >> sys.stderr, 'BaseTools/Source/C/PyEfiCompressor/setup.py and add it to PYTHONPATH.'
+    sys.exit(1)
+
+  TempDir = tempfile.mkdtemp()
+  InputFile = os.path.join(TempDir, 'input')
+  OutputFile = os.path.join(TempDir, 'output')
+  Failed = False
+  Totals = {}
+
+  def RunTool(Option, Input):
+    Result = subprocess.call([args.Tool, Option, '-q', '-o', OutputFile, Input])
+    if Result != 0:
+      print >> sys.stderr, '%s %s failed on %s' % (args.Tool, Option, Input)
+      sys.exit(1)
+    return open(OutputFile, 'rb').read()
+
+  print '  %-28s %12s %9s %10s %10s' % ('Encoder', 'Output', 'Ratio', 'Seconds', 'MB/s')
+  for Name in args.InputFiles:
+    Data = open(Name, 'rb').read()
+    open(InputFile, 'wb').write(Data)
+    print '%s: %d bytes' % (Name, len(Data))
+
+    #
+    # The reference time includes starting the tool and writing the output file
+    #
+    Results = [
+      ('TianoCompress tool (Tiano)', Measure(lambda: RunTool('-e', InputFile), args.Repeat), EfiCompressor.FrameworkDecompress),
+      ('FrameworkCompress (Tiano)', Measure(lambda: EfiCompressor.FrameworkCompress(Data, len(Data)), args.Repeat), EfiCompressor.FrameworkDecompress),
+      ('UefiCompress (EFI)', Measure(lambda: EfiCompressor.UefiCompress(Data, len(Data)), args.Repeat), EfiCompressor.UefiDecompress)
+      ]
+    for Encoder, (Seconds, Output), Decompress in Results:
+      Report(Encoder, len(Data), len(Output), Seconds)
+      Total = Totals.setdefault(Encoder, [0, 0, 0.0])
+      Total[0] += len(Data)
+      Total[1] += len(Output)
+      Total[2] += Seconds
+      if len(Data) != 0 and str(Decompress(Output, len(Output))) != Data:
+        print >> sys.stderr, '%s output of %s does not decompress' % (Encoder, Name)
+        Failed = True
+
+    #
+    # The standalone tool must also accept the output of the Common encoder
+    #
+    open(OutputFile + '.in', 'wb').write(Results[1][1][1])
+    if RunTool('-d', OutputFile + '.in') != Data:
+      print >> sys.stderr, '%s -d does not decompress the FrameworkCompress output of %s' % (args.Tool, Name)
+      Failed = True
+    os.remove(OutputFile + '.in')
+
+  if len(args.InputFiles) > 1:
+    print 'Total:'
+    for Encoder in [Result[0] for Result in Results]:
+      Report(Encoder, Totals[Encoder][0], Totals[Encoder][1], Totals[Encoder][2])
+
+  for Name in (InputFile, OutputFile):
+    if os.path.exists(Name):
+      os.remove(Name)
+  os.rmdir(TempDir)
+
+  if Failed:
+    sys.exit(1)
+  print 'All outputs decompress to the input'
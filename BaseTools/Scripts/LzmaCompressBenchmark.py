@@ -0,0 +1,83 @@
+## @file
+# Measure the LzmaCompress encoding time of a file, such as an FV image, for
+# each number of encoder threads, and check that the outputs are identical.
+#
+# Copyright (c) 2026 Baikal Electronics JSC
+# This program and the accompanying materials
+# are licensed and made available under the terms and conditions of the BSD License
+# which accompanies this distribution.  The full text of the license may be found at
+# http://opensource.org/licenses/bsd-license.php
+#
+# THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+# WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+'''
+LzmaCompressBenchmark
+'''
+
+import os
+import sys
+import argparse
+import hashlib
+import subprocess
+import tempfile
+import time
+
+#
+# Globals for help information
+#
+__prog__        = 'LzmaCompressBenchmark'
+__version__     = '%s Version %s' % (__prog__, '0.1 ')
+__copyright__   = 'Copyright (c) 2026 Baikal Electronics JSC'
+__description__ = 'Measure LzmaCompress encoding time per number of threads.\n'
+
+if __name__ == '__main__':
+  #
+  # Create command line argument parser object
+  #
+  parser = argparse.ArgumentParser(prog = __prog__, version = __version__,
+                                   description = __description__ + __copyright__,
+                                   conflict_handler = 'resolve')
+  parser.add_argument("-i", "--input", dest = 'InputFile', required = True,
+                      help = "File to compress, for example Build/<Platform>/<Target>_<Tool>/FV/DXEFV.Fv")
+  parser.add_argument("-t", "--threads", dest = 'Threads', type = int, nargs = '+', default = [1, 2],
+                      help = "Thread counts to measure.  Default is 1 2.")
+  parser.add_argument("-r", "--repeat", dest = 'Repeat', type = int, default = 3,
+                      help = "Number of runs per thread count.  The fastest one is reported.  Default is 3.")
+  parser.add_argument("--tool", dest = 'Tool', default = 'LzmaCompress',
+                      help = "LzmaCompress executable.  Default is LzmaCompress from PATH.")
+
+  #
+  # Parse command line arguments
+  #
+  args = parser.parse_args()
+
+  InputSize = os.path.getsize(args.InputFile)
+  OutputFile = os.path.join(tempfile.mkdtemp(), 'output.lzma')
+  Digests = {}
+
+  print '%s: %d bytes' % (args.InputFile, InputSize)
+  print '%8s %12s %12s %10s' % ('Threads', 'Seconds', 'Output', 'MB/s')
+  for Threads in args.Threads:
+    Best = None
+    for Index in range(max(args.Repeat, 1)):
+      Start = time.time()
+      Result = subprocess.call([args.Tool, '-e', '-q', '--threads', str(Threads), '-o', OutputFile, args.InputFile])
+      Elapsed = time.time() - Start
+      if Result != 0:
+        print >> sys.stderr, '%s failed with --threads %d' % (args.Tool, Threads)
+        sys.exit(1)
+      if Best == None or Elapsed < Best:
+        Best = Elapsed
+    Data = open(OutputFile, 'rb').read()
+    Digests[Threads] = hashlib.md5(Data).hexdigest()
+    print '%8d %12.3f %12d %10.2f' % (Threads, Best, len(Data), InputSize / Best / (1024 * 1024))
+
+  os.remove(OutputFile)
+  os.rmdir(os.path.dirname(OutputFile))
+
+  if len(set(Digests.values())) != 1:
+    print >> sys.stderr, 'The output differs between thread counts'
+    sys.exit(1)
+  print 'The output is identical for all thread counts'
@@ -0,0 +1,1538 @@
+/** @file
+Compression routines for the EFI and Tiano compression algorithms. The
+compression algorithm is a mixture of LZ77 and Huffman coding. LZ77 transforms
+the source data into a sequence of Original Characters and Pointers to repeated
+strings. This sequence is further divided into Blocks and Huffman codings are
+applied to each Block.
+
+The two algorithms only differ in the size of the sliding window and in the
+number of bits used to store the Position Set code lengths, so they share one
+encoder. All encoder state is kept in a COMPRESS_DATA structure allocated per
+call, which makes EfiCompress() and TianoCompress() reentrant. Repeated strings
+are found with hash chains and a one step lazy evaluation.
+
+Copyright (c) 2006 - 2016, Intel Corporation. All rights reserved.<BR>
+Copyright (c) 2026 Baikal Electronics JSC
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include "Compress.h"
+
+//
+// Macro Definitions
+//
+#undef  UINT8_MAX
+#define UINT8_MAX     0xff
+#define UINT8_BIT     8
+#define THRESHOLD     3
+#define MAXMATCH      256
+#define BLKSIZ        (1U << 14)  // 16 * 1024U
+#define CODE_BIT      16
+
+//
+// Window size of the EFI and Tiano algorithms
+//
+#define EFIWNDBIT     13
+#define TIANOWNDBIT   19
+#define MAXWNDBIT     TIANOWNDBIT
+
+//
+// Hash chain parameters. The hash of the 3 bytes at a position selects the
+// chain; at most MaxChain older positions of a chain are compared, and only
+// a quarter of that when the match at the previous position already has
+// GOOD_MATCH bytes. The search stops early once a match of NICE_MATCH bytes
+// is found. A match of LAZY_MATCH bytes or more is output without checking
+// the next position.
+//
+#define HASH_BIT      16
+#define HASH_SIZE     (1U << HASH_BIT)
+#define HASH(p)       ((((UINT32) (p)[0] << 16 | (UINT32) (p)[1] << 8 | (p)[2]) * 2654435761U) >> (32 - HASH_BIT))
+#define NIL           (-1)
+#define GOOD_MATCH    8
+#define NICE_MATCH    MAXMATCH
+#define LAZY_MATCH    32
+
+//
+// C: the Char&Len Set; P: the Position Set; T: the exTra Set
+//
+#define NC            (UINT8_MAX + MAXMATCH + 2 - THRESHOLD)
+#define CBIT          9
+#define EFIPBIT       4
+#define TIANOPBIT     5
+#define MAXNP         (MAXWNDBIT + 1)
+#define NT            (CODE_BIT + 3)
+#define TBIT          5
+#if NT > MAXNP
+#define NPT NT
+#else
+#define NPT MAXNP
+#endif
+
+typedef struct {
+  UINT32  WndBit;     // Number of bits of the sliding window size
+  UINT32  PBit;       // Number of bits of the Position Set code length count
+  UINT32  MaxChain;   // Number of hash chain positions compared per match
+  UINT32  TooFar;     // Position beyond which a THRESHOLD byte Pointer costs
+                      // more than the Original Characters, or 0
+} COMPRESS_PARAMETERS;
+
+//
+// The bigger Tiano window makes the hash chains much longer, so fewer of
+// their positions are compared.
+//
+STATIC CONST COMPRESS_PARAMETERS mEfiParameters   = { EFIWNDBIT, EFIPBIT, 256, 0 };
+STATIC CONST COMPRESS_PARAMETERS mTianoParameters = { TIANOWNDBIT, TIANOPBIT, 128, 1U << 11 };
+
+typedef struct {
+  //
+  // Algorithm parameters
+  //
+  UINT32  mWndSiz;
+  UINT32  mPBit;
+  INT32   mNP;
+  UINT32  mMaxChain;
+  UINT32  mTooFar;
+
+  //
+  // Input and output buffers
+  //
+  UINT8   *mSrc;
+  UINT32  mSrcSize;
+  UINT8   *mDst;
+  UINT8   *mDstUpperLimit;
+  UINT32  mCompSize;
+
+  //
+  // Hash chains, indexed by hash and by position modulo window size
+  //
+  INT32   *mHead;
+  INT32   *mPrev;
+
+  //
+  // Block buffer holding the Original Characters and Pointers
+  //
+  UINT8   *mBuf;
+  UINT32  mBufSiz;
+  UINT32  mOutputPos;
+  UINT32  mOutputMask;
+  UINT32  mCPos;
+
+  //
+  // Bit writer
+  //
+  INT32   mBitCount;
+  UINT32  mSubBitBuf;
+
+  //
+  // Huffman coding
+  //
+  UINT8   mCLen[NC];
+  UINT8   mPTLen[NPT];
+  UINT8   *mLen;
+  INT16   mHeap[NC + 1];
+  INT32   mHeapSize;
+  INT32   mN;
+  INT32   mDepth;
+  UINT16  *mFreq;
+  UINT16  *mSortPtr;
+  UINT16  mLenCnt[17];
+  UINT16  mLeft[2 * NC - 1];
+  UINT16  mRight[2 * NC - 1];
+  UINT16  mCFreq[2 * NC - 1];
+  UINT16  mCCode[NC];
+  UINT16  mPFreq[2 * MAXNP - 1];
+  UINT16  mPTCode[NPT];
+  UINT16  mTFreq[2 * NT - 1];
+} COMPRESS_DATA;
+
+//
+// Function Prototypes
+//
+
+STATIC
+EFI_STATUS
+Compress (
+  IN      UINT8   *SrcBuffer,
+  IN      UINT32  SrcSize,
+  IN      UINT8   *DstBuffer,
+  IN OUT  UINT32  *DstSize,
+  IN CONST COMPRESS_PARAMETERS *Parameters
+  );
+
+STATIC
+VOID
+PutDword (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         Data
+  );
+
+STATIC
+EFI_STATUS
+AllocateMemory (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+FreeMemory (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+InsertPosition (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         Pos
+  );
+
+STATIC
+UINT32
+FindMatch (
+  IN  COMPRESS_DATA  *Cd,
+  IN  UINT32         Pos,
+  IN  UINT32         PrevLen,
+  OUT UINT32         *MatchDist
+  );
+
+STATIC
+EFI_STATUS
+Encode (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+CountTFreq (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+WritePTLen (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Number,
+  IN INT32          nbit,
+  IN INT32          Special
+  );
+
+STATIC
+VOID
+WriteCLen (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+EncodeC (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Value
+  );
+
+STATIC
+VOID
+EncodeP (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         Value
+  );
+
+STATIC
+VOID
+SendBlock (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+Output (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         CharC,
+  IN UINT32         Pos
+  );
+
+STATIC
+VOID
+HufEncodeStart (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+HufEncodeEnd (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+PutBits (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Number,
+  IN UINT32         Value
+  );
+
+STATIC
+VOID
+InitPutBits (
+  IN COMPRESS_DATA  *Cd
+  );
+
+STATIC
+VOID
+CountLen (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Index
+  );
+
+STATIC
+VOID
+MakeLen (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Root
+  );
+
+STATIC
+VOID
+DownHeap (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Index
+  );
+
+STATIC
+VOID
+MakeCode (
+  IN  COMPRESS_DATA  *Cd,
+  IN  INT32          Number,
+  IN  UINT8          Len[],
+  OUT UINT16         Code[]
+  );
+
+STATIC
+INT32
+MakeTree (
+  IN  COMPRESS_DATA  *Cd,
+  IN  INT32          NParm,
+  IN  UINT16         FreqParm[],
+  OUT UINT8          LenParm[],
+  OUT UINT16         CodeParm[]
+  );
+
+//
+// functions
+//
+EFI_STATUS
+EfiCompress (
+  IN      UINT8   *SrcBuffer,
+  IN      UINT32  SrcSize,
+  IN      UINT8   *DstBuffer,
+  IN OUT  UINT32  *DstSize
+  )
+/*++
+
+Routine Description:
+
+  The compression routine of the EFI compression algorithm.
+
+Arguments:
+
+  SrcBuffer   - The buffer storing the source data
+  SrcSize     - The size of source data
+  DstBuffer   - The buffer to store the compressed data
+  DstSize     - On input, the size of DstBuffer; On output,
+                the size of the actual compressed data.
+
+Returns:
+
+  EFI_BUFFER_TOO_SMALL  - The DstBuffer is too small. In this case,
+                DstSize contains the size needed.
+  EFI_SUCCESS           - Compression is successful.
+  EFI_OUT_OF_RESOURCES  - No resource to complete function.
+
+--*/
+{
+  return Compress (SrcBuffer, SrcSize, DstBuffer, DstSize, &mEfiParameters);
+}
+
+EFI_STATUS
+TianoCompress (
+  IN      UINT8   *SrcBuffer,
+  IN      UINT32  SrcSize,
+  IN      UINT8   *DstBuffer,
+  IN OUT  UINT32  *DstSize
+  )
+/*++
+
+Routine Description:
+
+  The compression routine of the Tiano compression algorithm.
+
+Arguments:
+
+  SrcBuffer   - The buffer storing the source data
+  SrcSize     - The size of source data
+  DstBuffer   - The buffer to store the compressed data
+  DstSize     - On input, the size of DstBuffer; On output,
+                the size of the actual compressed data.
+
+Returns:
+
+  EFI_BUFFER_TOO_SMALL  - The DstBuffer is too small. In this case,
+                DstSize contains the size needed.
+  EFI_SUCCESS           - Compression is successful.
+  EFI_OUT_OF_RESOURCES  - No resource to complete function.
+
+--*/
+{
+  return Compress (SrcBuffer, SrcSize, DstBuffer, DstSize, &mTianoParameters);
+}
+
+STATIC
+EFI_STATUS
+Compress (
+  IN      UINT8   *SrcBuffer,
+  IN      UINT32  SrcSize,
+  IN      UINT8   *DstBuffer,
+  IN OUT  UINT32  *DstSize,
+  IN CONST COMPRESS_PARAMETERS *Parameters
+  )
+/*++
+
+Routine Description:
+
+  The internal implementation of [Efi/Tiano]Compress().
+
+Arguments:
+
+  SrcBuffer   - The buffer storing the source data
+  SrcSize     - The size of source data
+  DstBuffer   - The buffer to store the compressed data
+  DstSize     - On input, the size of DstBuffer; On output,
+                the size of the actual compressed data.
+  Parameters  - The parameters of the EFI or Tiano algorithm.
+
+Returns:
+
+  EFI_BUFFER_TOO_SMALL  - The DstBuffer is too small. In this case,
+                DstSize contains the size needed.
+  EFI_SUCCESS           - Compression is successful.
+  EFI_OUT_OF_RESOURCES  - No resource to complete function.
+
+--*/
+{
+  EFI_STATUS    Status;
+  COMPRESS_DATA *Cd;
+  UINT32        CompSize;
+
+  Cd = malloc (sizeof (COMPRESS_DATA));
+  if (Cd == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  memset (Cd, 0, sizeof (COMPRESS_DATA));
+
+  //
+  // Initializations
+  //
+  Cd->mWndSiz         = 1U << Parameters->WndBit;
+  Cd->mPBit           = Parameters->PBit;
+  Cd->mNP             = (INT32) Parameters->WndBit + 1;
+  Cd->mMaxChain       = Parameters->MaxChain;
+  Cd->mTooFar         = Parameters->TooFar;
+
+  Cd->mSrc            = SrcBuffer;
+  Cd->mSrcSize        = SrcSize;
+  Cd->mDst            = DstBuffer;
+  Cd->mDstUpperLimit  = DstBuffer + *DstSize;
+
+  PutDword (Cd, 0L);
+  PutDword (Cd, 0L);
+
+  //
+  // Compress it
+  //
+  Status = Encode (Cd);
+  if (EFI_ERROR (Status)) {
+    free (Cd);
+    return EFI_OUT_OF_RESOURCES;
+  }
+  //
+  // Null terminate the compressed data
+  //
+  if (Cd->mDst < Cd->mDstUpperLimit) {
+    *Cd->mDst++ = 0;
+  }
+  //
+  // Fill in compressed size and original size
+  //
+  CompSize  = Cd->mCompSize;
+  Cd->mDst  = DstBuffer;
+  PutDword (Cd, CompSize + 1);
+  PutDword (Cd, SrcSize);
+  free (Cd);
+
+  //
+  // Return
+  //
+  if (CompSize + 1 + 8 > *DstSize) {
+    *DstSize = CompSize + 1 + 8;
+    return EFI_BUFFER_TOO_SMALL;
+  } else {
+    *DstSize = CompSize + 1 + 8;
+    return EFI_SUCCESS;
+  }
+}
+
+STATIC
+VOID
+PutDword (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         Data
+  )
+/*++
+
+Routine Description:
+
+  Put a dword to output stream
+
+Arguments:
+
+  Cd      - The compression context
+  Data    - the dword to put
+
+Returns: (VOID)
+
+--*/
+{
+  if (Cd->mDst < Cd->mDstUpperLimit) {
+    *Cd->mDst++ = (UINT8) (((UINT8) (Data)) & 0xff);
+  }
+
+  if (Cd->mDst < Cd->mDstUpperLimit) {
+    *Cd->mDst++ = (UINT8) (((UINT8) (Data >> 0x08)) & 0xff);
+  }
+
+  if (Cd->mDst < Cd->mDstUpperLimit) {
+    *Cd->mDst++ = (UINT8) (((UINT8) (Data >> 0x10)) & 0xff);
+  }
+
+  if (Cd->mDst < Cd->mDstUpperLimit) {
+    *Cd->mDst++ = (UINT8) (((UINT8) (Data >> 0x18)) & 0xff);
+  }
+}
+
+STATIC
+EFI_STATUS
+AllocateMemory (
+  IN COMPRESS_DATA  *Cd
+  )
+/*++
+
+Routine Description:
+
+  Allocate memory spaces for data structures used in compression process
+
+Arguments:
+
+  Cd      - The compression context
+
+Returns:
+
+  EFI_SUCCESS           - Memory is allocated successfully
+  EFI_OUT_OF_RESOURCES  - Allocation fails
+
+--*/
+{
+  Cd->mHead = malloc (HASH_SIZE * sizeof (*Cd->mHead));
+  Cd->mPrev = malloc (Cd->mWndSiz * sizeof (*Cd->mPrev));
+  if (Cd->mHead == NULL || Cd->mPrev == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Every chain starts out empty; NIL is all bits set
+  //
+  memset (Cd->mHead, 0xFF, HASH_SIZE * sizeof (*Cd->mHead));
+
+  Cd->mBufSiz = BLKSIZ;
+  Cd->mBuf    = malloc (Cd->mBufSiz);
+  while (Cd->mBuf == NULL) {
+    Cd->mBufSiz = (Cd->mBufSiz / 10U) * 9U;
+    if (Cd->mBufSiz < 4 * 1024U) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Cd->mBuf = malloc (Cd->mBufSiz);
+  }
+
+  Cd->mBuf[0] = 0;
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+VOID
+FreeMemory (
+  IN COMPRESS_DATA  *Cd
+  )
+/*++
+
+Routine Description:
+
+  Called when compression is completed to free memory previously allocated.
+
+Arguments:
+
+  Cd      - The compression context
+
+Returns: (VOID)
+
+--*/
+{
+  if (Cd->mHead != NULL) {
+    free (Cd->mHead);
+  }
+
+  if (Cd->mPrev != NULL) {
+    free (Cd->mPrev);
+  }
+
+  if (Cd->mBuf != NULL) {
+    free (Cd->mBuf);
+  }
+
+  return ;
+}
+
+STATIC
+VOID
+InsertPosition (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         Pos
+  )
+/*++
+
+Routine Description:
+
+  Insert a position of the source data into the hash chain of the string
+  starting at that position.
+
+Arguments:
+
+  Cd      - The compression context
+  Pos     - The position to insert, at least THRESHOLD bytes before the end
+            of the source data
+
+Returns: (VOID)
+
+--*/
+{
+  UINT32  Hash;
+
+  Hash                                = HASH (&Cd->mSrc[Pos]);
+  Cd->mPrev[Pos & (Cd->mWndSiz - 1)]  = Cd->mHead[Hash];
+  Cd->mHead[Hash]                     = (INT32) Pos;
+}
+
+STATIC
+UINT32
+FindMatch (
+  IN  COMPRESS_DATA  *Cd,
+  IN  UINT32         Pos,
+  IN  UINT32         PrevLen,
+  OUT UINT32         *MatchDist
+  )
+/*++
+
+Routine Description:
+
+  Find the longest string within the sliding window that matches the string
+  starting at a position and is longer than the match found for the previous
+  position. Of the matches with the same length, the nearest one is returned.
+
+Arguments:
+
+  Cd        - The compression context
+  Pos       - The position of the string to match, at least THRESHOLD bytes
+              before the end of the source data
+  PrevLen   - The length of the match at the previous position, or 0
+  MatchDist - The distance from Pos back to the start of the match
+
+Returns:
+
+  The length of the match, or 0 when no match of THRESHOLD bytes that is
+  longer than PrevLen is found.
+
+--*/
+{
+  UINT8   *Src;
+  UINT8   *Scan;
+  UINT8   *Match;
+  UINT32  MaxLen;
+  UINT32  Len;
+  UINT32  BestLen;
+  UINT32  Chain;
+  UINT32  MaxChain;
+  INT32   Candidate;
+
+  Src     = Cd->mSrc;
+  Scan    = &Src[Pos];
+  MaxLen  = Cd->mSrcSize - Pos;
+  if (MaxLen > MAXMATCH) {
+    MaxLen = MAXMATCH;
+  }
+
+  if (PrevLen >= MaxLen) {
+    return 0;
+  }
+
+  MaxChain = Cd->mMaxChain;
+  if (PrevLen >= GOOD_MATCH) {
+    MaxChain >>= 2;
+  }
+
+  BestLen   = PrevLen;
+  Candidate = Cd->mHead[HASH (Scan)];
+  for (Chain = 0; Candidate != NIL && Chain < MaxChain; Chain++) {
+    //
+    // The Position field of a Pointer is the distance minus one and must
+    // fit in the window; older positions may have been overwritten in mPrev.
+    //
+    if (Pos - (UINT32) Candidate >= Cd->mWndSiz) {
+      break;
+    }
+
+    Match = &Src[Candidate];
+    if (Match[BestLen] == Scan[BestLen] && Match[0] == Scan[0] && Match[1] == Scan[1]) {
+      Len = 2;
+      while (Len < MaxLen && Match[Len] == Scan[Len]) {
+        Len++;
+      }
+
+      if (Len > BestLen) {
+        BestLen     = Len;
+        *MatchDist  = Pos - (UINT32) Candidate;
+        if (Len >= NICE_MATCH || Len >= MaxLen) {
+          break;
+        }
+      }
+    }
+
+    Candidate = Cd->mPrev[Candidate & (Cd->mWndSiz - 1)];
+  }
+
+  if (BestLen == PrevLen || BestLen < THRESHOLD) {
+    return 0;
+  }
+
+  if (BestLen == THRESHOLD && Cd->mTooFar != 0 && *MatchDist - 1 > Cd->mTooFar) {
+    return 0;
+  }
+
+  return BestLen;
+}
+
+STATIC
+EFI_STATUS
+Encode (
+  IN COMPRESS_DATA  *Cd
+  )
+/*++
+
+Routine Description:
+
+  The main controlling routine for compression process.
+
+Arguments:
+
+  Cd      - The compression context
+
+Returns:
+
+  EFI_SUCCESS           - The compression is successful
+  EFI_OUT_0F_RESOURCES  - Not enough memory for compression process
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT32      Pos;
+  UINT32      Last;
+  UINT32      MatchLen;
+  UINT32      MatchDist;
+  UINT32      LastMatchLen;
+  UINT32      LastMatchDist;
+  BOOLEAN     Pending;
+
+  Status = AllocateMemory (Cd);
+  if (EFI_ERROR (Status)) {
+    FreeMemory (Cd);
+    return Status;
+  }
+
+  HufEncodeStart (Cd);
+
+  //
+  // Positions from Last on are too close to the end to start a match
+  //
+  Last          = Cd->mSrcSize < THRESHOLD ? 0 : Cd->mSrcSize - THRESHOLD + 1;
+  LastMatchLen  = 0;
+  LastMatchDist = 0;
+  MatchDist     = 0;
+  Pending       = FALSE;
+  Pos           = 0;
+  while (Pos < Cd->mSrcSize) {
+    //
+    // Find a match for the current position, unless the match found for
+    // the previous position is already long enough to be taken as is
+    //
+    MatchLen = 0;
+    if (Pos < Last) {
+      if (LastMatchLen < LAZY_MATCH) {
+        MatchLen = FindMatch (Cd, Pos, LastMatchLen, &MatchDist);
+      }
+
+      InsertPosition (Cd, Pos);
+    }
+
+    if (Pending && LastMatchLen != 0 && MatchLen <= LastMatchLen) {
+      //
+      // The match starting at the previous position is at least as long as
+      // the one starting here, so output it as a Pointer and skip over it.
+      //
+      Output (Cd, LastMatchLen + (UINT8_MAX + 1 - THRESHOLD), LastMatchDist - 1);
+      for (Pos++, LastMatchLen -= 2; LastMatchLen > 0; Pos++, LastMatchLen--) {
+        if (Pos < Last) {
+          InsertPosition (Cd, Pos);
+        }
+      }
+
+      Pending = FALSE;
+    } else {
+      //
+      // Not enough benefits are gained by outputting a pointer for the
+      // previous position, so just output the original character
+      //
+      if (Pending) {
+        Output (Cd, Cd->mSrc[Pos - 1], 0);
+      }
+
+      LastMatchLen  = MatchLen;
+      LastMatchDist = MatchDist;
+      Pending       = TRUE;
+      Pos++;
+    }
+  }
+
+  if (Pending) {
+    Output (Cd, Cd->mSrc[Pos - 1], 0);
+  }
+
+  HufEncodeEnd (Cd);
+  FreeMemory (Cd);
+  return EFI_SUCCESS;
+}
+
+STATIC
+VOID
+CountTFreq (
+  IN COMPRESS_DATA  *Cd
+  )
+/*++
+
+Routine Description:
+
+  Count the frequencies for the Extra Set
+
+Arguments:
+
+  Cd      - The compression context
+
+Returns: (VOID)
+
+--*/
+{
+  INT32 Index;
+  INT32 Index3;
+  INT32 Number;
+  INT32 Count;
+
+  for (Index = 0; Index < NT; Index++) {
+    Cd->mTFreq[Index] = 0;
+  }
+
+  Number = NC;
+  while (Number > 0 && Cd->mCLen[Number - 1] == 0) {
+    Number--;
+  }
+
+  Index = 0;
+  while (Index < Number) {
+    Index3 = Cd->mCLen[Index++];
+    if (Index3 == 0) {
+      Count = 1;
+      while (Index < Number && Cd->mCLen[Index] == 0) {
+        Index++;
+        Count++;
+      }
+
+      if (Count <= 2) {
+        Cd->mTFreq[0] = (UINT16) (Cd->mTFreq[0] + Count);
+      } else if (Count <= 18) {
+        Cd->mTFreq[1]++;
+      } else if (Count == 19) {
+        Cd->mTFreq[0]++;
+        Cd->mTFreq[1]++;
+      } else {
+        Cd->mTFreq[2]++;
+      }
+    } else {
+      Cd->mTFreq[Index3 + 2]++;
+    }
+  }
+}
+
+STATIC
+VOID
+WritePTLen (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Number,
+  IN INT32          nbit,
+  IN INT32          Special
+  )
+/*++
+
+Routine Description:
+
+  Outputs the code length array for the Extra Set or the Position Set.
+
+Arguments:
+
+  Cd      - The compression context
+  Number  - the number of symbols
+  nbit    - the number of bits needed to represent 'n'
+  Special - the special symbol that needs to be take care of
+
+Returns: (VOID)
+
+--*/
+{
+  INT32 Index;
+  INT32 Index3;
+
+  while (Number > 0 && Cd->mPTLen[Number - 1] == 0) {
+    Number--;
+  }
+
+  PutBits (Cd, nbit, Number);
+  Index = 0;
+  while (Index < Number) {
+    Index3 = Cd->mPTLen[Index++];
+    if (Index3 <= 6) {
+      PutBits (Cd, 3, Index3);
+    } else {
+      PutBits (Cd, Index3 - 3, (1U << (Index3 - 3)) - 2);
+    }
+
+    if (Index == Special) {
+      while (Index < 6 && Cd->mPTLen[Index] == 0) {
+        Index++;
+      }
+
+      PutBits (Cd, 2, (Index - 3) & 3);
+    }
+  }
+}
+
+STATIC
+VOID
+WriteCLen (
+  IN COMPRESS_DATA  *Cd
+  )
+/*++
+
+Routine Description:
+
+  Outputs the code length array for Char&Length Set
+
+Arguments:
+
+  Cd      - The compression context
+
+Returns: (VOID)
+
+--*/
+{
+  INT32 Index;
+  INT32 Index3;
+  INT32 Number;
+  INT32 Count;
+
+  Number = NC;
+  while (Number > 0 && Cd->mCLen[Number - 1] == 0) {
+    Number--;
+  }
+
+  PutBits (Cd, CBIT, Number);
+  Index = 0;
+  while (Index < Number) {
+    Index3 = Cd->mCLen[Index++];
+    if (Index3 == 0) {
+      Count = 1;
+      while (Index < Number && Cd->mCLen[Index] == 0) {
+        Index++;
+        Count++;
+      }
+
+      if (Count <= 2) {
+        for (Index3 = 0; Index3 < Count; Index3++) {
+          PutBits (Cd, Cd->mPTLen[0], Cd->mPTCode[0]);
+        }
+      } else if (Count <= 18) {
+        PutBits (Cd, Cd->mPTLen[1], Cd->mPTCode[1]);
+        PutBits (Cd, 4, Count - 3);
+      } else if (Count == 19) {
+        PutBits (Cd, Cd->mPTLen[0], Cd->mPTCode[0]);
+        PutBits (Cd, Cd->mPTLen[1], Cd->mPTCode[1]);
+        PutBits (Cd, 4, 15);
+      } else {
+        PutBits (Cd, Cd->mPTLen[2], Cd->mPTCode[2]);
+        PutBits (Cd, CBIT, Count - 20);
+      }
+    } else {
+      PutBits (Cd, Cd->mPTLen[Index3 + 2], Cd->mPTCode[Index3 + 2]);
+    }
+  }
+}
+
+STATIC
+VOID
+EncodeC (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Value
+  )
+{
+  PutBits (Cd, Cd->mCLen[Value], Cd->mCCode[Value]);
+}
+
+STATIC
+VOID
+EncodeP (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         Value
+  )
+{
+  UINT32  Index;
+  UINT32  NodeQ;
+
+  Index = 0;
+  NodeQ = Value;
+  while (NodeQ) {
+    NodeQ >>= 1;
+    Index++;
+  }
+
+  PutBits (Cd, Cd->mPTLen[Index], Cd->mPTCode[Index]);
+  if (Index > 1) {
+    PutBits (Cd, Index - 1, Value & (0xFFFFFFFFU >> (32 - Index + 1)));
+  }
+}
+
+STATIC
+VOID
+SendBlock (
+  IN COMPRESS_DATA  *Cd
+  )
+/*++
+
+Routine Description:
+
+  Huffman code the block and output it.
+
+Arguments:
+
+  Cd      - The compression context
+
+Returns:
+  (VOID)
+
+--*/
+{
+  UINT32  Index;
+  UINT32  Index2;
+  UINT32  Index3;
+  UINT32  Flags;
+  UINT32  Root;
+  UINT32  Pos;
+  UINT32  Size;
+  Flags = 0;
+
+  Root  = MakeTree (Cd, NC, Cd->mCFreq, Cd->mCLen, Cd->mCCode);
+  Size  = Cd->mCFreq[Root];
+  PutBits (Cd, 16, Size);
+  if (Root >= NC) {
+    CountTFreq (Cd);
+    Root = MakeTree (Cd, NT, Cd->mTFreq, Cd->mPTLen, Cd->mPTCode);
+    if (Root >= NT) {
+      WritePTLen (Cd, NT, TBIT, 3);
+    } else {
+      PutBits (Cd, TBIT, 0);
+      PutBits (Cd, TBIT, Root);
+    }
+
+    WriteCLen (Cd);
+  } else {
+    PutBits (Cd, TBIT, 0);
+    PutBits (Cd, TBIT, 0);
+    PutBits (Cd, CBIT, 0);
+    PutBits (Cd, CBIT, Root);
+  }
+
+  Root = MakeTree (Cd, Cd->mNP, Cd->mPFreq, Cd->mPTLen, Cd->mPTCode);
+  if (Root >= (UINT32) Cd->mNP) {
+    WritePTLen (Cd, Cd->mNP, Cd->mPBit, -1);
+  } else {
+    PutBits (Cd, Cd->mPBit, 0);
+    PutBits (Cd, Cd->mPBit, Root);
+  }
+
+  Pos = 0;
+  for (Index = 0; Index < Size; Index++) {
+    if (Index % UINT8_BIT == 0) {
+      Flags = Cd->mBuf[Pos++];
+    } else {
+      Flags <<= 1;
+    }
+
+    if (Flags & (1U << (UINT8_BIT - 1))) {
+      EncodeC (Cd, Cd->mBuf[Pos++] + (1U << UINT8_BIT));
+      Index3 = Cd->mBuf[Pos++];
+      for (Index2 = 0; Index2 < 3; Index2++) {
+        Index3 <<= UINT8_BIT;
+        Index3 += Cd->mBuf[Pos++];
+      }
+
+      EncodeP (Cd, Index3);
+    } else {
+      EncodeC (Cd, Cd->mBuf[Pos++]);
+    }
+  }
+
+  for (Index = 0; Index < NC; Index++) {
+    Cd->mCFreq[Index] = 0;
+  }
+
+  for (Index = 0; Index < (UINT32) Cd->mNP; Index++) {
+    Cd->mPFreq[Index] = 0;
+  }
+}
+
+STATIC
+VOID
+Output (
+  IN COMPRESS_DATA  *Cd,
+  IN UINT32         CharC,
+  IN UINT32         Pos
+  )
+/*++
+
+Routine Description:
+
+  Outputs an Original Character or a Pointer
+
+Arguments:
+
+  Cd      - The compression context
+  CharC   - The original character or the 'String Length' element of a Pointer
+  Pos     - The 'Position' field of a Pointer
+
+Returns: (VOID)
+
+--*/
+{
+  if ((Cd->mOutputMask >>= 1) == 0) {
+    Cd->mOutputMask = 1U << (UINT8_BIT - 1);
+    //
+    // Check the buffer overflow per outputing UINT8_BIT symbols
+    // which is an Original Character or a Pointer. The biggest
+    // symbol is a Pointer which occupies 5 bytes.
+    //
+    if (Cd->mOutputPos >= Cd->mBufSiz - 5 * UINT8_BIT) {
+      SendBlock (Cd);
+      Cd->mOutputPos = 0;
+    }
+
+    Cd->mCPos             = Cd->mOutputPos++;
+    Cd->mBuf[Cd->mCPos]   = 0;
+  }
+
+  Cd->mBuf[Cd->mOutputPos++] = (UINT8) CharC;
+  Cd->mCFreq[CharC]++;
+  if (CharC >= (1U << UINT8_BIT)) {
+    Cd->mBuf[Cd->mCPos] |= Cd->mOutputMask;
+    Cd->mBuf[Cd->mOutputPos++]  = (UINT8) (Pos >> 24);
+    Cd->mBuf[Cd->mOutputPos++]  = (UINT8) (Pos >> 16);
+    Cd->mBuf[Cd->mOutputPos++]  = (UINT8) (Pos >> (UINT8_BIT));
+    Cd->mBuf[Cd->mOutputPos++]  = (UINT8) Pos;
+    CharC                       = 0;
+    while (Pos) {
+      Pos >>= 1;
+      CharC++;
+    }
+
+    Cd->mPFreq[CharC]++;
+  }
+}
+
+STATIC
+VOID
+HufEncodeStart (
+  IN COMPRESS_DATA  *Cd
+  )
+{
+  INT32 Index;
+
+  for (Index = 0; Index < NC; Index++) {
+    Cd->mCFreq[Index] = 0;
+  }
+
+  for (Index = 0; Index < Cd->mNP; Index++) {
+    Cd->mPFreq[Index] = 0;
+  }
+
+  Cd->mOutputPos = Cd->mOutputMask = 0;
+  InitPutBits (Cd);
+  return ;
+}
+
+STATIC
+VOID
+HufEncodeEnd (
+  IN COMPRESS_DATA  *Cd
+  )
+{
+  SendBlock (Cd);
+
+  //
+  // Flush remaining bits
+  //
+  PutBits (Cd, UINT8_BIT - 1, 0);
+
+  return ;
+}
+
+STATIC
+VOID
+PutBits (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Number,
+  IN UINT32         Value
+  )
+/*++
+
+Routine Description:
+
+  Outputs rightmost n bits of x
+
+Arguments:
+
+  Cd      - The compression context
+  Number  - the rightmost n bits of the data is used
+  Value   - the data
+
+Returns: (VOID)
+
+--*/
+{
+  UINT8 Temp;
+
+  while (Number >= Cd->mBitCount) {
+    //
+    // Number -= mBitCount should never equal to 32
+    //
+    Temp = (UINT8) (Cd->mSubBitBuf | (Value >> (Number -= Cd->mBitCount)));
+    if (Cd->mDst < Cd->mDstUpperLimit) {
+      *Cd->mDst++ = Temp;
+    }
+
+    Cd->mCompSize++;
+    Cd->mSubBitBuf  = 0;
+    Cd->mBitCount   = UINT8_BIT;
+  }
+
+  Cd->mSubBitBuf |= Value << (Cd->mBitCount -= Number);
+}
+
+STATIC
+VOID
+InitPutBits (
+  IN COMPRESS_DATA  *Cd
+  )
+{
+  Cd->mBitCount   = UINT8_BIT;
+  Cd->mSubBitBuf  = 0;
+}
+
+STATIC
+VOID
+CountLen (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Index
+  )
+/*++
+
+Routine Description:
+
+  Count the number of each code length for a Huffman tree.
+
+Arguments:
+
+  Cd      - The compression context
+  Index   - the top node
+
+Returns: (VOID)
+
+--*/
+{
+  if (Index < Cd->mN) {
+    Cd->mLenCnt[(Cd->mDepth < 16) ? Cd->mDepth : 16]++;
+  } else {
+    Cd->mDepth++;
+    CountLen (Cd, Cd->mLeft[Index]);
+    CountLen (Cd, Cd->mRight[Index]);
+    Cd->mDepth--;
+  }
+}
+
+STATIC
+VOID
+MakeLen (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Root
+  )
+/*++
+
+Routine Description:
+
+  Create code length array for a Huffman tree
+
+Arguments:
+
+  Cd      - The compression context
+  Root    - the root of the tree
+
+Returns:
+
+  VOID
+
+--*/
+{
+  INT32   Index;
+  INT32   Index3;
+  UINT32  Cum;
+
+  for (Index = 0; Index <= 16; Index++) {
+    Cd->mLenCnt[Index] = 0;
+  }
+
+  CountLen (Cd, Root);
+
+  //
+  // Adjust the length count array so that
+  // no code will be generated longer than its designated length
+  //
+  Cum = 0;
+  for (Index = 16; Index > 0; Index--) {
+    Cum += Cd->mLenCnt[Index] << (16 - Index);
+  }
+
+  while (Cum != (1U << 16)) {
+    Cd->mLenCnt[16]--;
+    for (Index = 15; Index > 0; Index--) {
+      if (Cd->mLenCnt[Index] != 0) {
+        Cd->mLenCnt[Index]--;
+        Cd->mLenCnt[Index + 1] += 2;
+        break;
+      }
+    }
+
+    Cum--;
+  }
+
+  for (Index = 16; Index > 0; Index--) {
+    Index3 = Cd->mLenCnt[Index];
+    Index3--;
+    while (Index3 >= 0) {
+      Cd->mLen[*Cd->mSortPtr++] = (UINT8) Index;
+      Index3--;
+    }
+  }
+}
+
+STATIC
+VOID
+DownHeap (
+  IN COMPRESS_DATA  *Cd,
+  IN INT32          Index
+  )
+{
+  INT32 Index2;
+  INT32 Index3;
+
+  //
+  // priority queue: send Index-th entry down heap
+  //
+  Index3  = Cd->mHeap[Index];
+  Index2  = 2 * Index;
+  while (Index2 <= Cd->mHeapSize) {
+    if (Index2 < Cd->mHeapSize && Cd->mFreq[Cd->mHeap[Index2]] > Cd->mFreq[Cd->mHeap[Index2 + 1]]) {
+      Index2++;
+    }
+
+    if (Cd->mFreq[Index3] <= Cd->mFreq[Cd->mHeap[Index2]]) {
+      break;
+    }
+
+    Cd->mHeap[Index]  = Cd->mHeap[Index2];
+    Index             = Index2;
+    Index2            = 2 * Index;
+  }
+
+  Cd->mHeap[Index] = (INT16) Index3;
+}
+
+STATIC
+VOID
+MakeCode (
+  IN  COMPRESS_DATA  *Cd,
+  IN  INT32          Number,
+  IN  UINT8          Len[],
+  OUT UINT16         Code[]
+  )
+/*++
+
+Routine Description:
+
+  Assign code to each symbol based on the code length array
+
+Arguments:
+
+  Cd      - The compression context
+  Number  - number of symbols
+  Len     - the code length array
+  Code    - stores codes for each symbol
+
+Returns: (VOID)
+
+--*/
+{
+  INT32   Index;
+  UINT16  Start[18];
+
+  Start[1] = 0;
+  for (Index = 1; Index <= 16; Index++) {
+    Start[Index + 1] = (UINT16) ((Start[Index] + Cd->mLenCnt[Index]) << 1);
+  }
+
+  for (Index = 0; Index < Number; Index++) {
+    Code[Index] = Start[Len[Index]]++;
+  }
+}
+
+STATIC
+INT32
+MakeTree (
+  IN  COMPRESS_DATA  *Cd,
+  IN  INT32          NParm,
+  IN  UINT16         FreqParm[],
+  OUT UINT8          LenParm[],
+  OUT UINT16         CodeParm[]
+  )
+/*++
+
+Routine Description:
+
+  Generates Huffman codes given a frequency distribution of symbols
+
+Arguments:
+
+  Cd       - The compression context
+  NParm    - number of symbols
+  FreqParm - frequency of each symbol
+  LenParm  - code length for each symbol
+  CodeParm - code for each symbol
+
+Returns:
+
+  Root of the Huffman tree.
+
+--*/
+{
+  INT32 Index;
+  INT32 Index2;
+  INT32 Index3;
+  INT32 Avail;
+
+  //
+  // make tree, calculate len[], return root
+  //
+  Cd->mN        = NParm;
+  Cd->mFreq     = FreqParm;
+  Cd->mLen      = LenParm;
+  Avail         = Cd->mN;
+  Cd->mHeapSize = 0;
+  Cd->mHeap[1]  = 0;
+  for (Index = 0; Index < Cd->mN; Index++) {
+    Cd->mLen[Index] = 0;
+    if (Cd->mFreq[Index]) {
+      Cd->mHeapSize++;
+      Cd->mHeap[Cd->mHeapSize] = (INT16) Index;
+    }
+  }
+
+  if (Cd->mHeapSize < 2) {
+    CodeParm[Cd->mHeap[1]] = 0;
+    return Cd->mHeap[1];
+  }
+
+  for (Index = Cd->mHeapSize / 2; Index >= 1; Index--) {
+    //
+    // make priority queue
+    //
+    DownHeap (Cd, Index);
+  }
+
+  Cd->mSortPtr = CodeParm;
+  do {
+    Index = Cd->mHeap[1];
+    if (Index < Cd->mN) {
+      *Cd->mSortPtr++ = (UINT16) Index;
+    }
+
+    Cd->mHeap[1] = Cd->mHeap[Cd->mHeapSize--];
+    DownHeap (Cd, 1);
+    Index2 = Cd->mHeap[1];
+    if (Index2 < Cd->mN) {
+      *Cd->mSortPtr++ = (UINT16) Index2;
+    }
+
+    Index3            = Avail++;
+    Cd->mFreq[Index3] = (UINT16) (Cd->mFreq[Index] + Cd->mFreq[Index2]);
+    Cd->mHeap[1]      = (INT16) Index3;
+    DownHeap (Cd, 1);
+    Cd->mLeft[Index3]   = (UINT16) Index;
+    Cd->mRight[Index3]  = (UINT16) Index2;
+  } while (Cd->mHeapSize > 1);
+
+  Cd->mSortPtr = CodeParm;
+  MakeLen (Cd, Index3);
+  MakeCode (Cd, NParm, LenParm, CodeParm);
+
+  //
+  // return root
+  //
+  return Index3;
+}
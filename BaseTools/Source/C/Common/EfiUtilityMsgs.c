@@ -104,6 +104,17 @@ Notes:
 {
   va_list List;
   //
+  // Current Print Level not output error information. The libBaseTools
+  // shared library uses it, since its callers report the errors themselves.
+  //
+  if (ERROR_LOG_LEVLE < mPrintLogLevel) {
+    mErrorCount++;
+    if (mStatus < STATUS_ERROR) {
+      mStatus = STATUS_ERROR;
+    }
+    return;
+  }
+  //
   // If limits have been set, then check that we have not exceeded them
   //
   if (mPrintLimitsSet) {
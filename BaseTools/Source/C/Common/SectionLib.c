@@ -0,0 +1,1159 @@
+/** @file
+Routines that create sections and FFS files from input data held in memory.
+
+Copyright (c) 2004 - 2017, Intel Corporation. All rights reserved.<BR>
+Copyright (c) 2026 Baikal Electronics JSC
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Common/UefiBaseTypes.h>
+#include <Common/PiFirmwareFile.h>
+#include <Protocol/GuidedSectionExtraction.h>
+#include <IndustryStandard/PeImage.h>
+#include <Guid/FfsSectionAlignmentPadding.h>
+
+#include "CommonLib.h"
+#include "Compress.h"
+#include "Crc32.h"
+#include "EfiUtilityMsgs.h"
+#include "SectionLib.h"
+
+//
+// Crc32 GUID section related definitions.
+//
+typedef struct {
+  EFI_GUID_DEFINED_SECTION  GuidSectionHeader;
+  UINT32                    CRC32Checksum;
+} CRC32_SECTION_HEADER;
+
+typedef struct {
+  EFI_GUID_DEFINED_SECTION2 GuidSectionHeader;
+  UINT32                    CRC32Checksum;
+} CRC32_SECTION_HEADER2;
+
+STATIC UINT32 mFfsValidAlign[] = {0, 8, 16, 128, 512, 1024, 4096, 32768, 65536, 131072, 262144,
+                                  524288, 1048576, 2097152, 4194304, 8388608, 16777216};
+
+STATIC EFI_GUID  mZeroGuid                 = {0x0, 0x0, 0x0, {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}};
+STATIC EFI_GUID  mEfiCrc32SectionGuid      = EFI_CRC32_GUIDED_SECTION_EXTRACTION_PROTOCOL_GUID;
+STATIC EFI_GUID  mEfiFfsSectionAlignmentPaddingGuid = EFI_FFS_SECTION_ALIGNMENT_PADDING_GUID;
+
+STATIC
+VOID
+Ascii2UnicodeString (
+  CHAR8    *String,
+  CHAR16   *UniString
+  )
+/*++
+
+Routine Description:
+
+  Write ascii string as unicode string format to FILE
+
+Arguments:
+
+  String      - Pointer to string that is written to FILE.
+  UniString   - Pointer to unicode string
+
+Returns:
+
+  NULL
+
+--*/
+{
+  while (*String != '\0') {
+    *(UniString++) = (CHAR16) *(String++);
+  }
+  //
+  // End the UniString with a NULL.
+  //
+  *UniString = '\0';
+}
+
+STATIC
+VOID
+CopySectionHeader (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         Offset,
+  OUT VOID           *Header,
+  IN  UINT32         HeaderSize
+  )
+/*++
+
+Routine Description:
+
+  Copy the header at Offset of an input section.  The part beyond the end
+  of the input is zero.
+
+--*/
+{
+  memset (Header, 0, HeaderSize);
+  if (Offset < Input->Size) {
+    memcpy (Header, Input->Data + Offset, MIN (HeaderSize, Input->Size - Offset));
+  }
+}
+
+EFI_STATUS
+ReadSectionInputFiles (
+  IN  CHAR8          **InputFileName,
+  IN  UINT32         *InputFileAlign,
+  IN  UINT32         InputFileNum,
+  OUT SECTION_INPUT  **Input
+  )
+/*++
+
+Routine Description:
+
+  Read the input files of GenSec or GenFfs.
+
+Arguments:
+
+  InputFileName  - Names of the input files.
+  InputFileAlign - Alignment of the input files, optional.
+  InputFileNum   - Number of input files.
+  Input          - The contents of the files, to be freed by FreeSectionInputs().
+
+Returns:
+
+  EFI_SUCCESS           - All files are read.
+  EFI_ABORTED           - A file cannot be read.
+  EFI_OUT_OF_RESOURCES  - No resource to complete the operation.
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT32      Index;
+
+  *Input = (SECTION_INPUT *) calloc (InputFileNum + 1, sizeof (SECTION_INPUT));
+  if (*Input == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < InputFileNum; Index++) {
+    Status = GetFileImage (InputFileName[Index], (CHAR8 **) &(*Input)[Index].Data, &(*Input)[Index].Size);
+    if (EFI_ERROR (Status)) {
+      FreeSectionInputs (*Input, Index);
+      *Input = NULL;
+      return Status;
+    }
+    DebugMsg (NULL, 0, 9, "Input files", "the input file name is %s and the size is %u bytes", InputFileName[Index], (unsigned) (*Input)[Index].Size);
+    if (InputFileAlign != NULL) {
+      (*Input)[Index].Alignment = InputFileAlign[Index];
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+VOID
+FreeSectionInputs (
+  IN SECTION_INPUT  *Input,
+  IN UINT32         InputNum
+  )
+/*++
+
+Routine Description:
+
+  Free the input files read by ReadSectionInputFiles().
+
+--*/
+{
+  UINT32  Index;
+
+  if (Input == NULL) {
+    return;
+  }
+  for (Index = 0; Index < InputNum; Index++) {
+    if (Input[Index].Data != NULL) {
+      free (Input[Index].Data);
+    }
+  }
+  free (Input);
+}
+
+VOID
+FreeSectionBuffer (
+  IN VOID           *Buffer
+  )
+/*++
+
+Routine Description:
+
+  Free a section or FFS file returned by the GenSection and GenFfsFile
+  routines.  Users of the shared BaseTools library must free them with
+  this routine.
+
+--*/
+{
+  free (Buffer);
+}
+
+STATIC
+EFI_STATUS
+ConcatenateSections (
+  IN     SECTION_INPUT            *Input,
+  IN     UINT32                   InputNum,
+  IN     EFI_FFS_FILE_ATTRIBUTES  FfsAttrib,
+  IN     BOOLEAN                  UseAlignment,
+  OUT    UINT8                    *FileBuffer,
+  IN OUT UINT32                   *BufferLength,
+  OUT    UINT32                   *MaxAlignment,
+  OUT    UINT8                    *PeSectionNum
+  )
+/*++
+
+Routine Description:
+
+  Worker of GetSectionContents().  If UseAlignment is FALSE, the alignment
+  of the input sections is ignored.
+
+--*/
+{
+  UINT32                              Size;
+  UINT32                              Offset;
+  UINT32                              Index;
+  UINT32                              Alignment;
+  EFI_FREEFORM_SUBTYPE_GUID_SECTION   *SectHeader;
+  EFI_COMMON_SECTION_HEADER2          TempSectHeader;
+  EFI_TE_IMAGE_HEADER                 TeHeader;
+  UINT32                              TeOffset;
+  EFI_GUID_DEFINED_SECTION            GuidSectHeader;
+  EFI_GUID_DEFINED_SECTION2           GuidSectHeader2;
+  UINT32                              HeaderSize;
+  UINT32                              MaxEncounteredAlignment;
+  UINT8                               PeNum;
+
+  if (InputNum < 1) {
+    Error (NULL, 0, 2000, "Invalid parameter", "must specify at least one input file");
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (BufferLength == NULL) {
+    Error (NULL, 0, 2000, "Invalid parameter", "BufferLength can't be NULL");
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Size                    = 0;
+  Offset                  = 0;
+  PeNum                   = 0;
+  MaxEncounteredAlignment = 1;
+
+  //
+  // Go through our array of sections and copy their contents
+  // to the output buffer.
+  //
+  for (Index = 0; Index < InputNum; Index++) {
+    //
+    // make sure section ends on a DWORD boundary
+    //
+    while ((Size & 0x03) != 0) {
+      if (FileBuffer != NULL && Size < *BufferLength) {
+        FileBuffer[Size] = 0;
+      }
+      Size++;
+    }
+
+    DebugMsg (NULL, 0, 9, "Input files", "the %uth input section size is %u bytes", (unsigned) Index, (unsigned) Input[Index].Size);
+    Alignment = UseAlignment ? Input[Index].Alignment : 0;
+    if (Alignment == 0) {
+      Alignment = 1;
+    }
+
+    //
+    // Check this section is Te/Pe section, and Calculate the numbers of Te/Pe section.
+    // The section might be EFI_COMMON_SECTION_HEADER2, but only Type needs to be checked.
+    //
+    TeOffset = 0;
+    if (Input[Index].Size >= MAX_SECTION_SIZE) {
+      HeaderSize = sizeof (EFI_COMMON_SECTION_HEADER2);
+    } else {
+      HeaderSize = sizeof (EFI_COMMON_SECTION_HEADER);
+    }
+    CopySectionHeader (&Input[Index], 0, &TempSectHeader, HeaderSize);
+    if (TempSectHeader.Type == EFI_SECTION_TE) {
+      PeNum ++;
+      CopySectionHeader (&Input[Index], HeaderSize, &TeHeader, sizeof (TeHeader));
+      if (TeHeader.Signature == EFI_TE_IMAGE_HEADER_SIGNATURE) {
+        TeOffset = TeHeader.StrippedSize - sizeof (TeHeader);
+      }
+    } else if (TempSectHeader.Type == EFI_SECTION_PE32) {
+      PeNum ++;
+    } else if (TempSectHeader.Type == EFI_SECTION_GUID_DEFINED) {
+      if (Input[Index].Size >= MAX_SECTION_SIZE) {
+        CopySectionHeader (&Input[Index], 0, &GuidSectHeader2, sizeof (GuidSectHeader2));
+        if ((GuidSectHeader2.Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0) {
+          HeaderSize = GuidSectHeader2.DataOffset;
+        }
+      } else {
+        CopySectionHeader (&Input[Index], 0, &GuidSectHeader, sizeof (GuidSectHeader));
+        if ((GuidSectHeader.Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0) {
+          HeaderSize = GuidSectHeader.DataOffset;
+        }
+      }
+      PeNum ++;
+    } else if (TempSectHeader.Type == EFI_SECTION_COMPRESSION ||
+               TempSectHeader.Type == EFI_SECTION_FIRMWARE_VOLUME_IMAGE) {
+      //
+      // for the encapsulated section, assume it contains Pe/Te section
+      //
+      PeNum ++;
+    }
+
+    //
+    // Revert TeOffset to the converse value relative to Alignment
+    // This is to assure the original PeImage Header at Alignment.
+    //
+    if (TeOffset != 0) {
+      TeOffset = Alignment - (TeOffset % Alignment);
+      TeOffset = TeOffset % Alignment;
+    }
+
+    //
+    // make sure section data meet its alignment requirement by adding one pad section.
+    //
+    if (((Size + HeaderSize + TeOffset) % Alignment) != 0) {
+      Offset = (Size + sizeof (EFI_COMMON_SECTION_HEADER) + HeaderSize + TeOffset + Alignment - 1) & ~(Alignment - 1);
+      Offset = Offset - Size - HeaderSize - TeOffset;
+
+      if (FileBuffer != NULL && ((Size + Offset) < *BufferLength)) {
+        //
+        // The maximal alignment is 64K, the raw section size must be less than 0xffffff
+        //
+        memset (FileBuffer + Size, 0, Offset);
+        SectHeader                        = (EFI_FREEFORM_SUBTYPE_GUID_SECTION *) (FileBuffer + Size);
+        SectHeader->CommonHeader.Size[0]  = (UINT8) (Offset & 0xff);
+        SectHeader->CommonHeader.Size[1]  = (UINT8) ((Offset & 0xff00) >> 8);
+        SectHeader->CommonHeader.Size[2]  = (UINT8) ((Offset & 0xff0000) >> 16);
+
+        //
+        // Only add a special reducible padding section if
+        // - this FFS has the FFS_ATTRIB_FIXED attribute,
+        // - none of the preceding sections have alignment requirements,
+        // - the size of the padding is sufficient for the
+        //   EFI_SECTION_FREEFORM_SUBTYPE_GUID header.
+        //
+        if ((FfsAttrib & FFS_ATTRIB_FIXED) != 0 &&
+            MaxEncounteredAlignment <= 1 &&
+            Offset >= sizeof (EFI_FREEFORM_SUBTYPE_GUID_SECTION)) {
+          SectHeader->CommonHeader.Type   = EFI_SECTION_FREEFORM_SUBTYPE_GUID;
+          SectHeader->SubTypeGuid         = mEfiFfsSectionAlignmentPaddingGuid;
+        } else {
+          SectHeader->CommonHeader.Type   = EFI_SECTION_RAW;
+        }
+      }
+      DebugMsg (NULL, 0, 9, "Pad raw section for section data alignment", "Pad Raw section size is %u", (unsigned) Offset);
+
+      Size = Size + Offset;
+    }
+
+    //
+    // Get the Max alignment of all input file datas
+    //
+    if (MaxEncounteredAlignment < Alignment) {
+      MaxEncounteredAlignment = Alignment;
+    }
+
+    //
+    // Now copy the section into the buffer
+    // Buffer must be enough to contain the section.
+    //
+    if ((Input[Index].Size > 0) && (FileBuffer != NULL) && ((Size + Input[Index].Size) <= *BufferLength)) {
+      memcpy (FileBuffer + Size, Input[Index].Data, Input[Index].Size);
+    }
+
+    Size += Input[Index].Size;
+  }
+
+  if (MaxAlignment != NULL) {
+    *MaxAlignment = MaxEncounteredAlignment;
+  }
+  if (PeSectionNum != NULL) {
+    *PeSectionNum = PeNum;
+  }
+
+  //
+  // Set the real required buffer size.
+  //
+  if (Size > *BufferLength) {
+    *BufferLength = Size;
+    return EFI_BUFFER_TOO_SMALL;
+  } else {
+    *BufferLength = Size;
+    return EFI_SUCCESS;
+  }
+}
+
+EFI_STATUS
+GetSectionContents (
+  IN     SECTION_INPUT            *Input,
+  IN     UINT32                   InputNum,
+  IN     EFI_FFS_FILE_ATTRIBUTES  FfsAttrib,
+  OUT    UINT8                    *FileBuffer,
+  IN OUT UINT32                   *BufferLength,
+  OUT    UINT32                   *MaxAlignment,
+  OUT    UINT8                    *PeSectionNum
+  )
+/*++
+
+Routine Description:
+
+  Concatenate the input sections into FileBuffer.  Each section starts on
+  a DWORD boundary, and a pad section is inserted in front of a section
+  whose data would not meet its alignment.
+
+Arguments:
+
+  Input          - The input sections.
+  InputNum       - Number of input sections.
+  FfsAttrib      - Attributes of the FFS file the sections go into, or 0.
+                   A fixed FFS file gets reducible padding sections.
+  FileBuffer     - Output buffer, or NULL to get the required size.
+  BufferLength   - On input, the size of FileBuffer.
+                   On output, the size of the data.
+  MaxAlignment   - The largest alignment of all input sections, optional.
+  PeSectionNum   - Number of PE32, TE and encapsulation sections, optional.
+
+Returns:
+
+  EFI_SUCCESS           - The data is in FileBuffer.
+  EFI_INVALID_PARAMETER - InputNum is 0 or BufferLength is NULL.
+  EFI_BUFFER_TOO_SMALL  - FileBuffer is too small. BufferLength is the size needed.
+
+--*/
+{
+  return ConcatenateSections (Input, InputNum, FfsAttrib, TRUE, FileBuffer, BufferLength, MaxAlignment, PeSectionNum);
+}
+
+EFI_STATUS
+GenSectionCommonLeafSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  IN  UINT8          SectionType,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Generate a leaf section of type other than EFI_SECTION_VERSION
+  and EFI_SECTION_USER_INTERFACE. Input must be well formed.
+  The function won't validate the input's contents. For
+  common leaf sections, the input may be a binary file.
+  The function will add section header to the input.
+
+Arguments:
+
+  Input          - The input data.
+  InputNum       - Number of inputs. Should be 1 for leaf section.
+  SectionType    - A valid section type
+  OutBuffer      - The section, to be freed by the caller.
+  OutLength      - Size of the section.
+
+Returns:
+
+  EFI_SUCCESS           - successful return
+  EFI_INVALID_PARAMETER - InputNum is not 1.
+  EFI_OUT_OF_RESOURCES  - No resource to complete the operation.
+
+--*/
+{
+  UINT8                     *Buffer;
+  UINT32                    TotalLength;
+  UINT32                    HeaderLength;
+  EFI_COMMON_SECTION_HEADER *CommonSect;
+
+  if (InputNum > 1) {
+    Error (NULL, 0, 2000, "Invalid parameter", "more than one input file specified");
+    return EFI_INVALID_PARAMETER;
+  } else if (InputNum < 1) {
+    Error (NULL, 0, 2000, "Invalid parameter", "no input file specified");
+    return EFI_INVALID_PARAMETER;
+  }
+
+  TotalLength  = sizeof (EFI_COMMON_SECTION_HEADER) + Input[0].Size;
+  HeaderLength = sizeof (EFI_COMMON_SECTION_HEADER);
+  if (TotalLength >= MAX_SECTION_SIZE) {
+    TotalLength = sizeof (EFI_COMMON_SECTION_HEADER2) + Input[0].Size;
+    HeaderLength = sizeof (EFI_COMMON_SECTION_HEADER2);
+  }
+  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) TotalLength);
+  //
+  // Fill in the fields in the local section header structure
+  //
+  Buffer = (UINT8 *) malloc ((size_t) TotalLength);
+  if (Buffer == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
+    return EFI_OUT_OF_RESOURCES;
+  }
+  CommonSect = (EFI_COMMON_SECTION_HEADER *) Buffer;
+  CommonSect->Type     = SectionType;
+  if (TotalLength < MAX_SECTION_SIZE) {
+    CommonSect->Size[0]  = (UINT8) (TotalLength & 0xff);
+    CommonSect->Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
+    CommonSect->Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
+  } else {
+    memset(CommonSect->Size, 0xff, sizeof(UINT8) * 3);
+    ((EFI_COMMON_SECTION_HEADER2 *)CommonSect)->ExtendedSize = TotalLength;
+  }
+
+  if (Input[0].Size != 0) {
+    memcpy (Buffer + HeaderLength, Input[0].Data, Input[0].Size);
+  }
+
+  *OutBuffer = Buffer;
+  *OutLength = TotalLength;
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+AllocateSectionContents (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  IN  BOOLEAN        UseAlignment,
+  IN  UINT32         HeaderRoom,
+  OUT UINT8          **FileBuffer,
+  OUT UINT32         *InputLength
+  )
+/*++
+
+Routine Description:
+
+  Concatenate the input sections into a new buffer, leaving HeaderRoom
+  bytes in front of them.
+
+--*/
+{
+  EFI_STATUS  Status;
+
+  *FileBuffer  = NULL;
+  *InputLength = 0;
+  Status = ConcatenateSections (Input, InputNum, 0, UseAlignment, NULL, InputLength, NULL, NULL);
+  if (Status != EFI_BUFFER_TOO_SMALL) {
+    return Status;
+  }
+
+  *FileBuffer = (UINT8 *) malloc (*InputLength + HeaderRoom);
+  if (*FileBuffer == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Status = ConcatenateSections (Input, InputNum, 0, UseAlignment, *FileBuffer + HeaderRoom, InputLength, NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    free (*FileBuffer);
+    *FileBuffer = NULL;
+  }
+  return Status;
+}
+
+EFI_STATUS
+GenSectionAllSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Concatenate the aligned input sections without a section header, which
+  is what GenSec does when no section type is given.
+
+--*/
+{
+  EFI_STATUS  Status;
+
+  Status = AllocateSectionContents (Input, InputNum, TRUE, 0, OutBuffer, OutLength);
+  if (!EFI_ERROR (Status)) {
+    VerboseMsg ("the size of the created section file is %u bytes", (unsigned) *OutLength);
+  }
+  return Status;
+}
+
+EFI_STATUS
+GenSectionCompressionSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  IN  UINT8          SectCompSubType,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Generate an encapsulating section of type EFI_SECTION_COMPRESSION
+  Input must be already sectioned. The function won't validate
+  the input's contents. Caller should hand in sections already
+  with section header.
+
+Arguments:
+
+  Input           - The input sections.
+  InputNum        - Number of input sections. Should be at least 1.
+  SectCompSubType - Specify the compression algorithm requested.
+  OutBuffer       - The section, to be freed by the caller.
+  OutLength       - Size of the section.
+
+Returns:
+
+  EFI_SUCCESS           on successful return
+  EFI_INVALID_PARAMETER if InputNum is less than 1
+  EFI_ABORTED           if the compression type is unknown.
+  EFI_OUT_OF_RESOURCES  No resource to complete the operation.
+
+--*/
+{
+  UINT32                  TotalLength;
+  UINT32                  InputLength;
+  UINT32                  CompressedLength;
+  UINT32                  HeaderLength;
+  UINT8                   *FileBuffer;
+  UINT8                   *OutputBuffer;
+  EFI_STATUS              Status;
+  EFI_COMPRESSION_SECTION *CompressionSect;
+  EFI_COMPRESSION_SECTION2 *CompressionSect2;
+
+  InputLength       = 0;
+  FileBuffer        = NULL;
+  OutputBuffer      = NULL;
+  CompressedLength  = 0;
+  TotalLength       = 0;
+
+  switch (SectCompSubType) {
+  case EFI_NOT_COMPRESSED:
+    //
+    // Read the input sections right behind the largest section header.
+    //
+    Status = AllocateSectionContents (Input, InputNum, FALSE, sizeof (EFI_COMPRESSION_SECTION2), &FileBuffer, &InputLength);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    CompressedLength = InputLength;
+    OutputBuffer     = FileBuffer + sizeof (EFI_COMPRESSION_SECTION2);
+    FileBuffer       = NULL;
+    break;
+
+  case EFI_STANDARD_COMPRESSION:
+    Status = AllocateSectionContents (Input, InputNum, FALSE, 0, &FileBuffer, &InputLength);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    //
+    // Compressible data fits in a buffer of the input size, so compress once
+    // into such a buffer, and only compress again if the data is too large.
+    //
+    CompressedLength = InputLength;
+    OutputBuffer = malloc (sizeof (EFI_COMPRESSION_SECTION2) + CompressedLength);
+    if (OutputBuffer == NULL) {
+      free (FileBuffer);
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Status = EfiCompress (FileBuffer, InputLength, OutputBuffer + sizeof (EFI_COMPRESSION_SECTION2), &CompressedLength);
+    if (Status == EFI_BUFFER_TOO_SMALL) {
+      free (OutputBuffer);
+      OutputBuffer = malloc (sizeof (EFI_COMPRESSION_SECTION2) + CompressedLength);
+      if (OutputBuffer == NULL) {
+        free (FileBuffer);
+        return EFI_OUT_OF_RESOURCES;
+      }
+      Status = EfiCompress (FileBuffer, InputLength, OutputBuffer + sizeof (EFI_COMPRESSION_SECTION2), &CompressedLength);
+    }
+    free (FileBuffer);
+    FileBuffer = NULL;
+    if (EFI_ERROR (Status)) {
+      free (OutputBuffer);
+      return Status;
+    }
+    OutputBuffer += sizeof (EFI_COMPRESSION_SECTION2);
+    break;
+
+  default:
+    Error (NULL, 0, 2000, "Invalid parameter", "unknown compression type");
+    return EFI_ABORTED;
+  }
+
+  DebugMsg (NULL, 0, 9, "comprss file size",
+            "the original section size is %d bytes and the compressed section size is %u bytes", (unsigned) InputLength, (unsigned) CompressedLength);
+
+  //
+  // The data follows the largest section header.  Use the smaller header
+  // when the section fits, and drop the room left for the larger one.
+  //
+  HeaderLength = sizeof (EFI_COMPRESSION_SECTION);
+  if (CompressedLength + HeaderLength >= MAX_SECTION_SIZE) {
+    HeaderLength = sizeof (EFI_COMPRESSION_SECTION2);
+  }
+  TotalLength = CompressedLength + HeaderLength;
+  FileBuffer  = OutputBuffer - sizeof (EFI_COMPRESSION_SECTION2);
+  if (HeaderLength != sizeof (EFI_COMPRESSION_SECTION2)) {
+    memmove (FileBuffer + HeaderLength, OutputBuffer, CompressedLength);
+  }
+  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) TotalLength);
+
+  //
+  // Add the section header for the compressed data
+  //
+  if (TotalLength >= MAX_SECTION_SIZE) {
+    CompressionSect2 = (EFI_COMPRESSION_SECTION2 *)FileBuffer;
+
+    memset(CompressionSect2->CommonHeader.Size, 0xff, sizeof(UINT8) * 3);
+    CompressionSect2->CommonHeader.Type         = EFI_SECTION_COMPRESSION;
+    CompressionSect2->CommonHeader.ExtendedSize = TotalLength;
+    CompressionSect2->CompressionType           = SectCompSubType;
+    CompressionSect2->UncompressedLength        = InputLength;
+  } else {
+    CompressionSect = (EFI_COMPRESSION_SECTION *) FileBuffer;
+
+    CompressionSect->CommonHeader.Type     = EFI_SECTION_COMPRESSION;
+    CompressionSect->CommonHeader.Size[0]  = (UINT8) (TotalLength & 0xff);
+    CompressionSect->CommonHeader.Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
+    CompressionSect->CommonHeader.Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
+    CompressionSect->CompressionType       = SectCompSubType;
+    CompressionSect->UncompressedLength    = InputLength;
+  }
+
+  *OutBuffer = FileBuffer;
+  *OutLength = TotalLength;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+GenSectionGuidDefinedSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  IN  EFI_GUID       *VendorGuid,
+  IN  UINT16         DataAttribute,
+  IN  UINT32         DataHeaderSize,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Generate an encapsulating section of type EFI_SECTION_GUID_DEFINED
+  Input must be already sectioned. The function won't validate
+  the input's contents. Caller should hand in sections already
+  with section header.
+
+Arguments:
+
+  Input          - The input sections.
+  InputNum       - Number of input sections. Should be at least 1.
+  VendorGuid     - Specify vendor guid value.
+  DataAttribute  - Specify attribute for the vendor guid data.
+  DataHeaderSize - Guided Data Header Size
+  OutBuffer      - The section, to be freed by the caller.
+  OutLength      - Size of the section.
+
+Returns:
+
+  EFI_SUCCESS on successful return
+  EFI_INVALID_PARAMETER if InputNum is less than 1
+  EFI_NOT_FOUND if the input is empty.
+  EFI_OUT_OF_RESOURCES  No resource to complete the operation.
+
+--*/
+{
+  UINT32                TotalLength;
+  UINT32                InputLength;
+  UINT32                Offset;
+  UINT8                 *FileBuffer;
+  UINT32                Crc32Checksum;
+  EFI_STATUS            Status;
+  CRC32_SECTION_HEADER  *Crc32GuidSect;
+  CRC32_SECTION_HEADER2  *Crc32GuidSect2;
+  EFI_GUID_DEFINED_SECTION  *VendorGuidSect;
+  EFI_GUID_DEFINED_SECTION2  *VendorGuidSect2;
+  BOOLEAN               UseAlignment;
+
+  InputLength = 0;
+  Offset      = 0;
+  FileBuffer  = NULL;
+  TotalLength = 0;
+
+  //
+  // Only the default CRC32 GUIDed section honours the alignment of the
+  // input sections.  The alignment for other GUIDed sections is processed
+  // when the dummy section of their contents is generated.
+  //
+  UseAlignment = (BOOLEAN) (CompareGuid (VendorGuid, &mZeroGuid) == 0);
+
+  //
+  // first get the size of all input sections
+  //
+  Status = ConcatenateSections (Input, InputNum, 0, UseAlignment, NULL, &InputLength, NULL, NULL);
+
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    if (CompareGuid (VendorGuid, &mZeroGuid) == 0) {
+      Offset = sizeof (CRC32_SECTION_HEADER);
+      if (InputLength + Offset >= MAX_SECTION_SIZE) {
+        Offset = sizeof (CRC32_SECTION_HEADER2);
+      }
+    } else {
+      Offset = sizeof (EFI_GUID_DEFINED_SECTION);
+      if (InputLength + Offset >= MAX_SECTION_SIZE) {
+        Offset = sizeof (EFI_GUID_DEFINED_SECTION2);
+      }
+    }
+    TotalLength = InputLength + Offset;
+
+    FileBuffer = (UINT8 *) malloc (InputLength + Offset);
+    if (FileBuffer == NULL) {
+      Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
+      return EFI_OUT_OF_RESOURCES;
+    }
+    //
+    // read all input sections into a buffer
+    //
+    Status = ConcatenateSections (Input, InputNum, 0, UseAlignment, FileBuffer + Offset, &InputLength, NULL, NULL);
+  }
+
+  if (EFI_ERROR (Status)) {
+    if (FileBuffer != NULL) {
+      free (FileBuffer);
+    }
+    return Status;
+  }
+
+  if (InputLength == 0) {
+    if (FileBuffer != NULL) {
+      free (FileBuffer);
+    }
+    Error (NULL, 0, 2000, "Invalid parameter", "the size of input file can't be zero");
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // InputLength != 0, but FileBuffer == NULL means out of resources.
+  //
+  if (FileBuffer == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Now data is in FileBuffer + Offset
+  //
+  if (CompareGuid (VendorGuid, &mZeroGuid) == 0) {
+    //
+    // Default Guid section is CRC32.
+    //
+    Crc32Checksum = 0;
+    CalculateCrc32 (FileBuffer + Offset, InputLength, &Crc32Checksum);
+
+    if (TotalLength >= MAX_SECTION_SIZE) {
+      Crc32GuidSect2 = (CRC32_SECTION_HEADER2 *) FileBuffer;
+      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
+      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Size[0]  = (UINT8) 0xff;
+      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Size[1]  = (UINT8) 0xff;
+      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Size[2]  = (UINT8) 0xff;
+      Crc32GuidSect2->GuidSectionHeader.CommonHeader.ExtendedSize = TotalLength;
+      memcpy (&(Crc32GuidSect2->GuidSectionHeader.SectionDefinitionGuid), &mEfiCrc32SectionGuid, sizeof (EFI_GUID));
+      Crc32GuidSect2->GuidSectionHeader.Attributes  = EFI_GUIDED_SECTION_AUTH_STATUS_VALID;
+      Crc32GuidSect2->GuidSectionHeader.DataOffset  = sizeof (CRC32_SECTION_HEADER2);
+      Crc32GuidSect2->CRC32Checksum                 = Crc32Checksum;
+      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", Crc32GuidSect2->GuidSectionHeader.DataOffset);
+    } else {
+      Crc32GuidSect = (CRC32_SECTION_HEADER *) FileBuffer;
+      Crc32GuidSect->GuidSectionHeader.CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
+      Crc32GuidSect->GuidSectionHeader.CommonHeader.Size[0]  = (UINT8) (TotalLength & 0xff);
+      Crc32GuidSect->GuidSectionHeader.CommonHeader.Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
+      Crc32GuidSect->GuidSectionHeader.CommonHeader.Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
+      memcpy (&(Crc32GuidSect->GuidSectionHeader.SectionDefinitionGuid), &mEfiCrc32SectionGuid, sizeof (EFI_GUID));
+      Crc32GuidSect->GuidSectionHeader.Attributes  = EFI_GUIDED_SECTION_AUTH_STATUS_VALID;
+      Crc32GuidSect->GuidSectionHeader.DataOffset  = sizeof (CRC32_SECTION_HEADER);
+      Crc32GuidSect->CRC32Checksum                 = Crc32Checksum;
+      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", Crc32GuidSect->GuidSectionHeader.DataOffset);
+    }
+  } else {
+    if (TotalLength >= MAX_SECTION_SIZE) {
+      VendorGuidSect2 = (EFI_GUID_DEFINED_SECTION2 *) FileBuffer;
+      VendorGuidSect2->CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
+      VendorGuidSect2->CommonHeader.Size[0]  = (UINT8) 0xff;
+      VendorGuidSect2->CommonHeader.Size[1]  = (UINT8) 0xff;
+      VendorGuidSect2->CommonHeader.Size[2]  = (UINT8) 0xff;
+      VendorGuidSect2->CommonHeader.ExtendedSize = InputLength + sizeof (EFI_GUID_DEFINED_SECTION2);
+      memcpy (&(VendorGuidSect2->SectionDefinitionGuid), VendorGuid, sizeof (EFI_GUID));
+      VendorGuidSect2->Attributes  = DataAttribute;
+      VendorGuidSect2->DataOffset  = (UINT16) (sizeof (EFI_GUID_DEFINED_SECTION2) + DataHeaderSize);
+      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", VendorGuidSect2->DataOffset);
+    } else {
+      VendorGuidSect = (EFI_GUID_DEFINED_SECTION *) FileBuffer;
+      VendorGuidSect->CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
+      VendorGuidSect->CommonHeader.Size[0]  = (UINT8) (TotalLength & 0xff);
+      VendorGuidSect->CommonHeader.Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
+      VendorGuidSect->CommonHeader.Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
+      memcpy (&(VendorGuidSect->SectionDefinitionGuid), VendorGuid, sizeof (EFI_GUID));
+      VendorGuidSect->Attributes  = DataAttribute;
+      VendorGuidSect->DataOffset  = (UINT16) (sizeof (EFI_GUID_DEFINED_SECTION) + DataHeaderSize);
+      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", VendorGuidSect->DataOffset);
+    }
+  }
+  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) TotalLength);
+
+  *OutBuffer = FileBuffer;
+  *OutLength = TotalLength;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+GenSectionVersionSection (
+  IN  UINT16         BuildNumber,
+  IN  CHAR8          *VersionString,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an EFI_SECTION_VERSION section.
+
+--*/
+{
+  UINT32               Length;
+  EFI_VERSION_SECTION  *VersionSect;
+
+  Length = sizeof (EFI_COMMON_SECTION_HEADER);
+  //
+  // 2 bytes for the build number UINT16
+  //
+  Length += 2;
+  //
+  // VersionString is ascii.. unicode is 2X + 2 bytes for terminating unicode null.
+  //
+  Length += (strlen (VersionString) * 2) + 2;
+  VersionSect = (EFI_VERSION_SECTION *) malloc (Length);
+  if (VersionSect == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
+    return EFI_OUT_OF_RESOURCES;
+  }
+  VersionSect->CommonHeader.Type     = EFI_SECTION_VERSION;
+  VersionSect->CommonHeader.Size[0]  = (UINT8) (Length & 0xff);
+  VersionSect->CommonHeader.Size[1]  = (UINT8) ((Length & 0xff00) >> 8);
+  VersionSect->CommonHeader.Size[2]  = (UINT8) ((Length & 0xff0000) >> 16);
+  VersionSect->BuildNumber           = BuildNumber;
+  Ascii2UnicodeString (VersionString, VersionSect->VersionString);
+  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) Length);
+
+  *OutBuffer = (UINT8 *) VersionSect;
+  *OutLength = Length;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+GenSectionUiSection (
+  IN  CHAR8          *Name,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an EFI_SECTION_USER_INTERFACE section.
+
+--*/
+{
+  UINT32                      Length;
+  EFI_USER_INTERFACE_SECTION  *UiSect;
+
+  Length = sizeof (EFI_COMMON_SECTION_HEADER);
+  //
+  // Name is ascii.. unicode is 2X + 2 bytes for terminating unicode null.
+  //
+  Length += (strlen (Name) * 2) + 2;
+  UiSect = (EFI_USER_INTERFACE_SECTION *) malloc (Length);
+  if (UiSect == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
+    return EFI_OUT_OF_RESOURCES;
+  }
+  UiSect->CommonHeader.Type     = EFI_SECTION_USER_INTERFACE;
+  UiSect->CommonHeader.Size[0]  = (UINT8) (Length & 0xff);
+  UiSect->CommonHeader.Size[1]  = (UINT8) ((Length & 0xff00) >> 8);
+  UiSect->CommonHeader.Size[2]  = (UINT8) ((Length & 0xff0000) >> 16);
+  Ascii2UnicodeString (Name, UiSect->FileNameString);
+  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) Length);
+
+  *OutBuffer = (UINT8 *) UiSect;
+  *OutLength = Length;
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+GenFfsFile (
+  IN  SECTION_INPUT            *Input,
+  IN  UINT32                   InputNum,
+  IN  EFI_FV_FILETYPE          FfsFiletype,
+  IN  EFI_GUID                 *FileGuid,
+  IN  EFI_FFS_FILE_ATTRIBUTES  FfsAttrib,
+  IN  UINT32                   FfsAlign,
+  OUT UINT8                    **OutBuffer,
+  OUT UINT32                   *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an FFS file of the input sections.
+
+Arguments:
+
+  Input          - The input sections.
+  InputNum       - Number of input sections.
+  FfsFiletype    - Type of the FFS file.
+  FileGuid       - Name of the FFS file.
+  FfsAttrib      - FFS_ATTRIB_FIXED and FFS_ATTRIB_CHECKSUM.
+  FfsAlign       - Minimum alignment of the FFS file as an index into the
+                   8, 16, 128, 512, 1K, 4K, 32K, 64K ... 16M alignments.
+  OutBuffer      - The FFS file, to be freed by the caller.
+  OutLength      - Size of the FFS file.
+
+Returns:
+
+  EFI_SUCCESS           - The FFS file is in OutBuffer.
+  EFI_INVALID_PARAMETER - The sections do not match the file type.
+  EFI_OUT_OF_RESOURCES  - No resource to complete the operation.
+
+--*/
+{
+  EFI_STATUS              Status;
+  UINT8                   *FileBuffer;
+  UINT32                  FileSize;
+  UINT32                  MaxAlignment;
+  EFI_FFS_FILE_HEADER2    *FfsFileHeader;
+  UINT32                  Index;
+  UINT8                   PeSectionNum;
+  UINT32                  HeaderSize;
+
+  FileSize     = 0;
+  MaxAlignment = 1;
+  PeSectionNum = 0;
+
+  //
+  // Calculate the size of all input sections.
+  //
+  Status = GetSectionContents (Input, InputNum, FfsAttrib, NULL, &FileSize, &MaxAlignment, &PeSectionNum);
+  if (Status != EFI_BUFFER_TOO_SMALL && EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if ((FfsFiletype == EFI_FV_FILETYPE_SECURITY_CORE ||
+      FfsFiletype == EFI_FV_FILETYPE_PEI_CORE ||
+      FfsFiletype == EFI_FV_FILETYPE_DXE_CORE) && (PeSectionNum != 1)) {
+    Error (NULL, 0, 2000, "Invalid parameter", "Fv File type 0x%02X must have one and only one Pe or Te section, but %u Pe/Te section are input", FfsFiletype, PeSectionNum);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((FfsFiletype == EFI_FV_FILETYPE_PEIM ||
+      FfsFiletype == EFI_FV_FILETYPE_DRIVER ||
+      FfsFiletype == EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER ||
+      FfsFiletype == EFI_FV_FILETYPE_APPLICATION) && (PeSectionNum < 1)) {
+    Error (NULL, 0, 2000, "Invalid parameter", "Fv File type 0x%02X must have at least one Pe or Te section, but no Pe/Te section is input", FfsFiletype);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (FileSize + sizeof (EFI_FFS_FILE_HEADER) >= MAX_FFS_SIZE) {
+    HeaderSize = sizeof (EFI_FFS_FILE_HEADER2);
+  } else {
+    HeaderSize = sizeof (EFI_FFS_FILE_HEADER);
+  }
+
+  //
+  // Read all input sections right behind the FFS file header.
+  //
+  FileBuffer = (UINT8 *) malloc (HeaderSize + FileSize);
+  if (FileBuffer == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+    return EFI_OUT_OF_RESOURCES;
+  }
+  memset (FileBuffer, 0, HeaderSize + FileSize);
+  Status = GetSectionContents (Input, InputNum, FfsAttrib, FileBuffer + HeaderSize, &FileSize, &MaxAlignment, &PeSectionNum);
+  if (EFI_ERROR (Status)) {
+    free (FileBuffer);
+    return Status;
+  }
+
+  //
+  // Create Ffs file header.
+  //
+  FfsFileHeader = (EFI_FFS_FILE_HEADER2 *) FileBuffer;
+  memcpy (&FfsFileHeader->Name, FileGuid, sizeof (EFI_GUID));
+  FfsFileHeader->Type       = FfsFiletype;
+  //
+  // Update FFS Alignment based on the max alignment required by input section files
+  //
+  VerboseMsg ("the max alignment of all input sections is %u", (unsigned) MaxAlignment);
+  for (Index = 0; Index < sizeof (mFfsValidAlign) / sizeof (UINT32) - 1; Index ++) {
+    if ((MaxAlignment > mFfsValidAlign [Index]) && (MaxAlignment <= mFfsValidAlign [Index + 1])) {
+      break;
+    }
+  }
+  if (FfsAlign < Index) {
+    FfsAlign = Index;
+  }
+  VerboseMsg ("the alignment of the generated FFS file is %u", (unsigned) mFfsValidAlign [FfsAlign + 1]);
+
+  //
+  // Now FileSize includes the EFI_FFS_FILE_HEADER
+  //
+  FileSize += HeaderSize;
+  if (HeaderSize == sizeof (EFI_FFS_FILE_HEADER2)) {
+    FfsFileHeader->ExtendedSize = FileSize;
+    FfsAttrib |= FFS_ATTRIB_LARGE_FILE;
+  } else {
+    FfsFileHeader->Size[0]  = (UINT8) (FileSize & 0xFF);
+    FfsFileHeader->Size[1]  = (UINT8) ((FileSize & 0xFF00) >> 8);
+    FfsFileHeader->Size[2]  = (UINT8) ((FileSize & 0xFF0000) >> 16);
+  }
+  VerboseMsg ("the size of the generated FFS file is %u bytes", (unsigned) FileSize);
+
+  //FfsAlign larger than 7, set FFS_ATTRIB_DATA_ALIGNMENT2
+  if (FfsAlign < 8) {
+    FfsFileHeader->Attributes = (EFI_FFS_FILE_ATTRIBUTES) (FfsAttrib | (FfsAlign << 3));
+  } else {
+    FfsFileHeader->Attributes = (EFI_FFS_FILE_ATTRIBUTES) (FfsAttrib | ((FfsAlign & 0x7) << 3) | FFS_ATTRIB_DATA_ALIGNMENT2);
+  }
+
+  //
+  // Fill in checksums and state, these must be zero for checksumming
+  //
+  FfsFileHeader->IntegrityCheck.Checksum.Header = CalculateChecksum8 (
+                                                    (UINT8 *) FfsFileHeader,
+                                                    HeaderSize
+                                                    );
+
+  if (FfsFileHeader->Attributes & FFS_ATTRIB_CHECKSUM) {
+    //
+    // Ffs header checksum = zero, so only need to calculate ffs body.
+    //
+    FfsFileHeader->IntegrityCheck.Checksum.File = CalculateChecksum8 (
+                                                    FileBuffer + HeaderSize,
+                                                    FileSize - HeaderSize
+                                                    );
+  } else {
+    FfsFileHeader->IntegrityCheck.Checksum.File = FFS_FIXED_CHECKSUM;
+  }
+
+  FfsFileHeader->State = EFI_FILE_HEADER_CONSTRUCTION | EFI_FILE_HEADER_VALID | EFI_FILE_DATA_VALID;
+
+  *OutBuffer = FileBuffer;
+  *OutLength = FileSize;
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,271 @@
+/** @file
+Header file for the routines that create sections and FFS files from
+input data held in memory.  They are shared by GenSec, GenFfs and the
+BaseTools shared library.
+
+Copyright (c) 2026 Baikal Electronics JSC
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef _SECTION_LIB_H_
+#define _SECTION_LIB_H_
+
+#include <Common/UefiBaseTypes.h>
+#include <Common/PiFirmwareFile.h>
+
+//
+// One input section or file.  Alignment is the required alignment of the
+// section data, 0 or 1 if there is no requirement.
+//
+typedef struct {
+  UINT8   *Data;
+  UINT32  Size;
+  UINT32  Alignment;
+} SECTION_INPUT;
+
+EFI_STATUS
+ReadSectionInputFiles (
+  IN  CHAR8          **InputFileName,
+  IN  UINT32         *InputFileAlign,
+  IN  UINT32         InputFileNum,
+  OUT SECTION_INPUT  **Input
+  )
+/*++
+
+Routine Description:
+
+  Read the input files of GenSec or GenFfs.
+
+Arguments:
+
+  InputFileName  - Names of the input files.
+  InputFileAlign - Alignment of the input files, optional.
+  InputFileNum   - Number of input files.
+  Input          - The contents of the files, to be freed by FreeSectionInputs().
+
+Returns:
+
+  EFI_SUCCESS           - All files are read.
+  EFI_ABORTED           - A file cannot be read.
+  EFI_OUT_OF_RESOURCES  - No resource to complete the operation.
+
+--*/
+;
+
+VOID
+FreeSectionInputs (
+  IN SECTION_INPUT  *Input,
+  IN UINT32         InputNum
+  )
+/*++
+
+Routine Description:
+
+  Free the input files read by ReadSectionInputFiles().
+
+--*/
+;
+
+VOID
+FreeSectionBuffer (
+  IN VOID           *Buffer
+  )
+/*++
+
+Routine Description:
+
+  Free a section or FFS file returned by the GenSection and GenFfsFile
+  routines.  Users of the shared BaseTools library must free them with
+  this routine.
+
+--*/
+;
+
+EFI_STATUS
+GetSectionContents (
+  IN     SECTION_INPUT            *Input,
+  IN     UINT32                   InputNum,
+  IN     EFI_FFS_FILE_ATTRIBUTES  FfsAttrib,
+  OUT    UINT8                    *FileBuffer,
+  IN OUT UINT32                   *BufferLength,
+  OUT    UINT32                   *MaxAlignment,
+  OUT    UINT8                    *PeSectionNum
+  )
+/*++
+
+Routine Description:
+
+  Concatenate the input sections into FileBuffer.  Each section starts on
+  a DWORD boundary, and a pad section is inserted in front of a section
+  whose data would not meet its alignment.
+
+Arguments:
+
+  Input          - The input sections.
+  InputNum       - Number of input sections.
+  FfsAttrib      - Attributes of the FFS file the sections go into, or 0.
+                   A fixed FFS file gets reducible padding sections.
+  FileBuffer     - Output buffer, or NULL to get the required size.
+  BufferLength   - On input, the size of FileBuffer.
+                   On output, the size of the data.
+  MaxAlignment   - The largest alignment of all input sections, optional.
+  PeSectionNum   - Number of PE32, TE and encapsulation sections, optional.
+
+Returns:
+
+  EFI_SUCCESS           - The data is in FileBuffer.
+  EFI_INVALID_PARAMETER - InputNum is 0 or BufferLength is NULL.
+  EFI_BUFFER_TOO_SMALL  - FileBuffer is too small. BufferLength is the size needed.
+
+--*/
+;
+
+EFI_STATUS
+GenSectionCommonLeafSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  IN  UINT8          SectionType,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Add a section header of SectionType to the single input.
+
+--*/
+;
+
+EFI_STATUS
+GenSectionAllSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Concatenate the aligned input sections without a section header, which
+  is what GenSec does when no section type is given.
+
+--*/
+;
+
+EFI_STATUS
+GenSectionCompressionSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  IN  UINT8          SectCompSubType,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an EFI_SECTION_COMPRESSION section of the input sections.
+  SectCompSubType is EFI_NOT_COMPRESSED or EFI_STANDARD_COMPRESSION.
+
+--*/
+;
+
+EFI_STATUS
+GenSectionGuidDefinedSection (
+  IN  SECTION_INPUT  *Input,
+  IN  UINT32         InputNum,
+  IN  EFI_GUID       *VendorGuid,
+  IN  UINT16         DataAttribute,
+  IN  UINT32         DataHeaderSize,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an EFI_SECTION_GUID_DEFINED section of the input sections.  A zero
+  VendorGuid creates the CRC32 GUIDed section.
+
+--*/
+;
+
+EFI_STATUS
+GenSectionVersionSection (
+  IN  UINT16         BuildNumber,
+  IN  CHAR8          *VersionString,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an EFI_SECTION_VERSION section.
+
+--*/
+;
+
+EFI_STATUS
+GenSectionUiSection (
+  IN  CHAR8          *Name,
+  OUT UINT8          **OutBuffer,
+  OUT UINT32         *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an EFI_SECTION_USER_INTERFACE section.
+
+--*/
+;
+
+EFI_STATUS
+GenFfsFile (
+  IN  SECTION_INPUT            *Input,
+  IN  UINT32                   InputNum,
+  IN  EFI_FV_FILETYPE          FfsFiletype,
+  IN  EFI_GUID                 *FileGuid,
+  IN  EFI_FFS_FILE_ATTRIBUTES  FfsAttrib,
+  IN  UINT32                   FfsAlign,
+  OUT UINT8                    **OutBuffer,
+  OUT UINT32                   *OutLength
+  )
+/*++
+
+Routine Description:
+
+  Create an FFS file of the input sections.
+
+Arguments:
+
+  Input          - The input sections.
+  InputNum       - Number of input sections.
+  FfsFiletype    - Type of the FFS file.
+  FileGuid       - Name of the FFS file.
+  FfsAttrib      - FFS_ATTRIB_FIXED and FFS_ATTRIB_CHECKSUM.
+  FfsAlign       - Minimum alignment of the FFS file as an index into the
+                   8, 16, 128, 512, 1K, 4K, 32K, 64K ... 16M alignments.
+  OutBuffer      - The FFS file, to be freed by the caller.
+  OutLength      - Size of the FFS file.
+
+Returns:
+
+  EFI_SUCCESS           - The FFS file is in OutBuffer.
+  EFI_INVALID_PARAMETER - The sections do not match the file type.
+  EFI_OUT_OF_RESOURCES  - No resource to complete the operation.
+
+--*/
+;
+
+#endif
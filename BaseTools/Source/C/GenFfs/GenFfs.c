@@ -18,12 +18,11 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Common/UefiBaseTypes.h>
 #include <Common/PiFirmwareFile.h>
-#include <IndustryStandard/PeImage.h>
-#include <Guid/FfsSectionAlignmentPadding.h>
 
 #include "CommonLib.h"
 #include "ParseInf.h"
 #include "EfiUtilityMsgs.h"
+#include "SectionLib.h"
 
 #define UTILITY_NAME            "GenFfs"
 #define UTILITY_MAJOR_VERSION   0
@@ -59,13 +58,8 @@ STATIC CHAR8 *mFfsValidAlignName[] = {
   "512K", "1M", "2M", "4M", "8M", "16M"
  };
 
-STATIC UINT32 mFfsValidAlign[] = {0, 8, 16, 128, 512, 1024, 4096, 32768, 65536, 131072, 262144,
-                                  524288, 1048576, 2097152, 4194304, 8388608, 16777216};
-
 STATIC EFI_GUID mZeroGuid = {0};
 
-STATIC EFI_GUID mEfiFfsSectionAlignmentPaddingGuid = EFI_FFS_SECTION_ALIGNMENT_PADDING_GUID;
-
 STATIC
 VOID 
 Version (
@@ -238,225 +232,6 @@ Returns:
   return EFI_FV_FILETYPE_ALL;
 }
 
-STATIC
-EFI_STATUS
-GetSectionContents (
-  IN  CHAR8                     **InputFileName,
-  IN  UINT32                    *InputFileAlign,
-  IN  UINT32                    InputFileNum,
-  IN  EFI_FFS_FILE_ATTRIBUTES   FfsAttrib,
-  OUT UINT8                     *FileBuffer,
-  OUT UINT32                    *BufferLength,
-  OUT UINT32                    *MaxAlignment,
-  OUT UINT8                     *PESectionNum
-  )
-/*++
-        
-Routine Description:
-           
-  Get the contents of all section files specified in InputFileName
-  into FileBuffer.
-            
-Arguments:
-               
-  InputFileName  - Name of the input file.
-                
-  InputFileAlign - Alignment required by the input file data.
-
-  InputFileNum   - Number of input files. Should be at least 1.
-
-  FileBuffer     - Output buffer to contain data
-
-  BufferLength   - On input, this is size of the FileBuffer. 
-                   On output, this is the actual length of the data.
-
-  MaxAlignment   - The max alignment required by all the input file datas.
-  
-  PeSectionNum   - Calculate the number of Pe/Te Section in this FFS file.
-
-Returns:
-                       
-  EFI_SUCCESS on successful return
-  EFI_INVALID_PARAMETER if InputFileNum is less than 1 or BufferLength point is NULL.
-  EFI_ABORTED if unable to open input file.
-  EFI_BUFFER_TOO_SMALL FileBuffer is not enough to contain all file data.
---*/
-{
-  UINT32                              Size;
-  UINT32                              Offset;
-  UINT32                              FileSize;
-  UINT32                              Index;
-  FILE                                *InFile;
-  EFI_FREEFORM_SUBTYPE_GUID_SECTION   *SectHeader;
-  EFI_COMMON_SECTION_HEADER2          TempSectHeader;
-  EFI_TE_IMAGE_HEADER                 TeHeader;
-  UINT32                              TeOffset;
-  EFI_GUID_DEFINED_SECTION            GuidSectHeader;
-  EFI_GUID_DEFINED_SECTION2           GuidSectHeader2;
-  UINT32                              HeaderSize;
-  UINT32                              MaxEncounteredAlignment;
-
-  Size                    = 0;
-  Offset                  = 0;
-  TeOffset                = 0;
-  MaxEncounteredAlignment = 1;
-
-  //
-  // Go through our array of file names and copy their contents
-  // to the output buffer.
-  //
-  for (Index = 0; Index < InputFileNum; Index++) {
-    //
-    // make sure section ends on a DWORD boundary
-    //
-    while ((Size & 0x03) != 0) {
-      Size++;
-    }
-    
-    // 
-    // Open file and read contents
-    //
-    InFile = fopen (LongFilePath (InputFileName[Index]), "rb");
-    if (InFile == NULL) {
-      Error (NULL, 0, 0001, "Error opening file", InputFileName[Index]);
-      return EFI_ABORTED;
-    }
-
-    fseek (InFile, 0, SEEK_END);
-    FileSize = ftell (InFile);
-    fseek (InFile, 0, SEEK_SET);
-    DebugMsg (NULL, 0, 9, "Input section files", 
-              "the input section name is %s and the size is %u bytes", InputFileName[Index], (unsigned) FileSize); 
-
-    //
-    // Check this section is Te/Pe section, and Calculate the numbers of Te/Pe section.
-    //
-    TeOffset = 0;
-    if (FileSize >= MAX_FFS_SIZE) {
-      HeaderSize = sizeof (EFI_COMMON_SECTION_HEADER2);
-    } else {
-      HeaderSize = sizeof (EFI_COMMON_SECTION_HEADER);
-    }
-    fread (&TempSectHeader, 1, HeaderSize, InFile);
-    if (TempSectHeader.Type == EFI_SECTION_TE) {
-      (*PESectionNum) ++;
-      fread (&TeHeader, 1, sizeof (TeHeader), InFile);
-      if (TeHeader.Signature == EFI_TE_IMAGE_HEADER_SIGNATURE) {
-        TeOffset = TeHeader.StrippedSize - sizeof (TeHeader);
-      }
-    } else if (TempSectHeader.Type == EFI_SECTION_PE32) {
-      (*PESectionNum) ++;
-    } else if (TempSectHeader.Type == EFI_SECTION_GUID_DEFINED) {
-      fseek (InFile, 0, SEEK_SET);
-      if (FileSize >= MAX_SECTION_SIZE) {
-        fread (&GuidSectHeader2, 1, sizeof (GuidSectHeader2), InFile);
-        if ((GuidSectHeader2.Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0) {
-          HeaderSize = GuidSectHeader2.DataOffset;
-        }
-      } else {
-        fread (&GuidSectHeader, 1, sizeof (GuidSectHeader), InFile);
-        if ((GuidSectHeader.Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0) {
-          HeaderSize = GuidSectHeader.DataOffset;
-        }
-      }
-      (*PESectionNum) ++;
-    } else if (TempSectHeader.Type == EFI_SECTION_COMPRESSION || 
-               TempSectHeader.Type == EFI_SECTION_FIRMWARE_VOLUME_IMAGE) {
-      //
-      // for the encapsulated section, assume it contains Pe/Te section 
-      //
-      (*PESectionNum) ++;
-    }
-
-    fseek (InFile, 0, SEEK_SET);
-
-    //
-    // Revert TeOffset to the converse value relative to Alignment
-    // This is to assure the original PeImage Header at Alignment.
-    //
-    if ((TeOffset != 0) && (InputFileAlign [Index] != 0)) {
-      TeOffset = InputFileAlign [Index] - (TeOffset % InputFileAlign [Index]);
-      TeOffset = TeOffset % InputFileAlign [Index];
-    }
-
-    //
-    // make sure section data meet its alignment requirement by adding one pad section.
-    // But the different sections have the different section header. Necessary or not?
-    // Based on section type to adjust offset? Todo
-    //
-    if ((InputFileAlign [Index] != 0) && (((Size + HeaderSize + TeOffset) % InputFileAlign [Index]) != 0)) {
-      Offset = (Size + sizeof (EFI_COMMON_SECTION_HEADER) + HeaderSize + TeOffset + InputFileAlign [Index] - 1) & ~(InputFileAlign [Index] - 1);
-      Offset = Offset - Size - HeaderSize - TeOffset;
-       
-      if (FileBuffer != NULL && ((Size + Offset) < *BufferLength)) {
-        //
-        // The maximal alignment is 64K, the raw section size must be less than 0xffffff
-        //
-        memset (FileBuffer + Size, 0, Offset);
-        SectHeader                        = (EFI_FREEFORM_SUBTYPE_GUID_SECTION *) (FileBuffer + Size);
-        SectHeader->CommonHeader.Size[0]  = (UINT8) (Offset & 0xff);
-        SectHeader->CommonHeader.Size[1]  = (UINT8) ((Offset & 0xff00) >> 8);
-        SectHeader->CommonHeader.Size[2]  = (UINT8) ((Offset & 0xff0000) >> 16);
-
-        //
-        // Only add a special reducible padding section if
-        // - this FFS has the FFS_ATTRIB_FIXED attribute,
-        // - none of the preceding sections have alignment requirements,
-        // - the size of the padding is sufficient for the
-        //   EFI_SECTION_FREEFORM_SUBTYPE_GUID header.
-        //
-        if ((FfsAttrib & FFS_ATTRIB_FIXED) != 0 &&
-            MaxEncounteredAlignment <= 1 &&
-            Offset >= sizeof (EFI_FREEFORM_SUBTYPE_GUID_SECTION)) {
-          SectHeader->CommonHeader.Type   = EFI_SECTION_FREEFORM_SUBTYPE_GUID;
-          SectHeader->SubTypeGuid         = mEfiFfsSectionAlignmentPaddingGuid;
-        } else {
-          SectHeader->CommonHeader.Type   = EFI_SECTION_RAW;
-        }
-      }
-      DebugMsg (NULL, 0, 9, "Pad raw section for section data alignment", 
-                "Pad Raw section size is %u", (unsigned) Offset);
-
-      Size = Size + Offset;
-    }
-
-    //
-    // Get the Max alignment of all input file datas
-    //
-    if (MaxEncounteredAlignment < InputFileAlign [Index]) {
-      MaxEncounteredAlignment = InputFileAlign [Index];
-    }
-
-    //
-    // Now read the contents of the file into the buffer
-    // Buffer must be enough to contain the file content.
-    //
-    if ((FileSize > 0) && (FileBuffer != NULL) && ((Size + FileSize) <= *BufferLength)) {
-      if (fread (FileBuffer + Size, (size_t) FileSize, 1, InFile) != 1) {
-        Error (NULL, 0, 0004, "Error reading file", InputFileName[Index]);
-        fclose (InFile);
-        return EFI_ABORTED;
-      }
-    }
-
-    fclose (InFile);
-    Size += FileSize;
-  }
-
-  *MaxAlignment = MaxEncounteredAlignment;
-
-  //
-  // Set the actual length of the data.
-  //
-  if (Size > *BufferLength) {
-    *BufferLength = Size;
-    return EFI_BUFFER_TOO_SMALL;
-  } else {
-    *BufferLength = Size;
-    return EFI_SUCCESS;
-  }
-}
-
 int
 main (
   int   argc,
@@ -488,15 +263,12 @@ Returns:
   UINT32                  InputFileNum;
   UINT32                  *InputFileAlign;
   CHAR8                   **InputFileName;
+  SECTION_INPUT           *Input;
   UINT8                   *FileBuffer;
   UINT32                  FileSize;
-  UINT32                  MaxAlignment;
-  EFI_FFS_FILE_HEADER2    FfsFileHeader;
   FILE                    *FfsFile;
   UINT32                  Index;
   UINT64                  LogLevel;
-  UINT8                   PeSectionNum;
-  UINT32                  HeaderSize;
   
   //
   // Init local variables
@@ -510,12 +282,11 @@ Returns:
   InputFileNum   = 0;
   InputFileName  = NULL;
   InputFileAlign = NULL;
+  Input          = NULL;
   FileBuffer     = NULL;
   FileSize       = 0;
-  MaxAlignment   = 1;
   FfsFile        = NULL;
   Status         = EFI_SUCCESS;
-  PeSectionNum   = 0;
 
   SetUtilityName (UTILITY_NAME);
 
@@ -799,137 +570,27 @@ Returns:
   }
   
   //
-  // Calculate the size of all input section files.
-  //  
-  Status = GetSectionContents (
-             InputFileName,
-             InputFileAlign,
-             InputFileNum,
-             FfsAttrib,
-             FileBuffer,
-             &FileSize,
-             &MaxAlignment,
-             &PeSectionNum
-             );
-  
-  if ((FfsFiletype == EFI_FV_FILETYPE_SECURITY_CORE || 
-      FfsFiletype == EFI_FV_FILETYPE_PEI_CORE ||
-      FfsFiletype == EFI_FV_FILETYPE_DXE_CORE) && (PeSectionNum != 1)) {
-    Error (NULL, 0, 2000, "Invalid parameter", "Fv File type %s must have one and only one Pe or Te section, but %u Pe/Te section are input", mFfsFileType [FfsFiletype], PeSectionNum);
-    goto Finish;
-  }
-  
-  if ((FfsFiletype == EFI_FV_FILETYPE_PEIM ||
-      FfsFiletype == EFI_FV_FILETYPE_DRIVER ||
-      FfsFiletype == EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER ||
-      FfsFiletype == EFI_FV_FILETYPE_APPLICATION) && (PeSectionNum < 1)) {
-    Error (NULL, 0, 2000, "Invalid parameter", "Fv File type %s must have at least one Pe or Te section, but no Pe/Te section is input", mFfsFileType [FfsFiletype]);
-    goto Finish;   
-  }
-
-  if (Status == EFI_BUFFER_TOO_SMALL) {
-    FileBuffer = (UINT8 *) malloc (FileSize);
-    if (FileBuffer == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
-      goto Finish;
-    }
-    memset (FileBuffer, 0, FileSize);
-    
-    //
-    // read all input file contents into a buffer
-    //
-    Status = GetSectionContents (
-               InputFileName,
-               InputFileAlign,
-               InputFileNum,
-               FfsAttrib,
-               FileBuffer,
-               &FileSize,
-               &MaxAlignment,
-               &PeSectionNum
-               );
-  }
-
+  // Read all input section files and create the FFS file.
+  //
+  Status = ReadSectionInputFiles (InputFileName, InputFileAlign, InputFileNum, &Input);
   if (EFI_ERROR (Status)) {
     goto Finish;
   }
 
-  if (FileBuffer == NULL && FileSize != 0) {
-    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+  Status = GenFfsFile (
+             Input,
+             InputFileNum,
+             FfsFiletype,
+             &FileGuid,
+             FfsAttrib,
+             FfsAlign,
+             &FileBuffer,
+             &FileSize
+             );
+  if (EFI_ERROR (Status)) {
     goto Finish;
   }
-  
-  //
-  // Create Ffs file header.
-  //
-  memset (&FfsFileHeader, 0, sizeof (EFI_FFS_FILE_HEADER2));
-  memcpy (&FfsFileHeader.Name, &FileGuid, sizeof (EFI_GUID));
-  FfsFileHeader.Type       = FfsFiletype;
-  //
-  // Update FFS Alignment based on the max alignment required by input section files 
-  //
-  VerboseMsg ("the max alignment of all input sections is %u", (unsigned) MaxAlignment); 
-  for (Index = 0; Index < sizeof (mFfsValidAlign) / sizeof (UINT32) - 1; Index ++) {
-    if ((MaxAlignment > mFfsValidAlign [Index]) && (MaxAlignment <= mFfsValidAlign [Index + 1])) {
-      break;
-    }
-  }
-  if (FfsAlign < Index) {
-    FfsAlign = Index;
-  }
-  VerboseMsg ("the alignment of the generated FFS file is %u", (unsigned) mFfsValidAlign [FfsAlign + 1]);  
-  
-  //
-  // Now FileSize includes the EFI_FFS_FILE_HEADER
-  //
-  if (FileSize + sizeof (EFI_FFS_FILE_HEADER) >= MAX_FFS_SIZE) {
-    HeaderSize = sizeof (EFI_FFS_FILE_HEADER2);
-    FileSize += sizeof (EFI_FFS_FILE_HEADER2);
-    FfsFileHeader.ExtendedSize = FileSize;
-    memset(FfsFileHeader.Size, 0, sizeof (UINT8) * 3);
-    FfsAttrib |= FFS_ATTRIB_LARGE_FILE;
-  } else {
-    HeaderSize = sizeof (EFI_FFS_FILE_HEADER);
-    FileSize += sizeof (EFI_FFS_FILE_HEADER);
-    FfsFileHeader.Size[0]  = (UINT8) (FileSize & 0xFF);
-    FfsFileHeader.Size[1]  = (UINT8) ((FileSize & 0xFF00) >> 8);
-    FfsFileHeader.Size[2]  = (UINT8) ((FileSize & 0xFF0000) >> 16);
-  }
-  VerboseMsg ("the size of the generated FFS file is %u bytes", (unsigned) FileSize);
-
-  //FfsAlign larger than 7, set FFS_ATTRIB_DATA_ALIGNMENT2
-  if (FfsAlign < 8) {
-    FfsFileHeader.Attributes = (EFI_FFS_FILE_ATTRIBUTES) (FfsAttrib | (FfsAlign << 3));
-  } else {
-    FfsFileHeader.Attributes = (EFI_FFS_FILE_ATTRIBUTES) (FfsAttrib | ((FfsAlign & 0x7) << 3) | FFS_ATTRIB_DATA_ALIGNMENT2);
-  }
-
-  //
-  // Fill in checksums and state, these must be zero for checksumming
-  //
-  // FileHeader.IntegrityCheck.Checksum.Header = 0;
-  // FileHeader.IntegrityCheck.Checksum.File = 0;
-  // FileHeader.State = 0;
-  //
-  FfsFileHeader.IntegrityCheck.Checksum.Header = CalculateChecksum8 (
-                                                   (UINT8 *) &FfsFileHeader,
-                                                   HeaderSize
-                                                   );
-
-  if (FfsFileHeader.Attributes & FFS_ATTRIB_CHECKSUM) {
-    //
-    // Ffs header checksum = zero, so only need to calculate ffs body.
-    //
-    FfsFileHeader.IntegrityCheck.Checksum.File = CalculateChecksum8 (
-                                                   FileBuffer, 
-                                                   FileSize - HeaderSize
-                                                   );    
-  } else {
-    FfsFileHeader.IntegrityCheck.Checksum.File = FFS_FIXED_CHECKSUM;
-  }
 
-  FfsFileHeader.State = EFI_FILE_HEADER_CONSTRUCTION | EFI_FILE_HEADER_VALID | EFI_FILE_DATA_VALID;
-  
   //
   // Open output file to write ffs data.
   //
@@ -940,17 +601,7 @@ Returns:
       Error (NULL, 0, 0001, "Error opening file", OutputFileName);
       goto Finish;
     }
-    //
-    // write header
-    //
-    fwrite (&FfsFileHeader, 1, HeaderSize, FfsFile);
-    //
-    // write data
-    //
-    if (FileBuffer != NULL) {
-      fwrite (FileBuffer, 1, FileSize - HeaderSize, FfsFile);
-    }
-
+    fwrite (FileBuffer, 1, FileSize, FfsFile);
     fclose (FfsFile);
   }
 
@@ -961,6 +612,7 @@ Finish:
   if (InputFileAlign != NULL) {
     free (InputFileAlign);
   }
+  FreeSectionInputs (Input, InputFileNum);
   if (FileBuffer != NULL) {
     free (FileBuffer);
   }
@@ -129,6 +129,12 @@ Returns:
   fprintf (stdout, "  -m logfile, --map logfile\n\
                         Logfile is the output fv map file name. if it is not\n\
                         given, the FvName.map will be the default map file name\n"); 
+  fprintf (stdout, "  --incremental         Reuse the previous FvImage. Only FFS files whose\n\
+                        contents changed are added again, the others are\n\
+                        copied if the FV layout stays the same. The layout\n\
+                        is recorded in FvName.layout and FvName.layout.ffs.\n\
+                        The FvImage is the same as the one created without\n\
+                        this option.\n");
   fprintf (stdout, "  -g Guid, --guid Guid\n\
                         GuidValue is one specific capsule guid value\n\
                         or fv file system guid value.\n\
@@ -523,6 +529,14 @@ Returns:
       continue; 
     }
 
+    if (stricmp (argv[0], "--incremental") == 0) {
+      mFvIncremental = TRUE;
+      DebugMsg (NULL, 0, 9, "Incremental FV image generation", NULL);
+      argc --;
+      argv ++;
+      continue;
+    }
+
     if ((stricmp (argv[0], "-v") == 0) || (stricmp (argv[0], "--verbose") == 0)) {
       SetPrintLevel (VERBOSE_LOG_LEVEL);
       VerboseMsg ("Verbose output Mode Set!");
@@ -170,6 +170,64 @@ BOOLEAN                     mIsLargeFfs = FALSE;
 EFI_PHYSICAL_ADDRESS mFvBaseAddress[0x10];
 UINT32               mFvBaseAddressNumber = 0;
 
+//
+// Incremental FV image generation.  The layout of every generated FV image is
+// recorded in FvName.layout.  FFS files whose contents did not change since
+// then are copied from the previous FV image instead of being added again.
+// A file is unchanged when it has the same bytes as the copy in the previous
+// FV image.  The files that AddFile() modifies, by rebasing them or by the
+// reset vector fixups, are compared to the copy saved in FvName.layout.ffs.
+//
+#define FV_LAYOUT_SIGNATURE     "GenFv Layout 2"
+#define FV_LAYOUT_DIGEST_SEED   (((UINT64) 0xCBF29CE4 << 32) | 0x84222325)
+#define FV_LAYOUT_DIGEST_PRIME  (((UINT64) 0x00000100 << 32) | 0x000001B3)
+#define FV_LAYOUT_NOT_SAVED     0xFFFFFFFF
+
+typedef struct {
+  UINT32                FileSize;
+  UINT64                Digest;
+  EFI_GUID              FileGuid;
+  UINT32                Alignment;
+  BOOLEAN               Changed;
+  BOOLEAN               Arm;
+  UINT32                Start;
+  UINT32                End;
+  UINT32                VtfOffset;
+  UINT32                ChildFvNumber;
+  UINT32                MapStart;
+  UINT32                MapEnd;
+  UINT32                ReportStart;
+  UINT32                ReportEnd;
+  UINT32                FileOffset;
+  UINT32                SavedOffset;
+} FV_LAYOUT_FILE;
+
+typedef struct {
+  UINT64                Key;
+  UINT32                FvSize;
+  UINT64                FvDigest;
+  UINT32                MapSize;
+  UINT64                MapDigest;
+  UINT32                ReportSize;
+  UINT64                ReportDigest;
+  UINT32                SavedSize;
+  UINT64                SavedDigest;
+  UINT32                ChildFvNumber;
+  EFI_PHYSICAL_ADDRESS  ChildFvBaseAddress[0x10];
+  UINT32                FileNumber;
+  FV_LAYOUT_FILE        Files[MAX_NUMBER_OF_FILES_IN_FV];
+} FV_LAYOUT;
+
+BOOLEAN              mFvIncremental = FALSE;
+STATIC BOOLEAN       mReusePreviousFv = FALSE;
+STATIC FV_LAYOUT     mFvLayout;
+STATIC FV_LAYOUT     mPreviousFvLayout;
+STATIC UINT8         *mPreviousFvImage = NULL;
+STATIC UINT8         *mPreviousFvMap = NULL;
+STATIC UINT8         *mPreviousFvReport = NULL;
+STATIC UINT8         *mPreviousFvSaved = NULL;
+STATIC UINT8         *mFvLayoutInput[MAX_NUMBER_OF_FILES_IN_FV];
+
 EFI_STATUS
 ParseFvInf (
   IN  MEMORY_FILE  *InfFile,
@@ -2437,6 +2495,813 @@ Returns:
   return EFI_SUCCESS;
 }
 
+STATIC
+UINT64
+FvLayoutDigest (
+  IN UINT64  Digest,
+  IN VOID    *Buffer,
+  IN UINTN   Size
+  )
+/*++
+
+Routine Description:
+
+  This function adds the contents of a buffer to a 64 bit FNV-1a digest.
+
+Arguments:
+
+  Digest        The digest of the preceding data or FV_LAYOUT_DIGEST_SEED.
+  Buffer        The data to add.
+  Size          The size of the data in bytes.
+
+Returns:
+
+  The updated digest.
+
+--*/
+{
+  UINT8  *Pointer;
+
+  Pointer = (UINT8 *) Buffer;
+  while (Size-- > 0) {
+    Digest = (Digest ^ *Pointer++) * FV_LAYOUT_DIGEST_PRIME;
+  }
+
+  return Digest;
+}
+
+STATIC
+EFI_STATUS
+ReadFvLayoutInput (
+  IN  CHAR8   *FileName,
+  IN  BOOLEAN Text,
+  OUT UINT8   **Buffer,
+  OUT UINT32  *Size
+  )
+/*++
+
+Routine Description:
+
+  This function reads a whole file into memory.  Unlike GetFileImage() it
+  reports no error, because a missing output of the previous build only
+  means that nothing can be reused.
+
+Arguments:
+
+  FileName      The name of the file to read.
+  Text          Read the file in text mode, as it was written.
+  Buffer        The allocated buffer with the file contents.
+  Size          The size of the file contents.
+
+Returns:
+
+  EFI_SUCCESS           The file was read.
+  EFI_NOT_FOUND         The file could not be opened.
+  EFI_OUT_OF_RESOURCES  No memory for the file contents.
+  EFI_ABORTED           The file could not be read.
+
+--*/
+{
+  FILE    *File;
+  size_t  Length;
+
+  *Buffer = NULL;
+  File    = fopen (LongFilePath (FileName), Text ? "r" : "rb");
+  if (File == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // In text mode the contents may be shorter than the file
+  //
+  *Size   = _filelength (fileno (File));
+  *Buffer = malloc (*Size + 1);
+  if (*Buffer == NULL) {
+    fclose (File);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Length = fread (*Buffer, sizeof (UINT8), *Size, File);
+  if (ferror (File) || (!Text && Length != *Size)) {
+    free (*Buffer);
+    *Buffer = NULL;
+    fclose (File);
+    return EFI_ABORTED;
+  }
+
+  *Size = (UINT32) Length;
+  fclose (File);
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+ReadFvLayout (
+  IN  CHAR8      *FvLayoutName,
+  OUT FV_LAYOUT  *Layout
+  )
+/*++
+
+Routine Description:
+
+  This function reads the layout file written by the previous build of the FV.
+
+Arguments:
+
+  FvLayoutName  The name of the FV layout file.
+  Layout        The layout of the previous FV image.
+
+Returns:
+
+  EFI_SUCCESS            The layout file was read.
+  EFI_NOT_FOUND          There is no layout file.
+  EFI_INVALID_PARAMETER  The layout file has an unknown format.
+
+--*/
+{
+  FILE                *File;
+  CHAR8               Line[64];
+  FV_LAYOUT_FILE      *Entry;
+  unsigned            Value[14];
+  unsigned long long  Value64[3];
+  UINT32              Index;
+
+  File = fopen (LongFilePath (FvLayoutName), "r");
+  if (File == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  memset (Layout, 0, sizeof (FV_LAYOUT));
+  if (fgets (Line, sizeof (Line), File) == NULL ||
+      strncmp (Line, FV_LAYOUT_SIGNATURE, strlen (FV_LAYOUT_SIGNATURE)) != 0 ||
+      fscanf (File, " Key = %llx", &Value64[0]) != 1 ||
+      fscanf (File, " Fv = %x %llx", &Value[0], &Value64[1]) != 2) {
+    goto Invalid;
+  }
+  Layout->Key      = Value64[0];
+  Layout->FvSize   = Value[0];
+  Layout->FvDigest = Value64[1];
+
+  if (fscanf (File, " Map = %x %llx", &Value[0], &Value64[0]) != 2 ||
+      fscanf (File, " Report = %x %llx", &Value[1], &Value64[1]) != 2 ||
+      fscanf (File, " Saved = %x %llx", &Value[2], &Value64[2]) != 2 ||
+      fscanf (File, " ChildFv = %u", &Value[3]) != 1 ||
+      Value[3] > sizeof (Layout->ChildFvBaseAddress) / sizeof (Layout->ChildFvBaseAddress[0])) {
+    goto Invalid;
+  }
+  Layout->MapSize       = Value[0];
+  Layout->MapDigest     = Value64[0];
+  Layout->ReportSize    = Value[1];
+  Layout->ReportDigest  = Value64[1];
+  Layout->SavedSize     = Value[2];
+  Layout->SavedDigest   = Value64[2];
+  Layout->ChildFvNumber = Value[3];
+
+  for (Index = 0; Index < Layout->ChildFvNumber; Index++) {
+    if (fscanf (File, " %llx", &Value64[0]) != 1) {
+      goto Invalid;
+    }
+    Layout->ChildFvBaseAddress[Index] = Value64[0];
+  }
+
+  if (fscanf (File, " Files = %u", &Value[0]) != 1 || Value[0] > MAX_NUMBER_OF_FILES_IN_FV) {
+    goto Invalid;
+  }
+  Layout->FileNumber = Value[0];
+
+  for (Index = 0; Index < Layout->FileNumber; Index++) {
+    if (fscanf (
+          File,
+          " File = %x %llx %x %x %x %x %u %u %x %x %x %x %x %x",
+          &Value[0],
+          &Value64[0],
+          &Value[1],
+          &Value[2],
+          &Value[3],
+          &Value[4],
+          &Value[5],
+          &Value[6],
+          &Value[7],
+          &Value[8],
+          &Value[9],
+          &Value[10],
+          &Value[11],
+          &Value[12]
+          ) != 14) {
+      goto Invalid;
+    }
+    Entry                = &Layout->Files[Index];
+    Entry->FileSize      = Value[0];
+    Entry->Digest        = Value64[0];
+    Entry->Start         = Value[1];
+    Entry->End           = Value[2];
+    Entry->VtfOffset     = Value[3];
+    Entry->Alignment     = Value[4];
+    Entry->Arm           = (BOOLEAN) (Value[5] != 0);
+    Entry->ChildFvNumber = Value[6];
+    Entry->MapStart      = Value[7];
+    Entry->MapEnd        = Value[8];
+    Entry->ReportStart   = Value[9];
+    Entry->ReportEnd     = Value[10];
+    Entry->FileOffset    = Value[11];
+    Entry->SavedOffset   = Value[12];
+    if (Entry->Start > Entry->End || Entry->End > Layout->FvSize || Entry->VtfOffset > Layout->FvSize ||
+        Entry->MapStart > Entry->MapEnd || Entry->MapEnd > Layout->MapSize ||
+        Entry->ReportStart > Entry->ReportEnd || Entry->ReportEnd > Layout->ReportSize ||
+        Entry->FileOffset > Layout->FvSize || Entry->FileSize > Layout->FvSize - Entry->FileOffset ||
+        (Entry->SavedOffset != FV_LAYOUT_NOT_SAVED &&
+         (Entry->SavedOffset > Layout->SavedSize || Entry->FileSize > Layout->SavedSize - Entry->SavedOffset))) {
+      goto Invalid;
+    }
+  }
+
+  fclose (File);
+  return EFI_SUCCESS;
+
+Invalid:
+  fclose (File);
+  return EFI_INVALID_PARAMETER;
+}
+
+STATIC
+EFI_STATUS
+WriteFvLayoutOutput (
+  IN  CHAR8   *TmpFileName,
+  IN  CHAR8   *FileName,
+  OUT UINT32  *Size,
+  OUT UINT64  *Digest
+  )
+/*++
+
+Routine Description:
+
+  This function writes the FV map or report file in text mode, like a full
+  build does, from the temporary file the entries were written to.  The
+  temporary file is removed.
+
+Arguments:
+
+  TmpFileName   The name of the temporary file, which must be closed.
+  FileName      The name of the FV map or report file.
+  Size          The size of the file contents.
+  Digest        The digest of the file contents.
+
+Returns:
+
+  EFI_SUCCESS   The file was written.
+  EFI_ABORTED   The temporary file could not be read, or the file could not
+                be written.
+
+--*/
+{
+  FILE    *File;
+  UINT8   *Buffer;
+  size_t  Length;
+
+  if (EFI_ERROR (ReadFvLayoutInput (TmpFileName, FALSE, &Buffer, Size))) {
+    Error (NULL, 0, 0004, "Error reading file", TmpFileName);
+    return EFI_ABORTED;
+  }
+  remove (LongFilePath (TmpFileName));
+  *Digest = FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, Buffer, *Size);
+
+  File = fopen (LongFilePath (FileName), "w");
+  if (File == NULL) {
+    free (Buffer);
+    Error (NULL, 0, 0001, "Error opening file", FileName);
+    return EFI_ABORTED;
+  }
+  Length = fwrite (Buffer, sizeof (UINT8), *Size, File);
+  free (Buffer);
+  if (fclose (File) != 0 || Length != *Size) {
+    Error (NULL, 0, 0002, "Error writing file", FileName);
+    return EFI_ABORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+WriteFvLayout (
+  IN CHAR8   *FvLayoutName,
+  IN UINT8   *FvImage,
+  IN UINTN   FvImageSize,
+  IN CHAR8   *FvMapName,
+  IN CHAR8   *FvMapTmpName,
+  IN CHAR8   *FvReportName,
+  IN CHAR8   *FvReportTmpName,
+  IN CHAR8   *FvSavedName
+  )
+/*++
+
+Routine Description:
+
+  This function writes the FV map and report files and the layout of the
+  generated FV image, so that the next build of the FV can reuse it.  The
+  files that are not stored unmodified in the FV image are saved as well.
+
+Arguments:
+
+  FvLayoutName    The name of the FV layout file.
+  FvImage         The generated FV image.
+  FvImageSize     The size of the FV image.
+  FvMapName       The name of the FV map file.
+  FvMapTmpName    The name of the closed temporary FV map file.
+  FvReportName    The name of the FV report file.
+  FvReportTmpName The name of the closed temporary FV report file.
+  FvSavedName     The name of the file to save the modified files to.
+
+Returns:
+
+  EFI_SUCCESS   The layout file was written.
+  EFI_ABORTED   The map or report file could not be written, or the layout
+                file or the saved files could not be written.
+
+--*/
+{
+  FILE            *File;
+  FV_LAYOUT_FILE  *Entry;
+  UINT32          Index;
+  size_t          Length;
+
+  mFvLayout.FvSize   = (UINT32) FvImageSize;
+  mFvLayout.FvDigest = FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, FvImage, FvImageSize);
+
+  if (EFI_ERROR (WriteFvLayoutOutput (FvMapTmpName, FvMapName, &mFvLayout.MapSize, &mFvLayout.MapDigest)) ||
+      EFI_ERROR (WriteFvLayoutOutput (FvReportTmpName, FvReportName, &mFvLayout.ReportSize, &mFvLayout.ReportDigest))) {
+    return EFI_ABORTED;
+  }
+
+  File = fopen (LongFilePath (FvSavedName), "wb");
+  if (File == NULL) {
+    Error (NULL, 0, 0001, "Error opening file", FvSavedName);
+    return EFI_ABORTED;
+  }
+
+  mFvLayout.SavedSize   = 0;
+  mFvLayout.SavedDigest = FV_LAYOUT_DIGEST_SEED;
+  for (Index = 0; Index < mFvLayout.FileNumber; Index++) {
+    Entry              = &mFvLayout.Files[Index];
+    Entry->SavedOffset = FV_LAYOUT_NOT_SAVED;
+    if (Entry->FileOffset <= FvImageSize && Entry->FileSize <= FvImageSize - Entry->FileOffset &&
+        memcmp (FvImage + Entry->FileOffset, mFvLayoutInput[Index], Entry->FileSize) == 0) {
+      continue;
+    }
+    Length = fwrite (mFvLayoutInput[Index], sizeof (UINT8), Entry->FileSize, File);
+    if (Length != Entry->FileSize) {
+      break;
+    }
+    Entry->SavedOffset    = mFvLayout.SavedSize;
+    mFvLayout.SavedSize  += Entry->FileSize;
+    mFvLayout.SavedDigest = FvLayoutDigest (mFvLayout.SavedDigest, mFvLayoutInput[Index], Entry->FileSize);
+  }
+
+  if (fclose (File) != 0 || Index != mFvLayout.FileNumber) {
+    Error (NULL, 0, 0002, "Error writing file", FvSavedName);
+    return EFI_ABORTED;
+  }
+
+  File = fopen (LongFilePath (FvLayoutName), "w");
+  if (File == NULL) {
+    Error (NULL, 0, 0001, "Error opening file", FvLayoutName);
+    return EFI_ABORTED;
+  }
+
+  fprintf (File, "%s\n", FV_LAYOUT_SIGNATURE);
+  fprintf (File, "Key = %016llx\n", (unsigned long long) mFvLayout.Key);
+  fprintf (File, "Fv = %x %016llx\n", (unsigned) mFvLayout.FvSize, (unsigned long long) mFvLayout.FvDigest);
+  fprintf (File, "Map = %x %016llx\n", (unsigned) mFvLayout.MapSize, (unsigned long long) mFvLayout.MapDigest);
+  fprintf (File, "Report = %x %016llx\n", (unsigned) mFvLayout.ReportSize, (unsigned long long) mFvLayout.ReportDigest);
+  fprintf (File, "Saved = %x %016llx\n", (unsigned) mFvLayout.SavedSize, (unsigned long long) mFvLayout.SavedDigest);
+  fprintf (File, "ChildFv = %u", (unsigned) mFvBaseAddressNumber);
+  for (Index = 0; Index < mFvBaseAddressNumber; Index++) {
+    fprintf (File, " %llx", (unsigned long long) mFvBaseAddress[Index]);
+  }
+  fprintf (File, "\nFiles = %u\n", (unsigned) mFvLayout.FileNumber);
+  for (Index = 0; Index < mFvLayout.FileNumber; Index++) {
+    Entry = &mFvLayout.Files[Index];
+    fprintf (
+      File,
+      "File = %x %016llx %x %x %x %x %u %u %x %x %x %x %x %x\n",
+      (unsigned) Entry->FileSize,
+      (unsigned long long) Entry->Digest,
+      (unsigned) Entry->Start,
+      (unsigned) Entry->End,
+      (unsigned) Entry->VtfOffset,
+      (unsigned) Entry->Alignment,
+      (unsigned) Entry->Arm,
+      (unsigned) Entry->ChildFvNumber,
+      (unsigned) Entry->MapStart,
+      (unsigned) Entry->MapEnd,
+      (unsigned) Entry->ReportStart,
+      (unsigned) Entry->ReportEnd,
+      (unsigned) Entry->FileOffset,
+      (unsigned) Entry->SavedOffset
+      );
+  }
+
+  if (fclose (File) != 0) {
+    Error (NULL, 0, 0002, "Error writing file", FvLayoutName);
+    return EFI_ABORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+VOID
+FreeFvLayout (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  This function frees the outputs of the previous build and stops reusing them.
+
+--*/
+{
+  if (mPreviousFvImage != NULL) {
+    free (mPreviousFvImage);
+    mPreviousFvImage = NULL;
+  }
+  if (mPreviousFvMap != NULL) {
+    free (mPreviousFvMap);
+    mPreviousFvMap = NULL;
+  }
+  if (mPreviousFvReport != NULL) {
+    free (mPreviousFvReport);
+    mPreviousFvReport = NULL;
+  }
+  if (mPreviousFvSaved != NULL) {
+    free (mPreviousFvSaved);
+    mPreviousFvSaved = NULL;
+  }
+  mReusePreviousFv = FALSE;
+}
+
+STATIC
+VOID
+FreeFvLayoutInput (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  This function frees the contents of the FFS files read for the FV layout.
+
+--*/
+{
+  UINT32  Index;
+
+  for (Index = 0; Index < MAX_NUMBER_OF_FILES_IN_FV; Index++) {
+    if (mFvLayoutInput[Index] != NULL) {
+      free (mFvLayoutInput[Index]);
+      mFvLayoutInput[Index] = NULL;
+    }
+  }
+}
+
+STATIC
+VOID
+PrepareFvLayout (
+  IN CHAR8                           *FvFileName,
+  IN CHAR8                           *FvMapName,
+  IN CHAR8                           *FvReportName,
+  IN CHAR8                           *FvLayoutName,
+  IN CHAR8                           *FvSavedName,
+  IN EFI_FIRMWARE_VOLUME_EXT_HEADER  *FvExtHeader
+  )
+/*++
+
+Routine Description:
+
+  This function reads all FFS files of the FV, compares them to the files of
+  the previous build and decides whether the previous FV image can be
+  reused.  That requires the same FV parameters and file list, unmodified
+  outputs of the previous build, and an unchanged VTF file, because the
+  reset vector fixups reach into other files.  The contents of the FFS files
+  are kept for WriteFvLayout().
+
+Arguments:
+
+  FvFileName    The name of the FV image.
+  FvMapName     The name of the FV map file.
+  FvReportName  The name of the FV report file.
+  FvLayoutName  The name of the FV layout file.
+  FvSavedName   The name of the file the modified files were saved to.
+  FvExtHeader   The FV extension header, or NULL.
+
+Returns:
+
+  None.  mReusePreviousFv is set if the previous FV image can be reused.
+  mFvIncremental is cleared if the FFS files cannot be read.
+
+--*/
+{
+  UINT8           *Buffer;
+  UINT8           *PreviousFile;
+  UINT32          Size;
+  FV_LAYOUT_FILE  *Entry;
+  FV_LAYOUT_FILE  *Previous;
+  UINT32          Index;
+  UINT32          ChangedNumber;
+
+  FreeFvLayout ();
+  FreeFvLayoutInput ();
+  memset (&mFvLayout, 0, sizeof (FV_LAYOUT));
+
+  //
+  // Everything that affects the FV image except the FFS file contents
+  //
+  mFvLayout.Key = FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, &mFvDataInfo, sizeof (FV_INFO));
+  if (FvExtHeader != NULL) {
+    mFvLayout.Key = FvLayoutDigest (mFvLayout.Key, FvExtHeader, FvExtHeader->ExtHeaderSize);
+  }
+  mFvLayout.Key = FvLayoutDigest (mFvLayout.Key, FvMapName, strlen (FvMapName));
+  mFvLayout.Key = FvLayoutDigest (mFvLayout.Key, &mIsLargeFfs, sizeof (mIsLargeFfs));
+
+  for (Index = 0; mFvDataInfo.FvFiles[Index][0] != 0; Index++) {
+    if (EFI_ERROR (ReadFvLayoutInput (mFvDataInfo.FvFiles[Index], FALSE, &Buffer, &Size))) {
+      //
+      // AddFile() reports the error.  Without the file contents the layout
+      // cannot be recorded.
+      //
+      FreeFvLayoutInput ();
+      mFvIncremental = FALSE;
+      return;
+    }
+    Entry           = &mFvLayout.Files[Index];
+    Entry->FileSize = Size;
+    Entry->Digest   = FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, Buffer, Size);
+    if (Size >= sizeof (EFI_FFS_FILE_HEADER)) {
+      memcpy (&Entry->FileGuid, Buffer, sizeof (EFI_GUID));
+      ReadFfsAlignment ((EFI_FFS_FILE_HEADER *) Buffer, &Entry->Alignment);
+    }
+    mFvLayoutInput[Index] = Buffer;
+  }
+  mFvLayout.FileNumber = Index;
+
+  if (EFI_ERROR (ReadFvLayout (FvLayoutName, &mPreviousFvLayout)) ||
+      mPreviousFvLayout.Key != mFvLayout.Key ||
+      mPreviousFvLayout.FileNumber != mFvLayout.FileNumber ||
+      mPreviousFvLayout.FvSize != mFvDataInfo.Size) {
+    return;
+  }
+
+  //
+  // The outputs of the previous build must not have been modified since.
+  //
+  if (EFI_ERROR (ReadFvLayoutInput (FvFileName, FALSE, &mPreviousFvImage, &Size)) ||
+      Size != mPreviousFvLayout.FvSize ||
+      FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, mPreviousFvImage, Size) != mPreviousFvLayout.FvDigest ||
+      EFI_ERROR (ReadFvLayoutInput (FvMapName, TRUE, &mPreviousFvMap, &Size)) ||
+      Size != mPreviousFvLayout.MapSize ||
+      FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, mPreviousFvMap, Size) != mPreviousFvLayout.MapDigest ||
+      EFI_ERROR (ReadFvLayoutInput (FvReportName, TRUE, &mPreviousFvReport, &Size)) ||
+      Size != mPreviousFvLayout.ReportSize ||
+      FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, mPreviousFvReport, Size) != mPreviousFvLayout.ReportDigest ||
+      EFI_ERROR (ReadFvLayoutInput (FvSavedName, FALSE, &mPreviousFvSaved, &Size)) ||
+      Size != mPreviousFvLayout.SavedSize ||
+      FvLayoutDigest (FV_LAYOUT_DIGEST_SEED, mPreviousFvSaved, Size) != mPreviousFvLayout.SavedDigest) {
+    FreeFvLayout ();
+    return;
+  }
+
+  ChangedNumber = 0;
+  for (Index = 0; Index < mFvLayout.FileNumber; Index++) {
+    Entry    = &mFvLayout.Files[Index];
+    Previous = &mPreviousFvLayout.Files[Index];
+    //
+    // The digest only rules out most changed files, compare the contents.
+    //
+    if (Previous->SavedOffset == FV_LAYOUT_NOT_SAVED) {
+      PreviousFile = mPreviousFvImage + Previous->FileOffset;
+    } else {
+      PreviousFile = mPreviousFvSaved + Previous->SavedOffset;
+    }
+    if (Entry->FileSize != Previous->FileSize ||
+        Entry->Digest != Previous->Digest ||
+        memcmp (mFvLayoutInput[Index], PreviousFile, Entry->FileSize) != 0) {
+      if (Previous->VtfOffset != 0) {
+        FreeFvLayout ();
+        return;
+      }
+      Entry->Changed = TRUE;
+      ChangedNumber++;
+    }
+  }
+
+  VerboseMsg ("%u of %u FFS files changed since the previous FV image", (unsigned) ChangedNumber, (unsigned) mFvLayout.FileNumber);
+  mReusePreviousFv = TRUE;
+}
+
+STATIC
+EFI_STATUS
+AddPreviousFile (
+  IN OUT MEMORY_FILE          *FvImage,
+  IN UINTN                    Index,
+  IN OUT EFI_FFS_FILE_HEADER  **VtfFileImage,
+  IN FILE                     *FvMapFile,
+  IN FILE                     *FvReportFile,
+  OUT BOOLEAN                 *LayoutChanged
+  )
+/*++
+
+Routine Description:
+
+  This function copies an unchanged file, together with its pad file, map
+  file and report file entries, from the previous FV image.
+
+Arguments:
+
+  FvImage       The memory image of the FV to add it to.
+  Index         The file in the mFvDataInfo file list to add.
+  VtfFileImage  A pointer to the VTF file within the FvImage.
+  FvMapFile     Pointer to FvMap File
+  FvReportFile  Pointer to FvReport File
+  LayoutChanged Set if the file cannot be copied to the same place.
+
+Returns:
+
+  EFI_SUCCESS   The file was copied, or LayoutChanged is set.
+
+--*/
+{
+  FV_LAYOUT_FILE  *Entry;
+  FV_LAYOUT_FILE  *Previous;
+  UINTN           Index1;
+  UINTN           ChildFvIndex;
+
+  Entry    = &mFvLayout.Files[Index];
+  Previous = &mPreviousFvLayout.Files[Index];
+
+  //
+  // Let the full build report duplicated file GUIDs.
+  //
+  for (Index1 = 0; Index1 < Index; Index1++) {
+    if (CompareGuid (&Entry->FileGuid, &mFileGuidArray[Index1]) == 0) {
+      *LayoutChanged = TRUE;
+      return EFI_SUCCESS;
+    }
+  }
+
+  if (Previous->VtfOffset != 0) {
+    if ((UINTN) *VtfFileImage != (UINTN) FvImage->Eof ||
+        FvImage->FileImage + Previous->VtfOffset < FvImage->CurrentFilePointer) {
+      *LayoutChanged = TRUE;
+      return EFI_SUCCESS;
+    }
+    memcpy (
+      FvImage->FileImage + Previous->VtfOffset,
+      mPreviousFvImage + Previous->VtfOffset,
+      mPreviousFvLayout.FvSize - Previous->VtfOffset
+      );
+    *VtfFileImage = (EFI_FFS_FILE_HEADER *) (FvImage->FileImage + Previous->VtfOffset);
+  } else {
+    if (FvImage->FileImage + Previous->Start != FvImage->CurrentFilePointer ||
+        FvImage->FileImage + Previous->End > (CHAR8 *) *VtfFileImage) {
+      *LayoutChanged = TRUE;
+      return EFI_SUCCESS;
+    }
+    memcpy (
+      FvImage->CurrentFilePointer,
+      mPreviousFvImage + Previous->Start,
+      Previous->End - Previous->Start
+      );
+    FvImage->CurrentFilePointer = FvImage->FileImage + Previous->End;
+  }
+
+  fwrite (mPreviousFvMap + Previous->MapStart, sizeof (UINT8), Previous->MapEnd - Previous->MapStart, FvMapFile);
+  fwrite (mPreviousFvReport + Previous->ReportStart, sizeof (UINT8), Previous->ReportEnd - Previous->ReportStart, FvReportFile);
+
+  //
+  // Restore what AddFile() records about the file.
+  //
+  memcpy (&mFileGuidArray[Index], &Entry->FileGuid, sizeof (EFI_GUID));
+  if (Entry->Alignment > MaxFfsAlignment) {
+    MaxFfsAlignment = Entry->Alignment;
+  }
+  mArm = Previous->Arm;
+  ChildFvIndex = 0;
+  for (Index1 = 0; Index1 < Index; Index1++) {
+    ChildFvIndex += mPreviousFvLayout.Files[Index1].ChildFvNumber;
+  }
+  for (Index1 = 0; Index1 < Previous->ChildFvNumber; Index1++) {
+    mFvBaseAddress[mFvBaseAddressNumber ++] = mPreviousFvLayout.ChildFvBaseAddress[ChildFvIndex + Index1];
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+AddLayoutFile (
+  IN OUT MEMORY_FILE          *FvImage,
+  IN UINTN                    Index,
+  IN OUT EFI_FFS_FILE_HEADER  **VtfFileImage,
+  IN FILE                     *FvMapFile,
+  IN FILE                     *FvReportFile,
+  OUT BOOLEAN                 *LayoutChanged
+  )
+/*++
+
+Routine Description:
+
+  This function adds a file to the FV image and records its layout.  A file
+  that did not change since the previous build is copied from the previous
+  FV image.  A changed file is added by AddFile(), and must end up in the
+  same place with the same pad file as before.  Otherwise LayoutChanged is
+  set and the caller must generate the whole FV image again.
+
+Arguments:
+
+  FvImage       The memory image of the FV to add it to.
+  Index         The file in the mFvDataInfo file list to add.
+  VtfFileImage  A pointer to the VTF file within the FvImage.
+  FvMapFile     Pointer to FvMap File
+  FvReportFile  Pointer to FvReport File
+  LayoutChanged Set if the previous FV image cannot be reused.
+
+Returns:
+
+  EFI_SUCCESS   The file was added.
+  Others        The status of AddFile().
+
+--*/
+{
+  EFI_STATUS           Status;
+  FV_LAYOUT_FILE       *Entry;
+  FV_LAYOUT_FILE       *Previous;
+  EFI_FFS_FILE_HEADER  *OrigVtfFileImage;
+  EFI_FFS_FILE_HEADER  *PadFile;
+  EFI_FFS_FILE_HEADER  *PreviousPadFile;
+  UINT32               OrigChildFvNumber;
+  BOOLEAN              OrigArm;
+
+  *LayoutChanged      = FALSE;
+  Entry               = &mFvLayout.Files[Index];
+  Previous            = &mPreviousFvLayout.Files[Index];
+  Entry->Start        = (UINT32) (FvImage->CurrentFilePointer - FvImage->FileImage);
+  Entry->MapStart     = (UINT32) ftell (FvMapFile);
+  Entry->ReportStart  = (UINT32) ftell (FvReportFile);
+  OrigVtfFileImage    = *VtfFileImage;
+  OrigChildFvNumber   = mFvBaseAddressNumber;
+
+  //
+  // Find out whether this file needs the ARM reset vector
+  //
+  OrigArm = mArm;
+  mArm    = FALSE;
+  if (mReusePreviousFv && !Entry->Changed) {
+    Status = AddPreviousFile (FvImage, Index, VtfFileImage, FvMapFile, FvReportFile, LayoutChanged);
+  } else {
+    Status = AddFile (FvImage, &mFvDataInfo, Index, VtfFileImage, FvMapFile, FvReportFile);
+  }
+  Entry->Arm = mArm;
+  mArm       = (BOOLEAN) (mArm || OrigArm);
+  if (EFI_ERROR (Status) || *LayoutChanged) {
+    return Status;
+  }
+
+  Entry->End           = (UINT32) (FvImage->CurrentFilePointer - FvImage->FileImage);
+  Entry->VtfOffset     = 0;
+  if (*VtfFileImage != OrigVtfFileImage) {
+    Entry->VtfOffset   = (UINT32) ((UINT8 *) *VtfFileImage - (UINT8 *) FvImage->FileImage);
+  }
+  //
+  // AddFile() puts the file at the end of its range, after the pad file.
+  //
+  if (Entry->VtfOffset != 0) {
+    Entry->FileOffset  = Entry->VtfOffset;
+  } else {
+    Entry->FileOffset  = Entry->End - ((Entry->FileSize + EFI_FFS_FILE_HEADER_ALIGNMENT - 1) & ~(EFI_FFS_FILE_HEADER_ALIGNMENT - 1));
+  }
+  Entry->ChildFvNumber = mFvBaseAddressNumber - OrigChildFvNumber;
+  Entry->MapEnd        = (UINT32) ftell (FvMapFile);
+  Entry->ReportEnd     = (UINT32) ftell (FvReportFile);
+
+  if (mReusePreviousFv && Entry->Changed) {
+    //
+    // The reset vector fixups look for pad files, so they must stay the same.
+    //
+    PadFile         = (EFI_FFS_FILE_HEADER *) (FvImage->FileImage + Entry->Start);
+    PreviousPadFile = (EFI_FFS_FILE_HEADER *) (mPreviousFvImage + Previous->Start);
+    if (Entry->Start != Previous->Start || Entry->End != Previous->End ||
+        Entry->VtfOffset != Previous->VtfOffset || Entry->Arm != Previous->Arm) {
+      *LayoutChanged = TRUE;
+    } else if (Entry->End > Entry->Start &&
+               (PadFile->Type == EFI_FV_FILETYPE_FFS_PAD || PreviousPadFile->Type == EFI_FV_FILETYPE_FFS_PAD) &&
+               memcmp (PadFile, PreviousPadFile, GetFfsHeaderLength (PadFile)) != 0) {
+      *LayoutChanged = TRUE;
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 GenerateFvImage (
   IN CHAR8                *InfFileImage,
@@ -2483,6 +3348,11 @@ Returns:
   UINTN                           FileSize;
   CHAR8                           *FvReportName;
   FILE                            *FvReportFile;
+  CHAR8                           *FvLayoutName;
+  CHAR8                           *FvMapTmpName;
+  CHAR8                           *FvReportTmpName;
+  CHAR8                           *FvSavedName;
+  BOOLEAN                         LayoutChanged;
 
   FvBufferHeader = NULL;
   FvFile         = NULL;
@@ -2490,6 +3360,10 @@ Returns:
   FvMapFile      = NULL;
   FvReportName   = NULL;
   FvReportFile   = NULL;
+  FvLayoutName   = NULL;
+  FvMapTmpName   = NULL;
+  FvReportTmpName = NULL;
+  FvSavedName    = NULL;
 
   if (InfFileImage != NULL) {
     //
@@ -2678,6 +3552,58 @@ Returns:
   strcpy (FvReportName, FvFileName);
   strcat (FvReportName, ".txt");
 
+  //
+  // FvLayout file to record the FV layout for incremental builds
+  //
+  if (mFvIncremental && !mFvDataInfo.IsPiFvImage) {
+    VerboseMsg ("Incremental generation is only supported for PI FV images");
+    mFvIncremental = FALSE;
+  }
+  if (mFvIncremental) {
+    if (strlen (FvFileName) + strlen (".layout.ffs") > MAX_LONG_FILE_PATH - 1) {
+      Error (NULL, 0, 1003, "Invalid option value", "FvFileName %s is too long!", FvFileName);
+      Status = EFI_ABORTED;
+      goto Finish;
+    }
+
+    FvLayoutName = malloc (strlen (FvFileName) + strlen (".layout") + 1);
+    FvSavedName  = malloc (strlen (FvFileName) + strlen (".layout.ffs") + 1);
+    if (FvLayoutName == NULL || FvSavedName == NULL) {
+      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+      Status = EFI_OUT_OF_RESOURCES;
+      goto Finish;
+    }
+
+    strcpy (FvLayoutName, FvFileName);
+    strcat (FvLayoutName, ".layout");
+    strcpy (FvSavedName, FvFileName);
+    strcat (FvSavedName, ".layout.ffs");
+
+    //
+    // The map and report entries are first written in binary mode to
+    // temporary files, so that the recorded offsets of the entries are exact
+    //
+    if (strlen (FvMapName) + strlen (".tmp") > MAX_LONG_FILE_PATH - 1 ||
+        strlen (FvReportName) + strlen (".tmp") > MAX_LONG_FILE_PATH - 1) {
+      Error (NULL, 0, 1003, "Invalid option value", "FvMapName %s or FvFileName %s is too long!", FvMapName, FvFileName);
+      Status = EFI_ABORTED;
+      goto Finish;
+    }
+
+    FvMapTmpName    = malloc (strlen (FvMapName) + strlen (".tmp") + 1);
+    FvReportTmpName = malloc (strlen (FvReportName) + strlen (".tmp") + 1);
+    if (FvMapTmpName == NULL || FvReportTmpName == NULL) {
+      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+      Status = EFI_OUT_OF_RESOURCES;
+      goto Finish;
+    }
+
+    strcpy (FvMapTmpName, FvMapName);
+    strcat (FvMapTmpName, ".tmp");
+    strcpy (FvReportTmpName, FvReportName);
+    strcat (FvReportTmpName, ".tmp");
+  }
+
   //
   // Calculate the FV size and Update Fv Size based on the actual FFS files.
   // And Update mFvDataInfo data.
@@ -2703,6 +3629,14 @@ Returns:
   }
   FvImage = (UINT8 *) (((UINTN) FvBufferHeader + 7) & ~7);
 
+  //
+  // Check which FFS files changed since the previous FV image was generated
+  //
+  if (mFvIncremental) {
+    PrepareFvLayout (FvFileName, FvMapName, FvReportName, FvLayoutName, FvSavedName, FvExtHeader);
+  }
+
+InitializeFvImage:
   //
   // Initialize the FV to the erase polarity
   //
@@ -2786,21 +3720,32 @@ Returns:
   VtfFileImage = (EFI_FFS_FILE_HEADER *) FvImageMemoryFile.Eof;
 
   //
-  // Open FvMap file
+  // Open FvMap file.  For incremental builds the entries go to a temporary
+  // file in binary mode, so that the recorded file offsets can be used to
+  // copy the entries of unchanged files.  WriteFvLayout() then writes the
+  // map file in text mode.
   //
-  FvMapFile = fopen (LongFilePath (FvMapName), "w");
+  if (mFvIncremental) {
+    FvMapFile = fopen (LongFilePath (FvMapTmpName), "wb");
+  } else {
+    FvMapFile = fopen (LongFilePath (FvMapName), "w");
+  }
   if (FvMapFile == NULL) {
-    Error (NULL, 0, 0001, "Error opening file", FvMapName);
+    Error (NULL, 0, 0001, "Error opening file", mFvIncremental ? FvMapTmpName : FvMapName);
     Status = EFI_ABORTED;
     goto Finish;
   }
   
   //
-  // Open FvReport file
+  // Open FvReport file, the same way as the FvMap file
   //
-  FvReportFile = fopen (LongFilePath (FvReportName), "w");
+  if (mFvIncremental) {
+    FvReportFile = fopen (LongFilePath (FvReportTmpName), "wb");
+  } else {
+    FvReportFile = fopen (LongFilePath (FvReportName), "w");
+  }
   if (FvReportFile == NULL) {
-    Error (NULL, 0, 0001, "Error opening file", FvReportName);
+    Error (NULL, 0, 0001, "Error opening file", mFvIncremental ? FvReportTmpName : FvReportName);
     Status = EFI_ABORTED;
     goto Finish;
   }
@@ -2849,7 +3794,11 @@ Returns:
     //
     // Add the file
     //
-    Status = AddFile (&FvImageMemoryFile, &mFvDataInfo, Index, &VtfFileImage, FvMapFile, FvReportFile);
+    if (mFvIncremental) {
+      Status = AddLayoutFile (&FvImageMemoryFile, Index, &VtfFileImage, FvMapFile, FvReportFile, &LayoutChanged);
+    } else {
+      Status = AddFile (&FvImageMemoryFile, &mFvDataInfo, Index, &VtfFileImage, FvMapFile, FvReportFile);
+    }
 
     //
     // Exit if error detected while adding the file
@@ -2857,6 +3806,22 @@ Returns:
     if (EFI_ERROR (Status)) {
       goto Finish;
     }
+
+    if (mFvIncremental && LayoutChanged) {
+      //
+      // The previous FV image cannot be reused, add all files again.
+      //
+      VerboseMsg ("the layout of the FV image changed, generate the whole FV image");
+      FreeFvLayout ();
+      fclose (FvMapFile);
+      fclose (FvReportFile);
+      FvMapFile            = NULL;
+      FvReportFile         = NULL;
+      MaxFfsAlignment      = 0;
+      mArm                 = FALSE;
+      mFvBaseAddressNumber = 0;
+      goto InitializeFvImage;
+    }
   }
 
   //
@@ -2946,7 +3911,22 @@ WriteFile:
     goto Finish;
   }
 
+  //
+  // Write the map and report files, and record the layout of the FV image
+  // for the next incremental build
+  //
+  if (mFvIncremental && FvMapFile != NULL) {
+    fclose (FvMapFile);
+    fclose (FvReportFile);
+    FvMapFile    = NULL;
+    FvReportFile = NULL;
+    Status = WriteFvLayout (FvLayoutName, FvImage, FvImageSize, FvMapName, FvMapTmpName, FvReportName, FvReportTmpName, FvSavedName);
+  }
+
 Finish:
+  FreeFvLayout ();
+  FreeFvLayoutInput ();
+
   if (FvBufferHeader != NULL) {
     free (FvBufferHeader);
   }
@@ -2962,6 +3942,14 @@ Finish:
   if (FvReportName != NULL) {
     free (FvReportName);
   }
+
+  if (FvLayoutName != NULL) {
+    free (FvLayoutName);
+  }
+
+  if (FvSavedName != NULL) {
+    free (FvSavedName);
+  }
   
   if (FvFile != NULL) {
     fflush (FvFile);
@@ -2977,6 +3965,19 @@ Finish:
     fflush (FvReportFile);
     fclose (FvReportFile);
   }
+
+  //
+  // Remove the temporary map and report files if the FV image failed
+  //
+  if (FvMapTmpName != NULL) {
+    remove (LongFilePath (FvMapTmpName));
+    free (FvMapTmpName);
+  }
+
+  if (FvReportTmpName != NULL) {
+    remove (LongFilePath (FvReportTmpName));
+    free (FvReportTmpName);
+  }
   return Status;
 }
 
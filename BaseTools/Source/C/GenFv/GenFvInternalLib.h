@@ -261,6 +261,7 @@ extern UINT32     mFvTakenSize;
 
 extern EFI_PHYSICAL_ADDRESS mFvBaseAddress[];
 extern UINT32               mFvBaseAddressNumber;
+extern BOOLEAN              mFvIncremental;
 //
 // Local function prototypes
 //
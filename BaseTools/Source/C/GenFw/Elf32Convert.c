@@ -1090,6 +1090,11 @@ WriteRelocations32 (
     }
   }
 
+  //
+  // Write the base relocation blocks.
+  //
+  CoffWriteFixups ();
+
   //
   // Pad by adding empty entries.
   //
@@ -73,6 +73,18 @@ CleanUp64 (
   VOID
   );
 
+STATIC
+Elf64_Shdr*
+GetShdrByIndex (
+  UINT32 Num
+  );
+
+STATIC
+BOOLEAN
+IsStrtabShdr (
+  Elf64_Shdr *Shdr
+  );
+
 //
 // Rename ELF32 strucutres to common names to help when porting to ELF64.
 //
@@ -94,6 +106,13 @@ STATIC Elf_Ehdr *mEhdr;
 STATIC Elf_Shdr *mShdrBase;
 STATIC Elf_Phdr *mPhdrBase;
 
+//
+// Section lookups done once in InitializeElf64 (), so that the filters
+// and symbol names do not compare section names for every call.
+//
+STATIC BOOLEAN  *mHiiRsrcShdr = NULL;
+STATIC Elf_Shdr *mStrtabShdr  = NULL;
+
 //
 // Coff information
 //
@@ -128,6 +147,8 @@ InitializeElf64 (
   ELF_FUNCTION_TABLE  *ElfFunctions
   )
 {
+  UINT32  Index;
+
   //
   // Initialize data pointer and structures.
   //
@@ -177,6 +198,25 @@ InitializeElf64 (
   }
   memset(mCoffSectionsOffset, 0, mEhdr->e_shnum * sizeof(UINT32));
 
+  //
+  // Find the .hii and .strtab sections.
+  //
+  VerboseMsg ("Index Sections");
+  mHiiRsrcShdr = (BOOLEAN *)malloc(mEhdr->e_shnum * sizeof (BOOLEAN));
+  if (mHiiRsrcShdr == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+    return FALSE;
+  }
+  mStrtabShdr = NULL;
+  for (Index = 0; Index < mEhdr->e_shnum; Index++) {
+    Elf_Shdr *Shdr   = GetShdrByIndex(Index);
+    Elf_Shdr *Namedr = GetShdrByIndex(mEhdr->e_shstrndx);
+    mHiiRsrcShdr[Index] = (BOOLEAN) (strcmp((CHAR8*)mEhdr + Namedr->sh_offset + Shdr->sh_name, ELF_HII_SECTION_NAME) == 0);
+    if (mStrtabShdr == NULL && IsStrtabShdr(Shdr)) {
+      mStrtabShdr = Shdr;
+    }
+  }
+
   //
   // Fill in function pointers.
   //
@@ -245,9 +285,7 @@ IsHiiRsrcShdr (
   Elf_Shdr *Shdr
   )
 {
-  Elf_Shdr *Namedr = GetShdrByIndex(mEhdr->e_shstrndx);
-
-  return (BOOLEAN) (strcmp((CHAR8*)mEhdr + Namedr->sh_offset + Shdr->sh_name, ELF_HII_SECTION_NAME) == 0);
+  return mHiiRsrcShdr[((UINT8*)Shdr - (UINT8*)mShdrBase) / mEhdr->e_shentsize];
 }
 
 STATIC
@@ -273,22 +311,6 @@ IsStrtabShdr (
   return (BOOLEAN) (strcmp((CHAR8*)mEhdr + Namedr->sh_offset + Shdr->sh_name, ELF_STRTAB_SECTION_NAME) == 0);
 }
 
-STATIC
-Elf_Shdr *
-FindStrtabShdr (
-  VOID
-  )
-{
-  UINT32 i;
-  for (i = 0; i < mEhdr->e_shnum; i++) {
-    Elf_Shdr *shdr = GetShdrByIndex(i);
-    if (IsStrtabShdr(shdr)) {
-      return shdr;
-    }
-  }
-  return NULL;
-}
-
 STATIC
 const UINT8 *
 GetSymName (
@@ -304,7 +326,7 @@ GetSymName (
     return NULL;
   }
 
-  StrtabShdr = FindStrtabShdr();
+  StrtabShdr = mStrtabShdr;
   if (StrtabShdr == NULL) {
     return NULL;
   }
@@ -1044,6 +1066,11 @@ WriteRelocations64 (
     }
   }
 
+  //
+  // Write the base relocation blocks.
+  //
+  CoffWriteFixups ();
+
   //
   // Pad by adding empty entries.
   //
@@ -1122,6 +1149,9 @@ CleanUp64 (
   if (mCoffSectionsOffset != NULL) {
     free (mCoffSectionsOffset);
   }
+  if (mHiiRsrcShdr != NULL) {
+    free (mHiiRsrcShdr);
+  }
 }
 
 
@@ -47,6 +47,20 @@ UINT8 *mCoffFile = NULL;
 EFI_IMAGE_BASE_RELOCATION *mCoffBaseRel;
 UINT16                    *mCoffEntryRel;
 
+//
+// Fixups added by CoffAddFixup(), written by CoffWriteFixups() in offset order.
+// Index keeps fixups at the same offset in the order they were added.
+//
+typedef struct {
+  UINT32  Offset;
+  UINT32  Index;
+  UINT8   Type;
+} COFF_FIXUP;
+
+STATIC COFF_FIXUP *mCoffFixups   = NULL;
+STATIC UINT32     mCoffFixupNum  = 0;
+STATIC UINT32     mCoffFixupMax  = 0;
+
 //
 // Current offset in coff file.
 //
@@ -80,46 +94,112 @@ CoffAddFixup(
   UINT8  Type
   )
 {
-  if (mCoffBaseRel == NULL
-      || mCoffBaseRel->VirtualAddress != (Offset & ~0xfff)) {
-    if (mCoffBaseRel != NULL) {
-      //
-      // Add a null entry (is it required ?)
-      //
-      CoffAddFixupEntry (0);
-      
-      //
-      // Pad for alignment.
-      //
-      if (mCoffOffset % 4 != 0)
-        CoffAddFixupEntry (0);
-    }
-
-    mCoffFile = realloc (
-      mCoffFile,
-      mCoffOffset + sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
-      );
-    if (mCoffFile == NULL) {
+  if (mCoffFixupNum == mCoffFixupMax) {
+    mCoffFixupMax = (mCoffFixupMax == 0) ? 0x100 : mCoffFixupMax * 2;
+    mCoffFixups = realloc (mCoffFixups, mCoffFixupMax * sizeof (COFF_FIXUP));
+    if (mCoffFixups == NULL) {
       Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
     }
-    assert (mCoffFile != NULL);
-    memset (
-      mCoffFile + mCoffOffset, 0,
-      sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
-      );
-
-    mCoffBaseRel = (EFI_IMAGE_BASE_RELOCATION*)(mCoffFile + mCoffOffset);
-    mCoffBaseRel->VirtualAddress = Offset & ~0xfff;
-    mCoffBaseRel->SizeOfBlock = sizeof(EFI_IMAGE_BASE_RELOCATION);
-
-    mCoffEntryRel = (UINT16 *)(mCoffBaseRel + 1);
-    mCoffOffset += sizeof(EFI_IMAGE_BASE_RELOCATION);
+    assert (mCoffFixups != NULL);
+  }
+
+  mCoffFixups[mCoffFixupNum].Offset = Offset;
+  mCoffFixups[mCoffFixupNum].Index  = mCoffFixupNum;
+  mCoffFixups[mCoffFixupNum].Type   = Type;
+  mCoffFixupNum++;
+}
+
+STATIC
+int
+CompareFixups (
+  const VOID *Left,
+  const VOID *Right
+  )
+{
+  const COFF_FIXUP *Fixup1;
+  const COFF_FIXUP *Fixup2;
+
+  Fixup1 = (const COFF_FIXUP *) Left;
+  Fixup2 = (const COFF_FIXUP *) Right;
+  if (Fixup1->Offset != Fixup2->Offset) {
+    return (Fixup1->Offset < Fixup2->Offset) ? -1 : 1;
+  }
+  return (Fixup1->Index < Fixup2->Index) ? -1 : 1;
+}
+
+VOID
+CoffWriteFixups (
+  VOID
+  )
+{
+  UINT32  Index;
+  UINT32  BlockNum;
+  UINT32  MaxSize;
+
+  if (mCoffFixupNum == 0) {
+    return;
   }
 
   //
-  // Fill the entry.
+  // Sort the fixups so that each 4K page gets a single relocation block,
+  // then grow the image once for all blocks.
   //
-  CoffAddFixupEntry((UINT16) ((Type << 12) | (Offset & 0xfff)));
+  qsort (mCoffFixups, mCoffFixupNum, sizeof (COFF_FIXUP), CompareFixups);
+
+  BlockNum = 1;
+  for (Index = 1; Index < mCoffFixupNum; Index++) {
+    if ((mCoffFixups[Index].Offset & ~0xfff) != (mCoffFixups[Index - 1].Offset & ~0xfff)) {
+      BlockNum++;
+    }
+  }
+  MaxSize = mCoffFixupNum * sizeof (UINT16)
+            + BlockNum * (sizeof (EFI_IMAGE_BASE_RELOCATION) + 2 * sizeof (UINT16))
+            + 2 * MAX_COFF_ALIGNMENT;
+
+  mCoffFile = realloc (mCoffFile, mCoffOffset + MaxSize);
+  if (mCoffFile == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+  }
+  assert (mCoffFile != NULL);
+  memset (mCoffFile + mCoffOffset, 0, MaxSize);
+
+  mCoffBaseRel = NULL;
+  for (Index = 0; Index < mCoffFixupNum; Index++) {
+    if (mCoffBaseRel == NULL
+        || mCoffBaseRel->VirtualAddress != (mCoffFixups[Index].Offset & ~0xfff)) {
+      if (mCoffBaseRel != NULL) {
+        //
+        // Add a null entry (is it required ?)
+        //
+        CoffAddFixupEntry (0);
+
+        //
+        // Pad for alignment.
+        //
+        if (mCoffOffset % 4 != 0)
+          CoffAddFixupEntry (0);
+      }
+
+      mCoffBaseRel = (EFI_IMAGE_BASE_RELOCATION*)(mCoffFile + mCoffOffset);
+      mCoffBaseRel->VirtualAddress = mCoffFixups[Index].Offset & ~0xfff;
+      mCoffBaseRel->SizeOfBlock = sizeof(EFI_IMAGE_BASE_RELOCATION);
+
+      mCoffEntryRel = (UINT16 *)(mCoffBaseRel + 1);
+      mCoffOffset += sizeof(EFI_IMAGE_BASE_RELOCATION);
+    }
+
+    //
+    // Fill the entry.
+    //
+    CoffAddFixupEntry((UINT16) ((mCoffFixups[Index].Type << 12) | (mCoffFixups[Index].Offset & 0xfff)));
+  }
+
+  VerboseMsg ("%u base relocations in %u blocks", (unsigned) mCoffFixupNum, (unsigned) BlockNum);
+
+  free (mCoffFixups);
+  mCoffFixups   = NULL;
+  mCoffFixupNum = 0;
+  mCoffFixupMax = 0;
 }
 
 VOID
@@ -196,6 +276,7 @@ ConvertElf (
   //  
   VerboseMsg ("Compute sections new address.");
   ElfFunctions.ScanSections ();
+  StatsEndPhase ("ELF scan sections");
 
   //
   // Write and relocate sections.
@@ -204,18 +285,21 @@ ConvertElf (
   ElfFunctions.WriteSections (SECTION_TEXT);
   ElfFunctions.WriteSections (SECTION_DATA);
   ElfFunctions.WriteSections (SECTION_HII);
+  StatsEndPhase ("ELF write sections");
 
   //
   // Translate and write relocations.
   //
   VerboseMsg ("Translate and write relocations.");
   ElfFunctions.WriteRelocations ();
+  StatsEndPhase ("ELF write relocations");
 
   //
   // Write debug info.
   //
   VerboseMsg ("Write debug info.");
   ElfFunctions.WriteDebug ();
+  StatsEndPhase ("ELF write debug");
 
   //
   // Make sure image size is correct before returning the new image.
@@ -74,6 +74,11 @@ CoffAddFixupEntry (
   UINT16 Val
   );
 
+VOID
+CoffWriteFixups (
+  VOID
+  );
+
 
 VOID
 CreateSectionHeader (
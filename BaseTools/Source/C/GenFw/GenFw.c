@@ -93,6 +93,17 @@ UINT32 mImageTimeStamp = 0;
 UINT32 mImageSize = 0;
 UINT32 mOutImageType = FW_DUMMY_IMAGE;
 
+//
+// Processor time spent in each phase, reported by --stats
+//
+#define MAX_STATS_PHASE_NUM  16
+
+STATIC BOOLEAN      mStats = FALSE;
+STATIC clock_t      mStatsClock;
+STATIC UINT32       mStatsPhaseNum = 0;
+STATIC const CHAR8  *mStatsPhaseName[MAX_STATS_PHASE_NUM];
+STATIC clock_t      mStatsPhaseTime[MAX_STATS_PHASE_NUM];
+
 
 STATIC
 EFI_STATUS
@@ -284,6 +295,9 @@ Returns:
                         except for -o or -r option. It is a action option.\n\
                         If it is combined with other action options, the later\n\
                         input action option will override the previous one.\n");
+  fprintf (stdout, "  --stats               Print the processor time spent in each phase,\n\
+                        such as reading the input, each step of the ELF\n\
+                        conversion and writing the output.\n");
   fprintf (stdout, "  -v, --verbose         Turn on verbose output with informational messages.\n");
   fprintf (stdout, "  -q, --quiet           Disable all messages except key message and fatal error\n");
   fprintf (stdout, "  -d, --debug level     Enable debug messages, at input debug level.\n");
@@ -291,6 +305,77 @@ Returns:
   fprintf (stdout, "  -h, --help            Show this help message and exit\n");
 }
 
+VOID
+StatsEndPhase (
+  IN const CHAR8  *PhaseName
+  )
+/*++
+
+Routine Description:
+
+  Record the processor time spent since the end of the previous phase
+  for the --stats report.
+
+Arguments:
+
+  PhaseName - Name of the phase that ends.
+
+Returns:
+
+  None
+
+--*/
+{
+  clock_t  Now;
+
+  if (!mStats || mStatsPhaseNum == MAX_STATS_PHASE_NUM) {
+    return;
+  }
+
+  Now = clock ();
+  mStatsPhaseName[mStatsPhaseNum] = PhaseName;
+  mStatsPhaseTime[mStatsPhaseNum] = Now - mStatsClock;
+  mStatsPhaseNum++;
+  mStatsClock = Now;
+}
+
+STATIC
+VOID
+StatsReport (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  Print the phases recorded by StatsEndPhase().
+
+Arguments:
+
+  None
+
+Returns:
+
+  None
+
+--*/
+{
+  UINT32   Index;
+  clock_t  Total;
+
+  if (!mStats) {
+    return;
+  }
+
+  Total = 0;
+  fprintf (stdout, "%s statistics for %s:\n", UTILITY_NAME, mInImageName == NULL ? "" : mInImageName);
+  for (Index = 0; Index < mStatsPhaseNum; Index++) {
+    fprintf (stdout, "  %-24s %10.3f ms\n", mStatsPhaseName[Index], mStatsPhaseTime[Index] * 1000.0 / CLOCKS_PER_SEC);
+    Total += mStatsPhaseTime[Index];
+  }
+  fprintf (stdout, "  %-24s %10.3f ms\n", "total", Total * 1000.0 / CLOCKS_PER_SEC);
+}
+
 STATIC
 STATUS
 CheckAcpiTable (
@@ -1290,6 +1375,14 @@ Returns:
       continue;
     }
 
+    if (stricmp (argv[0], "--stats") == 0) {
+      mStats = TRUE;
+      mStatsClock = clock ();
+      argc --;
+      argv ++;
+      continue;
+    }
+
     if ((stricmp (argv[0], "-m") == 0) || (stricmp (argv[0], "--mcifile") == 0)) {
       mOutImageType = FW_MCI_IMAGE;
       argc --;
@@ -1616,6 +1709,7 @@ Returns:
   fread (InputFileBuffer, 1, InputFileLength, fpIn);
   fclose (fpIn);
   DebugMsg (NULL, 0, 9, "input file info", "the input file size is %u bytes", (unsigned) InputFileLength);
+  StatsEndPhase ("read input");
 
   //
   // Combine multi binary HII package files.
@@ -2644,6 +2738,8 @@ Returns:
   }
 
 WriteFile:
+  StatsEndPhase ("process image");
+
   //
   // Update Image to EfiImage or TE image
   //
@@ -2675,6 +2771,7 @@ WriteFile:
     }
   }
   mImageSize = FileLength;
+  StatsEndPhase ("write output");
 
 Finish:
   if (fpInOut != NULL) {
@@ -2742,6 +2839,7 @@ Finish:
       free (ReportFileName);
     }
   }
+  StatsReport ();
   VerboseMsg ("%s tool done with return code is 0x%x.", UTILITY_NAME, GetUtilityStatus ());
 
   return GetUtilityStatus ();
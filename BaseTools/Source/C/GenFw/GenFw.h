@@ -53,4 +53,9 @@ ConvertElf (
   UINT32 *FileLength
   );
 
+VOID
+StatsEndPhase (
+  const CHAR8  *PhaseName
+  );
+
 #endif
@@ -19,14 +19,11 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Common/UefiBaseTypes.h>
 #include <Common/PiFirmwareFile.h>
-#include <Protocol/GuidedSectionExtraction.h>
-#include <IndustryStandard/PeImage.h>
 
 #include "CommonLib.h"
-#include "Compress.h"
-#include "Crc32.h"
 #include "EfiUtilityMsgs.h"
 #include "ParseInf.h"
+#include "SectionLib.h"
 
 //
 // GenSec Tool Information
@@ -78,21 +75,7 @@ STATIC CHAR8 *mAlignName[] = {
   "512K", "1M", "2M", "4M", "8M", "16M"
 };
 
-//
-// Crc32 GUID section related definitions.
-//
-typedef struct {
-  EFI_GUID_DEFINED_SECTION  GuidSectionHeader;
-  UINT32                    CRC32Checksum;
-} CRC32_SECTION_HEADER;
-
-typedef struct {
-  EFI_GUID_DEFINED_SECTION2 GuidSectionHeader;
-  UINT32                    CRC32Checksum;
-} CRC32_SECTION_HEADER2;
-
 STATIC EFI_GUID  mZeroGuid                 = {0x0, 0x0, 0x0, {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}};
-STATIC EFI_GUID  mEfiCrc32SectionGuid      = EFI_CRC32_GUIDED_SECTION_EXTRACTION_PROTOCOL_GUID;
 
 STATIC
 VOID 
@@ -194,159 +177,6 @@ Returns:
   fprintf (stdout, "  -h, --help            Show this help message and exit.\n");
 }
 
-VOID
-Ascii2UnicodeString (
-  CHAR8    *String,
-  CHAR16   *UniString
-  )
-/*++
-
-Routine Description:
-
-  Write ascii string as unicode string format to FILE 
-
-Arguments:
-
-  String      - Pointer to string that is written to FILE.
-  UniString   - Pointer to unicode string
-
-Returns:
-
-  NULL
-
---*/
-{
-  while (*String != '\0') {
-    *(UniString++) = (CHAR16) *(String++);
-  }
-  //
-  // End the UniString with a NULL.
-  //
-  *UniString = '\0';
-} 
-
-STATUS
-GenSectionCommonLeafSection (
-  CHAR8   **InputFileName,
-  UINT32  InputFileNum,
-  UINT8   SectionType,
-  UINT8   **OutFileBuffer
-  )
-/*++
-        
-Routine Description:
-           
-  Generate a leaf section of type other than EFI_SECTION_VERSION
-  and EFI_SECTION_USER_INTERFACE. Input file must be well formed.
-  The function won't validate the input file's contents. For
-  common leaf sections, the input file may be a binary file.
-  The utility will add section header to the file.
-            
-Arguments:
-               
-  InputFileName  - Name of the input file.
-                
-  InputFileNum   - Number of input files. Should be 1 for leaf section.
-
-  SectionType    - A valid section type string
-
-  OutFileBuffer  - Buffer pointer to Output file contents
-
-Returns:
-                       
-  STATUS_ERROR            - can't continue
-  STATUS_SUCCESS          - successful return
-
---*/
-{
-  UINT32                    InputFileLength;
-  FILE                      *InFile;
-  UINT8                     *Buffer;
-  UINT32                    TotalLength;
-  UINT32                    HeaderLength;
-  EFI_COMMON_SECTION_HEADER *CommonSect;
-  STATUS                    Status;
-
-  if (InputFileNum > 1) {
-    Error (NULL, 0, 2000, "Invalid parameter", "more than one input file specified");
-    return STATUS_ERROR;
-  } else if (InputFileNum < 1) {
-    Error (NULL, 0, 2000, "Invalid parameter", "no input file specified");
-    return STATUS_ERROR;
-  }
-  //
-  // Open the input file
-  //
-  InFile = fopen (LongFilePath (InputFileName[0]), "rb");
-  if (InFile == NULL) {
-    Error (NULL, 0, 0001, "Error opening file", InputFileName[0]);
-    return STATUS_ERROR;
-  }
-
-  Status  = STATUS_ERROR;
-  Buffer  = NULL;
-  //
-  // Seek to the end of the input file so we can determine its size
-  //
-  fseek (InFile, 0, SEEK_END);
-  InputFileLength = ftell (InFile);
-  fseek (InFile, 0, SEEK_SET);
-  DebugMsg (NULL, 0, 9, "Input file", "File name is %s and File size is %u bytes", InputFileName[0], (unsigned) InputFileLength);
-  TotalLength     = sizeof (EFI_COMMON_SECTION_HEADER) + InputFileLength;
-  //
-  // Size must fit in 3 bytes
-  //
-  //if (TotalLength >= MAX_SECTION_SIZE) {
-  //  Error (NULL, 0, 2000, "Invalid parameter", "%s file size (0x%X) exceeds section size limit(%uM).", InputFileName[0], (unsigned) TotalLength, MAX_SECTION_SIZE>>20);
-  //  goto Done;
-  //}
-  HeaderLength = sizeof (EFI_COMMON_SECTION_HEADER);
-  if (TotalLength >= MAX_SECTION_SIZE) {
-    TotalLength = sizeof (EFI_COMMON_SECTION_HEADER2) + InputFileLength;
-    HeaderLength = sizeof (EFI_COMMON_SECTION_HEADER2);
-  }
-  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) TotalLength);
-  //
-  // Fill in the fields in the local section header structure
-  //
-  Buffer = (UINT8 *) malloc ((size_t) TotalLength);
-  if (Buffer == NULL) {
-    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated"); 
-    goto Done;
-  }
-  CommonSect = (EFI_COMMON_SECTION_HEADER *) Buffer;
-  CommonSect->Type     = SectionType;
-  if (TotalLength < MAX_SECTION_SIZE) {
-    CommonSect->Size[0]  = (UINT8) (TotalLength & 0xff);
-    CommonSect->Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
-    CommonSect->Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
-  } else {
-    memset(CommonSect->Size, 0xff, sizeof(UINT8) * 3);
-    ((EFI_COMMON_SECTION_HEADER2 *)CommonSect)->ExtendedSize = TotalLength;
-  }
-  
-  //
-  // read data from the input file.
-  //
-  if (InputFileLength != 0) {
-    if (fread (Buffer + HeaderLength, (size_t) InputFileLength, 1, InFile) != 1) {
-      Error (NULL, 0, 0004, "Error reading file", InputFileName[0]);
-      goto Done;
-    }
-  }
-
-  //
-  // Set OutFileBuffer 
-  //
-  *OutFileBuffer = Buffer;
-  Status = STATUS_SUCCESS;
-
-Done:
-  fclose (InFile);
-
-  return Status;
-}
-
 STATIC
 EFI_STATUS
 StringtoAlignment (
@@ -387,601 +217,6 @@ Returns:
   return EFI_INVALID_PARAMETER;
 }
 
-EFI_STATUS
-GetSectionContents (
-  CHAR8   **InputFileName,
-  UINT32  *InputFileAlign,
-  UINT32  InputFileNum,
-  UINT8   *FileBuffer,
-  UINT32  *BufferLength
-  )
-/*++
-        
-Routine Description:
-           
-  Get the contents of all section files specified in InputFileName
-  into FileBuffer.
-            
-Arguments:
-               
-  InputFileName  - Name of the input file.
-
-  InputFileAlign - Alignment required by the input file data.
-
-  InputFileNum   - Number of input files. Should be at least 1.
-
-  FileBuffer     - Output buffer to contain data
-
-  BufferLength   - On input, this is size of the FileBuffer. 
-                   On output, this is the actual length of the data.
-
-Returns:
-                       
-  EFI_SUCCESS on successful return
-  EFI_INVALID_PARAMETER if InputFileNum is less than 1 or BufferLength point is NULL.
-  EFI_ABORTED if unable to open input file.
-  EFI_BUFFER_TOO_SMALL FileBuffer is not enough to contain all file data.
---*/
-{
-  UINT32                     Size;
-  UINT32                     Offset;
-  UINT32                     FileSize;
-  UINT32                     Index;
-  FILE                       *InFile;
-  EFI_COMMON_SECTION_HEADER  *SectHeader;
-  EFI_COMMON_SECTION_HEADER2 TempSectHeader;
-  EFI_TE_IMAGE_HEADER        TeHeader;
-  UINT32                     TeOffset;
-  EFI_GUID_DEFINED_SECTION   GuidSectHeader;
-  EFI_GUID_DEFINED_SECTION2  GuidSectHeader2;
-  UINT32                     HeaderSize;
-
-  if (InputFileNum < 1) {
-    Error (NULL, 0, 2000, "Invalid parameter", "must specify at least one input file");
-    return EFI_INVALID_PARAMETER;
-  }
-
-  if (BufferLength == NULL) {
-    Error (NULL, 0, 2000, "Invalid parameter", "BufferLength can't be NULL");
-    return EFI_INVALID_PARAMETER;
-  }
-
-  Size          = 0;
-  Offset        = 0;
-  TeOffset      = 0;
-  //
-  // Go through our array of file names and copy their contents
-  // to the output buffer.
-  //
-  for (Index = 0; Index < InputFileNum; Index++) {
-    //
-    // make sure section ends on a DWORD boundary
-    //
-    while ((Size & 0x03) != 0) {
-      if (FileBuffer != NULL && Size < *BufferLength) {
-        FileBuffer[Size] = 0;
-      }
-      Size++;
-    }
-    
-    // 
-    // Open file and read contents
-    //
-    InFile = fopen (LongFilePath (InputFileName[Index]), "rb");
-    if (InFile == NULL) {
-      Error (NULL, 0, 0001, "Error opening file", InputFileName[Index]);
-      return EFI_ABORTED;
-    }
-
-    fseek (InFile, 0, SEEK_END);
-    FileSize = ftell (InFile);
-    fseek (InFile, 0, SEEK_SET);
-    DebugMsg (NULL, 0, 9, "Input files", "the input file name is %s and the size is %u bytes", InputFileName[Index], (unsigned) FileSize); 
-    //
-    // Adjust section buffer when section alignment is required.
-    //
-    if (InputFileAlign != NULL) {
-      //
-      // Check this section is Te/Pe section, and Calculate the numbers of Te/Pe section.
-      //
-      TeOffset = 0;
-      //
-      // The section might be EFI_COMMON_SECTION_HEADER2
-      // But only Type needs to be checked
-      //
-      if (FileSize >= MAX_SECTION_SIZE) {
-        HeaderSize = sizeof (EFI_COMMON_SECTION_HEADER2);
-      } else {
-        HeaderSize = sizeof (EFI_COMMON_SECTION_HEADER);
-      }
-      fread (&TempSectHeader, 1, HeaderSize, InFile);
-      if (TempSectHeader.Type == EFI_SECTION_TE) {
-        fread (&TeHeader, 1, sizeof (TeHeader), InFile);
-        if (TeHeader.Signature == EFI_TE_IMAGE_HEADER_SIGNATURE) {
-          TeOffset = TeHeader.StrippedSize - sizeof (TeHeader);
-        }
-      } else if (TempSectHeader.Type == EFI_SECTION_GUID_DEFINED) {
-        fseek (InFile, 0, SEEK_SET);
-        if (FileSize >= MAX_SECTION_SIZE) {
-          fread (&GuidSectHeader2, 1, sizeof (GuidSectHeader2), InFile);
-          if ((GuidSectHeader2.Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0) {
-            HeaderSize = GuidSectHeader2.DataOffset;
-          }
-        } else {
-          fread (&GuidSectHeader, 1, sizeof (GuidSectHeader), InFile);
-          if ((GuidSectHeader.Attributes & EFI_GUIDED_SECTION_PROCESSING_REQUIRED) == 0) {
-            HeaderSize = GuidSectHeader.DataOffset;
-          }
-        }
-      } 
-
-      fseek (InFile, 0, SEEK_SET);
-
-      //
-      // Revert TeOffset to the converse value relative to Alignment
-      // This is to assure the original PeImage Header at Alignment.
-      //
-      if (TeOffset != 0) {
-        TeOffset = InputFileAlign [Index] - (TeOffset % InputFileAlign [Index]);
-        TeOffset = TeOffset % InputFileAlign [Index];
-      }
-
-      //
-      // make sure section data meet its alignment requirement by adding one raw pad section.
-      //
-      if ((InputFileAlign [Index] != 0) && (((Size + HeaderSize + TeOffset) % InputFileAlign [Index]) != 0)) {
-        Offset = (Size + sizeof (EFI_COMMON_SECTION_HEADER) + HeaderSize + TeOffset + InputFileAlign [Index] - 1) & ~(InputFileAlign [Index] - 1);
-        Offset = Offset - Size - HeaderSize - TeOffset;
-         
-        if (FileBuffer != NULL && ((Size + Offset) < *BufferLength)) {
-          //
-          // The maximal alignment is 64K, the raw section size must be less than 0xffffff
-          //
-          memset (FileBuffer + Size, 0, Offset);
-          SectHeader          = (EFI_COMMON_SECTION_HEADER *) (FileBuffer + Size);
-          SectHeader->Type    = EFI_SECTION_RAW;
-          SectHeader->Size[0] = (UINT8) (Offset & 0xff);
-          SectHeader->Size[1] = (UINT8) ((Offset & 0xff00) >> 8);
-          SectHeader->Size[2] = (UINT8) ((Offset & 0xff0000) >> 16);
-        }
-        DebugMsg (NULL, 0, 9, "Pad raw section for section data alignment", "Pad Raw section size is %u", (unsigned) Offset);
-
-        Size = Size + Offset;
-      }
-    }
-
-    //
-    // Now read the contents of the file into the buffer
-    // Buffer must be enough to contain the file content.
-    //
-    if ((FileSize > 0) && (FileBuffer != NULL) && ((Size + FileSize) <= *BufferLength)) {
-      if (fread (FileBuffer + Size, (size_t) FileSize, 1, InFile) != 1) {
-        Error (NULL, 0, 0004, "Error reading file", InputFileName[Index]);
-        fclose (InFile);
-        return EFI_ABORTED;
-      }
-    }
-
-    fclose (InFile);
-    Size += FileSize;
-  }
-  
-  //
-  // Set the real required buffer size.
-  //
-  if (Size > *BufferLength) {
-    *BufferLength = Size;
-    return EFI_BUFFER_TOO_SMALL;
-  } else {
-    *BufferLength = Size;
-    return EFI_SUCCESS;
-  }
-}
-
-EFI_STATUS
-GenSectionCompressionSection (
-  CHAR8   **InputFileName,
-  UINT32  *InputFileAlign,
-  UINT32  InputFileNum,
-  UINT8   SectCompSubType,
-  UINT8   **OutFileBuffer
-  )
-/*++
-        
-Routine Description:
-           
-  Generate an encapsulating section of type EFI_SECTION_COMPRESSION
-  Input file must be already sectioned. The function won't validate
-  the input files' contents. Caller should hand in files already 
-  with section header.
-            
-Arguments:
-               
-  InputFileName  - Name of the input file.
-
-  InputFileAlign - Alignment required by the input file data.
-
-  InputFileNum   - Number of input files. Should be at least 1.
-
-  SectCompSubType - Specify the compression algorithm requested. 
-  
-  OutFileBuffer   - Buffer pointer to Output file contents
-
-Returns:
-                       
-  EFI_SUCCESS           on successful return
-  EFI_INVALID_PARAMETER if InputFileNum is less than 1
-  EFI_ABORTED           if unable to open input file.
-  EFI_OUT_OF_RESOURCES  No resource to complete the operation.
---*/
-{
-  UINT32                  TotalLength;
-  UINT32                  InputLength;
-  UINT32                  CompressedLength;
-  UINT32                  HeaderLength;
-  UINT8                   *FileBuffer;
-  UINT8                   *OutputBuffer;
-  EFI_STATUS              Status;
-  EFI_COMPRESSION_SECTION *CompressionSect;
-  EFI_COMPRESSION_SECTION2 *CompressionSect2;
-  COMPRESS_FUNCTION       CompressFunction;
-
-  InputLength       = 0;
-  FileBuffer        = NULL;
-  OutputBuffer      = NULL;
-  CompressedLength  = 0;
-  TotalLength       = 0;
-  //
-  // read all input file contents into a buffer
-  // first get the size of all file contents
-  //
-  Status = GetSectionContents (
-            InputFileName,
-            InputFileAlign,
-            InputFileNum,
-            FileBuffer,
-            &InputLength
-            );
-
-  if (Status == EFI_BUFFER_TOO_SMALL) {
-    FileBuffer = (UINT8 *) malloc (InputLength);
-    if (FileBuffer == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
-      return EFI_OUT_OF_RESOURCES;
-    }
-    //
-    // read all input file contents into a buffer
-    //
-    Status = GetSectionContents (
-              InputFileName,
-              InputFileAlign,
-              InputFileNum,
-              FileBuffer,
-              &InputLength
-              );
-  }
-
-  if (EFI_ERROR (Status)) {
-    if (FileBuffer != NULL) {
-      free (FileBuffer);
-    }
-    return Status;
-  }
-
-  if (FileBuffer == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  CompressFunction = NULL;
-
-  //
-  // Now data is in FileBuffer, compress the data
-  //
-  switch (SectCompSubType) {
-  case EFI_NOT_COMPRESSED:
-    CompressedLength = InputLength;
-    HeaderLength = sizeof (EFI_COMPRESSION_SECTION);
-    if (CompressedLength + HeaderLength >= MAX_SECTION_SIZE) {
-      HeaderLength = sizeof (EFI_COMPRESSION_SECTION2);
-    }
-    TotalLength = CompressedLength + HeaderLength;
-    //
-    // Copy file buffer to the none compressed data.
-    //
-    OutputBuffer = malloc (TotalLength);
-    if (OutputBuffer == NULL) {
-      free (FileBuffer);
-      return EFI_OUT_OF_RESOURCES;
-    }
-    memcpy (OutputBuffer + HeaderLength, FileBuffer, CompressedLength);
-    free (FileBuffer);
-    FileBuffer = OutputBuffer;
-    break;
-
-  case EFI_STANDARD_COMPRESSION:
-    CompressFunction = (COMPRESS_FUNCTION) EfiCompress;
-    break;
-
-  default:
-    Error (NULL, 0, 2000, "Invalid parameter", "unknown compression type");
-    free (FileBuffer);
-    return EFI_ABORTED;
-  }
-
-  if (CompressFunction != NULL) {
-
-    Status = CompressFunction (FileBuffer, InputLength, OutputBuffer, &CompressedLength);
-    if (Status == EFI_BUFFER_TOO_SMALL) {
-      HeaderLength = sizeof (EFI_COMPRESSION_SECTION);
-      if (CompressedLength + HeaderLength >= MAX_SECTION_SIZE) {
-        HeaderLength = sizeof (EFI_COMPRESSION_SECTION2);
-      }
-      TotalLength = CompressedLength + HeaderLength;
-      OutputBuffer = malloc (TotalLength);
-      if (!OutputBuffer) {
-        free (FileBuffer);
-        return EFI_OUT_OF_RESOURCES;
-      }
-
-      Status = CompressFunction (FileBuffer, InputLength, OutputBuffer + HeaderLength, &CompressedLength);
-    }
-
-    free (FileBuffer);
-    FileBuffer = OutputBuffer;
-
-    if (EFI_ERROR (Status)) {
-      if (FileBuffer != NULL) {
-        free (FileBuffer);
-      }
-
-      return Status;
-    }
-
-    if (FileBuffer == NULL) {
-      return EFI_OUT_OF_RESOURCES;
-    }
-  }
-
-  DebugMsg (NULL, 0, 9, "comprss file size", 
-            "the original section size is %d bytes and the compressed section size is %u bytes", (unsigned) InputLength, (unsigned) CompressedLength);
-
-  //if (TotalLength >= MAX_SECTION_SIZE) {
-  //  Error (NULL, 0, 2000, "Invalid parameter", "The size of all files exceeds section size limit(%uM).", MAX_SECTION_SIZE>>20);
-  //  if (FileBuffer != NULL) {
-  //    free (FileBuffer);
-  //  }
-  //  if (OutputBuffer != NULL) {
-  //    free (OutputBuffer);
-  //  }
-  //  return STATUS_ERROR;
-  //}
-  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) TotalLength);
-
-  //
-  // Add the section header for the compressed data
-  //
-  if (TotalLength >= MAX_SECTION_SIZE) {
-    CompressionSect2 = (EFI_COMPRESSION_SECTION2 *)FileBuffer;
-
-    memset(CompressionSect2->CommonHeader.Size, 0xff, sizeof(UINT8) * 3);
-    CompressionSect2->CommonHeader.Type         = EFI_SECTION_COMPRESSION;
-    CompressionSect2->CommonHeader.ExtendedSize = TotalLength;
-    CompressionSect2->CompressionType           = SectCompSubType;
-    CompressionSect2->UncompressedLength        = InputLength;
-  } else {
-    CompressionSect = (EFI_COMPRESSION_SECTION *) FileBuffer;
-    
-    CompressionSect->CommonHeader.Type     = EFI_SECTION_COMPRESSION;
-    CompressionSect->CommonHeader.Size[0]  = (UINT8) (TotalLength & 0xff);
-    CompressionSect->CommonHeader.Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
-    CompressionSect->CommonHeader.Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
-    CompressionSect->CompressionType       = SectCompSubType;
-    CompressionSect->UncompressedLength    = InputLength;
-  }
-
-  //
-  // Set OutFileBuffer 
-  //
-  *OutFileBuffer = FileBuffer;
-
-  return EFI_SUCCESS;
-}
-
-EFI_STATUS
-GenSectionGuidDefinedSection (
-  CHAR8    **InputFileName,
-  UINT32   *InputFileAlign,
-  UINT32   InputFileNum,
-  EFI_GUID *VendorGuid,
-  UINT16   DataAttribute,
-  UINT32   DataHeaderSize,
-  UINT8    **OutFileBuffer
-  )
-/*++
-        
-Routine Description:
-           
-  Generate an encapsulating section of type EFI_SECTION_GUID_DEFINED
-  Input file must be already sectioned. The function won't validate
-  the input files' contents. Caller should hand in files already 
-  with section header.
-            
-Arguments:
-               
-  InputFileName - Name of the input file.
-                
-  InputFileAlign - Alignment required by the input file data.
-
-  InputFileNum  - Number of input files. Should be at least 1.
-
-  VendorGuid    - Specify vendor guid value.
-
-  DataAttribute - Specify attribute for the vendor guid data. 
-  
-  DataHeaderSize- Guided Data Header Size
-  
-  OutFileBuffer   - Buffer pointer to Output file contents
-
-Returns:
-                       
-  EFI_SUCCESS on successful return
-  EFI_INVALID_PARAMETER if InputFileNum is less than 1
-  EFI_ABORTED if unable to open input file.
-  EFI_OUT_OF_RESOURCES  No resource to complete the operation.
-
---*/
-{
-  UINT32                TotalLength;
-  UINT32                InputLength;
-  UINT32                Offset;
-  UINT8                 *FileBuffer;
-  UINT32                Crc32Checksum;
-  EFI_STATUS            Status;
-  CRC32_SECTION_HEADER  *Crc32GuidSect;
-  CRC32_SECTION_HEADER2  *Crc32GuidSect2;
-  EFI_GUID_DEFINED_SECTION  *VendorGuidSect;
-  EFI_GUID_DEFINED_SECTION2  *VendorGuidSect2;
-
-  InputLength = 0;
-  Offset      = 0;
-  FileBuffer  = NULL;
-  TotalLength = 0;
-
-  //
-  // read all input file contents into a buffer
-  // first get the size of all file contents
-  //
-  Status = GetSectionContents (
-            InputFileName,
-            InputFileAlign,
-            InputFileNum,
-            FileBuffer,
-            &InputLength
-            );
-
-  if (Status == EFI_BUFFER_TOO_SMALL) {
-    if (CompareGuid (VendorGuid, &mZeroGuid) == 0) {
-      Offset = sizeof (CRC32_SECTION_HEADER);
-      if (InputLength + Offset >= MAX_SECTION_SIZE) {
-        Offset = sizeof (CRC32_SECTION_HEADER2);
-      }
-    } else {
-      Offset = sizeof (EFI_GUID_DEFINED_SECTION);
-      if (InputLength + Offset >= MAX_SECTION_SIZE) {
-        Offset = sizeof (EFI_GUID_DEFINED_SECTION2);
-      }
-    }
-    TotalLength = InputLength + Offset;
-
-    FileBuffer = (UINT8 *) malloc (InputLength + Offset);
-    if (FileBuffer == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
-      return EFI_OUT_OF_RESOURCES;
-    }
-    //
-    // read all input file contents into a buffer
-    //
-    Status = GetSectionContents (
-              InputFileName,
-              InputFileAlign,
-              InputFileNum,
-              FileBuffer + Offset,
-              &InputLength
-              );
-  }
-
-  if (EFI_ERROR (Status)) {
-    if (FileBuffer != NULL) {
-      free (FileBuffer);
-    }
-    Error (NULL, 0, 0001, "Error opening file for reading", InputFileName[0]);
-    return Status;
-  }
-
-  if (InputLength == 0) {
-    if (FileBuffer != NULL) {
-      free (FileBuffer);
-    }
-    Error (NULL, 0, 2000, "Invalid parameter", "the size of input file %s can't be zero", InputFileName);
-    return EFI_NOT_FOUND;
-  }
-
-  //
-  // InputLength != 0, but FileBuffer == NULL means out of resources.
-  //
-  if (FileBuffer == NULL) {
-    Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  //
-  // Now data is in FileBuffer + Offset
-  //
-  if (CompareGuid (VendorGuid, &mZeroGuid) == 0) {
-    //
-    // Default Guid section is CRC32.
-    //
-    Crc32Checksum = 0;
-    CalculateCrc32 (FileBuffer + Offset, InputLength, &Crc32Checksum);
-    
-    if (TotalLength >= MAX_SECTION_SIZE) {
-      Crc32GuidSect2 = (CRC32_SECTION_HEADER2 *) FileBuffer;
-      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
-      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Size[0]  = (UINT8) 0xff;
-      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Size[1]  = (UINT8) 0xff;
-      Crc32GuidSect2->GuidSectionHeader.CommonHeader.Size[2]  = (UINT8) 0xff;
-      Crc32GuidSect2->GuidSectionHeader.CommonHeader.ExtendedSize = TotalLength;
-      memcpy (&(Crc32GuidSect2->GuidSectionHeader.SectionDefinitionGuid), &mEfiCrc32SectionGuid, sizeof (EFI_GUID));
-      Crc32GuidSect2->GuidSectionHeader.Attributes  = EFI_GUIDED_SECTION_AUTH_STATUS_VALID;
-      Crc32GuidSect2->GuidSectionHeader.DataOffset  = sizeof (CRC32_SECTION_HEADER2);
-      Crc32GuidSect2->CRC32Checksum                 = Crc32Checksum;
-      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", Crc32GuidSect2->GuidSectionHeader.DataOffset);
-    } else {
-      Crc32GuidSect = (CRC32_SECTION_HEADER *) FileBuffer;
-      Crc32GuidSect->GuidSectionHeader.CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
-      Crc32GuidSect->GuidSectionHeader.CommonHeader.Size[0]  = (UINT8) (TotalLength & 0xff);
-      Crc32GuidSect->GuidSectionHeader.CommonHeader.Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
-      Crc32GuidSect->GuidSectionHeader.CommonHeader.Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
-      memcpy (&(Crc32GuidSect->GuidSectionHeader.SectionDefinitionGuid), &mEfiCrc32SectionGuid, sizeof (EFI_GUID));
-      Crc32GuidSect->GuidSectionHeader.Attributes  = EFI_GUIDED_SECTION_AUTH_STATUS_VALID;
-      Crc32GuidSect->GuidSectionHeader.DataOffset  = sizeof (CRC32_SECTION_HEADER);
-      Crc32GuidSect->CRC32Checksum                 = Crc32Checksum;
-      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", Crc32GuidSect->GuidSectionHeader.DataOffset);
-    }
-  } else {
-    if (TotalLength >= MAX_SECTION_SIZE) {
-      VendorGuidSect2 = (EFI_GUID_DEFINED_SECTION2 *) FileBuffer;
-      VendorGuidSect2->CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
-      VendorGuidSect2->CommonHeader.Size[0]  = (UINT8) 0xff;
-      VendorGuidSect2->CommonHeader.Size[1]  = (UINT8) 0xff;
-      VendorGuidSect2->CommonHeader.Size[2]  = (UINT8) 0xff;
-      VendorGuidSect2->CommonHeader.ExtendedSize = InputLength + sizeof (EFI_GUID_DEFINED_SECTION2);
-      memcpy (&(VendorGuidSect2->SectionDefinitionGuid), VendorGuid, sizeof (EFI_GUID));
-      VendorGuidSect2->Attributes  = DataAttribute;
-      VendorGuidSect2->DataOffset  = (UINT16) (sizeof (EFI_GUID_DEFINED_SECTION2) + DataHeaderSize);
-      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", VendorGuidSect2->DataOffset);
-    } else {
-      VendorGuidSect = (EFI_GUID_DEFINED_SECTION *) FileBuffer;
-      VendorGuidSect->CommonHeader.Type     = EFI_SECTION_GUID_DEFINED;
-      VendorGuidSect->CommonHeader.Size[0]  = (UINT8) (TotalLength & 0xff);
-      VendorGuidSect->CommonHeader.Size[1]  = (UINT8) ((TotalLength & 0xff00) >> 8);
-      VendorGuidSect->CommonHeader.Size[2]  = (UINT8) ((TotalLength & 0xff0000) >> 16);
-      memcpy (&(VendorGuidSect->SectionDefinitionGuid), VendorGuid, sizeof (EFI_GUID));
-      VendorGuidSect->Attributes  = DataAttribute;
-      VendorGuidSect->DataOffset  = (UINT16) (sizeof (EFI_GUID_DEFINED_SECTION) + DataHeaderSize);
-      DebugMsg (NULL, 0, 9, "Guided section", "Data offset is %u", VendorGuidSect->DataOffset);
-    }
-  }
-  VerboseMsg ("the size of the created section file is %u bytes", (unsigned) TotalLength);
-  
-  //
-  // Set OutFileBuffer 
-  //
-  *OutFileBuffer = FileBuffer;
-
-  return EFI_SUCCESS;
-}
-
 int
 main (
   int  argc,
@@ -1019,15 +254,13 @@ Returns:
   UINT8                     SectCompSubType;
   UINT16                    SectGuidAttribute; 
   UINT64                    SectGuidHeaderLength;
-  EFI_VERSION_SECTION       *VersionSect;
-  EFI_USER_INTERFACE_SECTION *UiSect;
+  SECTION_INPUT             *Input;
   UINT32                    InputLength;
   UINT8                     *OutFileBuffer;
   EFI_STATUS                Status;
   UINT64                    LogLevel;
   UINT32                    *InputFileAlign;
   UINT32                    InputFileAlignNum;
-  EFI_COMMON_SECTION_HEADER *SectionHeader;
 
   InputFileAlign        = NULL;
   InputFileAlignNum     = 0;
@@ -1047,8 +280,7 @@ Returns:
   Status                = STATUS_SUCCESS;
   LogLevel              = 0;
   SectGuidHeaderLength  = 0;
-  VersionSect           = NULL;
-  UiSect                = NULL;
+  Input                 = NULL;
   
   SetUtilityName (UTILITY_NAME);
   
@@ -1421,134 +653,79 @@ Returns:
   VerboseMsg ("Output file name is %s", OutputFileName);
 
   //
-  // At this point, we've fully validated the command line, and opened appropriate
-  // files, so let's go and do what we've been asked to do...
-  //
-  //
-  // Within this switch, build and write out the section header including any
-  // section type specific pieces.  If there's an input file, it's tacked on later
+  // At this point, we've fully validated the command line, so read the
+  // input files and let's go and do what we've been asked to do...
   //
+  if (InputFileNum > 0) {
+    Status = ReadSectionInputFiles (InputFileName, InputFileAlign, InputFileNum, &Input);
+    if (EFI_ERROR (Status)) {
+      goto Finish;
+    }
+  }
+
   switch (SectType) {
   case EFI_SECTION_COMPRESSION:
-    if (InputFileAlign != NULL) {
-      free (InputFileAlign);
-      InputFileAlign = NULL;
-    }
     Status = GenSectionCompressionSection (
-              InputFileName,
-              InputFileAlign,
+              Input,
               InputFileNum,
               SectCompSubType,
-              &OutFileBuffer
+              &OutFileBuffer,
+              &InputLength
               );
     break;
 
   case EFI_SECTION_GUID_DEFINED:
-    if (InputFileAlign != NULL && (CompareGuid (&VendorGuid, &mZeroGuid) != 0)) {
-      //
-      // Only process alignment for the default known CRC32 guided section.
-      // For the unknown guided section, the alignment is processed when the dummy all section (EFI_SECTION_ALL) is generated.
-      //
-      free (InputFileAlign);
-      InputFileAlign = NULL;
-    }
+    //
+    // Only process alignment for the default known CRC32 guided section.
+    // For the unknown guided section, the alignment is processed when the dummy all section (EFI_SECTION_ALL) is generated.
+    //
     Status = GenSectionGuidDefinedSection (
-              InputFileName,
-              InputFileAlign,
+              Input,
               InputFileNum,
               &VendorGuid,
               SectGuidAttribute,
               (UINT32) SectGuidHeaderLength,
-              &OutFileBuffer
+              &OutFileBuffer,
+              &InputLength
               );
     break;
 
   case EFI_SECTION_VERSION:
-    Index           = sizeof (EFI_COMMON_SECTION_HEADER);
-    //
-    // 2 bytes for the build number UINT16
-    //
-    Index += 2;
-    //
-    // StringBuffer is ascii.. unicode is 2X + 2 bytes for terminating unicode null.
-    //
-    Index += (strlen (StringBuffer) * 2) + 2;
-    OutFileBuffer = (UINT8 *) malloc (Index);
-    if (OutFileBuffer == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
-      goto Finish;
-    }
-    VersionSect = (EFI_VERSION_SECTION *) OutFileBuffer;
-    VersionSect->CommonHeader.Type     = SectType;
-    VersionSect->CommonHeader.Size[0]  = (UINT8) (Index & 0xff);
-    VersionSect->CommonHeader.Size[1]  = (UINT8) ((Index & 0xff00) >> 8);
-    VersionSect->CommonHeader.Size[2]  = (UINT8) ((Index & 0xff0000) >> 16);
-    VersionSect->BuildNumber           = (UINT16) VersionNumber;
-    Ascii2UnicodeString (StringBuffer, VersionSect->VersionString);
-    VerboseMsg ("the size of the created section file is %u bytes", (unsigned) Index);
+    Status = GenSectionVersionSection (
+              (UINT16) VersionNumber,
+              StringBuffer,
+              &OutFileBuffer,
+              &InputLength
+              );
     break;
 
   case EFI_SECTION_USER_INTERFACE:
-    Index           = sizeof (EFI_COMMON_SECTION_HEADER);
-    //
-    // StringBuffer is ascii.. unicode is 2X + 2 bytes for terminating unicode null.
-    //
-    Index += (strlen (StringBuffer) * 2) + 2;
-    OutFileBuffer = (UINT8 *) malloc (Index);
-    if (OutFileBuffer == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
-      goto Finish;
-    }
-    UiSect = (EFI_USER_INTERFACE_SECTION *) OutFileBuffer;
-    UiSect->CommonHeader.Type     = SectType;
-    UiSect->CommonHeader.Size[0]  = (UINT8) (Index & 0xff);
-    UiSect->CommonHeader.Size[1]  = (UINT8) ((Index & 0xff00) >> 8);
-    UiSect->CommonHeader.Size[2]  = (UINT8) ((Index & 0xff0000) >> 16);
-    Ascii2UnicodeString (StringBuffer, UiSect->FileNameString);
-    VerboseMsg ("the size of the created section file is %u bytes", (unsigned) Index);
-   break;
+    Status = GenSectionUiSection (
+              StringBuffer,
+              &OutFileBuffer,
+              &InputLength
+              );
+    break;
 
   case EFI_SECTION_ALL:
-    //
-    // read all input file contents into a buffer
-    // first get the size of all file contents
-    //
-    Status = GetSectionContents (
-              InputFileName,
-              InputFileAlign,
+    Status = GenSectionAllSection (
+              Input,
               InputFileNum,
-              OutFileBuffer,
+              &OutFileBuffer,
               &InputLength
               );
-  
-    if (Status == EFI_BUFFER_TOO_SMALL) {
-      OutFileBuffer = (UINT8 *) malloc (InputLength);
-      if (OutFileBuffer == NULL) {
-        Error (NULL, 0, 4001, "Resource", "memory cannot be allcoated");
-        goto Finish;
-      }
-      //
-      // read all input file contents into a buffer
-      //
-      Status = GetSectionContents (
-                InputFileName,
-                InputFileAlign,
-                InputFileNum,
-                OutFileBuffer,
-                &InputLength
-                );
-    }
-    VerboseMsg ("the size of the created section file is %u bytes", (unsigned) InputLength);
     break;
+
   default:
     //
     // All other section types are caught by default (they're all the same)
     //
     Status = GenSectionCommonLeafSection (
-              InputFileName,
+              Input,
               InputFileNum,
               SectType,
-              &OutFileBuffer
+              &OutFileBuffer,
+              &InputLength
               );
     break;
   }
@@ -1558,17 +735,6 @@ Returns:
 	  goto Finish;
   }
 
-  //
-  // Get output file length
-  //
-  if (SectType != EFI_SECTION_ALL) {
-    SectionHeader = (EFI_COMMON_SECTION_HEADER *)OutFileBuffer;
-    InputLength = *(UINT32 *)SectionHeader->Size & 0x00ffffff;
-    if (InputLength == 0xffffff) {
-      InputLength = ((EFI_COMMON_SECTION_HEADER2 *)SectionHeader)->ExtendedSize;
-    }
-  }
-  
   //
   // Write the output file
   //
@@ -1585,6 +751,8 @@ Finish:
     free (InputFileName);
   }
 
+  FreeSectionInputs (Input, InputFileNum);
+
   if (InputFileAlign != NULL) {
     free (InputFileAlign);
   }
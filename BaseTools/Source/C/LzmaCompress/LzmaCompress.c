@@ -45,6 +45,7 @@ const char *kDataErrorMessage = "Data error";
 
 static Bool mQuietMode = False;
 static CONVERTER_TYPE mConType = NoConverter;
+static int mNumThreads = 1;
 
 #define UTILITY_NAME "LzmaCompress"
 #define UTILITY_MAJOR_VERSION 0
@@ -61,6 +62,7 @@ void PrintHelp(char *buffer)
              "  -d: decode file\n"
              "  -o FileName, --output FileName: specify the output filename\n"
              "  --f86: enable converter for x86 code\n"
+             "  --threads N: use 1 or 2 threads to encode, the output is the same (default: 1)\n"
              "  -v, --verbose: increase output messages\n"
              "  -q, --quiet: reduce output messages\n"
              "  --debug [0-9]: set debug level\n"
@@ -104,6 +106,7 @@ static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 file
   CLzmaEncProps props;
 
   LzmaEncProps_Init(&props);
+  props.numThreads = mNumThreads;
   LzmaEncProps_Normalize(&props);
 
   if (inSize != 0) {
@@ -271,6 +274,14 @@ int main2(int numArgs, const char *args[], char *rs)
       modeWasSet = True;
     } else if (strcmp(args[param], "--f86") == 0) {
       mConType = X86Converter;
+    } else if (strcmp(args[param], "--threads") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      mNumThreads = atoi(args[++param]);
+      if (mNumThreads < 1) {
+        return PrintError(rs, "Invalid number of threads");
+      }
     } else if (strcmp(args[param], "-o") == 0 ||
                strcmp(args[param], "--output") == 0) {
       if (numArgs < (param + 2)) {
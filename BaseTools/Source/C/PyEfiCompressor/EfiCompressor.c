@@ -14,6 +14,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include <Python.h>
 #include <Decompress.h>
+#include <Compress.h>
 
 /*
  UefiDecompress(data_buffer, size, original_size)
@@ -172,6 +173,114 @@ ERROR:
 }
 
 
+/*
+ Compress the buffer with CompressFunction. The encoders keep their state per
+ call, so the global interpreter lock is released while compressing and other
+ Python threads can compress at the same time.
+*/
+STATIC
+PyObject*
+CompressBuffer(
+  PyObject          *Args,
+  COMPRESS_FUNCTION CompressFunction
+  )
+{
+  PyObject      *SrcData;
+  PyObject      *DstData;
+  UINT32        SrcDataSize;
+  UINT32        DstDataSize;
+  UINTN         Status;
+  UINT8         *SrcBuf;
+  UINT8         *DstBuf;
+  UINT8         *TmpBuf;
+  Py_ssize_t    SegNum;
+  Py_ssize_t    Index;
+
+  SrcBuf = NULL;
+  DstBuf = NULL;
+  DstData = NULL;
+
+  Status = PyArg_ParseTuple(
+            Args,
+            "Oi",
+            &SrcData,
+            &SrcDataSize
+            );
+  if (Status == 0) {
+    return NULL;
+  }
+
+  if (SrcData->ob_type->tp_as_buffer == NULL
+      || SrcData->ob_type->tp_as_buffer->bf_getreadbuffer == NULL
+      || SrcData->ob_type->tp_as_buffer->bf_getsegcount == NULL) {
+    PyErr_SetString(PyExc_Exception, "First argument is not a buffer\n");
+    return NULL;
+  }
+
+  // Because some Python objects which support "buffer" protocol have more than one
+  // memory segment, we have to copy them into a contiguous memory.
+  SrcBuf = PyMem_Malloc(SrcDataSize);
+  if (SrcBuf == NULL) {
+    PyErr_SetString(PyExc_Exception, "Not enough memory\n");
+    goto ERROR;
+  }
+
+  SegNum = SrcData->ob_type->tp_as_buffer->bf_getsegcount((PyObject *)SrcData, NULL);
+  TmpBuf = SrcBuf;
+  for (Index = 0; Index < SegNum; ++Index) {
+    VOID *BufSeg;
+    Py_ssize_t Len;
+
+    Len = SrcData->ob_type->tp_as_buffer->bf_getreadbuffer((PyObject *)SrcData, Index, &BufSeg);
+    if (Len < 0) {
+      PyErr_SetString(PyExc_Exception, "Buffer segment is not available\n");
+      goto ERROR;
+    }
+    if (Len > SrcBuf + SrcDataSize - TmpBuf) {
+      PyErr_SetString(PyExc_Exception, "Buffer is larger than the given size\n");
+      goto ERROR;
+    }
+    memcpy(TmpBuf, BufSeg, Len);
+    TmpBuf += Len;
+  }
+
+  // Start with room for incompressible data, which grows by a few bytes per
+  // block; the encoder reports the size needed if that is not enough.
+  DstDataSize = SrcDataSize + SrcDataSize / 8 + 64;
+  Py_BEGIN_ALLOW_THREADS
+  Status = EFI_BUFFER_TOO_SMALL;
+  while (Status == EFI_BUFFER_TOO_SMALL) {
+    free(DstBuf);
+    DstBuf = malloc(DstDataSize);
+    if (DstBuf == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      break;
+    }
+    Status = CompressFunction(SrcBuf, SrcDataSize, DstBuf, &DstDataSize);
+  }
+  Py_END_ALLOW_THREADS
+
+  if (Status != EFI_SUCCESS) {
+    PyErr_SetString(PyExc_Exception, "Failed to compress\n");
+    goto ERROR;
+  }
+
+  DstData = PyString_FromStringAndSize((CONST INT8*)DstBuf, (Py_ssize_t)DstDataSize);
+
+ERROR:
+  if (SrcBuf != NULL) {
+    PyMem_Free(SrcBuf);
+  }
+
+  if (DstBuf != NULL) {
+    free(DstBuf);
+  }
+  return DstData;
+}
+
+/*
+ UefiCompress(data_buffer, size)
+*/
 STATIC
 PyObject*
 UefiCompress(
@@ -179,10 +288,13 @@ UefiCompress(
   PyObject    *Args
   )
 {
-  return NULL;
+  return CompressBuffer(Args, EfiCompress);
 }
 
 
+/*
+ FrameworkCompress(data_buffer, size)
+*/
 STATIC
 PyObject*
 FrameworkCompress(
@@ -190,7 +302,7 @@ FrameworkCompress(
   PyObject    *Args
   )
 {
-  return NULL;
+  return CompressBuffer(Args, TianoCompress);
 }
 
 STATIC INT8 DecompressDocs[] = "Decompress(): Decompress data using UEFI standard algorithm\n";
@@ -198,9 +310,9 @@ STATIC INT8 CompressDocs[] = "Compress(): Compress data using UEFI standard algo
 
 STATIC PyMethodDef EfiCompressor_Funcs[] = {
   {"UefiDecompress", (PyCFunction)UefiDecompress, METH_VARARGS, DecompressDocs},
-  {"UefiCompress", (PyCFunction)UefiCompress, METH_VARARGS, DecompressDocs},
+  {"UefiCompress", (PyCFunction)UefiCompress, METH_VARARGS, CompressDocs},
   {"FrameworkDecompress", (PyCFunction)FrameworkDecompress, METH_VARARGS, DecompressDocs},
-  {"FrameworkCompress", (PyCFunction)FrameworkCompress, METH_VARARGS, DecompressDocs},
+  {"FrameworkCompress", (PyCFunction)FrameworkCompress, METH_VARARGS, CompressDocs},
   {NULL, NULL, 0, NULL}
 };
 
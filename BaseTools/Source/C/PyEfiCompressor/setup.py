@@ -30,6 +30,7 @@ setup(
             'EfiCompressor',
             sources=[
                 os.path.join(BaseToolsDir, 'Source', 'C', 'Common', 'Decompress.c'),
+                os.path.join(BaseToolsDir, 'Source', 'C', 'Common', 'Compress.c'),
                 'EfiCompressor.c'
                 ],
             include_dirs=[
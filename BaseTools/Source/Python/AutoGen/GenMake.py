@@ -1457,6 +1457,15 @@ class TopLevelMakefile(BuildFile):
         if GlobalData.gIgnoreSource:
             ExtraOption += " --ignore-sources"
 
+        if GlobalData.gThreadNumber > 1:
+            ExtraOption += " -n %d" % GlobalData.gThreadNumber
+
+        if not GlobalData.gFfsCache:
+            ExtraOption += " --ffs-cache-size 0"
+
+        if GlobalData.gIncrementalFv:
+            ExtraOption += " --incremental-fv"
+
         if GlobalData.BuildOptionPcd:
             for index, option in enumerate(GlobalData.gCommand):
                 if "--pcd" == option and GlobalData.gCommand[index+1]:
@@ -0,0 +1,300 @@
+## @file
+# Python binding of the libBaseTools shared library
+#
+# libBaseTools is built from BaseTools/Source/C/Common together with the C
+# tools.  It creates sections and FFS files from data in memory with the
+# same routines as GenSec and GenFfs, so GenFds can call them in-process
+# and get the same output as from the tools.
+#
+# Copyright (c) 2026 Baikal Electronics JSC
+# This program and the accompanying materials
+# are licensed and made available under the terms and conditions of the BSD License
+# which accompanies this distribution.  The full text of the license may be found at
+# http://opensource.org/licenses/bsd-license.php
+#
+# THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+# WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import os
+import sys
+import uuid
+import ctypes
+
+## Section types accepted by the -s option of GenSec
+gSectionType = {
+    'EFI_SECTION_COMPRESSION'           : 0x01,
+    'EFI_SECTION_GUID_DEFINED'          : 0x02,
+    'EFI_SECTION_PE32'                  : 0x10,
+    'EFI_SECTION_PIC'                   : 0x11,
+    'EFI_SECTION_TE'                    : 0x12,
+    'EFI_SECTION_DXE_DEPEX'             : 0x13,
+    'EFI_SECTION_USER_INTERFACE'        : 0x15,
+    'EFI_SECTION_COMPATIBILITY16'       : 0x16,
+    'EFI_SECTION_FIRMWARE_VOLUME_IMAGE' : 0x17,
+    'EFI_SECTION_FREEFORM_SUBTYPE_GUID' : 0x18,
+    'EFI_SECTION_RAW'                   : 0x19,
+    'EFI_SECTION_PEI_DEPEX'             : 0x1B,
+    'EFI_SECTION_SMM_DEPEX'             : 0x1C
+}
+
+## File types accepted by the -t option of GenFfs
+gFileType = {
+    'EFI_FV_FILETYPE_RAW'                   : 0x01,
+    'EFI_FV_FILETYPE_FREEFORM'              : 0x02,
+    'EFI_FV_FILETYPE_SECURITY_CORE'         : 0x03,
+    'EFI_FV_FILETYPE_PEI_CORE'              : 0x04,
+    'EFI_FV_FILETYPE_DXE_CORE'              : 0x05,
+    'EFI_FV_FILETYPE_PEIM'                  : 0x06,
+    'EFI_FV_FILETYPE_DRIVER'                : 0x07,
+    'EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER'  : 0x08,
+    'EFI_FV_FILETYPE_APPLICATION'           : 0x09,
+    'EFI_FV_FILETYPE_SMM'                   : 0x0A,
+    'EFI_FV_FILETYPE_FIRMWARE_VOLUME_IMAGE' : 0x0B,
+    'EFI_FV_FILETYPE_COMBINED_SMM_DXE'      : 0x0C,
+    'EFI_FV_FILETYPE_SMM_CORE'              : 0x0D,
+    'EFI_FV_FILETYPE_MM_STANDALONE'         : 0x0E,
+    'EFI_FV_FILETYPE_MM_CORE_STANDALONE'    : 0x0F
+}
+
+gCompressionType = {'PI_NONE' : 0, 'PI_STD' : 1}
+gGuidAttribute = {'NONE' : 0, 'PROCESSING_REQUIRED' : 1, 'AUTH_STATUS_VALID' : 2}
+
+## Section alignments accepted by GenSec and GenFfs, 1 << index
+gAlignName = ['1', '2', '4', '8', '16', '32', '64', '128', '256', '512',
+              '1K', '2K', '4K', '8K', '16K', '32K', '64K', '128K', '256K',
+              '512K', '1M', '2M', '4M', '8M', '16M']
+
+## FFS file alignments accepted by the -a option of GenFfs
+gFfsAlignName = ['8', '16', '128', '512', '1K', '4K', '32K', '64K', '128K', '256K',
+                 '512K', '1M', '2M', '4M', '8M', '16M']
+
+FFS_ATTRIB_FIXED    = 0x04
+FFS_ATTRIB_CHECKSUM = 0x40
+
+## ERROR_LOG_LEVLE of EfiUtilityMsgs.h
+ERROR_LOG_LEVEL     = 50
+
+class SECTION_INPUT(ctypes.Structure):
+    _fields_ = [('Data', ctypes.c_char_p),
+                ('Size', ctypes.c_uint32),
+                ('Alignment', ctypes.c_uint32)]
+
+## Returned by the binding if an option is not understood
+class BaseToolsLibError(Exception):
+    pass
+
+## The loaded library of this process, False if it has not been looked for
+gLibrary = False
+
+## GetLibraryName()
+#
+#   @retval     The file name of the library on this host, or None
+#
+def GetLibraryName():
+    if sys.platform.startswith('linux'):
+        return 'libBaseTools.so'
+    if sys.platform == 'darwin':
+        return 'libBaseTools.dylib'
+    return None
+
+## GetGenSecPath()
+#
+#   Find the GenSec program that GenFds runs.  The script of
+#   BinWrappers/PosixLike is followed to the binary it executes.
+#
+#   @retval     The path of the GenSec binary, or None if it is not found
+#
+def GetGenSecPath():
+    Path = None
+    for Dir in os.environ.get('PATH', '').split(os.pathsep):
+        if Dir and os.path.isfile(os.path.join(Dir, 'GenSec')):
+            Path = os.path.join(Dir, 'GenSec')
+            break
+    if Path == None:
+        return None
+
+    WrapperDir = os.path.dirname(os.path.abspath(Path))
+    if os.path.basename(WrapperDir) == 'PosixLike' and \
+       os.path.basename(os.path.dirname(WrapperDir)) == 'BinWrappers':
+        Workspace = os.environ.get('WORKSPACE', '')
+        ToolsPath = os.environ.get('EDK_TOOLS_PATH', '')
+        if Workspace and os.path.exists(os.path.join(Workspace, 'Conf', 'BaseToolsCBinaries')):
+            Path = os.path.join(Workspace, 'Conf', 'BaseToolsCBinaries', 'GenSec')
+        elif Workspace and ToolsPath and os.path.exists(os.path.join(ToolsPath, 'Source', 'C')):
+            Path = os.path.join(ToolsPath, 'Source', 'C', 'bin', 'GenSec')
+        else:
+            Path = os.path.join(WrapperDir, '..', '..', 'Source', 'C', 'bin', 'GenSec')
+        if not os.path.isfile(Path):
+            return None
+    return os.path.realpath(Path)
+
+## GetBaseToolsLib()
+#
+#   Load libBaseTools from the directory of the GenSec binary, so that the
+#   library always matches the tools GenFds falls back to.
+#
+#   @retval     The BaseToolsLib object, or None if the library is not found
+#
+def GetBaseToolsLib():
+    global gLibrary
+    if gLibrary != False:
+        return gLibrary
+
+    gLibrary = None
+    Name = GetLibraryName()
+    if Name == None:
+        return None
+    GenSec = GetGenSecPath()
+    if GenSec == None:
+        return None
+    Path = os.path.join(os.path.dirname(GenSec), Name)
+    if os.path.isfile(Path):
+        try:
+            gLibrary = BaseToolsLib(Path)
+        except (OSError, AttributeError):
+            pass
+    return gLibrary
+
+## Convert a GenSec/GenFfs alignment string into the alignment
+def AlignmentValue(Align):
+    if Align.upper() not in gAlignName:
+        raise BaseToolsLibError('invalid alignment %s' % Align)
+    return 1 << gAlignName.index(Align.upper())
+
+## Convert a GUID in registry format into an EFI_GUID buffer
+def GuidBuffer(Guid):
+    try:
+        return ctypes.create_string_buffer(uuid.UUID(Guid).bytes_le, 16)
+    except ValueError:
+        raise BaseToolsLibError('invalid GUID %s' % Guid)
+
+## Convert a number in the format of AsciiStringToUint64() of BaseTools/Source/C/Common
+def IntegerValue(Value):
+    try:
+        if Value.lower().startswith('0x'):
+            return int(Value, 16)
+        return int(Value, 10)
+    except ValueError:
+        raise BaseToolsLibError('invalid number %s' % Value)
+
+class BaseToolsLib(object):
+    def __init__(self, Path):
+        self.Path = Path
+        self._Lib = ctypes.CDLL(Path)
+        Status = ctypes.c_size_t
+        Input = ctypes.POINTER(SECTION_INPUT)
+        Output = [ctypes.POINTER(ctypes.POINTER(ctypes.c_uint8)), ctypes.POINTER(ctypes.c_uint32)]
+        self._Lib.GenSectionCommonLeafSection.argtypes = [Input, ctypes.c_uint32, ctypes.c_uint8] + Output
+        self._Lib.GenSectionAllSection.argtypes = [Input, ctypes.c_uint32] + Output
+        self._Lib.GenSectionCompressionSection.argtypes = [Input, ctypes.c_uint32, ctypes.c_uint8] + Output
+        self._Lib.GenSectionGuidDefinedSection.argtypes = [Input, ctypes.c_uint32, ctypes.c_char_p, ctypes.c_uint16, ctypes.c_uint32] + Output
+        self._Lib.GenFfsFile.argtypes = [Input, ctypes.c_uint32, ctypes.c_uint8, ctypes.c_char_p, ctypes.c_uint8, ctypes.c_uint32] + Output
+        self._Lib.FreeSectionBuffer.argtypes = [ctypes.c_void_p]
+        self._Lib.FreeSectionBuffer.restype = None
+        for Function in ('GenSectionCommonLeafSection', 'GenSectionAllSection', 'GenSectionCompressionSection',
+                         'GenSectionGuidDefinedSection', 'GenFfsFile'):
+            getattr(self._Lib, Function).restype = Status
+        #
+        # A call that fails is repeated with GenSec or GenFfs, which prints the
+        # error.  Keep the library from printing it a first time.
+        #
+        self._Lib.SetPrintLevel.argtypes = [ctypes.c_uint64]
+        self._Lib.SetPrintLevel.restype = None
+        self._Lib.SetPrintLevel(ERROR_LOG_LEVEL + 1)
+
+    ## Call a routine returning a buffer, and return the buffer as a string, or None if it fails
+    def _Call(self, Function, *Args):
+        Buffer = ctypes.POINTER(ctypes.c_uint8)()
+        Length = ctypes.c_uint32(0)
+        Status = Function(*(Args + (ctypes.byref(Buffer), ctypes.byref(Length))))
+        if Status != 0:
+            return None
+        Data = ctypes.string_at(Buffer, Length.value)
+        self._Lib.FreeSectionBuffer(Buffer)
+        return Data
+
+    ## Make the SECTION_INPUT array of the contents and alignments of the inputs
+    @staticmethod
+    def _Inputs(DataList, AlignList):
+        Inputs = (SECTION_INPUT * max(len(DataList), 1))()
+        for Index in range(len(DataList)):
+            Inputs[Index].Data = DataList[Index]
+            Inputs[Index].Size = len(DataList[Index])
+            if AlignList:
+                Inputs[Index].Alignment = AlignList[Index]
+        return Inputs
+
+    ## GenerateSection()
+    #
+    #   Do what GenSec does for the options of GenFdsGlobalVariable.GenerateSection().
+    #   Version and user interface sections are not supported.
+    #
+    #   @param  DataList    The contents of the input files
+    #   @retval             The section, or None if it cannot be created
+    #
+    def GenerateSection(self, DataList, Type=None, CompressionType=None, Guid=None,
+                        GuidHdrLen=None, GuidAttr=[], InputAlign=None):
+        AlignList = None
+        if InputAlign != None:
+            if len(InputAlign) != len(DataList):
+                raise BaseToolsLibError('section alignment must be set for each section')
+            AlignList = [AlignmentValue(Align) for Align in InputAlign]
+        Inputs = self._Inputs(DataList, AlignList)
+        if Type in [None, '']:
+            return self._Call(self._Lib.GenSectionAllSection, Inputs, len(DataList))
+        if Type == 'EFI_SECTION_COMPRESSION':
+            if CompressionType in [None, '']:
+                CompressionType = 'PI_STD'
+            if CompressionType not in gCompressionType:
+                raise BaseToolsLibError('invalid compression type %s' % CompressionType)
+            return self._Call(self._Lib.GenSectionCompressionSection, Inputs, len(DataList), gCompressionType[CompressionType])
+        if Type == 'EFI_SECTION_GUID_DEFINED':
+            Attributes = 0
+            for Attr in GuidAttr:
+                if Attr not in gGuidAttribute:
+                    raise BaseToolsLibError('invalid GUIDed section attribute %s' % Attr)
+                Attributes |= gGuidAttribute[Attr]
+            HeaderLength = 0
+            if GuidHdrLen not in [None, '']:
+                HeaderLength = IntegerValue(GuidHdrLen)
+            return self._Call(self._Lib.GenSectionGuidDefinedSection, Inputs, len(DataList),
+                              GuidBuffer(Guid if Guid != None else str(uuid.UUID(int=0))), Attributes, HeaderLength)
+        if Type not in gSectionType or Type == 'EFI_SECTION_USER_INTERFACE':
+            raise BaseToolsLibError('unsupported section type %s' % Type)
+        return self._Call(self._Lib.GenSectionCommonLeafSection, Inputs, len(DataList), gSectionType[Type])
+
+    ## GenerateFfs()
+    #
+    #   Do what GenFfs does for the options of GenFdsGlobalVariable.GenerateFfs().
+    #
+    #   @param  DataList    The contents of the input section files
+    #   @retval             The FFS file, or None if it cannot be created
+    #
+    def GenerateFfs(self, DataList, Type, Guid, Fixed=False, CheckSum=False, Align=None, SectionAlign=None):
+        if Type not in gFileType:
+            raise BaseToolsLibError('invalid file type %s' % Type)
+        if len(DataList) == 0:
+            raise BaseToolsLibError('no input section')
+        Attributes = 0
+        if Fixed:
+            Attributes |= FFS_ATTRIB_FIXED
+        if CheckSum:
+            Attributes |= FFS_ATTRIB_CHECKSUM
+        FfsAlign = 0
+        if Align not in [None, '', '1', '2', '4']:
+            if Align.upper() not in gFfsAlignName:
+                raise BaseToolsLibError('invalid FFS alignment %s' % Align)
+            FfsAlign = gFfsAlignName.index(Align.upper())
+        AlignList = []
+        for Index in range(len(DataList)):
+            if SectionAlign not in [None, '', []] and SectionAlign[Index] not in [None, '']:
+                AlignList.append(AlignmentValue(SectionAlign[Index]))
+            else:
+                AlignList.append(1)
+        Inputs = self._Inputs(DataList, AlignList)
+        return self._Call(self._Lib.GenFfsFile, Inputs, len(DataList), gFileType[Type],
+                          GuidBuffer(Guid), Attributes, FfsAlign)
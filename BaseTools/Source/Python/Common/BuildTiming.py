@@ -0,0 +1,161 @@
+## @file
+# This file is used to record the time spent in the steps of a build, and to
+# save it as a Chrome trace which can be loaded by chrome://tracing.
+#
+# Copyright (c) 2026 Baikal Electronics JSC
+# This program and the accompanying materials
+# are licensed and made available under the terms and conditions of the BSD License
+# which accompanies this distribution.  The full text of the license may be found at
+# http://opensource.org/licenses/bsd-license.php
+#
+# THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+# WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import Common.LongFilePathOs as os
+import json
+import threading
+from Common.LongFilePathSupport import OpenLongFilePath as open
+
+## Categories of the timing events
+TIMING_AUTOGEN = "AutoGen"
+TIMING_MAKE = "Make"
+TIMING_GENFDS = "GenFds"
+TIMING_FFS = "FFS"
+TIMING_FV = "FV"
+
+## The timing events recorded by this process
+gTimingEvents = []
+gTimingLock = threading.Lock()
+
+## Record one timing event
+#
+#   @param  Category        One of the TIMING_* categories
+#   @param  Name            Name of the module, FFS file or step
+#   @param  Start           Start time returned by time.time()
+#   @param  End             End time returned by time.time()
+#   @param  Track           Thread or process which ran the step, optional
+#   @param  Dependencies    Names of the events of the same category which
+#                           had to finish before this one could start
+#
+def AddTimingEvent(Category, Name, Start, End, Track=None, Dependencies=None):
+    Event = {
+        "Category"      : Category,
+        "Name"          : str(Name),
+        "Start"         : Start,
+        "End"           : End,
+        "Track"         : None if Track is None else str(Track),
+        "Dependencies"  : [str(Item) for Item in (Dependencies or [])]
+    }
+    with gTimingLock:
+        gTimingEvents.append(Event)
+    return Event
+
+## Add the events recorded by another process
+def AddTimingEvents(Events):
+    with gTimingLock:
+        gTimingEvents.extend(Events)
+
+## Return a copy of the recorded timing events
+def GetTimingEvents():
+    with gTimingLock:
+        return list(gTimingEvents)
+
+## Save timing events to a file, which is how GenFds passes them to build
+def SaveTimingEvents(FilePath, Events):
+    Dir = os.path.dirname(FilePath)
+    if Dir and not os.path.exists(Dir):
+        os.makedirs(Dir)
+    with open(FilePath, 'w') as File:
+        json.dump(Events, File)
+
+## Load timing events from a file, or return an empty list if it cannot be read
+def LoadTimingEvents(FilePath):
+    try:
+        with open(FilePath, 'r') as File:
+            Events = json.load(File)
+    except:
+        return []
+    if not isinstance(Events, list):
+        return []
+    return Events
+
+## Return the total seconds of the events of a category, by name
+def GetTimingTotals(Events, Category):
+    Totals = {}
+    for Event in Events:
+        if Event["Category"] == Category:
+            Totals[Event["Name"]] = Totals.get(Event["Name"], 0.0) + Event["End"] - Event["Start"]
+    return Totals
+
+## Return the chain of dependent events of a category that takes the longest time
+#
+# The chain ends at the event finishing last.  Each event in it is preceded by
+# the dependency which finished last, which is the one that kept it waiting.
+#
+#   @retval list    The events in the chain, the first one first
+#
+def GetCriticalPath(Events, Category=TIMING_MAKE):
+    EventDict = {}
+    for Event in Events:
+        if Event["Category"] == Category:
+            EventDict[Event["Name"]] = Event
+    if not EventDict:
+        return []
+    Path = []
+    Event = max(EventDict.values(), key=lambda Item: Item["End"])
+    while Event is not None and Event not in Path:
+        Path.insert(0, Event)
+        Previous = [EventDict[Name] for Name in Event["Dependencies"] if Name in EventDict]
+        Event = max(Previous, key=lambda Item: Item["End"]) if Previous else None
+    return Path
+
+## Assign each event to a lane, so that the events in a lane do not overlap
+#
+# Events which give their own track are put in the lane of that track.
+#
+#   @retval dict    Lane name of each event, indexed by the position in Events
+#
+def AssignTimingLanes(Events):
+    Lanes = {}
+    LaneEnd = {}
+    Order = sorted(range(len(Events)), key=lambda Index: Events[Index]["Start"])
+    for Index in Order:
+        Event = Events[Index]
+        if Event.get("Track"):
+            Lanes[Index] = "%s %s" % (Event["Category"], Event["Track"])
+            continue
+        Lane = 0
+        while LaneEnd.get((Event["Category"], Lane), Event["Start"]) > Event["Start"]:
+            Lane += 1
+        LaneEnd[(Event["Category"], Lane)] = Event["End"]
+        Lanes[Index] = "%s #%d" % (Event["Category"], Lane)
+    return Lanes
+
+## Save timing events in the Chrome trace event format
+def SaveChromeTrace(FilePath, Events):
+    TraceEvents = []
+    if Events:
+        BeginTime = min(Event["Start"] for Event in Events)
+        Lanes = AssignTimingLanes(Events)
+        LaneId = {}
+        for Lane in sorted(set(Lanes.values())):
+            LaneId[Lane] = len(LaneId) + 1
+            TraceEvents.append({"name" : "thread_name", "ph" : "M", "pid" : 1, "tid" : LaneId[Lane],
+                                "args" : {"name" : Lane}})
+        for Index in range(len(Events)):
+            Event = Events[Index]
+            TraceEvents.append({
+                "name"  : Event["Name"],
+                "cat"   : Event["Category"],
+                "ph"    : "X",
+                "ts"    : int(round((Event["Start"] - BeginTime) * 1000000)),
+                "dur"   : int(round((Event["End"] - Event["Start"]) * 1000000)),
+                "pid"   : 1,
+                "tid"   : LaneId[Lanes[Index]]
+            })
+    with open(FilePath, 'w') as File:
+        json.dump({"traceEvents" : TraceEvents, "displayTimeUnit" : "ms"}, File)
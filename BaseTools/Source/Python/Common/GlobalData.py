@@ -66,6 +66,37 @@ gDatabasePath = ".cache/build.db"
 #
 gIgnoreSource = False
 
+#
+# Number of build threads, also passed to GenFds
+#
+gThreadNumber = 1
+
+#
+# Whether GenFds caches the outputs of its tools, cleared by the -N option of build
+#
+gFfsCache = True
+
+#
+# Whether GenFv reuses the previous FV image and only adds changed FFS files,
+# set by the --incremental-fv option of build
+#
+gIncrementalFv = False
+
+#
+# The FFS cache statistics file written by GenFds, relative to the build directory
+#
+gFfsCacheStatistics = "FfsCache/Statistics.txt"
+
+#
+# The FV and FFS timing events written by GenFds, relative to the build directory
+#
+gGenFdsTiming = "GenFdsTiming.json"
+
+#
+# Whether the build records the timing of each step for the TIMING report
+#
+gBuildTiming = False
+
 #
 # FDF parser
 #
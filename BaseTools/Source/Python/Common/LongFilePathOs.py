@@ -60,6 +60,7 @@ def listdir(path):
 
 environ = os.environ
 getcwd = os.getcwd
+getpid = os.getpid
 chdir = os.chdir
 walk = os.walk
 W_OK = os.W_OK
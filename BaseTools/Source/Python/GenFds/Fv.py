@@ -18,6 +18,10 @@
 import Common.LongFilePathOs as os
 import subprocess
 import StringIO
+import sys
+import time
+import traceback
+import multiprocessing
 from struct import *
 
 import Ffs
@@ -25,13 +29,65 @@ import AprioriSection
 from GenFdsGlobalVariable import GenFdsGlobalVariable
 from GenFds import GenFds
 from CommonDataClass.FdfClass import FvClassObject
+from CommonDataClass.FdfClass import FfsInfStatementClassObject
+from Common import EdkLogger
+from Common import GlobalData
 from Common.Misc import SaveFileOnChange
+from Common.BuildTiming import AddTimingEvent
+from Common.BuildTiming import AddTimingEvents
+from Common.BuildTiming import TIMING_FFS
+from Common.BuildTiming import TIMING_FV
 from Common.LongFilePathSupport import CopyLongFilePath
 from Common.LongFilePathSupport import OpenLongFilePath as open
 
 T_CHAR_LF = '\n'
 FV_UI_EXT_ENTY_GUID = 'A67DF1FA-8DE8-4E98-AF09-4BDF2EFFBC7C'
 
+## Modules whose FFS files are generated by the worker processes
+gFfsWorkList = []
+
+## Prepare a worker process generating FFS files
+#
+#   The worker inherits the workspace database from GenFds. It reads it through
+#   a read-only connection of its own.
+#
+def FfsWorkerInit():
+    GenFdsGlobalVariable.ThreadNumber = 1
+    GenFdsGlobalVariable.WorkSpace.OpenReadOnlyConnection(GlobalData.gDatabasePath)
+    if not GenFdsGlobalVariable.VerboseMode and GenFdsGlobalVariable.DebugLevel == -1:
+        EdkLogger.SetLevel(EdkLogger.SILENT)
+
+## Generate the FFS file of one module in a worker process
+#
+#   Errors are only logged in verbose mode here. The FFS file is generated again
+#   by GenFds which reports the error.
+#
+#   @param  Args    (Index of the module in gFfsWorkList, MacroDict, FvParentAddr)
+#   @retval tuple   (FFS cache hits, FFS cache misses, timing events) of this module
+#
+def FfsWorker(Args):
+    Index, MacroDict, FvParentAddr = Args
+    CacheHit = GenFdsGlobalVariable.FfsCacheHit
+    CacheMiss = GenFdsGlobalVariable.FfsCacheMiss
+    Events = []
+    StartTime = time.time()
+    try:
+        gFfsWorkList[Index].GenFfs(MacroDict, FvParentAddr=FvParentAddr)
+    except Exception:
+        EdkLogger.verbose("%s falls back to GenFds:\n%s" % (GetFfsTimingName(gFfsWorkList[Index]), traceback.format_exc()))
+    if GenFdsGlobalVariable.Timing:
+        Events.append(AddTimingEvent(TIMING_FFS, GetFfsTimingName(gFfsWorkList[Index]), StartTime, time.time(),
+                                     "process %d" % os.getpid()))
+    return GenFdsGlobalVariable.FfsCacheHit - CacheHit, GenFdsGlobalVariable.FfsCacheMiss - CacheMiss, Events
+
+## Return the name of an FFS statement in the timing events
+def GetFfsTimingName(FfsFile):
+    if isinstance(FfsFile, FfsInfStatementClassObject):
+        return FfsFile.InfFileName
+    if getattr(FfsFile, 'NameGuid', None):
+        return FfsFile.NameGuid
+    return FfsFile.__class__.__name__
+
 ## generate FV
 #
 #
@@ -90,6 +146,7 @@ class FV (FvClassObject):
                                 GenFdsGlobalVariable.ErrorLogger("Capsule %s in FD region can't contain a FV %s in FD region." % (self.CapsuleName, self.UiFvName.upper()))
 
         GenFdsGlobalVariable.InfLogger( "\nGenerating %s FV" %self.UiFvName)
+        FvStartTime = time.time()
         GenFdsGlobalVariable.LargeFileInFvFlags.append(False)
         FFSGuid = None
         
@@ -113,8 +170,12 @@ class FV (FvClassObject):
                                            T_CHAR_LF)
 
         # Process Modules in FfsList
+        self.__GenModuleFfsInParallel__(MacroDict, BaseAddress)
         for FfsFile in self.FfsList :
+            FfsStartTime = time.time()
             FileName = FfsFile.GenFfs(MacroDict, FvParentAddr=BaseAddress)
+            if GenFdsGlobalVariable.Timing:
+                AddTimingEvent(TIMING_FFS, GetFfsTimingName(FfsFile), FfsStartTime, time.time(), "GenFds")
             FfsFileList.append(FileName)
             self.FvInfFile.writelines("EFI_FILE_NAME = " + \
                                        FileName          + \
@@ -211,6 +272,8 @@ class FV (FvClassObject):
             FvFileObj.close()
             GenFds.ImageBinDict[self.UiFvName.upper() + 'fv'] = FvOutputFile
             GenFdsGlobalVariable.LargeFileInFvFlags.pop()
+            if GenFdsGlobalVariable.Timing:
+                AddTimingEvent(TIMING_FV, self.UiFvName, FvStartTime, time.time(), "GenFds")
         else:
             GenFdsGlobalVariable.ErrorLogger("Failed to generate %s FV file." %self.UiFvName)
         return FvOutputFile
@@ -239,6 +302,67 @@ class FV (FvClassObject):
                             return True
         return False
 
+    ## __GenModuleFfsInParallel__()
+    #
+    #   Generate the FFS files of the modules in this FV in worker processes.
+    #   AddToBuffer() then generates them again in FfsList order. That pass
+    #   finds the files up to date and skips the tools, so the FV is the same
+    #   as one generated by a single process.
+    #
+    #   @param  self        The object pointer
+    #   @param  MacroDict   macro value pair
+    #   @param  BaseAddress base address of FV
+    #
+    def __GenModuleFfsInParallel__(self, MacroDict, BaseAddress):
+        global gFfsWorkList
+        #
+        # Worker processes are forked to inherit the parsed FDF and workspace
+        #
+        if GenFdsGlobalVariable.ThreadNumber <= 1 or sys.platform == "win32":
+            return
+
+        InfFileNameSet = set()
+        WorkList = []
+        for FfsFile in self.FfsList:
+            if not isinstance(FfsFile, FfsInfStatementClassObject):
+                continue
+            #
+            # The same module may be listed more than once with different GUIDs.
+            # Only the first one is generated in parallel as they share files.
+            #
+            if FfsFile.InfFileName in InfFileNameSet:
+                continue
+            InfFileNameSet.add(FfsFile.InfFileName)
+            WorkList.append(FfsFile)
+        if len(WorkList) <= 1:
+            return
+
+        #
+        # Parse the INF files here so that the workers find them in the
+        # workspace database and do not need to write it.
+        #
+        for FfsFile in WorkList:
+            FfsFile.__InfParse__(MacroDict)
+        #
+        # The platform is kept in temporary tables the workers cannot see, so
+        # read the build options the GUIDed sections look for here.
+        #
+        for Arch in GenFdsGlobalVariable.ArchList:
+            GenFdsGlobalVariable.WorkSpace.BuildObject[GenFdsGlobalVariable.ActivePlatform, Arch, GenFdsGlobalVariable.TargetName, GenFdsGlobalVariable.ToolChainTag].BuildOptions
+        GenFdsGlobalVariable.WorkSpace.Conn.commit()
+        sys.stdout.flush()
+        gFfsWorkList = WorkList
+        Pool = multiprocessing.Pool(min(GenFdsGlobalVariable.ThreadNumber, len(WorkList)), FfsWorkerInit)
+        try:
+            for CacheHit, CacheMiss, Events in Pool.map(FfsWorker, [(Index, MacroDict, BaseAddress) for Index in range(len(WorkList))], 1):
+                GenFdsGlobalVariable.FfsCacheHit += CacheHit
+                GenFdsGlobalVariable.FfsCacheMiss += CacheMiss
+                AddTimingEvents(Events)
+        finally:
+            Pool.close()
+            Pool.join()
+            gFfsWorkList = []
+
     ## __InitializeInf__()
     #
     #   Initilize the inf file to create FV
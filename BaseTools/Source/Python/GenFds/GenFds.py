@@ -41,6 +41,8 @@ from Common.Misc import GuidStructureStringToGuidString
 from Common.Misc import CheckPcdDatum
 from Common.Misc import BuildOptionPcdValueFormat
 from Common.BuildVersion import gBUILD_VERSION
+from Common.BuildTiming import GetTimingEvents
+from Common.BuildTiming import SaveTimingEvents
 from Common.MultipleWorkspace import MultipleWorkspace as mws
 
 ## Version and Copyright
@@ -74,6 +76,21 @@ def main():
             
         if Options.FixedAddress != None:
             GenFdsGlobalVariable.FixedLoadAddress = True
+
+        if Options.ThreadNumber != None:
+            if Options.ThreadNumber < 1:
+                EdkLogger.error("GenFds", OPTION_VALUE_INVALID, "Invalid thread number: %d" % Options.ThreadNumber)
+            GenFdsGlobalVariable.ThreadNumber = Options.ThreadNumber
+        if Options.ExternalTools:
+            GenFdsGlobalVariable.UseToolLibrary = False
+        if Options.Timing:
+            GenFdsGlobalVariable.Timing = True
+        if Options.IncrementalFv:
+            GenFdsGlobalVariable.IncrementalFv = True
+        if Options.FfsCacheSize != None:
+            if Options.FfsCacheSize < 0:
+                EdkLogger.error("GenFds", OPTION_VALUE_INVALID, "Invalid FFS cache size: %d" % Options.FfsCacheSize)
+            GenFdsGlobalVariable.FfsCacheLimit = Options.FfsCacheSize * 1024 * 1024
             
         if Options.quiet != None:
             EdkLogger.SetLevel(EdkLogger.QUIET)
@@ -332,6 +349,15 @@ def main():
         """Display FV space info."""
         GenFds.DisplayFvSpaceInfo(FdfParserObj)
 
+        """Record FFS cache statistics for the build report."""
+        GenFds.SaveFfsCacheStatistics()
+
+        """Record FV and FFS timing for the build report."""
+        GenFds.SaveTiming()
+
+        """Keep the FFS cache within its size limit."""
+        GenFds.TrimFfsCache()
+
     except FdfParser.Warning, X:
         EdkLogger.error(X.ToolName, FORMAT_INVALID, File=X.FileName, Line=X.LineNumber, ExtraData=X.Message, RaiseError=False)
         ReturnCode = FORMAT_INVALID
@@ -535,6 +561,15 @@ def myOptionParser():
     Parser.add_option("--conf", action="store", type="string", dest="ConfDirectory", help="Specify the customized Conf directory.")
     Parser.add_option("--ignore-sources", action="store_true", dest="IgnoreSources", default=False, help="Focus to a binary build and ignore all source files")
     Parser.add_option("--pcd", action="append", dest="OptionPcd", help="Set PCD value by command line. Format: \"PcdName=Value\" ")
+    Parser.add_option("-n", action="store", type="int", dest="ThreadNumber", help="Number of processes generating the FFS files of modules in one FV.")
+    Parser.add_option("--external-tools", action="store_true", dest="ExternalTools", default=False,
+                      help="Call GenSec and GenFfs even if the libBaseTools library is found.")
+    Parser.add_option("--timing", action="store_true", dest="Timing", default=False,
+                      help="Record the time spent in each FV and FFS file for the TIMING build report.")
+    Parser.add_option("--ffs-cache-size", action="store", type="int", dest="FfsCacheSize",
+                      help="Size limit of the FFS cache in MB, 512 by default. 0 disables the cache.")
+    Parser.add_option("--incremental-fv", action="store_true", dest="IncrementalFv", default=False,
+                      help="Let GenFv reuse the previous FV images and only add the FFS files that changed.")
 
     (Options, args) = Parser.parse_args()
     return Options
@@ -751,12 +786,84 @@ class GenFds :
             os.remove(GuidXRefFileName)
         GuidXRefFile.close()
 
+    ## SaveFfsCacheStatistics()
+    #
+    #   Save the FFS cache hits and misses of this run for the build report
+    #
+    def SaveFfsCacheStatistics():
+        StatisticsFile = os.path.join(os.path.dirname(GenFdsGlobalVariable.FvDir), GlobalData.gFfsCacheStatistics)
+        if not GenFdsGlobalVariable.FfsCacheDir:
+            #
+            # Do not report the statistics of an earlier run
+            #
+            if os.path.isfile(StatisticsFile):
+                os.remove(StatisticsFile)
+            return
+        GenFdsGlobalVariable.VerboseLogger("\nFFS cache: %d hits, %d misses" % (GenFdsGlobalVariable.FfsCacheHit, GenFdsGlobalVariable.FfsCacheMiss))
+        if not os.path.exists(os.path.dirname(StatisticsFile)):
+            os.makedirs(os.path.dirname(StatisticsFile))
+        SaveFileOnChange(StatisticsFile, "HIT = %d\nMISS = %d\n" % (GenFdsGlobalVariable.FfsCacheHit, GenFdsGlobalVariable.FfsCacheMiss), False)
+
+    ## SaveTiming()
+    #
+    #   Save the FV and FFS timing events of this run for the build report
+    #
+    def SaveTiming():
+        if not GenFdsGlobalVariable.Timing:
+            return
+        #
+        # build looks for the file next to the FV directory, see LaunchGenFds()
+        #
+        TimingFile = os.path.join(os.path.dirname(GenFdsGlobalVariable.FvDir), GlobalData.gGenFdsTiming)
+        SaveTimingEvents(TimingFile, GetTimingEvents())
+
+    ## TrimFfsCache()
+    #
+    #   Remove the least recently used entries of the FFS cache until it is
+    #   not larger than its size limit
+    #
+    def TrimFfsCache():
+        CacheDir = GenFdsGlobalVariable.FfsCacheDir
+        if not CacheDir or not os.path.isdir(CacheDir):
+            return
+        EntryList = []
+        CacheSize = 0
+        for Root, Dirs, Files in os.walk(CacheDir):
+            #
+            # Entries are in sub-directories; Statistics.txt is in the top one
+            #
+            if Root == CacheDir:
+                continue
+            for File in Files:
+                Path = os.path.join(Root, File)
+                try:
+                    Stat = os.stat(Path)
+                except OSError:
+                    continue
+                EntryList.append((Stat.st_mtime, Stat.st_size, Path))
+                CacheSize += Stat.st_size
+        if CacheSize <= GenFdsGlobalVariable.FfsCacheLimit:
+            return
+        EntryList.sort()
+        for MTime, Size, Path in EntryList:
+            if CacheSize <= GenFdsGlobalVariable.FfsCacheLimit:
+                break
+            try:
+                os.remove(Path)
+            except OSError:
+                continue
+            CacheSize -= Size
+        GenFdsGlobalVariable.VerboseLogger("FFS cache trimmed to %d bytes" % CacheSize)
+
     ##Define GenFd as static function
     GenFd = staticmethod(GenFd)
     GetFvBlockSize = staticmethod(GetFvBlockSize)
     DisplayFvSpaceInfo = staticmethod(DisplayFvSpaceInfo)
     PreprocessImage = staticmethod(PreprocessImage)
     GenerateGuidXRefFile = staticmethod(GenerateGuidXRefFile)
+    SaveFfsCacheStatistics = staticmethod(SaveFfsCacheStatistics)
+    SaveTiming = staticmethod(SaveTiming)
+    TrimFfsCache = staticmethod(TrimFfsCache)
 
 if __name__ == '__main__':
     r = main()
@@ -20,6 +20,7 @@ import sys
 import subprocess
 import struct
 import array
+import hashlib
 
 from Common.BuildToolError import *
 from Common import EdkLogger
@@ -31,7 +32,10 @@ from AutoGen.BuildEngine import BuildRule
 import Common.DataType as DataType
 from Common.Misc import PathClass
 from Common.LongFilePathSupport import OpenLongFilePath as open
+from Common.LongFilePathSupport import CopyLongFilePath
 from Common.MultipleWorkspace import MultipleWorkspace as mws
+from Common.BaseToolsLib import GetBaseToolsLib
+from Common.BaseToolsLib import BaseToolsLibError
 
 ## Global variables
 #
@@ -64,6 +68,29 @@ class GenFdsGlobalVariable:
     FdfFileTimeStamp = 0
     FixedLoadAddress = False
     PlatformName = ''
+    # Number of processes generating the FFS files of one FV
+    ThreadNumber = 1
+    #
+    # Outputs of GenSec, GenFfs and GUIDed section tools are cached in FfsCacheDir,
+    # keyed by the MD5 digest of the tool, the command line and the content of the
+    # inputs.  The least recently used entries are removed at the end of the run
+    # when the cache is larger than FfsCacheLimit bytes, 0 disables the cache.
+    #
+    FfsCacheDir = ''
+    FfsCacheLimit = 512 * 1024 * 1024
+    FfsCacheHit = 0
+    FfsCacheMiss = 0
+    # Identity of each tool called by CallCachedTool(), see GetToolIdentity()
+    ToolIdentityDict = {}
+    #
+    # Sections and FFS files are created by libBaseTools in the GenFds process
+    # instead of GenSec and GenFfs if the library is found.
+    #
+    UseToolLibrary = True
+    # Record the time spent in each FV and FFS file for the build report
+    Timing = False
+    # Let GenFv reuse the previous FV image and only add changed FFS files
+    IncrementalFv = False
     
     BuildRuleFamily = "MSFT"
     ToolChainFamily = "MSFT"
@@ -285,6 +312,8 @@ class GenFdsGlobalVariable:
         GenFdsGlobalVariable.FfsDir = os.path.join(GenFdsGlobalVariable.FvDir, 'Ffs')
         if not os.path.exists(GenFdsGlobalVariable.FfsDir) :
             os.makedirs(GenFdsGlobalVariable.FfsDir)
+        if GenFdsGlobalVariable.FfsCacheLimit > 0:
+            GenFdsGlobalVariable.FfsCacheDir = os.path.join(GenFdsGlobalVariable.OutputDirDict[ArchList[0]], 'FfsCache')
 
         T_CHAR_LF = '\n'
         #
@@ -402,7 +431,7 @@ class GenFdsGlobalVariable:
             if not GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 return
 
-            GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, [], "Failed to generate section")
         else:
             Cmd += ["-o", Output]
             Cmd += Input
@@ -410,7 +439,10 @@ class GenFdsGlobalVariable:
             SaveFileOnChange(CommandFile, ' '.join(Cmd), False)
             if GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                LibraryCall = lambda Lib, DataList: Lib.GenerateSection(DataList, Type, CompressionType, Guid,
+                                                                        GuidHdrLen, GuidAttr, InputAlign)
+                GenFdsGlobalVariable.CallCachedTool(Cmd, Output, Input, "Failed to generate section",
+                                                    LibraryCall=LibraryCall)
 
             if (os.path.getsize(Output) >= GenFdsGlobalVariable.LARGE_FILE_SIZE and
                 GenFdsGlobalVariable.LargeFileInFvFlags):
@@ -457,7 +489,8 @@ class GenFdsGlobalVariable:
             return
         GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
 
-        GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate FFS")
+        LibraryCall = lambda Lib, DataList: Lib.GenerateFfs(DataList, Type, Guid, Fixed, CheckSum, Align, SectionAlign)
+        GenFdsGlobalVariable.CallCachedTool(Cmd, Output, Input, "Failed to generate FFS", LibraryCall=LibraryCall)
 
     @staticmethod
     def GenerateFirmwareVolume(Output, Input, BaseAddress=None, ForceRebase=None, Capsule=False, Dump=False,
@@ -479,6 +512,8 @@ class GenFdsGlobalVariable:
             Cmd += ["-c"]
         if Dump:
             Cmd += ["-p"]
+        if GenFdsGlobalVariable.IncrementalFv and not Capsule and not Dump:
+            Cmd += ["--incremental"]
         if AddressFile not in [None, '']:
             Cmd += ["-a", AddressFile]
         if MapFile not in [None, '']:
@@ -592,7 +627,189 @@ class GenFdsGlobalVariable:
         Cmd += ["-o", Output]
         Cmd += Input
 
-        GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to call " + ToolPath, returnValue)
+        GenFdsGlobalVariable.CallCachedTool(Cmd, Output, Input, "Failed to call " + ToolPath, returnValue)
+
+    ## CallCachedTool()
+    #
+    #   Call a tool whose output only depends on its command line and input files.
+    #   If the FFS cache holds the output for the same tool, command line and
+    #   input content, it is copied from the cache instead of calling the tool.
+    #   The tool is identified by the path, size and time of the program the
+    #   command runs, and of libBaseTools if the library creates the output.
+    #
+    #   @param  Cmd          The command line of the tool
+    #   @param  Output       The output file of the tool
+    #   @param  Input        The list of input files of the tool
+    #   @param  ErrorMess    The error message if the tool fails
+    #   @param  returnValue  Same as the one of CallExternalTool()
+    #   @param  LibraryCall  Function doing the same as the tool with libBaseTools,
+    #                        called with the library and the content of the inputs
+    #
+    @staticmethod
+    def CallCachedTool(Cmd, Output, Input, ErrorMess, returnValue=[], LibraryCall=None):
+        ToolLibrary = None
+        if LibraryCall != None:
+            ToolLibrary = GenFdsGlobalVariable.GetToolLibrary()
+
+        DataList = None
+        if GenFdsGlobalVariable.FfsCacheDir or ToolLibrary != None:
+            DataList = []
+            for File in Input:
+                if not os.path.isfile(File):
+                    DataList = None
+                    break
+                FileObj = open(File, 'rb')
+                DataList.append(FileObj.read())
+                FileObj.close()
+
+        CacheFile = None
+        ToolIdentity = GenFdsGlobalVariable.GetToolIdentity(Cmd[0])
+        if GenFdsGlobalVariable.FfsCacheDir and DataList != None and ToolIdentity != None:
+            Digest = hashlib.md5(ToolIdentity)
+            if ToolLibrary != None:
+                Digest.update(GenFdsGlobalVariable.GetFileIdentity(ToolLibrary.Path))
+            Digest.update(' '.join(Cmd))
+            for Data in DataList:
+                Digest.update(Data)
+            Key = Digest.hexdigest()
+            CacheFile = os.path.join(GenFdsGlobalVariable.FfsCacheDir, Key[0:2], Key)
+
+        if CacheFile != None and os.path.isfile(CacheFile):
+            GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s is copied from FFS cache %s" % (Output, CacheFile))
+            CopyLongFilePath(CacheFile, Output)
+            #
+            # Mark the entry as recently used for TrimFfsCache()
+            #
+            try:
+                os.utime(CacheFile, None)
+            except OSError:
+                pass
+            GenFdsGlobalVariable.FfsCacheHit += 1
+            if returnValue != []:
+                returnValue[0] = 0
+            return
+
+        if ToolLibrary == None or DataList == None or \
+           not GenFdsGlobalVariable.CallToolLibrary(ToolLibrary, LibraryCall, DataList, Output):
+            GenFdsGlobalVariable.CallExternalTool(Cmd, ErrorMess, returnValue)
+        if CacheFile == None:
+            return
+        GenFdsGlobalVariable.FfsCacheMiss += 1
+        if (returnValue != [] and returnValue[0] != 0) or not os.path.isfile(Output):
+            return
+
+        #
+        # Copy to a temporary file first so that other GenFds processes never
+        # see a partial cache entry.
+        #
+        CacheDir = os.path.dirname(CacheFile)
+        if not os.path.isdir(CacheDir):
+            try:
+                os.makedirs(CacheDir)
+            except OSError:
+                if not os.path.isdir(CacheDir):
+                    raise
+        TempFile = '%s.%d.tmp' % (CacheFile, os.getpid())
+        CopyLongFilePath(Output, TempFile)
+        try:
+            os.rename(TempFile, CacheFile)
+        except OSError:
+            os.remove(TempFile)
+
+    ## GetFileIdentity()
+    #
+    #   @retval     The path, size and modification time of a file
+    #
+    @staticmethod
+    def GetFileIdentity(Path):
+        Stat = os.stat(Path)
+        return '%s|%d|%r' % (os.path.normcase(os.path.abspath(Path)), Stat.st_size, Stat.st_mtime)
+
+    ## GetToolIdentity()
+    #
+    #   Find the program a command runs the way the shell does, so that a
+    #   rebuilt or different tool does not get the outputs of the old one.
+    #
+    #   @param  Tool        The first item of the command line
+    #
+    #   @retval     The identity of the program, or None if it is not found
+    #
+    @staticmethod
+    def GetToolIdentity(Tool):
+        if Tool in GenFdsGlobalVariable.ToolIdentityDict:
+            return GenFdsGlobalVariable.ToolIdentityDict[Tool]
+        if os.path.dirname(Tool):
+            CandidateList = [Tool]
+        else:
+            CandidateList = [os.path.join(Dir, Tool) for Dir in os.environ.get('PATH', '').split(os.pathsep) if Dir]
+        ExtList = ['']
+        if sys.platform == 'win32':
+            ExtList += os.environ.get('PATHEXT', '.COM;.EXE;.BAT;.CMD').split(os.pathsep)
+        Identity = None
+        for Candidate in CandidateList:
+            for Ext in ExtList:
+                if os.path.isfile(Candidate + Ext):
+                    Identity = GenFdsGlobalVariable.GetFileIdentity(Candidate + Ext)
+                    break
+            if Identity != None:
+                break
+        GenFdsGlobalVariable.ToolIdentityDict[Tool] = Identity
+        return Identity
+
+    ## GetToolLibrary()
+    #
+    #   @retval     The BaseToolsLib object, or None if the tools must be called
+    #
+    @staticmethod
+    def GetToolLibrary():
+        #
+        # The tools print their messages in verbose and debug mode
+        #
+        if not GenFdsGlobalVariable.UseToolLibrary or GenFdsGlobalVariable.VerboseMode or \
+           GenFdsGlobalVariable.DebugLevel != -1:
+            return None
+        return GetBaseToolsLib()
+
+    ## CallToolLibrary()
+    #
+    #   Create Output with libBaseTools instead of calling GenSec or GenFfs.
+    #
+    #   libBaseTools prints no messages, so a failed call is repeated with the
+    #   tool to report the error once.
+    #
+    #   @retval True    Output is created
+    #   @retval False   The tool must be called, which also reports the error if any
+    #
+    @staticmethod
+    def CallToolLibrary(ToolLibrary, LibraryCall, DataList, Output):
+        try:
+            Data = LibraryCall(ToolLibrary, DataList)
+        except BaseToolsLibError:
+            return False
+        if Data == None:
+            return False
+        try:
+            FileObj = open(Output, 'wb')
+            FileObj.write(Data)
+            FileObj.close()
+        except IOError:
+            return False
+
+        GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s is created by libBaseTools" % Output)
+        GenFdsGlobalVariable.ShowProgress()
+        return True
+
+    ## ShowProgress()
+    #
+    #   Print a '#' for each section or file created.
+    #
+    @staticmethod
+    def ShowProgress():
+        sys.stdout.write ('#')
+        sys.stdout.flush()
+        GenFdsGlobalVariable.SharpCounter = GenFdsGlobalVariable.SharpCounter + 1
+        if GenFdsGlobalVariable.SharpCounter % GenFdsGlobalVariable.SharpNumberPerLine == 0:
+            sys.stdout.write('\n')
 
     def CallExternalTool (cmd, errorMess, returnValue=[]):
 
@@ -607,11 +824,7 @@ class GenFdsGlobalVariable:
             cmd += ('-v',)
             GenFdsGlobalVariable.InfLogger (cmd)
         else:
-            sys.stdout.write ('#')
-            sys.stdout.flush()
-            GenFdsGlobalVariable.SharpCounter = GenFdsGlobalVariable.SharpCounter + 1
-            if GenFdsGlobalVariable.SharpCounter % GenFdsGlobalVariable.SharpNumberPerLine == 0:
-                sys.stdout.write('\n')
+            GenFdsGlobalVariable.ShowProgress()
 
         try:
             PopenObject = subprocess.Popen(' '.join(cmd), stdout=subprocess.PIPE, stderr=subprocess.PIPE, shell=True)
@@ -3105,6 +3105,33 @@ determine whether database file is out of date!\n")
             self.Conn.close()
             self._DbClosedFlag = True
 
+    ## Open a read-only connection of its own in a forked process
+    #
+    # A connection must not be used across fork(), so the tables owned by the
+    # database, and those of the meta files parsed for the cached build objects,
+    # are moved to a new connection. The inherited one is left alone, as closing
+    # it would touch the state of the parent. The temporary tables of the parent
+    # are not visible through the new connection.
+    #
+    # @param DbPath     The absolute path of workspace database file
+    #
+    def OpenReadOnlyConnection(self, DbPath):
+        OldCur = self.Cur
+        self._InheritedConn = self.Conn
+        self.Conn = sqlite3.connect(DbPath, isolation_level='DEFERRED')
+        self.Conn.execute("PRAGMA query_only=ON")
+        self.Conn.execute("PRAGMA temp_store=MEMORY")
+        self.Conn.execute("PRAGMA cache_size=8192")
+        self.Conn.text_factory = str
+        self.Cur = self.Conn.cursor()
+        TableList = [self.TblDataModel, self.TblFile]
+        for BuildData in self.BuildObject._CACHE_.values():
+            TableList.append(BuildData._RawData._RawTable)
+            TableList.append(BuildData._RawData._Table)
+        for Tbl in TableList:
+            if Tbl.Cur is OldCur:
+                Tbl.Cur = self.Cur
+
     ## Summarize all packages in the database
     def GetPackageList(self, Platform, Arch, TargetName, ToolChainTag):
         self.Platform = Platform
@@ -0,0 +1,309 @@
+## @file
+# This file is used to save and restore the resolved platform of a build, so
+# that a build whose meta-data files have not changed since the last one can
+# skip parsing and AutoGen and go straight to make.
+#
+# Copyright (c) 2026 Baikal Electronics JSC
+# This program and the accompanying materials
+# are licensed and made available under the terms and conditions of the BSD License
+# which accompanies this distribution.  The full text of the license may be found at
+# http://opensource.org/licenses/bsd-license.php
+#
+# THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+# WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import Common.LongFilePathOs as os
+import sys
+import hashlib
+import Common.EdkLogger as EdkLogger
+import Common.GlobalData as GlobalData
+from Common.LongFilePathSupport import OpenLongFilePath as open
+from Common.BuildVersion import gBUILD_VERSION
+from Common.Misc import DataDump
+from Common.Misc import DataRestore
+
+## Version of the snapshot content, increased whenever the content changes
+gSnapshotVersion = 1
+
+## Build options which have no effect on the resolved platform
+gSnapshotNeutralOptions = ['ThreadNumber', 'LogFile', 'SilentMode', 'verbose', 'quiet', 'debug',
+                           'ReportFile', 'ReportType', 'SkipAutoGen', 'Reparse', 'DisableCache']
+
+## Environment variables which locate the meta-data files
+gSnapshotEnvironment = ['WORKSPACE', 'PACKAGES_PATH', 'EDK_TOOLS_PATH', 'EDK_TOOLS_BIN', 'CONF_PATH',
+                        'ECP_SOURCE', 'EDK_SOURCE', 'EFI_SOURCE']
+
+## Return the MD5 digest of the content of a file, or None if it cannot be read
+def GetFileDigest(FilePath):
+    try:
+        with open(FilePath, 'rb') as File:
+            return hashlib.md5(File.read()).hexdigest()
+    except:
+        return None
+
+## Return the modified time of build.exe or of the newest Python source of the build tool
+def GetToolTimeStamp():
+    if hasattr(sys, "frozen"):
+        return os.stat(os.path.abspath(sys.executable))[8]
+    TimeStamp = 0
+    RootPath = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    for Root, Dirs, Files in os.walk(RootPath):
+        for File in Files:
+            if os.path.splitext(File)[1].lower() == ".py":
+                TimeStamp = max(TimeStamp, os.stat(os.path.join(Root, File))[8])
+    return TimeStamp
+
+## Compute the key of the snapshot of a platform build
+#
+#   The key covers everything besides the content of the meta-data files which
+#   can change the resolved platform: the build options and macros, the tool
+#   definitions with their environment variables expanded, and the build tool
+#   itself.
+#
+#   @param  Options         The build options from the command line
+#   @param  ToolDef         The ToolDefClassObject of the build
+#   @param  ArchList        The architectures to build
+#
+#   @retval string          The MD5 digest of the key
+#
+def GetSnapshotKey(Options, ToolDef, ArchList):
+    Key = hashlib.md5()
+    Key.update('%d %s %d\n' % (gSnapshotVersion, gBUILD_VERSION, GetToolTimeStamp()))
+    for Name in sorted(vars(Options)):
+        if Name not in gSnapshotNeutralOptions:
+            Key.update('%s=%s\n' % (Name, vars(Options)[Name]))
+    for Name in gSnapshotEnvironment:
+        Key.update('%s=%s\n' % (Name, os.environ.get(Name)))
+    for Name in sorted(GlobalData.gGlobalDefines):
+        if Name != 'ARCH':
+            Key.update('%s=%s\n' % (Name, GlobalData.gGlobalDefines[Name]))
+    for Name in sorted(GlobalData.gCommandLineDefines):
+        Key.update('%s=%s\n' % (Name, GlobalData.gCommandLineDefines[Name]))
+    for Name in sorted(ToolDef.ToolsDefTxtDictionary):
+        Key.update('%s=%s\n' % (Name, ToolDef.ToolsDefTxtDictionary[Name]))
+    Key.update(' '.join(ArchList))
+    return Key.hexdigest()
+
+## Return the path of the snapshot of a platform build in the cache directory
+def GetSnapshotPath(PlatformFile, BuildTarget, ToolChain, ArchList):
+    Name = hashlib.md5('%s %s %s %s' % (PlatformFile, BuildTarget, ToolChain, ' '.join(ArchList))).hexdigest()
+    return os.path.join(os.path.dirname(GlobalData.gDatabasePath), 'Snapshot_%s' % Name)
+
+## Module in a snapshot
+#
+# This class stands in for the ModuleAutoGen object of a module or library
+# when it is built from a snapshot. It provides what the make units and the
+# build tasks need.
+#
+class SnapshotModule(object):
+    ## The constructor
+    #
+    #   @param  Ma      The ModuleAutoGen object of the module
+    #
+    def __init__(self, Ma):
+        self.MetaFile = str(Ma.MetaFile)
+        self.Arch = Ma.Arch
+        self.BuildTarget = Ma.BuildTarget
+        self.ToolChain = Ma.ToolChain
+        self.Name = Ma.Name
+        self.Guid = Ma.Guid
+        self.IsLibrary = Ma.IsLibrary
+        self.IsBinaryModule = Ma.IsBinaryModule
+        self.BuildCommand = Ma.BuildCommand
+        self.MakeFileDir = Ma.MakeFileDir
+        self.DebugDir = Ma.DebugDir
+        self.BuildTime = None
+        self.LibraryAutoGenList = []
+        self.TimeStampPath = None
+        self.MapFile = None
+        self.MapFileStat = None
+        if not self.IsBinaryModule:
+            self.TimeStampPath = Ma.GetTimeStampPath()
+            if not self.IsLibrary:
+                self.MapFile = os.path.join(Ma.OutputDir, Ma.Name + '.map')
+                self.MapFileStat = self.GetMapFileStat()
+
+    ## Return the size and modified time of the map file of the module
+    #
+    #   The as-built INF of a module is generated from its map file. It can be
+    #   reused only if the map file is the one the INF was generated from.
+    #
+    def GetMapFileStat(self):
+        if self.MapFile == None or not os.path.exists(self.MapFile):
+            return None
+        Stat = os.stat(self.MapFile)
+        return (Stat[6], Stat[8])
+
+    ## Check if the AutoGen files and makefile of the module are up-to-date
+    #
+    #   The same rule as ModuleAutoGen.CanSkip() is applied: all files recorded
+    #   in the AutoGenTimeStamp file must be older than that file.
+    #
+    def IsAutoGenUpToDate(self, TimeDict):
+        if self.TimeStampPath == None:
+            return True
+        if not os.path.exists(self.TimeStampPath):
+            return False
+        DstTimeStamp = os.stat(self.TimeStampPath)[8]
+        with open(self.TimeStampPath, 'r') as File:
+            for Source in File:
+                Source = Source.rstrip('\n')
+                if Source not in TimeDict:
+                    if not os.path.exists(Source):
+                        return False
+                    TimeDict[Source] = os.stat(Source)[8]
+                if TimeDict[Source] > DstTimeStamp:
+                    return False
+        return True
+
+    def __str__(self):
+        return self.MetaFile
+
+    def __repr__(self):
+        return self.MetaFile
+
+    def __eq__(self, Other):
+        return isinstance(Other, SnapshotModule) and self.MetaFile == Other.MetaFile and self.Arch == Other.Arch
+
+    def __ne__(self, Other):
+        return not self.__eq__(Other)
+
+    def __hash__(self):
+        return hash(self.MetaFile)
+
+## Snapshot of the resolved platform of a build
+#
+# A snapshot holds, for one build target and tool chain, the modules to make
+# in each architecture with their library instances, the commands and
+# directories needed after make, and the digests of all meta-data files the
+# platform was resolved from. The PCD database and other AutoGen files
+# already exist in the build directory and are reused as they are.
+#
+class WorkspaceSnapshot(object):
+    ## The constructor
+    #
+    #   @param  Key             The key from GetSnapshotKey()
+    #   @param  FileList        The meta-data files the platform depends on
+    #   @param  AutoGenTime     The seconds spent to resolve the platform
+    #
+    def __init__(self, Key, FileList, AutoGenTime):
+        self.Version = gSnapshotVersion
+        self.Key = Key
+        self.Files = {}
+        for FilePath in FileList:
+            self.Files[FilePath] = GetFileDigest(FilePath)
+        self.AutoGenTime = AutoGenTime
+        self.Name = None
+        self.BuildDir = None
+        self.FvDir = None
+        self.FdfFile = None
+        self.FvNameList = []
+        self.GenFdsCommand = None
+        self.ModuleList = []
+        self.PlatformModules = {}
+        self._ModuleDict = {}
+
+    ## Take the platform information from a WorkspaceAutoGen object
+    #
+    #   @param  Wa              The WorkspaceAutoGen object of the build
+    #   @param  ModuleList      The ModuleAutoGen objects to make, in order
+    #
+    def AddWorkspace(self, Wa, ModuleList):
+        self.Name = Wa.Name
+        self.BuildDir = Wa.BuildDir
+        self.FvDir = Wa.FvDir
+        self.FdfFile = Wa.FdfFile
+        if Wa.FdfProfile:
+            self.FvNameList = Wa.FdfProfile.FvDict.keys()
+        self.GenFdsCommand = Wa.GenFdsCommand
+        for Ma in ModuleList:
+            self.ModuleList.append(self._GetModule(Ma))
+        for Pa in Wa.AutoGenObjectList:
+            for Ma in Pa.ModuleAutoGenList:
+                if Ma != None and not Ma.IsLibrary:
+                    self.PlatformModules[Ma.Guid.upper()] = self._GetModule(Ma)
+        self._ModuleDict = {}
+
+    def _GetModule(self, Ma):
+        Key = (str(Ma.MetaFile), Ma.Arch)
+        if Key not in self._ModuleDict:
+            Module = SnapshotModule(Ma)
+            self._ModuleDict[Key] = Module
+            for La in Ma.LibraryAutoGenList:
+                Module.LibraryAutoGenList.append(self._GetModule(La))
+        return self._ModuleDict[Key]
+
+    ## Return all modules and libraries in the snapshot
+    def _GetAllModules(self):
+        ModuleSet = set()
+        ModuleList = self.ModuleList + self.PlatformModules.values()
+        while ModuleList:
+            Module = ModuleList.pop()
+            if Module not in ModuleSet:
+                ModuleSet.add(Module)
+                ModuleList.extend(Module.LibraryAutoGenList)
+        return ModuleSet
+
+    ## Check if the platform can be built from the snapshot
+    #
+    #   The content of all meta-data files must be unchanged, and the AutoGen
+    #   files and makefiles of all modules must be up-to-date.
+    #
+    def IsUpToDate(self):
+        for FilePath in self.Files:
+            if GetFileDigest(FilePath) != self.Files[FilePath]:
+                EdkLogger.verbose("Workspace snapshot is out of date: %s changed" % FilePath)
+                return False
+        TimeDict = {}
+        for Module in self._GetAllModules():
+            if not Module.IsAutoGenUpToDate(TimeDict):
+                EdkLogger.verbose("Workspace snapshot is out of date: AutoGen of %s [%s] is needed" % (Module, Module.Arch))
+                return False
+        return True
+
+    ## Check if the map files of all modules are the ones in the snapshot
+    def IsMapFileUnchanged(self):
+        for Module in self._GetAllModules():
+            if Module.MapFile != None and Module.GetMapFileStat() != Module.MapFileStat:
+                EdkLogger.verbose("Workspace snapshot is out of date: %s changed" % Module.MapFile)
+                return False
+        return True
+
+    ## Copy the build time of the modules to the ModuleAutoGen objects of a workspace
+    def CopyBuildTime(self, Wa):
+        BuildTimeDict = {}
+        for Module in self._GetAllModules():
+            BuildTimeDict[Module.MetaFile, Module.Arch] = Module.BuildTime
+        for Pa in Wa.AutoGenObjectList:
+            for Ma in Pa.ModuleAutoGenList + Pa.LibraryAutoGenList:
+                if Ma != None and BuildTimeDict.get((str(Ma.MetaFile), Ma.Arch)):
+                    Ma.BuildTime = BuildTimeDict[str(Ma.MetaFile), Ma.Arch]
+
+    ## Save the snapshot to a file
+    def Save(self, FilePath):
+        DataDump(self, FilePath)
+
+## Restore the snapshot of a build
+#
+#   @param  FilePath        The path from GetSnapshotPath()
+#   @param  Key             The key from GetSnapshotKey()
+#
+#   @retval WorkspaceSnapshot   The snapshot if it exists and is up-to-date
+#   @retval None                Otherwise
+#
+def RestoreSnapshot(FilePath, Key):
+    if not os.path.isfile(FilePath):
+        return None
+    Snapshot = DataRestore(FilePath)
+    if not isinstance(Snapshot, WorkspaceSnapshot) or Snapshot.Version != gSnapshotVersion:
+        return None
+    if Snapshot.Key != Key:
+        EdkLogger.verbose("Workspace snapshot is out of date: build options or tool definitions changed")
+        return None
+    if not Snapshot.IsUpToDate():
+        return None
+    return Snapshot
@@ -44,6 +44,15 @@ from Common.DataType import TAB_SPACE_SPLIT
 from Common.DataType import TAB_BRG_PCD
 from Common.DataType import TAB_BRG_LIBRARY
 from Common.DataType import TAB_BACK_SLASH
+from Common.BuildTiming import GetTimingEvents
+from Common.BuildTiming import GetTimingTotals
+from Common.BuildTiming import GetCriticalPath
+from Common.BuildTiming import SaveChromeTrace
+from Common.BuildTiming import TIMING_AUTOGEN
+from Common.BuildTiming import TIMING_MAKE
+from Common.BuildTiming import TIMING_GENFDS
+from Common.BuildTiming import TIMING_FFS
+from Common.BuildTiming import TIMING_FV
 from Common.LongFilePathSupport import OpenLongFilePath as open
 from Common.MultipleWorkspace import MultipleWorkspace as mws
 import Common.GlobalData as GlobalData
@@ -1623,6 +1632,79 @@ class FdReport(object):
             FileWrite(File, gSubSectionEnd)
         FileWrite(File, gSectionEnd)
 
+##
+# Reports the time spent in each step of the build
+#
+# This class reports the AutoGen and make time of each module, the GenFds
+# time of each FV and FFS file, and the chain of modules which decided how
+# long the make phase took.
+#
+class TimingReport(object):
+    ## Number of items listed for each kind of step
+    MaxItems = 20
+
+    ##
+    # Constructor function for class TimingReport
+    #
+    # @param self            The object pointer
+    # @param Events          The timing events recorded by the build and GenFds
+    #
+    def __init__(self, Events):
+        self.Events = Events
+        self.CriticalPath = GetCriticalPath(Events, TIMING_MAKE)
+
+    ##
+    # Write the items of a category taking the longest time
+    #
+    # @param self            The object pointer
+    # @param File            The file object for report
+    # @param Category        The category of the timing events
+    # @param Title           The title of the subsection
+    #
+    def _GenerateTopItems(self, File, Category, Title):
+        Totals = GetTimingTotals(self.Events, Category)
+        if not Totals:
+            return
+        FileWrite(File, gSubSectionStart)
+        FileWrite(File, "%s (%d items, %.3fs in total)" % (Title, len(Totals), sum(Totals.values())))
+        FileWrite(File, gSubSectionSep)
+        for Name in sorted(Totals, key=lambda Item: (-Totals[Item], Item))[:self.MaxItems]:
+            FileWrite(File, "%10.3fs  %s" % (Totals[Name], Name))
+        FileWrite(File, gSubSectionEnd)
+
+    ##
+    # Generate report for the build timing
+    #
+    # @param self            The object pointer
+    # @param File            The file object for report
+    #
+    def GenerateReport(self, File):
+        FileWrite(File, gSectionStart)
+        FileWrite(File, "Build Timing")
+        if not self.Events:
+            FileWrite(File, "No timing is recorded for this build")
+            FileWrite(File, gSectionEnd)
+            return
+        BeginTime = min(Event["Start"] for Event in self.Events)
+        EndTime = max(Event["End"] for Event in self.Events)
+        FileWrite(File, "Timed Duration:     %.3fs" % (EndTime - BeginTime))
+        self._GenerateTopItems(File, TIMING_AUTOGEN, "AutoGen Time of Modules")
+        self._GenerateTopItems(File, TIMING_MAKE, "Make Time of Modules")
+        self._GenerateTopItems(File, TIMING_GENFDS, "GenFds Time")
+        self._GenerateTopItems(File, TIMING_FV, "GenFds Time of FVs")
+        self._GenerateTopItems(File, TIMING_FFS, "GenFds Time of FFS Files")
+        if self.CriticalPath:
+            PathBegin = self.CriticalPath[0]["Start"]
+            PathEnd = self.CriticalPath[-1]["End"]
+            Busy = sum(Event["End"] - Event["Start"] for Event in self.CriticalPath)
+            FileWrite(File, gSubSectionStart)
+            FileWrite(File, "Make Critical Path (%d modules, %.3fs, %.3fs waiting)" % (len(self.CriticalPath), PathEnd - PathBegin, PathEnd - PathBegin - Busy))
+            FileWrite(File, gSubSectionSep)
+            for Event in self.CriticalPath:
+                FileWrite(File, "%10.3fs  %10.3fs  %s" % (Event["Start"] - BeginTime, Event["End"] - Event["Start"], Event["Name"]))
+            FileWrite(File, gSubSectionEnd)
+        FileWrite(File, gSectionEnd)
+
 
 
 ##
@@ -1641,8 +1723,9 @@ class PlatformReport(object):
     # @param self            The object pointer
     # @param Wa              Workspace context information
     # @param MaList          The list of modules in the platform build
+    # @param SnapshotSavedTime The AutoGen time saved by the workspace snapshot
     #
-    def __init__(self, Wa, MaList, ReportType):
+    def __init__(self, Wa, MaList, ReportType, SnapshotSavedTime=None):
         self._WorkspaceDir = Wa.WorkspaceDir
         self.PlatformName = Wa.Name
         self.PlatformDscPath = Wa.Platform
@@ -1651,6 +1734,8 @@ class PlatformReport(object):
         self.Target = Wa.BuildTarget
         self.OutputPath = os.path.join(Wa.WorkspaceDir, Wa.OutputDir)
         self.BuildEnvironment = platform.platform()
+        self.FfsCacheStatistics = os.path.join(Wa.BuildDir, GlobalData.gFfsCacheStatistics)
+        self.SnapshotSavedTime = SnapshotSavedTime
 
         self.PcdReport = None
         if "PCD" in ReportType:
@@ -1722,10 +1807,19 @@ class PlatformReport(object):
         FileWrite(File, "Build Duration:       %s" % BuildDuration)
         if AutoGenTime:
             FileWrite(File, "AutoGen Duration:     %s" % AutoGenTime)
+        if self.SnapshotSavedTime:
+            FileWrite(File, "Workspace Snapshot:   used, saved %s" % self.SnapshotSavedTime)
         if MakeTime:
             FileWrite(File, "Make Duration:        %s" % MakeTime)
         if GenFdsTime:
             FileWrite(File, "GenFds Duration:      %s" % GenFdsTime)
+            if os.path.isfile(self.FfsCacheStatistics):
+                Statistics = {}
+                for Line in open(self.FfsCacheStatistics, 'r'):
+                    if '=' in Line:
+                        Name, Value = Line.split('=', 1)
+                        Statistics[Name.strip()] = Value.strip()
+                FileWrite(File, "FFS Cache:            %s hits, %s misses" % (Statistics.get('HIT', '0'), Statistics.get('MISS', '0')))
         FileWrite(File, "Report Content:       %s" % ", ".join(ReportType))
 
         if GlobalData.MixedPcd:
@@ -1787,10 +1881,11 @@ class BuildReport(object):
     # @param self            The object pointer
     # @param Wa              Workspace context information
     # @param MaList          The list of modules in the platform build
+    # @param SnapshotSavedTime The AutoGen time saved by the workspace snapshot
     #
-    def AddPlatformReport(self, Wa, MaList=None):
+    def AddPlatformReport(self, Wa, MaList=None, SnapshotSavedTime=None):
         if self.ReportFile:
-            self.ReportList.append((Wa, MaList))
+            self.ReportList.append((Wa, MaList, SnapshotSavedTime))
 
     ##
     # Generates the final report.
@@ -1808,17 +1903,31 @@ class BuildReport(object):
         if self.ReportFile:
             try:
                 File = StringIO('')
-                for (Wa, MaList) in self.ReportList:
-                    PlatformReport(Wa, MaList, self.ReportType).GenerateReport(File, BuildDuration, AutoGenTime, MakeTime, GenFdsTime, self.ReportType)
+                for (Wa, MaList, SnapshotSavedTime) in self.ReportList:
+                    PlatformReport(Wa, MaList, self.ReportType, SnapshotSavedTime).GenerateReport(File, BuildDuration, AutoGenTime, MakeTime, GenFdsTime, self.ReportType)
+                if "TIMING" in self.ReportType:
+                    Events = GetTimingEvents()
+                    TimingReport(Events).GenerateReport(File)
+                    SaveChromeTrace(self.GetTraceFile(), Events)
                 Content = FileLinesSplit(File.getvalue(), gLineMaxLength)
                 SaveFileOnChange(self.ReportFile, Content, True)
                 EdkLogger.quiet("Build report can be found at %s" % os.path.abspath(self.ReportFile))
+                if "TIMING" in self.ReportType:
+                    EdkLogger.quiet("Build trace can be found at %s" % os.path.abspath(self.GetTraceFile()))
             except IOError:
                 EdkLogger.error(None, FILE_WRITE_FAILURE, ExtraData=self.ReportFile)
             except:
                 EdkLogger.error("BuildReport", CODE_ERROR, "Unknown fatal error when generating build report", ExtraData=self.ReportFile, RaiseError=False)
                 EdkLogger.quiet("(Python %s on %s\n%s)" % (platform.python_version(), sys.platform, traceback.format_exc()))
             File.close()
+
+    ##
+    # Return the path of the Chrome trace saved with the TIMING report
+    #
+    # @param self            The object pointer
+    #
+    def GetTraceFile(self):
+        return os.path.splitext(self.ReportFile)[0] + ".trace.json"
             
 # This acts like the main() function for the script, unless it is 'import'ed into another script.
 if __name__ == '__main__':
@@ -26,6 +26,7 @@ import platform
 import traceback
 import encodings.ascii
 import itertools
+import multiprocessing
 
 from struct import *
 from threading import *
@@ -42,7 +43,17 @@ from Common.BuildVersion import gBUILD_VERSION
 from AutoGen.AutoGen import *
 from Common.BuildToolError import *
 from Workspace.WorkspaceDatabase import *
+from Workspace.WorkspaceSnapshot import GetSnapshotKey
+from Workspace.WorkspaceSnapshot import GetSnapshotPath
+from Workspace.WorkspaceSnapshot import RestoreSnapshot
+from Workspace.WorkspaceSnapshot import WorkspaceSnapshot
 from Common.MultipleWorkspace import MultipleWorkspace as mws
+from Common.BuildTiming import AddTimingEvent
+from Common.BuildTiming import AddTimingEvents
+from Common.BuildTiming import LoadTimingEvents
+from Common.BuildTiming import TIMING_AUTOGEN
+from Common.BuildTiming import TIMING_MAKE
+from Common.BuildTiming import TIMING_GENFDS
 
 from BuildReport import BuildReport
 from GenPatchPcdTable.GenPatchPcdTable import *
@@ -324,6 +335,28 @@ def LaunchCommand(Command, WorkingDir):
         EdkLogger.error("build", COMMAND_FAILURE, ExtraData="%s [%s]" % (Command, WorkingDir))
     return "%dms" % (int(round((time.time() - BeginTime) * 1000)))
 
+## Launch GenFds, and collect the time it spent in each FV and FFS file for the TIMING report
+#
+# @param  Command               The GenFds command of the workspace
+# @param  WorkingDir            The directory in which GenFds will be running
+# @param  FvDir                 The FV directory of the workspace
+#
+def LaunchGenFds(Command, WorkingDir, FvDir):
+    if not GlobalData.gBuildTiming:
+        LaunchCommand(Command, WorkingDir)
+        return
+    TimingFile = os.path.join(os.path.dirname(FvDir), GlobalData.gGenFdsTiming)
+    if os.path.exists(TimingFile):
+        os.remove(TimingFile)
+    BeginTime = time.time()
+    LaunchCommand(Command + " --timing", WorkingDir)
+    AddTimingEvent(TIMING_GENFDS, "GenFds", BeginTime, time.time())
+    AddTimingEvents(LoadTimingEvents(TimingFile))
+
+## Return the name of a module in the timing events
+def GetTimingName(Module):
+    return "%s [%s]" % (Module.MetaFile, Module.Arch)
+
 ## The smallest unit that can be built in multi-thread build mode
 #
 # This is the base class of build unit. The "Obj" parameter must provide
@@ -667,7 +700,11 @@ class BuildTask:
     #
     def _CommandThread(self, Command, WorkingDir):
         try:
+            BeginTime = time.time()
             self.BuildItem.BuildObject.BuildTime = LaunchCommand(Command, WorkingDir)
+            if GlobalData.gBuildTiming:
+                AddTimingEvent(TIMING_MAKE, GetTimingName(self.BuildItem.BuildObject), BeginTime, time.time(),
+                               Dependencies=[GetTimingName(Dep.BuildItem.BuildObject) for Dep in self.DependencyList])
             self.CompleteFlag = True
         except:
             #
@@ -723,6 +760,64 @@ class PeImageInfo():
         self.Image            = ImageClass
         self.Image.Size       = (self.Image.Size / 0x1000 + 1) * 0x1000
 
+## Create AutoGen code and makefile of a module
+#
+#   @param  Ma              The ModuleAutoGen object
+#   @param  Target          The build command target
+#   @param  SkipAutoGen     Whether AutoGen is skipped for the "all" target
+#   @param  WithLibraries   Whether the files of the dependent libraries are created too
+#
+#   @retval dict            The timing event of the module if the build is timed
+#   @retval None            Otherwise
+#
+def CreateModuleAutoGenFiles(Ma, Target, SkipAutoGen, WithLibraries):
+    BeginTime = time.time()
+    if not SkipAutoGen or Target == 'genc':
+        Ma.CreateCodeFile(WithLibraries)
+    if Target != 'genc' and (not SkipAutoGen or Target == 'genmake'):
+        Ma.CreateMakeFile(WithLibraries)
+    if GlobalData.gBuildTiming:
+        return AddTimingEvent(TIMING_AUTOGEN, GetTimingName(Ma), BeginTime, time.time(), "process %d" % os.getpid())
+    return None
+
+## Modules handled by the AutoGen worker processes
+#
+#   The workers are forked from the build process, so they inherit the
+#   ModuleAutoGen objects together with the parsed workspace database and PCD
+#   data behind them. Nothing is pickled or parsed again.
+#
+gAutoGenUnitList = []
+gAutoGenDatabase = None
+
+## Initialize an AutoGen worker process
+#
+#   A worker opens its own read-only connection to the database. A unit whose
+#   generation needs to write it, or needs a temporary table of the parent,
+#   fails with an exception and is created by the parent.
+#
+def AutoGenWorkerInit():
+    gAutoGenDatabase.OpenReadOnlyConnection(GlobalData.gDatabasePath)
+
+## Create AutoGen code and makefile of one module in a worker process
+#
+#   @param  Args    (Index of the unit in gAutoGenUnitList, Target, SkipAutoGen)
+#
+#   @retval tuple   (Index, ErrorCode, DepexGenerated, TimingEvent). ErrorCode is 0
+#                   on success, the code of an error reported already, or None when
+#                   the unit has to be created again by the parent.
+#
+def AutoGenWorker(Args):
+    Index, Target, SkipAutoGen = Args
+    Ma = gAutoGenUnitList[Index]
+    try:
+        TimingEvent = CreateModuleAutoGenFiles(Ma, Target, SkipAutoGen, False)
+    except FatalError, X:
+        return Index, X.args[0], False, None
+    except Exception:
+        EdkLogger.verbose("AutoGen of %s falls back to the build process:\n%s" % (Ma, traceback.format_exc()))
+        return Index, None, False, None
+    return Index, 0, Ma.DepexGenerated, TimingEvent
+
 ## The class implementing the EDK2 build process
 #
 #   The build process includes:
@@ -759,10 +854,12 @@ class Build():
         self.ThreadNumber   = BuildOptions.ThreadNumber
         self.SkipAutoGen    = BuildOptions.SkipAutoGen
         self.Reparse        = BuildOptions.Reparse
+        self.DisableCache   = BuildOptions.DisableCache
         self.SkuId          = BuildOptions.SkuId
         self.ConfDirectory = BuildOptions.ConfDirectory
         self.SpawnMode      = True
         self.BuildReport    = BuildReport(BuildOptions.ReportFile, BuildOptions.ReportType)
+        GlobalData.gBuildTiming = bool(BuildOptions.ReportFile) and "TIMING" in BuildOptions.ReportType
         self.TargetTxt      = TargetTxtClassObject()
         self.ToolDef        = ToolDefClassObject()
         self.AutoGenTime    = 0
@@ -771,6 +868,8 @@ class Build():
         GlobalData.BuildOptionPcd     = BuildOptions.OptionPcd
         #Set global flag for build mode
         GlobalData.gIgnoreSource = BuildOptions.IgnoreSources
+        GlobalData.gFfsCache = not BuildOptions.DisableCache
+        GlobalData.gIncrementalFv = BuildOptions.IncrementalFv
         GlobalData.gUseHashCache = BuildOptions.UseHashCache
         GlobalData.gBinCacheDest   = BuildOptions.BinCacheDest
         GlobalData.gBinCacheSource = BuildOptions.BinCacheSource
@@ -823,6 +922,7 @@ class Build():
         self.LoadFixAddress = 0
         self.UniFlag        = BuildOptions.Flag
         self.BuildModules = []
+        self.SnapshotDict = {}
         self.Db_Flag = False
         self.LaunchPrebuildFlag = False
         self.PlatformBuildPath = os.path.join(GlobalData.gConfDirectory,'.cache', '.PlatformBuild')
@@ -932,6 +1032,7 @@ class Build():
 
         if self.ThreadNumber == 0:
             self.ThreadNumber = 1
+        GlobalData.gThreadNumber = self.ThreadNumber
 
         if not self.PlatformFile:
             PlatformFile = self.TargetTxt.TargetTxtDictionary[DataType.TAB_TAT_DEFINES_ACTIVE_PLATFORM]
@@ -1374,7 +1475,7 @@ class Build():
 
         # genfds
         if Target == 'fds':
-            LaunchCommand(AutoGenObject.GenFdsCommand, AutoGenObject.MakeFileDir)
+            LaunchGenFds(AutoGenObject.GenFdsCommand, AutoGenObject.MakeFileDir, AutoGenObject.FvDir)
             return True
 
         # run
@@ -1504,13 +1605,13 @@ class Build():
 
     ## Collect MAP information of all FVs
     #
-    def _CollectFvMapBuffer (self, MapBuffer, Wa, ModuleList):
+    def _CollectFvMapBuffer (self, MapBuffer, FvDir, FvNameList, ModuleList):
         if self.Fdf:
             # First get the XIP base address for FV map file.
             GuidPattern = re.compile("[-a-fA-F0-9]+")
             GuidName = re.compile("\(GUID=[-a-fA-F0-9]+")
-            for FvName in Wa.FdfProfile.FvDict.keys():
-                FvMapBuffer = os.path.join(Wa.FvDir, FvName + '.Fv.map')
+            for FvName in FvNameList:
+                FvMapBuffer = os.path.join(FvDir, FvName + '.Fv.map')
                 if not os.path.exists(FvMapBuffer):
                     continue
                 FvMap = open(FvMapBuffer, 'r')
@@ -1776,7 +1877,7 @@ class Build():
                         #
                         # Create MAP file for all platform FVs after GenFds.
                         #
-                        self._CollectFvMapBuffer(MapBuffer, Wa, ModuleList)
+                        self._CollectFvMapBuffer(MapBuffer, Wa.FvDir, Wa.FdfProfile.FvDict.keys(), ModuleList)
                     #
                     # Save MAP buffer into MAP file.
                     #
@@ -1921,12 +2022,123 @@ class Build():
                     #
                     # Create MAP file for all platform FVs after GenFds.
                     #
-                    self._CollectFvMapBuffer(MapBuffer, Wa, ModuleList)
+                    self._CollectFvMapBuffer(MapBuffer, Wa.FvDir, Wa.FdfProfile.FvDict.keys(), ModuleList)
                     #
                     # Save MAP buffer into MAP file.
                     #
                     self._SaveMapFile (MapBuffer, Wa)
 
+    ## Check whether the AutoGen files are created by worker processes
+    #
+    #   Windows cannot fork the build process, and the workers cannot connect
+    #   to the in-memory database used when the build cache is disabled. The
+    #   modules are created one by one then, as they are with a single build
+    #   thread.
+    #
+    def _UseAutoGenWorkers(self):
+        return self.ThreadNumber > 1 and sys.platform != 'win32' and not self.DisableCache
+
+    ## Create AutoGen code and makefiles of modules
+    #
+    #   With more than one build thread, the modules and their libraries are
+    #   spread over that many worker processes. Each library is created only
+    #   once instead of through every module using it.
+    #
+    #   @param  ModuleList      The list of ModuleAutoGen objects
+    #
+    def _CreateAutoGenFiles(self, ModuleList):
+        if not self._UseAutoGenWorkers() or len(ModuleList) <= 1:
+            TimedSet = set()
+            for Ma in ModuleList:
+                #
+                # Time the libraries apart from the first module linking them
+                #
+                if GlobalData.gBuildTiming and not Ma.IsLibrary and not Ma.IsBinaryModule and not Ma.CanSkip():
+                    for La in Ma.LibraryAutoGenList:
+                        if La not in TimedSet:
+                            TimedSet.add(La)
+                            CreateModuleAutoGenFiles(La, self.Target, self.SkipAutoGen, False)
+                if Ma not in TimedSet:
+                    TimedSet.add(Ma)
+                    CreateModuleAutoGenFiles(Ma, self.Target, self.SkipAutoGen, True)
+            return
+
+        global gAutoGenUnitList, gAutoGenDatabase
+        UnitList = []
+        UnitSet = set()
+        for Ma in ModuleList:
+            if not Ma.IsLibrary and not Ma.IsBinaryModule and not Ma.CanSkip():
+                for La in Ma.LibraryAutoGenList:
+                    if La not in UnitSet:
+                        UnitSet.add(La)
+                        UnitList.append(La)
+        for Ma in ModuleList:
+            if Ma not in UnitSet:
+                UnitSet.add(Ma)
+                UnitList.append(Ma)
+
+        #
+        # Leave no transaction open in the database the workers inherit.
+        #
+        self.Db.Conn.commit()
+        gAutoGenUnitList = UnitList
+        gAutoGenDatabase = self.Db
+        ProcessNumber = min(self.ThreadNumber, len(UnitList))
+        EdkLogger.verbose("Creating AutoGen files of %d modules in %d processes" % (len(UnitList), ProcessNumber))
+        Pool = multiprocessing.Pool(ProcessNumber, AutoGenWorkerInit)
+        try:
+            Results = Pool.map(AutoGenWorker, [(Index, self.Target, self.SkipAutoGen) for Index in range(len(UnitList))], 1)
+        finally:
+            Pool.close()
+            Pool.join()
+            gAutoGenUnitList = []
+            gAutoGenDatabase = None
+
+        for Index, ErrorCode, DepexGenerated, TimingEvent in Results:
+            Ma = UnitList[Index]
+            if ErrorCode == None:
+                CreateModuleAutoGenFiles(Ma, self.Target, self.SkipAutoGen, False)
+            elif ErrorCode != 0:
+                raise FatalError(ErrorCode)
+            else:
+                if TimingEvent != None:
+                    AddTimingEvents([TimingEvent])
+                #
+                # The as-built INF of the module depends on it.
+                #
+                Ma.DepexGenerated = DepexGenerated
+
+    ## Put the modules of one arch in the queue of the build tasks
+    #
+    #   @param  Pa              The PlatformAutoGen object of the arch
+    #   @param  PaList          The PlatformAutoGen objects created so far
+    #   @param  ExitFlag        The exit flag of the task scheduler
+    #
+    def _StartArchMake(self, Pa, PaList, ExitFlag):
+        GlobalData.gGlobalDefines['ARCH'] = Pa.Arch
+        for Ma in self.BuildModules:
+            if Ma.Arch != Pa.Arch:
+                continue
+            # Generate build task for the module
+            if not Ma.IsBinaryModule:
+                Bt = BuildTask.New(ModuleMakeUnit(Ma, self.Target))
+            # Break build if any build thread has error
+            if BuildTask.HasError():
+                # we need a full version of makefile for platform
+                ExitFlag.set()
+                BuildTask.WaitForComplete()
+                for ArchPa in PaList:
+                    ArchPa.CreateMakeFile(False)
+                EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
+            # Start task scheduler
+            if not BuildTask.IsOnGoing():
+                BuildTask.StartScheduler(self.ThreadNumber, ExitFlag)
+
+        # in case there's an interruption. we need a full version of makefile for platform
+        Pa.CreateMakeFile(False)
+        if BuildTask.HasError():
+            EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
+
     ## Build a platform in multi-thread mode
     #
     def _MultiThreadBuildPlatform(self):
@@ -1940,6 +2152,20 @@ class Build():
                 GlobalData.gGlobalDefines['TOOL_CHAIN_TAG'] = ToolChain
                 GlobalData.gGlobalDefines['FAMILY'] = self.ToolChainFamily[index]
                 index += 1
+
+                #
+                # Skip parsing and AutoGen if nothing has changed since the last build
+                #
+                SnapshotPath = None
+                if self._CanUseWorkspaceSnapshot():
+                    SnapshotPath = GetSnapshotPath(self.PlatformFile, BuildTarget, ToolChain, self.ArchList)
+                    SnapshotKey = GetSnapshotKey(GlobalData.gOptions, self.ToolDef, self.ArchList)
+                    Snapshot = self._RestoreWorkspaceSnapshot(SnapshotPath, SnapshotKey)
+                    if Snapshot != None:
+                        if self._BuildWorkspaceSnapshot(Snapshot, BuildTarget, ToolChain, WorkspaceAutoGenTime):
+                            continue
+                        WorkspaceAutoGenTime = time.time()
+
                 Wa = WorkspaceAutoGen(
                         self.WorkspaceDir,
                         self.PlatformFile,
@@ -1965,13 +2191,16 @@ class Build():
                 # multi-thread exit flag
                 ExitFlag = threading.Event()
                 ExitFlag.clear()
-                self.AutoGenTime += int(round((time.time() - WorkspaceAutoGenTime)))
+                AutoGenTime = time.time() - WorkspaceAutoGenTime
+                self.AutoGenTime += int(round(AutoGenTime))
+                PaList = []
                 for Arch in Wa.ArchList:
                     AutoGenStart = time.time()
                     GlobalData.gGlobalDefines['ARCH'] = Arch
                     Pa = PlatformAutoGen(Wa, self.PlatformFile, BuildTarget, ToolChain, Arch)
                     if Pa == None:
                         continue
+                    PaList.append(Pa)
                     ModuleList = []
                     for Inf in Pa.Platform.Modules:
                         ModuleList.append(Inf)
@@ -1982,6 +2211,7 @@ class Build():
                             if Inf in Pa.Platform.Modules:
                                 continue
                             ModuleList.append(Inf)
+                    AutoGenList = []
                     for Module in ModuleList:
                         # Get ModuleAutoGen object to generate C code file and makefile
                         Ma = ModuleAutoGen(Wa, Module, BuildTarget, ToolChain, Arch, self.PlatformFile)
@@ -1994,38 +2224,28 @@ class Build():
                         # Not to auto-gen for targets 'clean', 'cleanlib', 'cleanall', 'run', 'fds'
                         if self.Target not in ['clean', 'cleanlib', 'cleanall', 'run', 'fds']:
                             # for target which must generate AutoGen code and makefile
-                            if not self.SkipAutoGen or self.Target == 'genc':
-                                Ma.CreateCodeFile(True)
-                            if self.Target == "genc":
-                                continue
-
-                            if not self.SkipAutoGen or self.Target == 'genmake':
-                                Ma.CreateMakeFile(True)
-                            if self.Target == "genmake":
+                            AutoGenList.append(Ma)
+                            if self.Target in ["genc", "genmake"]:
                                 continue
                         self.BuildModules.append(Ma)
                     self.Progress.Stop("done!")
+                    self._CreateAutoGenFiles(AutoGenList)
+                    AutoGenTime += time.time() - AutoGenStart
                     self.AutoGenTime += int(round((time.time() - AutoGenStart)))
-                    MakeStart = time.time()
-                    for Ma in self.BuildModules:
-                        # Generate build task for the module
-                        if not Ma.IsBinaryModule:
-                            Bt = BuildTask.New(ModuleMakeUnit(Ma, self.Target))
-                        # Break build if any build thread has error
-                        if BuildTask.HasError():
-                            # we need a full version of makefile for platform
-                            ExitFlag.set()
-                            BuildTask.WaitForComplete()
-                            Pa.CreateMakeFile(False)
-                            EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
-                        # Start task scheduler
-                        if not BuildTask.IsOnGoing():
-                            BuildTask.StartScheduler(self.ThreadNumber, ExitFlag)
+                    if not self._UseAutoGenWorkers():
+                        MakeStart = time.time()
+                        self._StartArchMake(Pa, PaList, ExitFlag)
+                        self.MakeTime += int(round((time.time() - MakeStart)))
+                SnapshotModules = list(self.BuildModules)
 
-                    # in case there's an interruption. we need a full version of makefile for platform
-                    Pa.CreateMakeFile(False)
-                    if BuildTask.HasError():
-                        EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
+                if self._UseAutoGenWorkers():
+                    #
+                    # Schedule the make of all arches only now, so that no build thread is
+                    # running while the AutoGen worker processes are forked.
+                    #
+                    MakeStart = time.time()
+                    for Pa in PaList:
+                        self._StartArchMake(Pa, PaList, ExitFlag)
                     self.MakeTime += int(round((time.time() - MakeStart)))
 
                 MakeContiue = time.time()
@@ -2082,40 +2302,187 @@ class Build():
                         # Generate FD image if there's a FDF file found
                         #
                         GenFdsStart = time.time()
-                        LaunchCommand(Wa.GenFdsCommand, os.getcwd())
+                        LaunchGenFds(Wa.GenFdsCommand, os.getcwd(), Wa.FvDir)
 
                         #
                         # Create MAP file for all platform FVs after GenFds.
                         #
-                        self._CollectFvMapBuffer(MapBuffer, Wa, ModuleList)
+                        self._CollectFvMapBuffer(MapBuffer, Wa.FvDir, Wa.FdfProfile.FvDict.keys(), ModuleList)
                         self.GenFdsTime += int(round((time.time() - GenFdsStart)))
                     #
                     # Save MAP buffer into MAP file.
                     #
                     self._SaveMapFile(MapBuffer, Wa)
 
+                #
+                # Save the resolved platform for the next build
+                #
+                if SnapshotPath != None and self.LoadFixAddress == 0:
+                    Snapshot = WorkspaceSnapshot(SnapshotKey, self._GetWorkspaceMetaFiles(Wa), AutoGenTime)
+                    Snapshot.AddWorkspace(Wa, SnapshotModules)
+                    Snapshot.Save(SnapshotPath)
+
+    ## Check if the resolved platform can be saved to and restored from a snapshot
+    #
+    #   The snapshot is not used when the build cache is disabled, and when
+    #   modules are skipped or restored by their hash values.
+    #
+    def _CanUseWorkspaceSnapshot(self):
+        if self.DisableCache or self.Target not in ["", "all"]:
+            return False
+        if GlobalData.gUseHashCache or GlobalData.gBinCacheSource or GlobalData.gBinCacheDest:
+            return False
+        return True
+
+    ## Get the meta-data files the resolved platform of a build depends on
+    #
+    #   @param  Wa              The WorkspaceAutoGen object of the build
+    #
+    def _GetWorkspaceMetaFiles(self, Wa):
+        FileSet = set()
+        for Key in Wa.BuildDatabase._CACHE_:
+            FileSet.add(Key[0].Path)
+        for Pa in Wa.AutoGenObjectList:
+            for IncludedFile in Pa.Platform._RawData.IncludedFiles:
+                FileSet.add(IncludedFile.Path)
+        if Wa.FdfFile:
+            FileSet.add(Wa.FdfFile.Path)
+            for IncludedFile in GlobalData.gFdfParser.GetAllIncludedFile():
+                FileSet.add(IncludedFile.FileName)
+        FileSet.add(os.path.join(GlobalData.gConfDirectory, gBuildConfiguration))
+        FileSet.add(os.path.join(GlobalData.gConfDirectory, gDefaultBuildRuleFile))
+        FileSet.add(os.path.join(GlobalData.gConfDirectory, gToolsDefinition))
+        for Name in [DataType.TAB_TAT_DEFINES_BUILD_RULE_CONF, DataType.TAB_TAT_DEFINES_TOOL_CHAIN_CONF]:
+            if self.TargetTxt.TargetTxtDictionary.get(Name):
+                FileSet.add(mws.join(self.WorkspaceDir, self.TargetTxt.TargetTxtDictionary[Name]))
+        return FileSet
+
+    ## Restore the resolved platform of a build from its snapshot
+    #
+    #   A snapshot which is out of date is removed, so that a snapshot never
+    #   outlives the build it was saved by.
+    #
+    #   @retval WorkspaceSnapshot   The snapshot if it is up-to-date
+    #   @retval None                Otherwise
+    #
+    def _RestoreWorkspaceSnapshot(self, SnapshotPath, SnapshotKey):
+        Snapshot = None
+        if not self.Reparse:
+            Snapshot = RestoreSnapshot(SnapshotPath, SnapshotKey)
+        if Snapshot == None and os.path.exists(SnapshotPath):
+            os.remove(SnapshotPath)
+        return Snapshot
+
+    ## Build a platform with the modules and commands in its snapshot
+    #
+    #   The modules are made without parsing the meta-data files or generating
+    #   the AutoGen files again.
+    #
+    #   @param  Snapshot        The snapshot of the resolved platform
+    #   @param  BuildTarget     The build target
+    #   @param  ToolChain       The tool chain
+    #   @param  AutoGenStart    The time the AutoGen phase started
+    #
+    #   @retval True            The platform has been built
+    #   @retval False           The map file of a module has changed, so a full
+    #                           AutoGen is needed to update its as-built INF
+    #
+    def _BuildWorkspaceSnapshot(self, Snapshot, BuildTarget, ToolChain, AutoGenStart):
+        EdkLogger.info("Workspace snapshot is up to date, skip AutoGen of %s [%s, %s]" % (Snapshot.Name, BuildTarget, ToolChain))
+        self.Fdf = Snapshot.FdfFile
+        self.LoadFixAddress = 0
+        AutoGenTime = time.time() - AutoGenStart
+        self.AutoGenTime += int(round(AutoGenTime))
+
+        # multi-thread exit flag
+        ExitFlag = threading.Event()
+        ExitFlag.clear()
+        MakeStart = time.time()
+        for Module in Snapshot.ModuleList:
+            GlobalData.gGlobalDefines['ARCH'] = Module.Arch
+            # Generate build task for the module
+            if not Module.IsBinaryModule:
+                Bt = BuildTask.New(ModuleMakeUnit(Module, self.Target))
+            # Break build if any build thread has error
+            if BuildTask.HasError():
+                ExitFlag.set()
+                BuildTask.WaitForComplete()
+                EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
+            # Start task scheduler
+            if not BuildTask.IsOnGoing():
+                BuildTask.StartScheduler(self.ThreadNumber, ExitFlag)
+        ExitFlag.set()
+        BuildTask.WaitForComplete()
+        self.MakeTime += int(round((time.time() - MakeStart)))
+        if BuildTask.HasError():
+            EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
+
+        if not Snapshot.IsMapFileUnchanged():
+            return False
+
+        MapBuffer = StringIO('')
+        if self.Fdf:
+            GenFdsStart = time.time()
+            LaunchGenFds(Snapshot.GenFdsCommand, os.getcwd(), Snapshot.FvDir)
+            self._CollectFvMapBuffer(MapBuffer, Snapshot.FvDir, Snapshot.FvNameList, Snapshot.PlatformModules)
+            self.GenFdsTime += int(round((time.time() - GenFdsStart)))
+        self._SaveMapFile(MapBuffer, Snapshot)
+
+        #
+        # The build report needs the whole workspace
+        #
+        if self.BuildReport.ReportFile:
+            ReportStart = time.time()
+            Wa = WorkspaceAutoGen(
+                    self.WorkspaceDir,
+                    self.PlatformFile,
+                    BuildTarget,
+                    ToolChain,
+                    self.ArchList,
+                    self.BuildDatabase,
+                    self.TargetTxt,
+                    self.ToolDef,
+                    self.Fdf,
+                    self.FdList,
+                    self.FvList,
+                    self.CapList,
+                    self.SkuId,
+                    self.UniFlag,
+                    self.Progress
+                    )
+            Snapshot.CopyBuildTime(Wa)
+            AutoGenTime += time.time() - ReportStart
+            self.AutoGenTime += int(round((time.time() - ReportStart)))
+            SavedTime = int(round(max(Snapshot.AutoGenTime - AutoGenTime, 0)))
+            self.BuildReport.AddPlatformReport(Wa, None, LogBuildTime(SavedTime) or "00:00:00")
+        self.SnapshotDict[BuildTarget, ToolChain] = Snapshot
+        return True
+
     ## Generate GuidedSectionTools.txt in the FV directories.
     #
     def CreateGuidedSectionToolsFile(self):
         for BuildTarget in self.BuildTargetList:
             for ToolChain in self.ToolChainList:
-                Wa = WorkspaceAutoGen(
-                        self.WorkspaceDir,
-                        self.PlatformFile,
-                        BuildTarget,
-                        ToolChain,
-                        self.ArchList,
-                        self.BuildDatabase,
-                        self.TargetTxt,
-                        self.ToolDef,
-                        self.Fdf,
-                        self.FdList,
-                        self.FvList,
-                        self.CapList,
-                        self.SkuId,
-                        self.UniFlag
-                        )
-                FvDir = Wa.FvDir
+                if (BuildTarget, ToolChain) in self.SnapshotDict:
+                    FvDir = self.SnapshotDict[BuildTarget, ToolChain].FvDir
+                else:
+                    Wa = WorkspaceAutoGen(
+                            self.WorkspaceDir,
+                            self.PlatformFile,
+                            BuildTarget,
+                            ToolChain,
+                            self.ArchList,
+                            self.BuildDatabase,
+                            self.TargetTxt,
+                            self.ToolDef,
+                            self.Fdf,
+                            self.FdList,
+                            self.FvList,
+                            self.CapList,
+                            self.SkuId,
+                            self.UniFlag
+                            )
+                    FvDir = Wa.FvDir
                 if not os.path.exists(FvDir):
                     continue
 
@@ -2300,8 +2667,8 @@ def MyOptionParser():
     Parser.add_option("-D", "--define", action="append", type="string", dest="Macros", help="Macro: \"Name [= Value]\".")
 
     Parser.add_option("-y", "--report-file", action="store", dest="ReportFile", help="Create/overwrite the report to the specified filename.")
-    Parser.add_option("-Y", "--report-type", action="append", type="choice", choices=['PCD','LIBRARY','FLASH','DEPEX','BUILD_FLAGS','FIXED_ADDRESS','HASH','EXECUTION_ORDER'], dest="ReportType", default=[],
-        help="Flags that control the type of build report to generate.  Must be one of: [PCD, LIBRARY, FLASH, DEPEX, BUILD_FLAGS, FIXED_ADDRESS, HASH, EXECUTION_ORDER].  "\
+    Parser.add_option("-Y", "--report-type", action="append", type="choice", choices=['PCD','LIBRARY','FLASH','DEPEX','BUILD_FLAGS','FIXED_ADDRESS','HASH','EXECUTION_ORDER','TIMING'], dest="ReportType", default=[],
+        help="Flags that control the type of build report to generate.  Must be one of: [PCD, LIBRARY, FLASH, DEPEX, BUILD_FLAGS, FIXED_ADDRESS, HASH, EXECUTION_ORDER, TIMING].  "\
              "To specify more than one flag, repeat this option on the command line and the default flag set is [PCD, LIBRARY, FLASH, DEPEX, HASH, BUILD_FLAGS, FIXED_ADDRESS]")
     Parser.add_option("-F", "--flag", action="store", type="string", dest="Flag",
         help="Specify the specific option to parse EDK UNI file. Must be one of: [-c, -s]. -c is for EDK framework UNI file, and -s is for EDK UEFI UNI file. "\
@@ -2316,6 +2683,8 @@ def MyOptionParser():
     Parser.add_option("--hash", action="store_true", dest="UseHashCache", default=False, help="Enable hash-based caching during build process.")
     Parser.add_option("--binary-destination", action="store", type="string", dest="BinCacheDest", help="Generate a cache of binary files in the specified directory.")
     Parser.add_option("--binary-source", action="store", type="string", dest="BinCacheSource", help="Consume a cache of binary files from the specified directory.")
+    Parser.add_option("--incremental-fv", action="store_true", dest="IncrementalFv", default=False,
+        help="Let GenFv reuse the previous FV images and only add the FFS files that changed.")
 
     (Opt, Args) = Parser.parse_args()
     return (Opt, Args)
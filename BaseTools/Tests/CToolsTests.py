@@ -20,8 +20,16 @@ import sys
 import unittest
 
 import TianoCompress
+import LzmaCompress
+import GenFv
+import SectionLib
+import EfiCompress
 modules = (
     TianoCompress,
+    LzmaCompress,
+    GenFv,
+    SectionLib,
+    EfiCompress,
     )
 
 
@@ -0,0 +1,99 @@
+## @file
+#  Unit tests for Common.BuildTiming
+#
+#  Copyright (c) 2026 Baikal Electronics JSC
+#
+#  This program and the accompanying materials
+#  are licensed and made available under the terms and conditions of the BSD License
+#  which accompanies this distribution.  The full text of the license may be found at
+#  http://opensource.org/licenses/bsd-license.php
+#
+#  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import json
+import unittest
+
+import TestTools
+
+from Common.BuildTiming import AssignTimingLanes
+from Common.BuildTiming import GetCriticalPath
+from Common.BuildTiming import GetTimingTotals
+from Common.BuildTiming import LoadTimingEvents
+from Common.BuildTiming import SaveChromeTrace
+from Common.BuildTiming import SaveTimingEvents
+from Common.BuildTiming import TIMING_FFS
+from Common.BuildTiming import TIMING_MAKE
+
+def MakeEvent(Category, Name, Start, End, Track=None, Dependencies=[]):
+    return {"Category" : Category, "Name" : Name, "Start" : Start, "End" : End,
+            "Track" : Track, "Dependencies" : Dependencies}
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        #
+        # Lib is made first, then A and B at the same time. C needs both.
+        #
+        self.events = [
+            MakeEvent(TIMING_MAKE, 'Lib', 100.0, 101.0),
+            MakeEvent(TIMING_MAKE, 'A', 101.0, 103.0, Dependencies=['Lib']),
+            MakeEvent(TIMING_MAKE, 'B', 101.5, 102.0, Dependencies=['Lib']),
+            MakeEvent(TIMING_MAKE, 'C', 103.5, 104.0, Dependencies=['A', 'B']),
+            MakeEvent(TIMING_FFS, 'A.inf', 105.0, 105.5, 'GenFds'),
+            MakeEvent(TIMING_FFS, 'A.inf', 106.0, 106.25, 'GenFds'),
+            ]
+
+    def testCriticalPath(self):
+        path = [event['Name'] for event in GetCriticalPath(self.events)]
+        self.assertTrue(path == ['Lib', 'A', 'C'])
+        self.assertTrue(GetCriticalPath([]) == [])
+
+    def testCyclicDependencies(self):
+        events = [
+            MakeEvent(TIMING_MAKE, 'A', 0.0, 1.0, Dependencies=['B']),
+            MakeEvent(TIMING_MAKE, 'B', 1.0, 2.0, Dependencies=['A']),
+            ]
+        path = [event['Name'] for event in GetCriticalPath(events)]
+        self.assertTrue(path == ['A', 'B'])
+
+    def testTotals(self):
+        totals = GetTimingTotals(self.events, TIMING_FFS)
+        self.assertTrue(totals == {'A.inf' : 0.75})
+
+    def testLanes(self):
+        lanes = AssignTimingLanes(self.events)
+        self.assertTrue(lanes[0] == lanes[1])
+        self.assertTrue(lanes[1] != lanes[2])
+        self.assertTrue(lanes[3] in (lanes[1], lanes[2]))
+        self.assertTrue(lanes[4] == lanes[5] == 'FFS GenFds')
+
+    def testSaveAndLoad(self):
+        path = self.GetTmpFilePath('timing.json')
+        SaveTimingEvents(path, self.events)
+        self.assertTrue(LoadTimingEvents(path) == self.events)
+        self.WriteTmpFile('timing.json', '{')
+        self.assertTrue(LoadTimingEvents(path) == [])
+        self.assertTrue(LoadTimingEvents(self.GetTmpFilePath('missing.json')) == [])
+
+    def testChromeTrace(self):
+        path = self.GetTmpFilePath('build.trace.json')
+        SaveChromeTrace(path, self.events)
+        trace = json.loads(self.ReadTmpFile('build.trace.json'))
+        complete = [event for event in trace['traceEvents'] if event['ph'] == 'X']
+        names = [event for event in trace['traceEvents'] if event['ph'] == 'M']
+        self.assertTrue(len(complete) == len(self.events))
+        self.assertTrue(complete[0]['ts'] == 0 and complete[0]['dur'] == 1000000)
+        self.assertTrue(len(names) == len(set(AssignTimingLanes(self.events).values())))
+        self.assertTrue(set(event['tid'] for event in complete) == set(event['tid'] for event in names))
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
@@ -0,0 +1,115 @@
+## @file
+#  Unit tests for Workspace.WorkspaceSnapshot
+#
+#  Copyright (c) 2026 Baikal Electronics JSC
+#
+#  This program and the accompanying materials
+#  are licensed and made available under the terms and conditions of the BSD License
+#  which accompanies this distribution.  The full text of the license may be found at
+#  http://opensource.org/licenses/bsd-license.php
+#
+#  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import os
+import unittest
+
+import TestTools
+
+import Common.GlobalData as GlobalData
+from Workspace.WorkspaceSnapshot import GetSnapshotPath
+from Workspace.WorkspaceSnapshot import RestoreSnapshot
+from Workspace.WorkspaceSnapshot import SnapshotModule
+from Workspace.WorkspaceSnapshot import WorkspaceSnapshot
+
+from Common import EdkLogger
+EdkLogger.InitializeForUnitTest()
+
+class ModuleStub(object):
+    def __init__(self, testDir, name):
+        self.MetaFile = os.path.join(testDir, name + '.inf')
+        self.Arch = 'X64'
+        self.BuildTarget = 'DEBUG'
+        self.ToolChain = 'GCC5'
+        self.Name = name
+        self.Guid = '00000000-0000-0000-0000-000000000000'
+        self.IsLibrary = False
+        self.IsBinaryModule = False
+        self.BuildCommand = ['make']
+        self.MakeFileDir = testDir
+        self.DebugDir = testDir
+        self.OutputDir = testDir
+
+    def GetTimeStampPath(self):
+        return os.path.join(self.MakeFileDir, self.Name + '.TimeStamp')
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        GlobalData.gDatabasePath = self.GetTmpFilePath('build.db')
+        self.snapshotPath = GetSnapshotPath('Platform.dsc', 'DEBUG', 'GCC5', ['X64'])
+
+    def SaveSnapshot(self, files, modules=[]):
+        snapshot = WorkspaceSnapshot('key', [self.GetTmpFilePath(name) for name in files], 10.0)
+        snapshot.ModuleList = modules
+        snapshot.Save(self.snapshotPath)
+
+    def testRestore(self):
+        self.WriteTmpFile('Platform.dsc', '[Defines]\n')
+        self.WriteTmpFile('Module.inf', '[Defines]\n')
+        self.SaveSnapshot(['Platform.dsc', 'Module.inf'])
+        snapshot = RestoreSnapshot(self.snapshotPath, 'key')
+        self.assertTrue(snapshot is not None)
+        self.assertTrue(snapshot.AutoGenTime == 10.0)
+        self.assertTrue(RestoreSnapshot(self.snapshotPath, 'other key') is None)
+
+    def testChangedMetaFile(self):
+        self.WriteTmpFile('Platform.dsc', '[Defines]\n')
+        self.WriteTmpFile('Module.inf', '[Defines]\n')
+        self.SaveSnapshot(['Platform.dsc', 'Module.inf'])
+        self.WriteTmpFile('Module.inf', '[Defines]\n[Sources]\n')
+        self.assertTrue(RestoreSnapshot(self.snapshotPath, 'key') is None)
+
+    def testMissingMetaFile(self):
+        self.WriteTmpFile('Platform.dsc', '[Defines]\n')
+        self.SaveSnapshot(['Platform.dsc', 'Include.dsc'])
+        self.assertTrue(RestoreSnapshot(self.snapshotPath, 'key') is not None)
+        self.WriteTmpFile('Include.dsc', '[Defines]\n')
+        self.assertTrue(RestoreSnapshot(self.snapshotPath, 'key') is None)
+
+    def testModuleAutoGen(self):
+        self.WriteTmpFile('Platform.dsc', '[Defines]\n')
+        self.WriteTmpFile('Source.c', '')
+        module = ModuleStub(self.testDir, 'Module')
+        self.WriteTmpFile('Module.TimeStamp', self.GetTmpFilePath('Source.c') + '\n')
+        self.SaveSnapshot(['Platform.dsc'], [SnapshotModule(module)])
+        self.assertTrue(RestoreSnapshot(self.snapshotPath, 'key') is not None)
+
+        #
+        # A source file newer than the AutoGen files of its module
+        #
+        timeStamp = os.stat(module.GetTimeStampPath()).st_mtime
+        os.utime(self.GetTmpFilePath('Source.c'), (timeStamp + 10, timeStamp + 10))
+        self.assertTrue(RestoreSnapshot(self.snapshotPath, 'key') is None)
+
+        os.remove(module.GetTimeStampPath())
+        self.assertTrue(RestoreSnapshot(self.snapshotPath, 'key') is None)
+
+    def testMapFile(self):
+        self.WriteTmpFile('Module.map', 'map')
+        snapshot = WorkspaceSnapshot('key', [], 10.0)
+        snapshot.ModuleList = [SnapshotModule(ModuleStub(self.testDir, 'Module'))]
+        self.assertTrue(snapshot.IsMapFileUnchanged())
+        self.WriteTmpFile('Module.map', 'new map')
+        self.assertFalse(snapshot.IsMapFileUnchanged())
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
@@ -0,0 +1,119 @@
+## @file
+# Unit tests for the EFI and Tiano encoders of BaseTools/Source/C/Common
+#
+#  Copyright (c) 2026 Baikal Electronics JSC
+#
+#  This program and the accompanying materials
+#  are licensed and made available under the terms and conditions of the BSD License
+#  which accompanies this distribution.  The full text of the license may be found at
+#  http://opensource.org/licenses/bsd-license.php
+#
+#  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import ctypes
+import os
+import random
+import sys
+import unittest
+
+import TestTools
+
+from Common.BaseToolsLib import GetLibraryName
+
+EFI_BUFFER_TOO_SMALL = (1 << (8 * ctypes.sizeof(ctypes.c_size_t) - 1)) | 5
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        name = GetLibraryName()
+        if name is None:
+            self.skipTest('libBaseTools is not built on this host')
+        path = os.path.join(TestTools.BaseToolsDir, 'Source', 'C', 'bin', name)
+        if not os.path.exists(path):
+            self.skipTest('%s is not built' % path)
+        #
+        # libBaseTools links Compress.c and Decompress.c of Common
+        #
+        self.lib = ctypes.CDLL(path)
+        for function in ('EfiCompress', 'TianoCompress', 'EfiGetInfo', 'TianoGetInfo',
+                         'EfiDecompress', 'TianoDecompress'):
+            getattr(self.lib, function).restype = ctypes.c_size_t
+
+    def compress(self, function, data):
+        size = ctypes.c_uint32(len(data) + 0x1000)
+        while True:
+            output = ctypes.create_string_buffer(size.value)
+            status = function(data, len(data), output, ctypes.byref(size))
+            if status != EFI_BUFFER_TOO_SMALL:
+                break
+        self.assertTrue(status == 0)
+        return output.raw[:size.value]
+
+    def decompress(self, getInfo, function, data):
+        dstSize = ctypes.c_uint32(0)
+        scratchSize = ctypes.c_uint32(0)
+        self.assertTrue(getInfo(data, len(data), ctypes.byref(dstSize), ctypes.byref(scratchSize)) == 0)
+        output = ctypes.create_string_buffer(max(dstSize.value, 1))
+        scratch = ctypes.create_string_buffer(scratchSize.value)
+        self.assertTrue(function(data, len(data), output, dstSize, scratch, scratchSize) == 0)
+        return output.raw[:dstSize.value]
+
+    def compressionTestCycle(self, data):
+        compressed = self.compress(self.lib.EfiCompress, data)
+        finish = self.decompress(self.lib.EfiGetInfo, self.lib.EfiDecompress, compressed)
+        self.assertTrue(finish == data)
+
+        compressed = self.compress(self.lib.TianoCompress, data)
+        finish = self.decompress(self.lib.TianoGetInfo, self.lib.TianoDecompress, compressed)
+        self.assertTrue(finish == data)
+
+        #
+        # The decoder of the TianoCompress tool is not built from Decompress.c
+        #
+        f = self.OpenTmpFile('input', 'wb')
+        f.write(compressed)
+        f.close()
+        result = self.RunTool(
+            '-d',
+            '-o', self.GetTmpFilePath('output'),
+            self.GetTmpFilePath('input'),
+            toolName='TianoCompress'
+            )
+        self.assertTrue(result == 0)
+        f = self.OpenTmpFile('output', 'rb')
+        finish = f.read()
+        f.close()
+        self.assertTrue(finish == data)
+
+    def testTinyData(self):
+        for data in ('', 'a', 'abc', '\0' * 4):
+            self.compressionTestCycle(data)
+
+    def testRandomDataCycles(self):
+        for i in range(8):
+            self.compressionTestCycle(self.GetRandomString(1024, 2048))
+        self.compressionTestCycle(self.GetRandomString(0x10000, 0x20000))
+
+    def testRepetitiveDataCycles(self):
+        self.compressionTestCycle('\0' * 0x40000)
+        self.compressionTestCycle('\xff\x00' * 0x8000 + 'abc' * 0x4000)
+        #
+        # Matches of the longest length and at the largest distances of
+        # the EFI (8KB) and Tiano (512KB) windows
+        #
+        block = self.GetRandomString(0x1000, 0x1000)
+        self.compressionTestCycle(block * 0x90)
+        block = self.GetRandomString(0x2000, 0x2000)
+        self.compressionTestCycle(block + self.GetRandomString(0x7E000, 0x7E000) + block * 2)
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
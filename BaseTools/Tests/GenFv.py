@@ -0,0 +1,139 @@
+## @file
+# Unit tests for GenFv utility
+#
+#  Copyright (c) 2026 Baikal Electronics JSC
+#
+#  This program and the accompanying materials
+#  are licensed and made available under the terms and conditions of the BSD License
+#  which accompanies this distribution.  The full text of the license may be found at
+#  http://opensource.org/licenses/bsd-license.php
+#
+#  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import os
+import random
+import sys
+import unittest
+
+import TestTools
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        self.toolName = 'GenFv'
+        self.alignments = [None, '4K', '16', None, '1K', '8']
+
+    def testHelp(self):
+        result = self.RunTool('--help', logFile='help')
+        self.assertTrue(result == 0)
+
+    def readBinaryFile(self, fileName):
+        f = self.OpenTmpFile(fileName, 'rb')
+        data = f.read()
+        f.close()
+        return data
+
+    def makeFfsFile(self, index, size):
+        name = 'file%d' % index
+        f = self.OpenTmpFile(name + '.bin', 'wb')
+        f.write(self.GetRandomString(size, size))
+        f.close()
+        result = self.RunTool(
+            '-s', 'EFI_SECTION_RAW',
+            '-o', self.GetTmpFilePath(name + '.sec'),
+            self.GetTmpFilePath(name + '.bin'),
+            toolName='GenSec'
+            )
+        self.assertTrue(result == 0)
+        args = [
+            '-t', 'EFI_FV_FILETYPE_FREEFORM',
+            '-g', '%08X-0000-0000-0000-000000000000' % (index + 1),
+            '-o', self.GetTmpFilePath(name + '.ffs'),
+            '-i', self.GetTmpFilePath(name + '.sec')
+            ]
+        if self.alignments[index] is not None:
+            args = ['-a', self.alignments[index]] + args
+        result = self.RunTool(*args, toolName='GenFfs')
+        self.assertTrue(result == 0)
+
+    def writeFvInf(self):
+        inf = '[options]\nEFI_BLOCK_SIZE = 0x1000\nEFI_NUM_BLOCKS = 0x20\n'
+        inf += 'EFI_BASE_ADDRESS = 0xFFE00000\n'
+        inf += '[attributes]\nEFI_ERASE_POLARITY = 1\n[files]\n'
+        for index in range(len(self.alignments)):
+            inf += 'EFI_FILE_NAME = %s\n' % self.GetTmpFilePath('file%d.ffs' % index)
+        self.WriteTmpFile('fv.inf', inf)
+
+    def generateFv(self, output, incremental):
+        args = ['-i', self.GetTmpFilePath('fv.inf'), '-o', self.GetTmpFilePath(output)]
+        if incremental:
+            args = ['--incremental'] + args
+        result = self.RunTool(*args)
+        self.assertTrue(result == 0)
+
+    def checkIncrementalFv(self):
+        self.generateFv('incremental.fv', True)
+        self.generateFv('full.fv', False)
+        for suffix in ('', '.map', '.txt'):
+            incremental = self.readBinaryFile('incremental.fv' + suffix)
+            full = self.readBinaryFile('full.fv' + suffix)
+            if incremental != full:
+                print
+                print 'Incremental and full builds of %s differ' % ('fv' + suffix)
+            self.assertTrue(incremental == full)
+        for suffix in ('.map.tmp', '.txt.tmp'):
+            self.assertFalse(os.path.exists(self.GetTmpFilePath('incremental.fv' + suffix)))
+
+    def fvLayoutDigest(self, data):
+        digest = 0xCBF29CE484222325
+        for c in data:
+            digest = ((digest ^ ord(c)) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+        return digest
+
+    def forgeFvLayoutDigest(self, index):
+        #
+        # Record the digest of the new contents of a file in the layout of the
+        # previous FV image, like a digest collision would
+        #
+        digest = '%016x' % self.fvLayoutDigest(self.readBinaryFile('file%d.ffs' % index))
+        lines = self.readBinaryFile('incremental.fv.layout').split('\n')
+        files = [i for i in range(len(lines)) if lines[i].startswith('File = ')]
+        fields = lines[files[index]].split(' ')
+        fields[3] = digest
+        lines[files[index]] = ' '.join(fields)
+        self.WriteTmpFile('incremental.fv.layout', '\n'.join(lines))
+
+    def testIncrementalFv(self):
+        sizes = [random.randint(64, 4096) for index in self.alignments]
+        for index in range(len(self.alignments)):
+            self.makeFfsFile(index, sizes[index])
+        self.writeFvInf()
+        self.checkIncrementalFv()
+
+        #
+        # Unchanged files, a file with new contents of the same size,
+        # and files whose new size moves the following files
+        #
+        self.checkIncrementalFv()
+        self.makeFfsFile(1, sizes[1])
+        self.checkIncrementalFv()
+        self.makeFfsFile(3, sizes[3])
+        self.forgeFvLayoutDigest(3)
+        self.checkIncrementalFv()
+        self.makeFfsFile(2, sizes[2] + 1000)
+        self.checkIncrementalFv()
+        self.makeFfsFile(4, sizes[4] - 40)
+        self.checkIncrementalFv()
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
+
@@ -0,0 +1,86 @@
+## @file
+# Unit tests for LzmaCompress utility
+#
+#  Copyright (c) 2026 Baikal Electronics JSC
+#
+#  This program and the accompanying materials
+#  are licensed and made available under the terms and conditions of the BSD License
+#  which accompanies this distribution.  The full text of the license may be found at
+#  http://opensource.org/licenses/bsd-license.php
+#
+#  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import os
+import random
+import sys
+import unittest
+
+import TestTools
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        self.toolName = 'LzmaCompress'
+
+    def testHelp(self):
+        result = self.RunTool('--help', logFile='help')
+        self.assertTrue(result == 0)
+
+    def testInvalidThreads(self):
+        self.WriteTmpFile('input', self.GetRandomString(16, 32))
+        result = self.RunTool(
+            '-e', '--threads', '0',
+            '-o', self.GetTmpFilePath('output'),
+            self.GetTmpFilePath('input'),
+            logFile='threads'
+            )
+        self.assertTrue(result != 0)
+
+    def compressionTestCycle(self, data, threads):
+        self.WriteTmpFile('input', data)
+        result = self.RunTool(
+            '-e', '-q', '--threads', str(threads),
+            '-o', self.GetTmpFilePath('output1'),
+            self.GetTmpFilePath('input')
+            )
+        self.assertTrue(result == 0)
+        result = self.RunTool(
+            '-d', '-q',
+            '-o', self.GetTmpFilePath('output2'),
+            self.GetTmpFilePath('output1')
+            )
+        self.assertTrue(result == 0)
+        self.assertTrue(self.ReadTmpFile('input') == self.ReadTmpFile('output2'))
+        return self.ReadTmpFile('output1')
+
+    def testThreadedOutputMatches(self):
+        #
+        # Repeat random blocks so that the match finder has work to do
+        #
+        blocks = [self.GetRandomString(512, 4096) for i in range(16)]
+        data = ''.join([random.choice(blocks) for i in range(256)])
+        single = self.compressionTestCycle(data, 1)
+        multi = self.compressionTestCycle(data, 2)
+        if single != multi:
+            print
+            print 'Output of --threads 2 did not match --threads 1'
+        self.assertTrue(single == multi)
+
+    def testRandomDataCycles(self):
+        for i in range(4):
+            data = self.GetRandomString(1024, 2048)
+            self.compressionTestCycle(data, 2)
+            self.CleanUpTmpDir()
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
+
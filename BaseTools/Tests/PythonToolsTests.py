@@ -26,6 +26,10 @@ def TheTestSuite():
     suites.append(CheckPythonSyntax.TheTestSuite())
     import CheckUnicodeSourceFiles
     suites.append(CheckUnicodeSourceFiles.TheTestSuite())
+    import CheckWorkspaceSnapshot
+    suites.append(CheckWorkspaceSnapshot.TheTestSuite())
+    import CheckBuildTiming
+    suites.append(CheckBuildTiming.TheTestSuite())
     return unittest.TestSuite(suites)
 
 if __name__ == '__main__':
@@ -0,0 +1,161 @@
+## @file
+# Unit tests for the section routines of libBaseTools
+#
+#  Copyright (c) 2026 Baikal Electronics JSC
+#
+#  This program and the accompanying materials
+#  are licensed and made available under the terms and conditions of the BSD License
+#  which accompanies this distribution.  The full text of the license may be found at
+#  http://opensource.org/licenses/bsd-license.php
+#
+#  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+##
+# Import Modules
+#
+import os
+import random
+import sys
+import unittest
+
+import TestTools
+
+from Common.BaseToolsLib import BaseToolsLib
+from Common.BaseToolsLib import GetLibraryName
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        name = GetLibraryName()
+        if name is None:
+            self.skipTest('libBaseTools is not built on this host')
+        path = os.path.join(TestTools.BaseToolsDir, 'Source', 'C', 'bin', name)
+        if not os.path.exists(path):
+            self.skipTest('%s is not built' % path)
+        self.lib = BaseToolsLib(path)
+
+    def readBinaryFile(self, fileName):
+        f = self.OpenTmpFile(fileName, 'rb')
+        data = f.read()
+        f.close()
+        return data
+
+    def makeInputs(self, count, minlen=1, maxlen=0x800):
+        inputs = []
+        for index in range(count):
+            name = 'input%d.bin' % index
+            data = self.GetRandomString(minlen, maxlen)
+            f = self.OpenTmpFile(name, 'wb')
+            f.write(data)
+            f.close()
+            inputs.append((self.GetTmpFilePath(name), data))
+        return inputs
+
+    def checkSection(self, inputs, args, **kwd):
+        output = self.GetTmpFilePath('output.sec')
+        args = list(args) + ['-o', output] + [path for (path, data) in inputs]
+        result = self.RunTool(*args, toolName='GenSec')
+        self.assertTrue(result == 0)
+        section = self.lib.GenerateSection([data for (path, data) in inputs], **kwd)
+        self.assertTrue(section == self.readBinaryFile('output.sec'))
+        return section
+
+    def checkFfs(self, inputs, args, **kwd):
+        output = self.GetTmpFilePath('output.ffs')
+        args = list(args) + ['-o', output]
+        for (path, data) in inputs:
+            args += ['-i', path]
+        result = self.RunTool(*args, toolName='GenFfs')
+        self.assertTrue(result == 0)
+        ffs = self.lib.GenerateFfs([data for (path, data) in inputs], **kwd)
+        self.assertTrue(ffs == self.readBinaryFile('output.ffs'))
+
+    def testLeafSection(self):
+        inputs = self.makeInputs(1)
+        section = self.checkSection(inputs, ['-s', 'EFI_SECTION_RAW'], Type='EFI_SECTION_RAW')
+        self.assertTrue(len(section) == len(inputs[0][1]) + 4)
+        self.checkSection(inputs, ['-s', 'EFI_SECTION_PE32'], Type='EFI_SECTION_PE32')
+
+    def testAlignedSections(self):
+        inputs = self.makeInputs(4)
+        align = ['16', '1', '4K', '8']
+        args = []
+        for a in align:
+            args += ['--sectionalign', a]
+        self.checkSection(inputs, args, InputAlign=align)
+
+    def testCompressionSection(self):
+        inputs = self.makeInputs(3)
+        for compression in ('PI_STD', 'PI_NONE'):
+            self.checkSection(
+                inputs,
+                ['-s', 'EFI_SECTION_COMPRESSION', '-c', compression],
+                Type='EFI_SECTION_COMPRESSION',
+                CompressionType=compression
+                )
+
+    def testGuidDefinedSection(self):
+        inputs = self.makeInputs(2)
+        self.checkSection(inputs, ['-s', 'EFI_SECTION_GUID_DEFINED'], Type='EFI_SECTION_GUID_DEFINED')
+        guid = 'A31280AD-481E-41B6-95E8-127F4C984779'
+        self.checkSection(
+            inputs,
+            ['-s', 'EFI_SECTION_GUID_DEFINED', '-g', guid, '-r', 'PROCESSING_REQUIRED', '-l', '0x20'],
+            Type='EFI_SECTION_GUID_DEFINED',
+            Guid=guid,
+            GuidAttr=['PROCESSING_REQUIRED'],
+            GuidHdrLen='0x20'
+            )
+
+    def testFfsFile(self):
+        inputs = self.makeInputs(3)
+        guid = '%08X-0000-0000-0000-000000000000' % random.randint(1, 0xFFFFFFFF)
+        args = ['-t', 'EFI_FV_FILETYPE_FREEFORM', '-g', guid]
+        self.checkFfs(inputs, args, Type='EFI_FV_FILETYPE_FREEFORM', Guid=guid)
+        self.checkFfs(
+            inputs,
+            args + ['-x', '-s', '-a', '4K'],
+            Type='EFI_FV_FILETYPE_FREEFORM',
+            Guid=guid,
+            Fixed=True,
+            CheckSum=True,
+            Align='4K'
+            )
+
+    def testAlignedFfsFile(self):
+        inputs = self.makeInputs(3)
+        guid = '%08X-0000-0000-0000-000000000000' % random.randint(1, 0xFFFFFFFF)
+        align = ['32', None, '1K']
+        args = ['-t', 'EFI_FV_FILETYPE_FREEFORM', '-g', guid, '-o', self.GetTmpFilePath('output.ffs')]
+        for index in range(len(inputs)):
+            args += ['-i', inputs[index][0]]
+            if align[index] is not None:
+                args += ['-n', align[index]]
+        for fixed in (False, True):
+            result = self.RunTool(*(args + (['-x'] if fixed else [])), toolName='GenFfs')
+            self.assertTrue(result == 0)
+            ffs = self.lib.GenerateFfs(
+                [data for (path, data) in inputs],
+                'EFI_FV_FILETYPE_FREEFORM',
+                guid,
+                Fixed=fixed,
+                SectionAlign=align
+                )
+            self.assertTrue(ffs == self.readBinaryFile('output.ffs'))
+
+    def testInvalidFfsFile(self):
+        #
+        # A PEIM without a PE32 or TE section
+        #
+        rawSection = '\x08\x00\x00\x19' + self.GetRandomString(4, 4)
+        guid = '00000001-0000-0000-0000-000000000000'
+        self.assertTrue(self.lib.GenerateFfs([rawSection], 'EFI_FV_FILETYPE_PEIM', guid) is None)
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
@@ -0,0 +1,336 @@
+/** @file
+  A shell application that measures the throughput of the cryptographic
+  primitives provided by BaseCryptLib.
+
+  It reports the SHA-1, SHA-256 and SHA-512 hash and the AES-128/256-CBC
+  encryption throughput in MB/s, and the RSA-2048 PKCS#1 v1.5 signature
+  verification rate in operations per second. Running it against OpensslLib.inf
+  and OpensslLibAccel.inf shows what the OpenSSL assembly gains on a platform.
+
+  Copyright (c) 2026 Baikal Electronics JSC
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Uefi.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/PrintLib.h>
+#include <Library/BenchmarkLib.h>
+#include <Library/BaseCryptLib.h>
+
+#define CRYPTO_BENCHMARK_BUFFER_SIZE     SIZE_1MB
+#define CRYPTO_BENCHMARK_ITERATIONS      32
+#define CRYPTO_BENCHMARK_RSA_BITS        2048
+#define CRYPTO_BENCHMARK_RSA_ITERATIONS  1000
+
+typedef
+BOOLEAN
+(EFIAPI *HASH_ALL_FUNCTION) (
+  IN   CONST VOID                  *Data,
+  IN   UINTN                       DataSize,
+  OUT  UINT8                       *HashValue
+  );
+
+typedef struct {
+  CHAR16                           *Name;
+  HASH_ALL_FUNCTION                HashAll;
+} HASH_BENCHMARK;
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST HASH_BENCHMARK mHashBenchmarks[] = {
+  { L"SHA-1",   Sha1HashAll   },
+  { L"SHA-256", Sha256HashAll },
+  { L"SHA-512", Sha512HashAll }
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 mAesKey[32] = {
+  0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+  0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 mAesIvec[16] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST CHAR8 mRsaMessage[] = "EDK II cryptographic benchmark";
+
+/**
+  Print the throughput of a bulk operation.
+
+  @param[in]  Name         The name of the operation.
+  @param[in]  Bytes        The number of bytes processed.
+  @param[in]  Start        The performance counter value at the start.
+  @param[in]  End          The performance counter value at the end.
+
+**/
+VOID
+PrintThroughput (
+  IN  CHAR16                       *Name,
+  IN  UINT64                       Bytes,
+  IN  UINT64                       Start,
+  IN  UINT64                       End
+  )
+{
+  CHAR16                           Label[32];
+
+  UnicodeSPrint (Label, sizeof (Label), L"%-14s", Name);
+  BenchmarkPrintThroughput (Label, Bytes, BenchmarkElapsedNanoSecond (Start, End));
+}
+
+/**
+  Measure the throughput of the hash algorithms.
+
+  @param[in]  Buffer       The data to hash.
+  @param[in]  Length       The number of bytes in the buffer.
+
+  @retval EFI_SUCCESS      The measurement completed.
+  @retval EFI_ABORTED      A hash operation failed.
+
+**/
+EFI_STATUS
+BenchmarkHash (
+  IN  UINT8                        *Buffer,
+  IN  UINTN                        Length
+  )
+{
+  UINT8                            Digest[SHA512_DIGEST_SIZE];
+  UINTN                            Algorithm;
+  UINTN                            Index;
+  UINT64                           Start;
+  UINT64                           End;
+
+  for (Algorithm = 0; Algorithm < ARRAY_SIZE (mHashBenchmarks); Algorithm++) {
+    Start = GetPerformanceCounter ();
+    for (Index = 0; Index < CRYPTO_BENCHMARK_ITERATIONS; Index++) {
+      if (!mHashBenchmarks[Algorithm].HashAll (Buffer, Length, Digest)) {
+        Print (L"%s failed\n", mHashBenchmarks[Algorithm].Name);
+        return EFI_ABORTED;
+      }
+    }
+    End = GetPerformanceCounter ();
+
+    PrintThroughput (
+      mHashBenchmarks[Algorithm].Name,
+      MultU64x32 (Length, CRYPTO_BENCHMARK_ITERATIONS),
+      Start,
+      End
+      );
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Measure the AES-CBC encryption throughput for one key length.
+
+  @param[in]  Name         The name of the operation.
+  @param[in]  KeyLength    The key length in bits.
+  @param[in]  Buffer       The data to encrypt.
+  @param[in]  Output       The buffer receiving the cipher text.
+  @param[in]  Length       The number of bytes in the buffers.
+
+  @retval EFI_SUCCESS          The measurement completed.
+  @retval EFI_OUT_OF_RESOURCES The AES context could not be allocated.
+  @retval EFI_ABORTED          An AES operation failed.
+
+**/
+EFI_STATUS
+BenchmarkAesCbc (
+  IN  CHAR16                       *Name,
+  IN  UINTN                        KeyLength,
+  IN  UINT8                        *Buffer,
+  IN  UINT8                        *Output,
+  IN  UINTN                        Length
+  )
+{
+  VOID                             *AesContext;
+  UINTN                            Index;
+  UINT64                           Start;
+  UINT64                           End;
+  EFI_STATUS                       Status;
+
+  AesContext = AllocatePool (AesGetContextSize ());
+  if (AesContext == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = EFI_SUCCESS;
+  if (!AesInit (AesContext, mAesKey, KeyLength)) {
+    Print (L"%s key setup failed\n", Name);
+    Status = EFI_ABORTED;
+    goto Done;
+  }
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < CRYPTO_BENCHMARK_ITERATIONS; Index++) {
+    if (!AesCbcEncrypt (AesContext, Buffer, Length, mAesIvec, Output)) {
+      Print (L"%s failed\n", Name);
+      Status = EFI_ABORTED;
+      goto Done;
+    }
+  }
+  End = GetPerformanceCounter ();
+
+  PrintThroughput (Name, MultU64x32 (Length, CRYPTO_BENCHMARK_ITERATIONS), Start, End);
+
+Done:
+  FreePool (AesContext);
+  return Status;
+}
+
+/**
+  Measure the RSA PKCS#1 v1.5 signature verification rate.
+
+  A fresh key pair is generated and one SHA-256 signature is made with it,
+  then the signature is verified repeatedly.
+
+  @retval EFI_SUCCESS          The measurement completed.
+  @retval EFI_OUT_OF_RESOURCES The RSA context or signature could not be allocated.
+  @retval EFI_ABORTED          An RSA operation failed.
+
+**/
+EFI_STATUS
+BenchmarkRsaVerify (
+  VOID
+  )
+{
+  VOID                             *Rsa;
+  UINT8                            Digest[SHA256_DIGEST_SIZE];
+  UINT8                            *Signature;
+  UINTN                            SigSize;
+  UINTN                            Index;
+  UINT64                           Start;
+  UINT64                           End;
+  UINT64                           Elapsed;
+  UINT64                           Rate;
+  EFI_STATUS                       Status;
+
+  Rsa = RsaNew ();
+  if (Rsa == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  SigSize   = CRYPTO_BENCHMARK_RSA_BITS / 8;
+  Signature = AllocatePool (SigSize);
+  if (Signature == NULL) {
+    RsaFree (Rsa);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = EFI_ABORTED;
+  if (!RsaGenerateKey (Rsa, CRYPTO_BENCHMARK_RSA_BITS, NULL, 0) || !RsaCheckKey (Rsa)) {
+    Print (L"RSA-%d key generation failed\n", CRYPTO_BENCHMARK_RSA_BITS);
+    goto Done;
+  }
+
+  if (!Sha256HashAll (mRsaMessage, sizeof (mRsaMessage) - 1, Digest) ||
+      !RsaPkcs1Sign (Rsa, Digest, sizeof (Digest), Signature, &SigSize)) {
+    Print (L"RSA-%d signing failed\n", CRYPTO_BENCHMARK_RSA_BITS);
+    goto Done;
+  }
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < CRYPTO_BENCHMARK_RSA_ITERATIONS; Index++) {
+    if (!RsaPkcs1Verify (Rsa, Digest, sizeof (Digest), Signature, SigSize)) {
+      Print (L"RSA-%d verification failed\n", CRYPTO_BENCHMARK_RSA_BITS);
+      goto Done;
+    }
+  }
+  End = GetPerformanceCounter ();
+
+  Elapsed = BenchmarkElapsedNanoSecond (Start, End);
+  if (Elapsed == 0) {
+    Print (L"RSA-%d verify too fast to measure\n", CRYPTO_BENCHMARK_RSA_BITS);
+  } else {
+    Rate = DivU64x64Remainder (MultU64x32 (1000000000, CRYPTO_BENCHMARK_RSA_ITERATIONS), Elapsed, NULL);
+    Print (L"RSA-%d verify %6ld ops/s\n", CRYPTO_BENCHMARK_RSA_BITS, Rate);
+  }
+  Status = EFI_SUCCESS;
+
+Done:
+  FreePool (Signature);
+  RsaFree (Rsa);
+  return Status;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoBenchmarkMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  UINT8                *Buffer;
+  UINT8                *Output;
+  UINTN                Index;
+  UINT32               Seed;
+  EFI_STATUS           Status;
+
+  Buffer = AllocatePool (CRYPTO_BENCHMARK_BUFFER_SIZE);
+  Output = AllocatePool (CRYPTO_BENCHMARK_BUFFER_SIZE);
+  if (Buffer == NULL || Output == NULL) {
+    Print (L"CryptoBenchmark: Unable to allocate the data buffers\n");
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  //
+  // Fill the buffer with pseudo random data.
+  //
+  Seed = 0x12345678;
+  for (Index = 0; Index < CRYPTO_BENCHMARK_BUFFER_SIZE; Index++) {
+    Seed          = Seed * 1664525 + 1013904223;
+    Buffer[Index] = (UINT8) (Seed >> 24);
+  }
+
+  RandomSeed (NULL, 0);
+
+  Print (L"Cryptographic throughput on a %d KiB buffer:\n", CRYPTO_BENCHMARK_BUFFER_SIZE / SIZE_1KB);
+
+  Status = BenchmarkHash (Buffer, CRYPTO_BENCHMARK_BUFFER_SIZE);
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  Status = BenchmarkAesCbc (L"AES-128-CBC", 128, Buffer, Output, CRYPTO_BENCHMARK_BUFFER_SIZE);
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  Status = BenchmarkAesCbc (L"AES-256-CBC", 256, Buffer, Output, CRYPTO_BENCHMARK_BUFFER_SIZE);
+  if (EFI_ERROR (Status)) {
+    goto Done;
+  }
+
+  Status = BenchmarkRsaVerify ();
+
+Done:
+  if (Buffer != NULL) {
+    FreePool (Buffer);
+  }
+  if (Output != NULL) {
+    FreePool (Output);
+  }
+  return Status;
+}
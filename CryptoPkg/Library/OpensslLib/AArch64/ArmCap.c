@@ -0,0 +1,87 @@
+/** @file
+  AArch64 CPU capability detection for the accelerated OpenSSL library.
+
+  This replaces OpenSSL crypto/armcap.c, which probes the capabilities by
+  executing each instruction under a SIGILL handler or by asking the Linux
+  auxiliary vector. Neither is available in UEFI, but the ID registers are
+  readable at EL1 and EL2, so decode them directly.
+
+Copyright (c) 2026 Baikal Electronics JSC
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Base.h>
+#include "arm_arch.h"
+
+//
+// Capability vector consumed by the OpenSSL ARMv8 assembly.
+//
+UINT32  OPENSSL_armcap_P = 0;
+
+/**
+  Read the AArch64 feature registers and fill in OPENSSL_armcap_P.
+
+**/
+VOID
+OPENSSL_cpuid_setup (
+  VOID
+  )
+{
+  UINT64  Pfr0;
+  UINT64  Isar0;
+
+  __asm__ ("mrs %0, id_aa64pfr0_el1" : "=r" (Pfr0));
+  __asm__ ("mrs %0, id_aa64isar0_el1" : "=r" (Isar0));
+
+  OPENSSL_armcap_P = 0;
+
+  //
+  // ID_AA64PFR0_EL1.AdvSIMD, bits [23:20], is 0xF when NEON is not implemented.
+  // The crypto instructions are only usable together with NEON.
+  //
+  if (((Pfr0 >> 20) & 0xF) == 0xF) {
+    return;
+  }
+  OPENSSL_armcap_P |= ARMV7_NEON;
+
+  //
+  // ID_AA64ISAR0_EL1.AES, bits [7:4]: 1 for AESE/AESD, 2 if PMULL is also present.
+  //
+  if (((Isar0 >> 4) & 0xF) >= 1) {
+    OPENSSL_armcap_P |= ARMV8_AES;
+  }
+  if (((Isar0 >> 4) & 0xF) >= 2) {
+    OPENSSL_armcap_P |= ARMV8_PMULL;
+  }
+
+  //
+  // ID_AA64ISAR0_EL1.SHA1, bits [11:8], and SHA2, bits [15:12].
+  //
+  if (((Isar0 >> 8) & 0xF) >= 1) {
+    OPENSSL_armcap_P |= ARMV8_SHA1;
+  }
+  if (((Isar0 >> 12) & 0xF) >= 1) {
+    OPENSSL_armcap_P |= ARMV8_SHA256;
+  }
+}
+
+/**
+  The generic timer is not used as an entropy source here.
+
+  @return  Always 0.
+
+**/
+UINT32
+OPENSSL_rdtsc (
+  VOID
+  )
+{
+  return 0;
+}
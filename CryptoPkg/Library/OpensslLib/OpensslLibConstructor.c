@@ -0,0 +1,49 @@
+/** @file
+  Constructor of the accelerated OpenSSL library instance.
+
+  OpenSSL normally probes the CPU capabilities from an ELF .init section or a
+  Windows CRT initializer, neither of which runs in a UEFI image. Probe them
+  from the library constructor instead, so the assembly code paths are picked
+  before the first cryptographic operation.
+
+Copyright (c) 2026 Baikal Electronics JSC
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Uefi.h>
+
+//
+// Implemented by OpenSSL crypto/cryptlib.c on X64 and by AArch64/ArmCap.c
+// on AARCH64.
+//
+VOID
+OPENSSL_cpuid_setup (
+  VOID
+  );
+
+/**
+  Fill in the OpenSSL CPU capability vector.
+
+  @param  ImageHandle   The firmware allocated handle for the EFI image.
+  @param  SystemTable   A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS   The constructor always returns EFI_SUCCESS.
+
+**/
+EFI_STATUS
+EFIAPI
+OpensslLibConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  OPENSSL_cpuid_setup ();
+  return EFI_SUCCESS;
+}
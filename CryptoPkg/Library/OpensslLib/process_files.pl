@@ -2,7 +2,8 @@
 #
 # This script runs the OpenSSL Configure script, then processes the
 # resulting file list into our local OpensslLib[Crypto].inf and also
-# takes a copy of opensslconf.h.
+# takes a copy of opensslconf.h. It also runs the OpenSSL perlasm scripts
+# to produce the assembly sources of OpensslLibAccel.inf.
 #
 # This only needs to be done once by a developer when updating to a
 # new version of OpenSSL (or changing options, etc.). Normal users
@@ -216,6 +217,226 @@ print "\n--> Duplicating opensslconf.h into Include/openssl ... ";
 copy($OPENSSL_PATH . "/include/openssl/opensslconf.h",
      $OPENSSL_PATH . "/../../Include/openssl/") ||
    die "Cannot copy opensslconf.h!";
+
+#
+# OpensslLibAccel.inf shares this header, so let it opt out of OPENSSL_NO_ASM.
+#
+my $conf_file = $OPENSSL_PATH . "/../../Include/openssl/opensslconf.h";
+open( FD, "<" . $conf_file ) ||
+    die "Cannot open \"" . $conf_file . "\"!";
+my @conf = (<FD>);
+close(FD) ||
+    die "Cannot close \"" . $conf_file . "\"!";
+foreach (@conf) {
+    s/^#ifndef OPENSSL_NO_ASM$/#if !defined(OPENSSL_NO_ASM) && !defined(EDKII_OPENSSL_ASM)/;
+}
+open( FD, ">" . $conf_file ) ||
+    die $conf_file;
+print( FD @conf ) ||
+    die $conf_file;
+close(FD) ||
+    die $conf_file;
+print "Done!\n";
+
+#
+# Assembly modules used by OpensslLibAccel.inf, per architecture. Each entry
+# is the perlasm script and the output file name without extension. The C
+# files listed in "replaces" are dropped from the common file list since the
+# assembly provides their functions, and "extra" lists the C files (or headers
+# needed on the include path) the assembly depends on.
+#
+my %accel = (
+    "X64" => {
+        "dir"      => "X64",
+        "flavours" => [
+            # perlasm flavour, file extension, toolchain family
+            [ "nasm", ".nasm", "MSFT" ],
+            [ "elf",  ".S",    "GCC"  ],
+        ],
+        "replaces" => [
+            "crypto/aes/aes_cbc.c",
+            "crypto/aes/aes_core.c",
+            "crypto/mem_clr.c",
+        ],
+        "extra"    => [
+            "crypto/bn/rsaz_exp.c",
+        ],
+        "modules"  => [
+            [ "crypto/x86_64cpuid.pl",                   "crypto/x86_64cpuid" ],
+            [ "crypto/aes/asm/aes-x86_64.pl",            "crypto/aes/aes-x86_64" ],
+            [ "crypto/aes/asm/aesni-mb-x86_64.pl",       "crypto/aes/aesni-mb-x86_64" ],
+            [ "crypto/aes/asm/aesni-sha1-x86_64.pl",     "crypto/aes/aesni-sha1-x86_64" ],
+            [ "crypto/aes/asm/aesni-sha256-x86_64.pl",   "crypto/aes/aesni-sha256-x86_64" ],
+            [ "crypto/aes/asm/aesni-x86_64.pl",          "crypto/aes/aesni-x86_64" ],
+            [ "crypto/aes/asm/bsaes-x86_64.pl",          "crypto/aes/bsaes-x86_64" ],
+            [ "crypto/aes/asm/vpaes-x86_64.pl",          "crypto/aes/vpaes-x86_64" ],
+            [ "crypto/bn/asm/rsaz-avx2.pl",              "crypto/bn/rsaz-avx2" ],
+            [ "crypto/bn/asm/rsaz-x86_64.pl",            "crypto/bn/rsaz-x86_64" ],
+            [ "crypto/bn/asm/x86_64-mont.pl",            "crypto/bn/x86_64-mont" ],
+            [ "crypto/bn/asm/x86_64-mont5.pl",           "crypto/bn/x86_64-mont5" ],
+            [ "crypto/modes/asm/aesni-gcm-x86_64.pl",    "crypto/modes/aesni-gcm-x86_64" ],
+            [ "crypto/modes/asm/ghash-x86_64.pl",        "crypto/modes/ghash-x86_64" ],
+            [ "crypto/sha/asm/sha1-mb-x86_64.pl",        "crypto/sha/sha1-mb-x86_64" ],
+            [ "crypto/sha/asm/sha1-x86_64.pl",           "crypto/sha/sha1-x86_64" ],
+            [ "crypto/sha/asm/sha256-mb-x86_64.pl",      "crypto/sha/sha256-mb-x86_64" ],
+            [ "crypto/sha/asm/sha512-x86_64.pl",         "crypto/sha/sha256-x86_64" ],
+            [ "crypto/sha/asm/sha512-x86_64.pl",         "crypto/sha/sha512-x86_64" ],
+        ],
+    },
+    "AARCH64" => {
+        "dir"      => "AArch64",
+        "flavours" => [
+            [ "linux64", ".S", "" ],
+        ],
+        "replaces" => [
+            "crypto/mem_clr.c",
+        ],
+        "extra"    => [
+            "crypto/aes/aes_cbc.c",
+            "crypto/aes/aes_core.c",
+            "crypto/arm_arch.h",
+        ],
+        "modules"  => [
+            [ "crypto/arm64cpuid.pl",                    "crypto/arm64cpuid" ],
+            [ "crypto/aes/asm/aesv8-armx.pl",            "crypto/aes/aesv8-armx" ],
+            [ "crypto/bn/asm/armv8-mont.pl",             "crypto/bn/armv8-mont" ],
+            [ "crypto/modes/asm/ghashv8-armx.pl",        "crypto/modes/ghashv8-armx" ],
+            [ "crypto/sha/asm/sha1-armv8.pl",            "crypto/sha/sha1-armv8" ],
+            [ "crypto/sha/asm/sha512-armv8.pl",          "crypto/sha/sha256-armv8" ],
+            [ "crypto/sha/asm/sha512-armv8.pl",          "crypto/sha/sha512-armv8" ],
+        ],
+    },
+);
+
+#
+# The common list of OpensslLibAccel.inf leaves out any C file that is
+# replaced by assembly on at least one architecture; the architectures that
+# still need it list it back in "extra".
+#
+my %replaced = ();
+foreach my $arch (keys %accel) {
+    foreach my $s (@{$accel{$arch}->{"replaces"}}) {
+        $replaced{$s} = 1;
+    }
+}
+my @accelfilelist = ();
+foreach my $line ((@cryptofilelist, @sslfilelist)) {
+    my $s = $line;
+    $s =~ s/^\s*\$\(OPENSSL_PATH\)\///;
+    $s =~ s/\r\n$//;
+    next if ($replaced{$s});
+    push @accelfilelist, $line;
+}
+
+my %accelarchlist = ();
+foreach my $arch (sort keys %accel) {
+    my $info = $accel{$arch};
+    my @list = ();
+
+    print "\n--> Generating " . $arch . " assembly ... ";
+    foreach my $s (@{$info->{"extra"}}) {
+        push @list, '  $(OPENSSL_PATH)/' . $s . "\r\n";
+    }
+    foreach my $flavour (@{$info->{"flavours"}}) {
+        my ($scheme, $ext, $family) = @{$flavour};
+        foreach my $module (@{$info->{"modules"}}) {
+            my ($script, $out) = @{$module};
+            my $target = $info->{"dir"} . "/" . $out . $ext;
+            my $dir = $target;
+            $dir =~ s/\/[^\/]*$//;
+            system("mkdir", "-p", $dir) == 0 ||
+                die "Cannot create \"" . $dir . "\"!";
+            system("perl", $OPENSSL_PATH . "/" . $script, $scheme, $target) == 0 ||
+                die "Failed to generate \"" . $target . "\"!";
+
+            #
+            # The ELF flavour registers OPENSSL_cpuid_setup() in .init, which
+            # does not survive the conversion to PE/COFF. The library
+            # constructor calls it instead.
+            #
+            if ($scheme eq "elf") {
+                open( FD, "<" . $target ) ||
+                    die "Cannot open \"" . $target . "\"!";
+                my @asm = (<FD>);
+                close(FD) ||
+                    die "Cannot close \"" . $target . "\"!";
+                my @new_asm = ();
+                my $in_init = 0;
+                foreach (@asm) {
+                    if (/^\s*\.section\s+\.init\b/) {
+                        $in_init = 1;
+                        next;
+                    }
+                    if ($in_init && /^\s*call\s+OPENSSL_cpuid_setup\b/) {
+                        next;
+                    }
+                    $in_init = 0;
+                    push @new_asm, $_;
+                }
+                open( FD, ">" . $target ) ||
+                    die $target;
+                print( FD @new_asm ) ||
+                    die $target;
+                close(FD) ||
+                    die $target;
+            }
+
+            my $entry = '  ' . $target;
+            if ($family ne "") {
+                $entry = sprintf("  %-40s| %s", $target, $family);
+            }
+            push @list, $entry . "\r\n";
+        }
+    }
+    $accelarchlist{$arch} = \@list;
+    print "Done!";
+}
+
+#
+# Update OpensslLibAccel.inf with the common and per-architecture file lists
+#
+$inf_file = "OpensslLibAccel.inf";
+
+@inf = ();
+@new_inf = ();
+open( FD, "<" . $inf_file ) ||
+    die "Cannot open \"" . $inf_file . "\"!";
+@inf = (<FD>);
+close(FD) ||
+    die "Cannot close \"" . $inf_file . "\"!";
+
+$subbing = 0;
+print "\n--> Updating OpensslLibAccel.inf ... ";
+foreach (@inf) {
+    if ( $_ =~ "# Autogenerated files list starts here" ) {
+        push @new_inf, $_, @accelfilelist;
+        $subbing = 1;
+        next;
+    }
+    if ( $_ =~ /# Autogenerated (\w+) files list starts here/ ) {
+        push @new_inf, $_, @{$accelarchlist{$1}};
+        $subbing = 1;
+        next;
+    }
+    if ( $_ =~ /# Autogenerated (\w+ )?files list ends here/ ) {
+        push @new_inf, $_;
+        $subbing = 0;
+        next;
+    }
+
+    push @new_inf, $_
+        unless ($subbing);
+}
+
+$new_inf_file = $inf_file . ".new";
+open( FD, ">" . $new_inf_file ) ||
+    die $new_inf_file;
+print( FD @new_inf ) ||
+    die $new_inf_file;
+close(FD) ||
+    die $new_inf_file;
+rename( $new_inf_file, $inf_file ) ||
+    die "rename $inf_file";
 print "Done!\n";
 
 print "\nProcessing Files Done!\n";
@@ -98,6 +98,14 @@ TlsCtxNew (
   //
   SSL_CTX_set_options (TlsCtx, SSL_OP_NO_SSLv3);
 
+  //
+  // Client sessions are kept by each TLS object for resumption when it is
+  // reused for a new connection, see TlsDoHandshake(). Make sure session
+  // tickets are requested and don't grow an internal cache for them.
+  //
+  SSL_CTX_clear_options (TlsCtx, SSL_OP_NO_TICKET);
+  SSL_CTX_set_session_cache_mode (TlsCtx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+
   //
   // Treat as minimum accepted versions by setting the minimal bound.
   // Client can use higher TLS version if server supports it
@@ -48,6 +48,47 @@ TlsInHandshake (
   return !SSL_is_init_finished (TlsConn->Ssl);
 }
 
+/**
+  Reset a TLS object which was used for a previous connection, so that it can
+  perform a new handshake over a new transport connection.
+
+  If the previous handshake completed, its session is kept and offered again in
+  the next ClientHello, by session ID or by session ticket (RFC 5077), so that
+  the server can resume it with an abbreviated handshake.
+
+  @param[in]  TlsConn    Pointer to the TLS connection object.
+
+**/
+VOID
+TlsResetConnection (
+  IN     TLS_CONNECTION           *TlsConn
+  )
+{
+  SSL_SESSION     *Session;
+
+  Session = NULL;
+  if (SSL_is_init_finished (TlsConn->Ssl)) {
+    Session = SSL_get1_session (TlsConn->Ssl);
+
+    //
+    // The previous transport connection may have gone away without a
+    // close_notify. As of TLS 1.1 this no longer prevents resumption
+    // (RFC 5246, section 7.2.1), so mark the connection as shut down to keep
+    // SSL_clear() from invalidating the session.
+    //
+    SSL_set_shutdown (TlsConn->Ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+  }
+
+  SSL_clear (TlsConn->Ssl);
+  (VOID) BIO_reset (TlsConn->InBio);
+  (VOID) BIO_reset (TlsConn->OutBio);
+
+  if (Session != NULL) {
+    SSL_set_session (TlsConn->Ssl, Session);
+    SSL_SESSION_free (Session);
+  }
+}
+
 /**
   Perform a TLS/SSL handshake.
 
@@ -110,6 +151,14 @@ TlsDoHandshake (
     //
     PendingBufferSize = (UINTN) BIO_ctrl_pending (TlsConn->OutBio);
     if (PendingBufferSize == 0) {
+      //
+      // A TLS object which already went through a handshake is being reused
+      // for a new connection, start over and try to resume the last session.
+      //
+      if (!SSL_in_before (TlsConn->Ssl)) {
+        TlsResetConnection (TlsConn);
+      }
+
       SSL_set_connect_state (TlsConn->Ssl);
       Ret = SSL_do_handshake (TlsConn->Ssl);
       PendingBufferSize = (UINTN) BIO_ctrl_pending (TlsConn->OutBio);
@@ -43,6 +43,7 @@ FatFreeODir (
     FatFreeDirEnt (DirEnt);
   }
 
+  FreePool (ODir->ShortNameHashTable);
   FreePool (ODir);
 }
 
@@ -63,6 +64,18 @@ FatAllocateODir (
 
   ODir = AllocateZeroPool (sizeof (FAT_ODIR));
   if (ODir != NULL) {
+    //
+    // Allocate the hash tables for short and long names with the minimum size,
+    // they grow with the directory
+    //
+    ODir->ShortNameHashTable = AllocateZeroPool (2 * HASH_TABLE_MIN_SIZE * sizeof (FAT_DIRENT *));
+    if (ODir->ShortNameHashTable == NULL) {
+      FreePool (ODir);
+      return NULL;
+    }
+
+    ODir->LongNameHashTable = ODir->ShortNameHashTable + HASH_TABLE_MIN_SIZE;
+    ODir->HashTableMask     = HASH_TABLE_MIN_SIZE - 1;
     //
     // Initialize the directory entry list
     //
@@ -74,10 +87,33 @@ FatAllocateODir (
   return ODir;
 }
 
+/**
+
+  Remove the directory structure from the directory cache of the volume.
+
+  @param  Volume                - FAT file system volume.
+  @param  ODir                  - The cached directory to be removed.
+
+**/
+STATIC
+VOID
+FatRemoveODirFromCache (
+  IN FAT_VOLUME   *Volume,
+  IN FAT_ODIR     *ODir
+  )
+{
+  RemoveEntryList (&ODir->DirCacheLink);
+  Volume->DirCacheCount--;
+  Volume->DirCacheEntryCount -= ODir->DirEntCount;
+}
+
 /**
 
   Discard the directory structure when an OFile will be freed.
-  Volume will cache this directory if the OFile does not represent a deleted file.
+  Volume will cache this directory if the OFile does not represent a deleted file
+  and the volume is still valid.
+  The least recent used directories are released while the directory cache holds
+  more than FAT_MAX_DIR_CACHE_COUNT directories or FAT_MAX_DIR_CACHE_ENTRY_COUNT entries.
 
   @param  OFile                 - The OFile whose directory structure is to be discarded.
 
@@ -92,31 +128,31 @@ FatDiscardODir (
 
   Volume  = OFile->Volume;
   ODir    = OFile->ODir;
-  if (!OFile->DirEnt->Invalid) {
+  if (OFile->DirEnt->Invalid || !Volume->Valid) {
     //
-    // If OFile does not represent a deleted file, then we will cache the directory
-    // We use OFile's first cluster as the directory's tag
+    // Release ODir Structure. The directory of an invalidated volume
+    // may come from a media that is no longer present.
     //
-    ODir->DirCacheTag = OFile->FileCluster;
-    InsertHeadList (&Volume->DirCacheList, &ODir->DirCacheLink);
-    if (Volume->DirCacheCount == FAT_MAX_DIR_CACHE_COUNT) {
-      //
-      // Replace the least recent used directory
-      //
-      ODir = ODIR_FROM_DIRCACHELINK (Volume->DirCacheList.BackLink);
-      RemoveEntryList (&ODir->DirCacheLink);
-    } else {
-      //
-      // No need to find a replace
-      //
-      Volume->DirCacheCount++;
-      ODir = NULL;
-    }
+    FatFreeODir (ODir);
+    return;
   }
+
   //
-  // Release ODir Structure
+  // If OFile does not represent a deleted file, then we will cache the directory
+  // We use OFile's first cluster as the directory's tag
   //
-  if (ODir != NULL) {
+  ODir->DirCacheTag = OFile->FileCluster;
+  InsertHeadList (&Volume->DirCacheList, &ODir->DirCacheLink);
+  Volume->DirCacheCount++;
+  Volume->DirCacheEntryCount += ODir->DirEntCount;
+  while (Volume->DirCacheCount > 1 &&
+         (Volume->DirCacheCount > FAT_MAX_DIR_CACHE_COUNT ||
+          Volume->DirCacheEntryCount > FAT_MAX_DIR_CACHE_ENTRY_COUNT)) {
+    //
+    // Replace the least recent used directory
+    //
+    ODir = ODIR_FROM_DIRCACHELINK (Volume->DirCacheList.BackLink);
+    FatRemoveODirFromCache (Volume, ODir);
     FatFreeODir (ODir);
   }
 }
@@ -151,8 +187,8 @@ FatRequestODir (
       ) {
     CurrentODir = ODIR_FROM_DIRCACHELINK (CurrentODirLink);
     if (CurrentODir->DirCacheTag == DirCacheTag) {
-      RemoveEntryList (&CurrentODir->DirCacheLink);
-      Volume->DirCacheCount--;
+      FatRemoveODirFromCache (Volume, CurrentODir);
+      Volume->DirCacheHitCount++;
       ODir = CurrentODir;
       break;
     }
@@ -162,6 +198,7 @@ FatRequestODir (
     //
     // This directory is not cached, then allocate a new one
     //
+    Volume->DirParseCount++;
     ODir = FatAllocateODir (OFile);
   }
 
@@ -170,7 +207,8 @@ FatRequestODir (
 
 /**
 
-  Clean up all the cached directory structures when the volume is going to be abandoned.
+  Clean up all the cached directory structures when the volume is going to be abandoned,
+  or when its media is changed or removed.
 
   @param  Volume                - FAT file system volume.
 
@@ -181,10 +219,10 @@ FatCleanupODirCache (
   )
 {
   FAT_ODIR  *ODir;
+
   while (Volume->DirCacheCount > 0) {
     ODir = ODIR_FROM_DIRCACHELINK (Volume->DirCacheList.BackLink);
-    RemoveEntryList (&ODir->DirCacheLink);
+    FatRemoveODirFromCache (Volume, ODir);
     FatFreeODir (ODir);
-    Volume->DirCacheCount--;
   }
 }
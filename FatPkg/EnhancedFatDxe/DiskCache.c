@@ -14,6 +14,97 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include "Fat.h"
 
+/**
+
+  Get the address of the cache page that belongs to the cache tag.
+
+  @param  DiskCache             - The disk cache.
+  @param  CacheTag              - The Cache Tag of the cache page.
+
+  @return The address of the cache page.
+
+**/
+STATIC
+UINT8 *
+FatCachePageAddress (
+  IN DISK_CACHE         *DiskCache,
+  IN CACHE_TAG          *CacheTag
+  )
+{
+  return DiskCache->CacheBase + ((UINTN) (CacheTag - DiskCache->CacheTag) << DiskCache->PageAlignment);
+}
+
+/**
+
+  Search the set that PageNo maps to for the cache page of PageNo.
+
+  @param  DiskCache             - The disk cache.
+  @param  PageNo                - PageNo to match with the cache.
+
+  @return The Cache Tag holding PageNo, or NULL if the page is not cached.
+
+**/
+STATIC
+CACHE_TAG *
+FatLookupCachePage (
+  IN DISK_CACHE         *DiskCache,
+  IN UINTN              PageNo
+  )
+{
+  UINTN       Way;
+  UINTN       GroupCount;
+  CACHE_TAG   *CacheTag;
+
+  GroupCount  = DiskCache->GroupMask + 1;
+  CacheTag    = &DiskCache->CacheTag[PageNo & DiskCache->GroupMask];
+  for (Way = 0; Way < DiskCache->WayCount; Way++, CacheTag += GroupCount) {
+    if (CacheTag->RealSize > 0 && CacheTag->PageNo == PageNo) {
+      return CacheTag;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+
+  Select the cache page to be replaced in the set that PageNo maps to.
+  An empty cache page is preferred, otherwise the least recently used one is selected.
+
+  @param  DiskCache             - The disk cache.
+  @param  PageNo                - PageNo that will be loaded into the cache.
+
+  @return The Cache Tag of the cache page to be replaced.
+
+**/
+STATIC
+CACHE_TAG *
+FatSelectVictimCachePage (
+  IN DISK_CACHE         *DiskCache,
+  IN UINTN              PageNo
+  )
+{
+  UINTN       Way;
+  UINTN       GroupCount;
+  CACHE_TAG   *CacheTag;
+  CACHE_TAG   *Victim;
+
+  GroupCount  = DiskCache->GroupMask + 1;
+  CacheTag    = &DiskCache->CacheTag[PageNo & DiskCache->GroupMask];
+  Victim      = CacheTag;
+  for (Way = 0; Way < DiskCache->WayCount; Way++, CacheTag += GroupCount) {
+    if (CacheTag->RealSize == 0) {
+      return CacheTag;
+    }
+
+    if (CacheTag->AccessStamp < Victim->AccessStamp) {
+      Victim = CacheTag;
+    }
+  }
+
+  return Victim;
+}
+
 /**
 
   This function is used by the Data Cache.
@@ -44,24 +135,18 @@ FatFlushDataCacheRange (
   )
 {
   UINTN       PageNo;
-  UINTN       GroupNo;
-  UINTN       GroupMask;
   UINTN       PageSize;
   UINT8       PageAlignment;
   DISK_CACHE  *DiskCache;
   CACHE_TAG   *CacheTag;
-  UINT8       *BaseAddress;
 
   DiskCache     = &Volume->DiskCache[CacheData];
-  BaseAddress   = DiskCache->CacheBase;
-  GroupMask     = DiskCache->GroupMask;
   PageAlignment = DiskCache->PageAlignment;
   PageSize      = (UINTN)1 << PageAlignment;
 
   for (PageNo = StartPageNo; PageNo < EndPageNo; PageNo++) {
-    GroupNo   = PageNo & GroupMask;
-    CacheTag  = &DiskCache->CacheTag[GroupNo];
-    if (CacheTag->RealSize > 0 && CacheTag->PageNo == PageNo) {
+    CacheTag = FatLookupCachePage (DiskCache, PageNo);
+    if (CacheTag != NULL) {
       //
       // When reading data form disk directly, if some dirty data
       // in cache is in this rang, this data in the Buffer need to
@@ -71,7 +156,7 @@ FatFlushDataCacheRange (
         if (CacheTag->Dirty) {
           CopyMem (
             Buffer + ((PageNo - StartPageNo) << PageAlignment),
-            BaseAddress + (GroupNo << PageAlignment),
+            FatCachePageAddress (DiskCache, CacheTag),
             PageSize
             );
         }
@@ -110,7 +195,6 @@ FatExchangeCachePage (
   )
 {
   EFI_STATUS  Status;
-  UINTN       GroupNo;
   UINTN       PageNo;
   UINTN       WriteCount;
   UINTN       RealSize;
@@ -122,9 +206,8 @@ FatExchangeCachePage (
 
   DiskCache     = &Volume->DiskCache[DataType];
   PageNo        = CacheTag->PageNo;
-  GroupNo       = PageNo & DiskCache->GroupMask;
   PageAlignment = DiskCache->PageAlignment;
-  PageAddress   = DiskCache->CacheBase + (GroupNo << PageAlignment);
+  PageAddress   = FatCachePageAddress (DiskCache, CacheTag);
   EntryPos      = DiskCache->BaseAddress + LShiftU64 (PageNo, PageAlignment);
   RealSize      = CacheTag->RealSize;
   if (IoMode == ReadDisk) {
@@ -158,6 +241,96 @@ FatExchangeCachePage (
   return EFI_SUCCESS;
 }
 
+/**
+
+  Load PageNo and the pages following it into the data cache with a single disk read.
+
+  The pages are placed into the same way as CacheTag, where consecutive pages are
+  contiguous in the cache buffer. The run stops at the last set, at a page that is
+  already cached, at the end of the data region, or at a cache page that is dirty or
+  is not the one FatSelectVictimCachePage() would replace, so read-ahead never evicts
+  a more recently used page. The pages after PageNo are inserted at the least recently
+  used position of their sets, and are the first to be replaced if they are not used.
+
+  @param  Volume                - FAT file system volume.
+  @param  CacheTag              - The Cache Tag selected for PageNo.
+  @param  PageNo                - The first page to load.
+
+  @retval EFI_SUCCESS           - The pages are loaded successfully.
+  @return Others                - An error occurred when reading the pages.
+
+**/
+STATIC
+EFI_STATUS
+FatReadAheadCachePages (
+  IN FAT_VOLUME         *Volume,
+  IN CACHE_TAG          *CacheTag,
+  IN UINTN              PageNo
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+  UINTN       PageCount;
+  UINTN       MaxPageCount;
+  UINTN       PageSize;
+  UINTN       ReadSize;
+  UINT64      EntryPos;
+  UINT64      MaxSize;
+  DISK_CACHE  *DiskCache;
+  CACHE_TAG   *NextTag;
+  UINT8       PageAlignment;
+
+  DiskCache     = &Volume->DiskCache[CacheData];
+  PageAlignment = DiskCache->PageAlignment;
+  PageSize      = (UINTN)1 << PageAlignment;
+  EntryPos      = DiskCache->BaseAddress + LShiftU64 (PageNo, PageAlignment);
+  MaxPageCount  = DiskCache->GroupMask + 1 - (PageNo & DiskCache->GroupMask);
+  if (MaxPageCount > DiskCache->ReadAheadCount) {
+    MaxPageCount = DiskCache->ReadAheadCount;
+  }
+
+  for (PageCount = 1; PageCount < MaxPageCount; PageCount++) {
+    if (EntryPos + LShiftU64 (PageCount, PageAlignment) >= DiskCache->LimitAddress) {
+      break;
+    }
+
+    NextTag = CacheTag + PageCount;
+    if ((NextTag->RealSize > 0 && NextTag->Dirty) ||
+        FatLookupCachePage (DiskCache, PageNo + PageCount) != NULL ||
+        FatSelectVictimCachePage (DiskCache, PageNo + PageCount) != NextTag) {
+      break;
+    }
+  }
+
+  ReadSize = PageCount << PageAlignment;
+  MaxSize  = DiskCache->LimitAddress - EntryPos;
+  if (MaxSize < ReadSize) {
+    ReadSize = (UINTN) MaxSize;
+  }
+
+  for (Index = 0; Index < PageCount; Index++) {
+    CacheTag[Index].RealSize = 0;
+  }
+
+  Status = FatDiskIo (Volume, ReadDisk, EntryPos, ReadSize, FatCachePageAddress (DiskCache, CacheTag), NULL);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  for (Index = 0; Index < PageCount; Index++) {
+    CacheTag[Index].PageNo      = PageNo + Index;
+    CacheTag[Index].Dirty       = FALSE;
+    CacheTag[Index].RealSize    = ReadSize < PageSize ? ReadSize : PageSize;
+    CacheTag[Index].AccessStamp = 0;
+    ReadSize                   -= CacheTag[Index].RealSize;
+  }
+
+  CacheTag->AccessStamp = DiskCache->AccessStamp;
+
+  DiskCache->ReadAheadPages += PageCount - 1;
+  return EFI_SUCCESS;
+}
+
 /**
 
   Get one cache page by specified PageNo.
@@ -174,39 +347,60 @@ FatExchangeCachePage (
 STATIC
 EFI_STATUS
 FatGetCachePage (
-  IN FAT_VOLUME         *Volume,
-  IN CACHE_DATA_TYPE    CacheDataType,
-  IN UINTN              PageNo,
-  IN CACHE_TAG          *CacheTag
+  IN  FAT_VOLUME         *Volume,
+  IN  CACHE_DATA_TYPE    CacheDataType,
+  IN  UINTN              PageNo,
+  OUT CACHE_TAG          **CacheTag
   )
 {
   EFI_STATUS  Status;
-  UINTN       OldPageNo;
+  DISK_CACHE  *DiskCache;
+  CACHE_TAG   *Tag;
 
-  OldPageNo = CacheTag->PageNo;
-  if (CacheTag->RealSize > 0 && OldPageNo == PageNo) {
+  DiskCache = &Volume->DiskCache[CacheDataType];
+  DiskCache->AccessStamp++;
+
+  Tag = FatLookupCachePage (DiskCache, PageNo);
+  if (Tag != NULL) {
     //
     // Cache Hit occurred
     //
+    DiskCache->HitCount++;
+    Tag->AccessStamp  = DiskCache->AccessStamp;
+    *CacheTag         = Tag;
     return EFI_SUCCESS;
   }
 
+  DiskCache->MissCount++;
+  Tag = FatSelectVictimCachePage (DiskCache, PageNo);
+
   //
   // Write dirty cache page back to disk
   //
-  if (CacheTag->RealSize > 0 && CacheTag->Dirty) {
-    Status = FatExchangeCachePage (Volume, CacheDataType, WriteDisk, CacheTag, NULL);
+  if (Tag->RealSize > 0 && Tag->Dirty) {
+    Status = FatExchangeCachePage (Volume, CacheDataType, WriteDisk, Tag, NULL);
     if (EFI_ERROR (Status)) {
       return Status;
     }
   }
   //
-  // Load new data from disk;
+  // Load new data from disk; read ahead when the data cache is accessed sequentially
   //
-  CacheTag->PageNo  = PageNo;
-  Status            = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, NULL);
+  Tag->PageNo       = PageNo;
+  Tag->AccessStamp  = DiskCache->AccessStamp;
+  if (DiskCache->Sequential && DiskCache->ReadAheadCount > 1) {
+    Status = FatReadAheadCachePages (Volume, Tag, PageNo);
+  } else {
+    Status = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, Tag, NULL);
+  }
 
-  return Status;
+  if (EFI_ERROR (Status)) {
+    Tag->RealSize = 0;
+    return Status;
+  }
+
+  *CacheTag = Tag;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -243,14 +437,11 @@ FatAccessUnalignedCachePage (
   VOID        *Destination;
   DISK_CACHE  *DiskCache;
   CACHE_TAG   *CacheTag;
-  UINTN       GroupNo;
 
   DiskCache = &Volume->DiskCache[CacheDataType];
-  GroupNo   = PageNo & DiskCache->GroupMask;
-  CacheTag  = &DiskCache->CacheTag[GroupNo];
-  Status    = FatGetCachePage (Volume, CacheDataType, PageNo, CacheTag);
+  Status    = FatGetCachePage (Volume, CacheDataType, PageNo, &CacheTag);
   if (!EFI_ERROR (Status)) {
-    Source      = DiskCache->CacheBase + (GroupNo << DiskCache->PageAlignment) + Offset;
+    Source      = FatCachePageAddress (DiskCache, CacheTag) + Offset;
     Destination = Buffer;
     if (IoMode != ReadDisk) {
       CacheTag->Dirty   = TRUE;
@@ -279,7 +470,10 @@ FatAccessUnalignedCachePage (
   2. Access of Data cache (CACHE_DATA):
      The access data will be divided into UnderRun data, Aligned data and OverRun data;
      The UnderRun data and OverRun data will be accessed by the Data cache,
-     but the Aligned data will be accessed with disk directly.
+     but the Aligned data will be accessed with disk directly, except for the leading
+     aligned pages of a read that are already present in the Data cache.
+     When the Data cache is read sequentially, a page miss loads the following
+     pages as well (read-ahead).
 
   @param  Volume                - FAT file system volume.
   @param  CacheDataType         - The type of cache: CACHE_DATA or CACHE_FAT.
@@ -315,6 +509,7 @@ FatAccessCache (
   UINTN       AlignedPageCount;
   UINTN       OverRunPageNo;
   DISK_CACHE  *DiskCache;
+  CACHE_TAG   *CacheTag;
   UINT64      EntryPos;
   UINT8       PageAlignment;
 
@@ -328,6 +523,15 @@ FatAccessCache (
   PageNo        = (UINTN) RShiftU64 (EntryPos, PageAlignment);
   UnderRun      = ((UINTN) EntryPos) & (PageSize - 1);
 
+  //
+  // Detect sequential reads: the access starts in or right after the last accessed page
+  //
+  if (BufferSize > 0) {
+    DiskCache->Sequential = (BOOLEAN) (IoMode == ReadDisk &&
+                                       (PageNo == DiskCache->LastPageNo || PageNo == DiskCache->LastPageNo + 1));
+    DiskCache->LastPageNo = (UINTN) RShiftU64 (EntryPos + BufferSize - 1, PageAlignment);
+  }
+
   if (UnderRun > 0) {
     Length = PageSize - UnderRun;
     if (Length > BufferSize) {
@@ -355,6 +559,28 @@ FatAccessCache (
     //
     ASSERT (CacheDataType == CacheData);
 
+    //
+    // Serve the leading pages that were already loaded (e.g. by read-ahead) from the cache
+    //
+    if (IoMode == ReadDisk) {
+      while (AlignedPageCount > 0) {
+        CacheTag = FatLookupCachePage (DiskCache, PageNo);
+        if (CacheTag == NULL || CacheTag->RealSize != PageSize) {
+          break;
+        }
+
+        CopyMem (Buffer, FatCachePageAddress (DiskCache, CacheTag), PageSize);
+        CacheTag->AccessStamp = ++DiskCache->AccessStamp;
+        DiskCache->HitCount++;
+        Buffer     += PageSize;
+        BufferSize -= PageSize;
+        PageNo++;
+        AlignedPageCount--;
+      }
+    }
+  }
+
+  if (AlignedPageCount > 0) {
     EntryPos    = Volume->RootPos + LShiftU64 (PageNo, PageAlignment);
     AlignedSize = AlignedPageCount << PageAlignment;
     Status      = FatDiskIo (Volume, IoMode, EntryPos, AlignedSize, Buffer, Task);
@@ -402,8 +628,8 @@ FatVolumeFlushCache (
 {
   EFI_STATUS      Status;
   CACHE_DATA_TYPE CacheDataType;
-  UINTN           GroupIndex;
-  UINTN           GroupMask;
+  UINTN           TagIndex;
+  UINTN           TagCount;
   DISK_CACHE      *DiskCache;
   CACHE_TAG       *CacheTag;
 
@@ -413,9 +639,9 @@ FatVolumeFlushCache (
       //
       // Data cache or fat cache is dirty, write the dirty data back
       //
-      GroupMask = DiskCache->GroupMask;
-      for (GroupIndex = 0; GroupIndex <= GroupMask; GroupIndex++) {
-        CacheTag = &DiskCache->CacheTag[GroupIndex];
+      TagCount = (DiskCache->GroupMask + 1) * DiskCache->WayCount;
+      for (TagIndex = 0; TagIndex < TagCount; TagIndex++) {
+        CacheTag = &DiskCache->CacheTag[TagIndex];
         if (CacheTag->RealSize > 0 && CacheTag->Dirty) {
           //
           // Write back all Dirty Data Cache Page to disk
@@ -441,6 +667,9 @@ FatVolumeFlushCache (
 
   Initialize the disk cache according to Volume's FatType.
 
+  The size and associativity of the Data cache are taken from PcdFatDataCacheSize
+  and PcdFatDataCacheWayCount, the read-ahead size from PcdFatReadAheadPageCount.
+
   @param  Volume                - FAT file system volume.
 
   @retval EFI_SUCCESS           - The disk cache is successfully initialized.
@@ -454,8 +683,11 @@ FatInitializeDiskCache (
 {
   DISK_CACHE  *DiskCache;
   UINTN       FatCacheGroupCount;
+  UINTN       DataCacheGroupCount;
+  UINTN       DataCacheWayCount;
   UINTN       DataCacheSize;
   UINTN       FatCacheSize;
+  UINTN       CacheTagSize;
   UINT8       *CacheBuffer;
 
   DiskCache = Volume->DiskCache;
@@ -472,18 +704,37 @@ FatInitializeDiskCache (
     DiskCache[CacheData].PageAlignment = FAT_DATACACHE_PAGE_MAX_ALIGNMENT;
   }
 
-  DiskCache[CacheData].GroupMask     = FAT_DATACACHE_GROUP_COUNT - 1;
-  DiskCache[CacheData].BaseAddress   = Volume->RootPos;
-  DiskCache[CacheData].LimitAddress  = Volume->VolumeSize;
-  DiskCache[CacheFat].GroupMask      = FatCacheGroupCount - 1;
-  DiskCache[CacheFat].BaseAddress    = Volume->FatPos;
-  DiskCache[CacheFat].LimitAddress   = Volume->FatPos + Volume->FatSize;
+  DataCacheWayCount   = PcdGet32 (PcdFatDataCacheWayCount);
+  if (DataCacheWayCount == 0) {
+    DataCacheWayCount = 1;
+  }
+
+  DataCacheGroupCount = GetPowerOfTwo32 (
+                          (PcdGet32 (PcdFatDataCacheSize) >> DiskCache[CacheData].PageAlignment) / (UINT32) DataCacheWayCount
+                          );
+  if (DataCacheGroupCount == 0) {
+    DataCacheGroupCount = 1;
+  }
+
+  DiskCache[CacheData].GroupMask      = DataCacheGroupCount - 1;
+  DiskCache[CacheData].WayCount       = DataCacheWayCount;
+  DiskCache[CacheData].BaseAddress    = Volume->RootPos;
+  DiskCache[CacheData].LimitAddress   = Volume->VolumeSize;
+  DiskCache[CacheData].LastPageNo     = MAX_UINTN - 1;
+  DiskCache[CacheData].ReadAheadCount = MIN (PcdGet32 (PcdFatReadAheadPageCount), DataCacheGroupCount);
+  DiskCache[CacheFat].GroupMask       = FatCacheGroupCount - 1;
+  DiskCache[CacheFat].WayCount        = 1;
+  DiskCache[CacheFat].BaseAddress     = Volume->FatPos;
+  DiskCache[CacheFat].LimitAddress    = Volume->FatPos + Volume->FatSize;
+  DiskCache[CacheFat].LastPageNo      = MAX_UINTN - 1;
+  DiskCache[CacheFat].ReadAheadCount  = 0;
   FatCacheSize                        = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
-  DataCacheSize                       = FAT_DATACACHE_GROUP_COUNT << DiskCache[CacheData].PageAlignment;
+  DataCacheSize                       = (DataCacheGroupCount * DataCacheWayCount) << DiskCache[CacheData].PageAlignment;
+  CacheTagSize                        = (FatCacheGroupCount + DataCacheGroupCount * DataCacheWayCount) * sizeof (CACHE_TAG);
   //
-  // Allocate the Fat Cache buffer
+  // Allocate the Fat Cache buffer, the Data Cache buffer and the Cache Tags
   //
-  CacheBuffer = AllocateZeroPool (FatCacheSize + DataCacheSize);
+  CacheBuffer = AllocateZeroPool (FatCacheSize + DataCacheSize + CacheTagSize);
   if (CacheBuffer == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -491,5 +742,33 @@ FatInitializeDiskCache (
   Volume->CacheBuffer             = CacheBuffer;
   DiskCache[CacheFat].CacheBase  = CacheBuffer;
   DiskCache[CacheData].CacheBase = CacheBuffer + FatCacheSize;
+  DiskCache[CacheFat].CacheTag   = (CACHE_TAG *) (CacheBuffer + FatCacheSize + DataCacheSize);
+  DiskCache[CacheData].CacheTag  = DiskCache[CacheFat].CacheTag + FatCacheGroupCount;
   return EFI_SUCCESS;
 }
+
+/**
+
+  Report the hit, miss and read-ahead statistics of the disk cache.
+
+  @param  Volume                - FAT file system volume.
+
+**/
+VOID
+FatDumpDiskCacheStatistics (
+  IN FAT_VOLUME         *Volume
+  )
+{
+  DISK_CACHE  *DiskCache;
+
+  DiskCache = Volume->DiskCache;
+  DEBUG ((
+    EFI_D_INFO,
+    "FatDiskCache: FAT hit %ld miss %ld, Data hit %ld miss %ld read-ahead pages %ld\n",
+    DiskCache[CacheFat].HitCount,
+    DiskCache[CacheFat].MissCount,
+    DiskCache[CacheData].HitCount,
+    DiskCache[CacheData].MissCount,
+    DiskCache[CacheData].ReadAheadPages
+    ));
+}
@@ -86,7 +86,6 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define FAT_FATCACHE_PAGE_MAX_ALIGNMENT   15
 #define FAT_DATACACHE_PAGE_MIN_ALIGNMENT  13
 #define FAT_DATACACHE_PAGE_MAX_ALIGNMENT  16
-#define FAT_DATACACHE_GROUP_COUNT         64
 #define FAT_FATCACHE_GROUP_MIN_COUNT      1
 #define FAT_FATCACHE_GROUP_MAX_COUNT      16
 
@@ -110,7 +109,13 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define LC_ISO_639_2_ENTRY_SIZE 3
 #define MAX_LANG_CODE_SIZE      100
 
-#define FAT_MAX_DIR_CACHE_COUNT 8
+//
+// The directory cache keeps at most FAT_MAX_DIR_CACHE_COUNT directories, and
+// evicts the least recently used ones while the cached directories together hold
+// more than FAT_MAX_DIR_CACHE_ENTRY_COUNT directory entries
+//
+#define FAT_MAX_DIR_CACHE_COUNT       64
+#define FAT_MAX_DIR_CACHE_ENTRY_COUNT 0x8000
 #define FAT_MAX_DIRENTRY_COUNT  0xFFFF
 typedef CHAR8                   LC_ISO_639_2;
 
@@ -153,8 +158,14 @@ typedef struct {
   UINTN   PageNo;
   UINTN   RealSize;
   BOOLEAN Dirty;
+  UINTN   AccessStamp;                        // Stamp of the last access, used for LRU replacement
 } CACHE_TAG;
 
+//
+// The disk cache is set-associative: page PageNo lives in set (PageNo & GroupMask)
+// in one of WayCount ways. The tag and page of way W in set S are at index
+// (W * (GroupMask + 1) + S), so consecutive pages of one way are contiguous in memory.
+//
 typedef struct {
   UINT64    BaseAddress;
   UINT64    LimitAddress;
@@ -162,14 +173,31 @@ typedef struct {
   BOOLEAN   Dirty;
   UINT8     PageAlignment;
   UINTN     GroupMask;
-  CACHE_TAG CacheTag[FAT_DATACACHE_GROUP_COUNT];
+  UINTN     WayCount;
+  UINTN     AccessStamp;
+  //
+  // Sequential access detection and read-ahead
+  //
+  UINTN     LastPageNo;
+  BOOLEAN   Sequential;
+  UINTN     ReadAheadCount;
+  //
+  // Statistics
+  //
+  UINT64    HitCount;
+  UINT64    MissCount;
+  UINT64    ReadAheadPages;
+  CACHE_TAG *CacheTag;
 } DISK_CACHE;
 
 //
-// Hash table size
+// Hash table size. The hash tables of a directory start at HASH_TABLE_MIN_SIZE
+// buckets and are doubled, up to HASH_TABLE_MAX_SIZE buckets, whenever the
+// directory holds more than HASH_TABLE_LOAD_FACTOR entries per bucket
 //
-#define HASH_TABLE_SIZE  0x400
-#define HASH_TABLE_MASK  (HASH_TABLE_SIZE - 1)
+#define HASH_TABLE_MIN_SIZE     0x40
+#define HASH_TABLE_MAX_SIZE     0x4000
+#define HASH_TABLE_LOAD_FACTOR  2
 
 //
 // The directory entry for opened directory
@@ -202,8 +230,10 @@ struct _FAT_ODIR {
   BOOLEAN             EndOfDir;               // Indicate whether we have reached the end of the directory
   LIST_ENTRY          DirCacheLink;           // Linked in Volume->DirCacheList when discarded
   UINTN               DirCacheTag;            // The identification of the directory when in directory cache
-  FAT_DIRENT          *LongNameHashTable[HASH_TABLE_SIZE];
-  FAT_DIRENT          *ShortNameHashTable[HASH_TABLE_SIZE];
+  UINTN               DirEntCount;            // The count of directory entries in the hash tables
+  UINTN               HashTableMask;          // The bucket count of the hash tables minus one
+  FAT_DIRENT          **LongNameHashTable;
+  FAT_DIRENT          **ShortNameHashTable;
 };
 
 typedef struct {
@@ -375,6 +405,12 @@ struct _FAT_VOLUME {
   //
   LIST_ENTRY                      DirCacheList;
   UINTN                           DirCacheCount;
+  UINTN                           DirCacheEntryCount;
+  //
+  // Directory cache statistics
+  //
+  UINTN                           DirParseCount;
+  UINTN                           DirCacheHitCount;
 
   //
   // Disk Cache for this volume
@@ -774,6 +810,18 @@ FatVolumeFlushCache (
   IN FAT_TASK                *Task
   );
 
+/**
+
+  Report the hit, miss and read-ahead statistics of the disk cache.
+
+  @param  Volume                - FAT file system volume.
+
+**/
+VOID
+FatDumpDiskCacheStatistics (
+  IN FAT_VOLUME              *Volume
+  );
+
 //
 // Flush.c
 //
@@ -1991,7 +2039,8 @@ FatRequestODir (
 
 /**
 
-  Clean up all the cached directory structures when the volume is going to be abandoned.
+  Clean up all the cached directory structures when the volume is going to be abandoned,
+  or when its media is changed or removed.
 
   @param  Volume                - FAT file system volume.
 
@@ -398,6 +398,14 @@ FatCleanupVolume (
   // volume be cleaned up even the volume is invalid.
   //
   FatCheckVolumeRef (Volume);
+  //
+  // The cached directories describe the old media once the media is changed
+  // or removed, so they must not be reused.
+  //
+  if (!Volume->Valid || EfiStatus == EFI_MEDIA_CHANGED || EfiStatus == EFI_NO_MEDIA) {
+    FatCleanupODirCache (Volume);
+  }
+
   if (Volume->Valid) {
     //
     // Update the free hint info. Volume->FreeInfoPos != 0
@@ -39,7 +39,7 @@ FatHashLongName (
     );
   FatStrUpr (UpCasedLongFileName);
   gBS->CalculateCrc32 (UpCasedLongFileName, StrSize (UpCasedLongFileName), &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
 }
 
 /**
@@ -59,7 +59,7 @@ FatHashShortName (
 {
   UINT32  HashValue;
   gBS->CalculateCrc32 (ShortNameString, FAT_NAME_LEN, &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
 }
 
 /**
@@ -79,7 +79,7 @@ FatLongNameHashSearch (
   )
 {
   FAT_DIRENT  **PreviousHashNode;
-  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString)];
+  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString) & ODir->HashTableMask];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->LongNameForwardLink
       ) {
@@ -108,7 +108,7 @@ FatShortNameHashSearch (
   )
 {
   FAT_DIRENT  **PreviousHashNode;
-  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString)];
+  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString) & ODir->HashTableMask];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->ShortNameForwardLink
       ) {
@@ -120,9 +120,65 @@ FatShortNameHashSearch (
   return PreviousHashNode;
 }
 
+/**
+
+  Double the bucket count of the hash tables of the directory and move all
+  directory entries into the new tables.
+  If the new tables cannot be allocated, the directory keeps its current tables.
+
+  @param  ODir                  - The directory whose hash tables are to be grown.
+
+**/
+STATIC
+VOID
+FatGrowHashTable (
+  IN FAT_ODIR     *ODir
+  )
+{
+  FAT_DIRENT  **LongNameHashTable;
+  FAT_DIRENT  **ShortNameHashTable;
+  FAT_DIRENT  *DirEnt;
+  UINTN       HashTableSize;
+  UINTN       HashTableMask;
+  UINTN       Index;
+  UINTN       HashTableIndex;
+
+  HashTableSize       = (ODir->HashTableMask + 1) * 2;
+  HashTableMask       = HashTableSize - 1;
+  ShortNameHashTable  = AllocateZeroPool (2 * HashTableSize * sizeof (FAT_DIRENT *));
+  if (ShortNameHashTable == NULL) {
+    return;
+  }
+
+  LongNameHashTable = ShortNameHashTable + HashTableSize;
+  for (Index = 0; Index <= ODir->HashTableMask; Index++) {
+    while (ODir->ShortNameHashTable[Index] != NULL) {
+      DirEnt                              = ODir->ShortNameHashTable[Index];
+      ODir->ShortNameHashTable[Index]     = DirEnt->ShortNameForwardLink;
+      HashTableIndex                      = FatHashShortName (DirEnt->Entry.FileName) & HashTableMask;
+      DirEnt->ShortNameForwardLink        = ShortNameHashTable[HashTableIndex];
+      ShortNameHashTable[HashTableIndex]  = DirEnt;
+    }
+
+    while (ODir->LongNameHashTable[Index] != NULL) {
+      DirEnt                              = ODir->LongNameHashTable[Index];
+      ODir->LongNameHashTable[Index]      = DirEnt->LongNameForwardLink;
+      HashTableIndex                      = FatHashLongName (DirEnt->FileString) & HashTableMask;
+      DirEnt->LongNameForwardLink         = LongNameHashTable[HashTableIndex];
+      LongNameHashTable[HashTableIndex]   = DirEnt;
+    }
+  }
+
+  FreePool (ODir->ShortNameHashTable);
+  ODir->ShortNameHashTable  = ShortNameHashTable;
+  ODir->LongNameHashTable   = LongNameHashTable;
+  ODir->HashTableMask       = HashTableMask;
+}
+
 /**
 
   Insert directory entry to hash table.
+  The hash tables are grown when the directory becomes too large for them.
 
   @param  ODir                  - The parent directory.
   @param  DirEnt                - The directory entry node.
@@ -135,19 +191,25 @@ FatInsertToHashTable (
   )
 {
   FAT_DIRENT  **HashTable;
-  UINT32      HashTableIndex;
+  UINTN       HashTableIndex;
+
+  if (ODir->DirEntCount >= HASH_TABLE_LOAD_FACTOR * (ODir->HashTableMask + 1) &&
+      ODir->HashTableMask + 1 < HASH_TABLE_MAX_SIZE) {
+    FatGrowHashTable (ODir);
+  }
 
+  ODir->DirEntCount++;
   //
   // Insert hash table index for short name
   //
-  HashTableIndex                = FatHashShortName (DirEnt->Entry.FileName);
+  HashTableIndex                = FatHashShortName (DirEnt->Entry.FileName) & ODir->HashTableMask;
   HashTable                     = ODir->ShortNameHashTable;
   DirEnt->ShortNameForwardLink  = HashTable[HashTableIndex];
   HashTable[HashTableIndex]     = DirEnt;
   //
   // Insert hash table index for long name
   //
-  HashTableIndex                = FatHashLongName (DirEnt->FileString);
+  HashTableIndex                = FatHashLongName (DirEnt->FileString) & ODir->HashTableMask;
   HashTable                     = ODir->LongNameHashTable;
   DirEnt->LongNameForwardLink   = HashTable[HashTableIndex];
   HashTable[HashTableIndex]     = DirEnt;
@@ -169,4 +231,5 @@ FatDeleteFromHashTable (
 {
   *FatShortNameHashSearch (ODir, DirEnt->Entry.FileName) = DirEnt->ShortNameForwardLink;
   *FatLongNameHashSearch (ODir, DirEnt->FileString)      = DirEnt->LongNameForwardLink;
+  ODir->DirEntCount--;
 }
@@ -459,11 +459,18 @@ FatFreeVolume (
   // Free disk cache
   //
   if (Volume->CacheBuffer != NULL) {
+    FatDumpDiskCacheStatistics (Volume);
     FreePool (Volume->CacheBuffer);
   }
   //
   // Free directory cache
   //
+  DEBUG ((
+    EFI_D_INFO,
+    "FatODirCache: %ld directories parsed, %ld directory cache hits\n",
+    (UINT64) Volume->DirParseCount,
+    (UINT64) Volume->DirCacheHitCount
+    ));
   FatCleanupODirCache (Volume);
   FreePool (Volume);
 }
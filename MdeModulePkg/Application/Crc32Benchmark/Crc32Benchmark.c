@@ -0,0 +1,207 @@
+/** @file
+  A shell application that measures the throughput of the CRC32 calculation.
+
+  It computes the CRC32 of a 64 MiB buffer with the BaseLib CalculateCrc32(),
+  the CalculateCrc32() boot service and a byte-at-a-time reference loop, checks
+  that they agree and reports the throughput of each in GB/s.
+
+  Copyright (c) 2026 Baikal Electronics JSC
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Uefi.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/BaseLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/PrintLib.h>
+#include <Library/BenchmarkLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#define CRC32_BENCHMARK_BUFFER_SIZE   SIZE_64MB
+#define CRC32_BENCHMARK_ITERATIONS    4
+
+/**
+  Compute the CRC32 of a buffer one byte at a time, as a reference.
+
+  @param[in]  Buffer       A pointer to the buffer.
+  @param[in]  Length       The number of bytes in the buffer.
+
+  @return The 32-bit CRC of the buffer.
+
+**/
+UINT32
+ReferenceCrc32 (
+  IN  VOID                         *Buffer,
+  IN  UINTN                        Length
+  )
+{
+  UINT8                            *Ptr;
+  UINT32                           Crc;
+  UINTN                            Bit;
+
+  Crc = 0xFFFFFFFF;
+  for (Ptr = Buffer; Length > 0; Ptr++, Length--) {
+    Crc ^= *Ptr;
+    for (Bit = 0; Bit < 8; Bit++) {
+      Crc = (Crc >> 1) ^ (0xEDB88320 & (0 - (Crc & 1)));
+    }
+  }
+  return Crc ^ 0xFFFFFFFF;
+}
+
+/**
+  Compute the CRC32 of a buffer with the BaseLib CalculateCrc32().
+
+  @param[in]  Buffer       A pointer to the buffer.
+  @param[in]  Length       The number of bytes in the buffer.
+
+  @return The 32-bit CRC of the buffer.
+
+**/
+UINT32
+BaseLibCrc32 (
+  IN  VOID                         *Buffer,
+  IN  UINTN                        Length
+  )
+{
+  return CalculateCrc32 (Buffer, Length);
+}
+
+/**
+  Compute the CRC32 of a buffer with the CalculateCrc32() boot service.
+
+  @param[in]  Buffer       A pointer to the buffer.
+  @param[in]  Length       The number of bytes in the buffer.
+
+  @return The 32-bit CRC of the buffer.
+
+**/
+UINT32
+BootServiceCrc32 (
+  IN  VOID                         *Buffer,
+  IN  UINTN                        Length
+  )
+{
+  UINT32                           Crc;
+
+  Crc = 0;
+  gBS->CalculateCrc32 (Buffer, Length, &Crc);
+  return Crc;
+}
+
+typedef
+UINT32
+(*CRC32_FUNCTION) (
+  IN  VOID                         *Buffer,
+  IN  UINTN                        Length
+  );
+
+/**
+  Measure and print the throughput of one CRC32 implementation.
+
+  @param[in]  Name         The name of the implementation.
+  @param[in]  Function     The implementation.
+  @param[in]  Buffer       A pointer to the buffer.
+  @param[in]  Length       The number of bytes in the buffer.
+  @param[in]  Iterations   The number of times to compute the CRC.
+
+  @return The 32-bit CRC of the buffer.
+
+**/
+UINT32
+MeasureCrc32 (
+  IN  CHAR16                       *Name,
+  IN  CRC32_FUNCTION               Function,
+  IN  VOID                         *Buffer,
+  IN  UINTN                        Length,
+  IN  UINTN                        Iterations
+  )
+{
+  UINT64                           Start;
+  UINT64                           End;
+  UINTN                            Index;
+  UINT32                           Crc;
+  CHAR16                           Label[32];
+
+  Crc   = 0;
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < Iterations; Index++) {
+    Crc = Function (Buffer, Length);
+  }
+  End = GetPerformanceCounter ();
+
+  UnicodeSPrint (Label, sizeof (Label), L"%-14s CRC %08x ", Name, Crc);
+  BenchmarkPrintThroughput (Label, MultU64x32 (Length, (UINT32) Iterations), BenchmarkElapsedNanoSecond (Start, End));
+
+  return Crc;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  UINT32               *Buffer;
+  UINTN                Index;
+  UINT32               Seed;
+  UINT32               Crc;
+  UINT32               ReferenceCrc;
+  BOOLEAN              Match;
+
+  Buffer = AllocatePool (CRC32_BENCHMARK_BUFFER_SIZE);
+  if (Buffer == NULL) {
+    Print (L"Crc32Benchmark: Unable to allocate %d MiB buffer\n", CRC32_BENCHMARK_BUFFER_SIZE / SIZE_1MB);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Fill the buffer with pseudo random data.
+  //
+  Seed = 0x12345678;
+  for (Index = 0; Index < CRC32_BENCHMARK_BUFFER_SIZE / sizeof (UINT32); Index++) {
+    Seed          = Seed * 1664525 + 1013904223;
+    Buffer[Index] = Seed;
+  }
+
+  Print (L"CRC32 throughput on a %d MiB buffer:\n", CRC32_BENCHMARK_BUFFER_SIZE / SIZE_1MB);
+
+  ReferenceCrc = MeasureCrc32 (L"Reference", ReferenceCrc32, Buffer, CRC32_BENCHMARK_BUFFER_SIZE, 1);
+  Match        = TRUE;
+  Crc          = MeasureCrc32 (L"BaseLib", BaseLibCrc32, Buffer, CRC32_BENCHMARK_BUFFER_SIZE, CRC32_BENCHMARK_ITERATIONS);
+  Match        = (BOOLEAN) (Match && (Crc == ReferenceCrc));
+  Crc          = MeasureCrc32 (L"BootServices", BootServiceCrc32, Buffer, CRC32_BENCHMARK_BUFFER_SIZE, CRC32_BENCHMARK_ITERATIONS);
+  Match        = (BOOLEAN) (Match && (Crc == ReferenceCrc));
+
+  //
+  // Unaligned start and odd length exercise the head and tail handling.
+  //
+  Crc   = CalculateCrc32 ((UINT8 *) Buffer + 3, CRC32_BENCHMARK_BUFFER_SIZE - 10);
+  Match = (BOOLEAN) (Match && (Crc == ReferenceCrc32 ((UINT8 *) Buffer + 3, CRC32_BENCHMARK_BUFFER_SIZE - 10)));
+
+  Print (L"CRC32 results %s\n", Match ? L"match" : L"MISMATCH");
+
+  FreePool (Buffer);
+  return Match ? EFI_SUCCESS : EFI_CRC_ERROR;
+}
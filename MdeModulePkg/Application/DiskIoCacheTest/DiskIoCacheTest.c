@@ -0,0 +1,377 @@
+/** @file
+  A shell application that checks the Disk I/O metadata cache is not stale.
+
+  It registers a RAM disk holding an MBR with one partition, reads a few bytes
+  of the partition through the Disk I/O protocol of the whole disk so that the
+  block is cached, then changes them by writing through the Disk I/O protocol
+  of the whole disk and through the Disk I/O and Block I/O protocols of the
+  partition, and checks that every read through the whole disk and through the
+  partition returns the new data.
+
+  Copyright (c) 2026 Baikal Electronics JSC
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Uefi.h>
+#include <IndustryStandard/Mbr.h>
+#include <Protocol/BlockIo.h>
+#include <Protocol/DiskIo.h>
+#include <Protocol/DevicePath.h>
+#include <Protocol/RamDisk.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#define DISK_IO_CACHE_TEST_BLOCK_SIZE       512
+#define DISK_IO_CACHE_TEST_DISK_BLOCKS      64
+#define DISK_IO_CACHE_TEST_PARTITION_START  8
+#define DISK_IO_CACHE_TEST_OFFSET           100
+#define DISK_IO_CACHE_TEST_LENGTH           16
+
+typedef enum {
+  WriteThroughDiskIo,
+  WriteThroughPartitionDiskIo,
+  WriteThroughPartitionBlockIo,
+  WriteMax
+} DISK_IO_CACHE_TEST_WRITE;
+
+CHAR16 *mWriteName[] = {
+  L"parent Disk I/O",
+  L"partition Disk I/O",
+  L"partition Block I/O"
+};
+
+/**
+  Build a disk image with an MBR holding one partition.
+
+  @return The disk image, or NULL if there is not enough memory.
+
+**/
+UINT8 *
+CreateDiskImage (
+  VOID
+  )
+{
+  UINT8                            *Disk;
+  MASTER_BOOT_RECORD               *Mbr;
+  UINT32                           Value;
+  UINTN                            Index;
+
+  //
+  // The RAM disk keeps using the memory until it is unregistered.
+  //
+  Disk = AllocateZeroPool (DISK_IO_CACHE_TEST_DISK_BLOCKS * DISK_IO_CACHE_TEST_BLOCK_SIZE);
+  if (Disk == NULL) {
+    return NULL;
+  }
+
+  Mbr = (MASTER_BOOT_RECORD *) Disk;
+  Mbr->Partition[0].OSIndicator = 0x83;
+  Value = DISK_IO_CACHE_TEST_PARTITION_START;
+  CopyMem (Mbr->Partition[0].StartingLBA, &Value, sizeof (Value));
+  Value = DISK_IO_CACHE_TEST_DISK_BLOCKS - DISK_IO_CACHE_TEST_PARTITION_START;
+  CopyMem (Mbr->Partition[0].SizeInLBA, &Value, sizeof (Value));
+  Mbr->Signature = MBR_SIGNATURE;
+
+  for (Index = DISK_IO_CACHE_TEST_PARTITION_START * DISK_IO_CACHE_TEST_BLOCK_SIZE;
+       Index < DISK_IO_CACHE_TEST_DISK_BLOCKS * DISK_IO_CACHE_TEST_BLOCK_SIZE;
+       Index++) {
+    Disk[Index] = (UINT8) Index;
+  }
+  return Disk;
+}
+
+/**
+  Find the handles of the whole disk and of its partition.
+
+  @param[in]  DevicePath     The device path of the RAM disk.
+  @param[out] DiskHandle     Returns the handle of the whole disk.
+  @param[out] PartitionHandle Returns the handle of the partition.
+
+  @retval EFI_SUCCESS        Both handles are found.
+  @retval EFI_NOT_FOUND      A handle is not found.
+
+**/
+EFI_STATUS
+FindDiskHandles (
+  IN  EFI_DEVICE_PATH_PROTOCOL     *DevicePath,
+  OUT EFI_HANDLE                   *DiskHandle,
+  OUT EFI_HANDLE                   *PartitionHandle
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_HANDLE                       *Handles;
+  UINTN                            HandleCount;
+  UINTN                            Index;
+  UINTN                            Size;
+  EFI_DEVICE_PATH_PROTOCOL         *HandleDevicePath;
+
+  *DiskHandle      = NULL;
+  *PartitionHandle = NULL;
+  Status = gBS->LocateHandleBuffer (ByProtocol, &gEfiDiskIoProtocolGuid, NULL, &HandleCount, &Handles);
+  if (EFI_ERROR (Status)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Size = GetDevicePathSize (DevicePath) - END_DEVICE_PATH_LENGTH;
+  for (Index = 0; Index < HandleCount; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiDevicePathProtocolGuid, (VOID **) &HandleDevicePath);
+    if (EFI_ERROR (Status) || (GetDevicePathSize (HandleDevicePath) < Size + END_DEVICE_PATH_LENGTH) ||
+        (CompareMem (HandleDevicePath, DevicePath, Size) != 0)) {
+      continue;
+    }
+    if (GetDevicePathSize (HandleDevicePath) == Size + END_DEVICE_PATH_LENGTH) {
+      *DiskHandle = Handles[Index];
+    } else {
+      *PartitionHandle = Handles[Index];
+    }
+  }
+  FreePool (Handles);
+
+  if ((*DiskHandle == NULL) || (*PartitionHandle == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return EFI_SUCCESS;
+}
+
+/**
+  Write a few bytes at DISK_IO_CACHE_TEST_OFFSET of the first block of the
+  partition.
+
+  @param[in]  DiskHandle     The handle of the whole disk.
+  @param[in]  PartitionHandle The handle of the partition.
+  @param[in]  Write          The protocol to write through.
+  @param[in]  Data           The bytes to write.
+
+  @return The status of the write.
+
+**/
+EFI_STATUS
+WriteData (
+  IN EFI_HANDLE                    DiskHandle,
+  IN EFI_HANDLE                    PartitionHandle,
+  IN DISK_IO_CACHE_TEST_WRITE      Write,
+  IN UINT8                         *Data
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_HANDLE                       Handle;
+  EFI_DISK_IO_PROTOCOL             *DiskIo;
+  EFI_BLOCK_IO_PROTOCOL            *BlockIo;
+  UINT64                           Offset;
+  UINT8                            Block[DISK_IO_CACHE_TEST_BLOCK_SIZE];
+
+  if (Write == WriteThroughDiskIo) {
+    Handle = DiskHandle;
+    Offset = DISK_IO_CACHE_TEST_PARTITION_START * DISK_IO_CACHE_TEST_BLOCK_SIZE + DISK_IO_CACHE_TEST_OFFSET;
+  } else {
+    Handle = PartitionHandle;
+    Offset = DISK_IO_CACHE_TEST_OFFSET;
+  }
+
+  Status = gBS->HandleProtocol (Handle, &gEfiBlockIoProtocolGuid, (VOID **) &BlockIo);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (Write != WriteThroughPartitionBlockIo) {
+    Status = gBS->HandleProtocol (Handle, &gEfiDiskIoProtocolGuid, (VOID **) &DiskIo);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+    return DiskIo->WriteDisk (DiskIo, BlockIo->Media->MediaId, Offset, DISK_IO_CACHE_TEST_LENGTH, Data);
+  }
+
+  Status = BlockIo->ReadBlocks (BlockIo, BlockIo->Media->MediaId, 0, sizeof (Block), Block);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+  CopyMem (Block + DISK_IO_CACHE_TEST_OFFSET, Data, DISK_IO_CACHE_TEST_LENGTH);
+  return BlockIo->WriteBlocks (BlockIo, BlockIo->Media->MediaId, 0, sizeof (Block), Block);
+}
+
+/**
+  Read a few bytes at DISK_IO_CACHE_TEST_OFFSET of the first block of the
+  partition.
+
+  @param[in]  DiskHandle     The handle of the whole disk.
+  @param[in]  PartitionHandle The handle of the partition, or NULL to read
+                             through the whole disk.
+  @param[out] Data           Returns the bytes read.
+
+  @return The status of the read.
+
+**/
+EFI_STATUS
+ReadData (
+  IN  EFI_HANDLE                   DiskHandle,
+  IN  EFI_HANDLE                   PartitionHandle,
+  OUT UINT8                        *Data
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_HANDLE                       Handle;
+  EFI_DISK_IO_PROTOCOL             *DiskIo;
+  EFI_BLOCK_IO_PROTOCOL            *BlockIo;
+  UINT64                           Offset;
+
+  if (PartitionHandle == NULL) {
+    Handle = DiskHandle;
+    Offset = DISK_IO_CACHE_TEST_PARTITION_START * DISK_IO_CACHE_TEST_BLOCK_SIZE + DISK_IO_CACHE_TEST_OFFSET;
+  } else {
+    Handle = PartitionHandle;
+    Offset = DISK_IO_CACHE_TEST_OFFSET;
+  }
+
+  Status = gBS->HandleProtocol (Handle, &gEfiBlockIoProtocolGuid, (VOID **) &BlockIo);
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->HandleProtocol (Handle, &gEfiDiskIoProtocolGuid, (VOID **) &DiskIo);
+  }
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+  return DiskIo->ReadDisk (DiskIo, BlockIo->Media->MediaId, Offset, DISK_IO_CACHE_TEST_LENGTH, Data);
+}
+
+/**
+  Check that reads through the whole disk and through the partition see the
+  writes.
+
+  @param[in]  DiskHandle     The handle of the whole disk.
+  @param[in]  PartitionHandle The handle of the partition.
+
+  @return The number of failed checks.
+
+**/
+UINTN
+RunTests (
+  IN EFI_HANDLE                    DiskHandle,
+  IN EFI_HANDLE                    PartitionHandle
+  )
+{
+  EFI_STATUS                       Status;
+  UINT8                            Expected[DISK_IO_CACHE_TEST_LENGTH];
+  UINT8                            Data[DISK_IO_CACHE_TEST_LENGTH];
+  UINT8                            PartitionData[DISK_IO_CACHE_TEST_LENGTH];
+  DISK_IO_CACHE_TEST_WRITE         Write;
+  UINTN                            Index;
+  UINTN                            Failures;
+
+  Failures = 0;
+  for (Write = WriteThroughDiskIo; Write < WriteMax; Write++) {
+    //
+    // Read the bytes twice, so that the block is cached and served from the
+    // cache of the whole disk at least once before the write.
+    //
+    for (Index = 0; Index < 2; Index++) {
+      Status = ReadData (DiskHandle, NULL, Data);
+    }
+    for (Index = 0; Index < sizeof (Expected); Index++) {
+      Expected[Index] = (UINT8) (Data[Index] ^ (0x5A + Write));
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = WriteData (DiskHandle, PartitionHandle, Write, Expected);
+    }
+    if (!EFI_ERROR (Status)) {
+      Status = ReadData (DiskHandle, NULL, Data);
+    }
+    if (!EFI_ERROR (Status)) {
+      Status = ReadData (DiskHandle, PartitionHandle, PartitionData);
+    }
+
+    if (EFI_ERROR (Status)) {
+      Print (L"DiskIoCacheTest: write through %s: FAILED - %r\n", mWriteName[Write], Status);
+      Failures++;
+    } else if ((CompareMem (Data, Expected, sizeof (Data)) != 0) ||
+               (CompareMem (PartitionData, Expected, sizeof (PartitionData)) != 0)) {
+      Print (L"DiskIoCacheTest: write through %s: FAILED - stale data read\n", mWriteName[Write]);
+      Failures++;
+    } else {
+      Print (L"DiskIoCacheTest: write through %s: PASS\n", mWriteName[Write]);
+    }
+  }
+
+  return Failures;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       All the checks passed.
+  @retval EFI_ABORTED       A check failed.
+  @retval other             The RAM disk could not be set up.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_RAM_DISK_PROTOCOL            *RamDisk;
+  EFI_DEVICE_PATH_PROTOCOL         *DevicePath;
+  EFI_HANDLE                       DiskHandle;
+  EFI_HANDLE                       PartitionHandle;
+  UINT8                            *Disk;
+  UINTN                            Failures;
+
+  Status = gBS->LocateProtocol (&gEfiRamDiskProtocolGuid, NULL, (VOID **) &RamDisk);
+  if (EFI_ERROR (Status)) {
+    Print (L"DiskIoCacheTest: no RAM disk protocol - %r\n", Status);
+    return Status;
+  }
+
+  Disk = CreateDiskImage ();
+  if (Disk == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Registering the RAM disk connects the Disk I/O and partition drivers.
+  //
+  Status = RamDisk->Register (
+                      (UINT64) (UINTN) Disk,
+                      DISK_IO_CACHE_TEST_DISK_BLOCKS * DISK_IO_CACHE_TEST_BLOCK_SIZE,
+                      &gEfiVirtualDiskGuid,
+                      NULL,
+                      &DevicePath
+                      );
+  if (EFI_ERROR (Status)) {
+    Print (L"DiskIoCacheTest: failed to register the RAM disk - %r\n", Status);
+    FreePool (Disk);
+    return Status;
+  }
+
+  Status = FindDiskHandles (DevicePath, &DiskHandle, &PartitionHandle);
+  if (EFI_ERROR (Status)) {
+    Print (L"DiskIoCacheTest: the partition is not found - %r\n", Status);
+    Failures = WriteMax;
+  } else {
+    Failures = RunTests (DiskHandle, PartitionHandle);
+  }
+
+  RamDisk->Unregister (DevicePath);
+  FreePool (DevicePath);
+  FreePool (Disk);
+
+  return (Failures == 0) ? EFI_SUCCESS : EFI_ABORTED;
+}
@@ -0,0 +1,340 @@
+/** @file
+  A shell application that measures the NET_BUF receive and checksum paths.
+
+  It compares NetblockChecksum() against a 16-bit at a time reference loop, at
+  aligned and odd offsets, and then pumps UDP sized datagrams through NET_BUF
+  the way Udp4Dxe does: wrap the payload with NetbufFromExt(), prepend the UDP
+  head, checksum it and deliver it to several receivers, either by cloning the
+  net buffer or by duplicating its data. It reports the throughput of each.
+
+  Copyright (c) 2026 Baikal Electronics JSC
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Uefi.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/NetLib.h>
+#include <Library/PrintLib.h>
+#include <Library/BenchmarkLib.h>
+
+#define NETBUF_BENCHMARK_BUFFER_SIZE      SIZE_1MB
+#define NETBUF_BENCHMARK_ITERATIONS       64
+#define NETBUF_BENCHMARK_DATAGRAM_SIZE    1472
+#define NETBUF_BENCHMARK_DATAGRAMS        100000
+#define NETBUF_BENCHMARK_RECEIVERS        4
+
+typedef
+NET_BUF *
+(EFIAPI *NETBUF_COPY_FUNCTION) (
+  IN NET_BUF                       *Nbuf
+  );
+
+/**
+  Compute the checksum of a buffer 16 bits at a time, as a reference.
+
+  @param[in]  Bulk         A pointer to the data.
+  @param[in]  Len          The number of bytes in the data.
+
+  @return The folded 16-bit one's complement sum of the data.
+
+**/
+UINT16
+ReferenceChecksum (
+  IN  UINT8                        *Bulk,
+  IN  UINT32                       Len
+  )
+{
+  UINT64                           Sum;
+
+  Sum = 0;
+  if (Len % 2 != 0) {
+    Sum += *(Bulk + Len - 1);
+  }
+
+  while (Len > 1) {
+    Sum  += ReadUnaligned16 ((UINT16 *) Bulk);
+    Bulk += 2;
+    Len  -= 2;
+  }
+
+  while (RShiftU64 (Sum, 16) != 0) {
+    Sum = (Sum & 0xffff) + RShiftU64 (Sum, 16);
+  }
+
+  return (UINT16) Sum;
+}
+
+/**
+  Measure the throughput of one checksum implementation.
+
+  @param[in]  Name         The name of the implementation.
+  @param[in]  UseNetLib    TRUE to use NetblockChecksum(), FALSE for the reference.
+  @param[in]  Buffer       A pointer to the data.
+  @param[in]  Length       The number of bytes in the data.
+
+  @return The checksum of the data.
+
+**/
+UINT16
+MeasureChecksum (
+  IN  CHAR16                       *Name,
+  IN  BOOLEAN                      UseNetLib,
+  IN  UINT8                        *Buffer,
+  IN  UINT32                       Length
+  )
+{
+  UINT64                           Start;
+  UINT64                           End;
+  UINTN                            Index;
+  UINT16                           Checksum;
+  CHAR16                           Label[32];
+
+  Checksum = 0;
+  Start    = GetPerformanceCounter ();
+  for (Index = 0; Index < NETBUF_BENCHMARK_ITERATIONS; Index++) {
+    if (UseNetLib) {
+      Checksum = NetblockChecksum (Buffer, Length);
+    } else {
+      Checksum = ReferenceChecksum (Buffer, Length);
+    }
+  }
+  End = GetPerformanceCounter ();
+
+  UnicodeSPrint (Label, sizeof (Label), L"%-24s", Name);
+  BenchmarkPrintThroughput (
+    Label,
+    MultU64x32 (Length, NETBUF_BENCHMARK_ITERATIONS),
+    BenchmarkElapsedNanoSecond (Start, End)
+    );
+
+  return Checksum;
+}
+
+/**
+  The external free function of the benchmark's datagrams, the payload is
+  owned by the benchmark so there is nothing to release.
+
+  @param[in]  Arg          Unused.
+
+**/
+VOID
+EFIAPI
+BenchmarkExtFree (
+  IN VOID                          *Arg
+  )
+{
+}
+
+/**
+  Give a receiver a private copy of the datagram's data.
+
+  @param[in]  Nbuf         The datagram.
+
+  @return The copy, or NULL if out of resources.
+
+**/
+NET_BUF *
+EFIAPI
+DuplicateDatagram (
+  IN NET_BUF                       *Nbuf
+  )
+{
+  return NetbufDuplicate (Nbuf, NULL, 0);
+}
+
+/**
+  Send datagrams through NET_BUF and deliver each one to several receivers.
+
+  @param[in]  Name         The name of the run.
+  @param[in]  Copy         How each receiver gets its own net buffer.
+  @param[in]  Payload      The datagram payload.
+
+  @retval EFI_SUCCESS           All the datagrams were delivered.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate a net buffer.
+
+**/
+EFI_STATUS
+MeasureDatagrams (
+  IN  CHAR16                       *Name,
+  IN  NETBUF_COPY_FUNCTION         Copy,
+  IN  UINT8                        *Payload
+  )
+{
+  NET_FRAGMENT                     Fragment;
+  NET_FRAGMENT                     RxFragment[2];
+  UINT32                           FragmentCount;
+  NET_BUF                          *Packet;
+  NET_BUF                          *Receiver[NETBUF_BENCHMARK_RECEIVERS];
+  EFI_UDP_HEADER                   *Udp;
+  UINT64                           Start;
+  UINT64                           End;
+  UINTN                            Index;
+  UINTN                            Rx;
+  EFI_STATUS                       Status;
+  CHAR16                           Label[32];
+
+  Fragment.Bulk = Payload;
+  Fragment.Len  = NETBUF_BENCHMARK_DATAGRAM_SIZE;
+  Status        = EFI_SUCCESS;
+
+  Start = GetPerformanceCounter ();
+  for (Index = 0; Index < NETBUF_BENCHMARK_DATAGRAMS; Index++) {
+    Packet = NetbufFromExt (&Fragment, 1, sizeof (EFI_UDP_HEADER), 0, BenchmarkExtFree, NULL);
+    if (Packet == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      break;
+    }
+
+    Udp = (EFI_UDP_HEADER *) NetbufAllocSpace (Packet, sizeof (EFI_UDP_HEADER), NET_BUF_HEAD);
+    ASSERT (Udp != NULL);
+
+    Udp->SrcPort  = HTONS (1024);
+    Udp->DstPort  = HTONS (69);
+    Udp->Length   = HTONS ((UINT16) Packet->TotalSize);
+    Udp->Checksum = 0;
+    Udp->Checksum = (UINT16) ~NetbufChecksum (Packet);
+
+    //
+    // Deliver the datagram to each receiver, which then builds the fragment
+    // table it would hand up to the application.
+    //
+    for (Rx = 0; Rx < NETBUF_BENCHMARK_RECEIVERS; Rx++) {
+      Receiver[Rx] = Copy (Packet);
+      if (Receiver[Rx] == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+        break;
+      }
+
+      FragmentCount = 2;
+      NetbufBuildExt (Receiver[Rx], RxFragment, &FragmentCount);
+    }
+
+    while (Rx > 0) {
+      NetbufFree (Receiver[--Rx]);
+    }
+
+    NetbufFree (Packet);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+  End = GetPerformanceCounter ();
+
+  if (EFI_ERROR (Status)) {
+    Print (L"%-24s failed: %r\n", Name, Status);
+    return Status;
+  }
+
+  UnicodeSPrint (Label, sizeof (Label), L"%-24s", Name);
+  BenchmarkPrintThroughput (
+    Label,
+    MultU64x32 (NETBUF_BENCHMARK_DATAGRAM_SIZE, NETBUF_BENCHMARK_DATAGRAMS),
+    BenchmarkElapsedNanoSecond (Start, End)
+    );
+
+  return EFI_SUCCESS;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  UINT32               *Buffer;
+  UINTN                Index;
+  UINT32               Seed;
+  UINT32               Offset;
+  BOOLEAN              Match;
+  EFI_STATUS           Status;
+
+  Buffer = AllocatePool (NETBUF_BENCHMARK_BUFFER_SIZE + sizeof (UINT32));
+  if (Buffer == NULL) {
+    Print (L"NetBufBenchmark: Unable to allocate %d MiB buffer\n", NETBUF_BENCHMARK_BUFFER_SIZE / SIZE_1MB);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Fill the buffer with pseudo random data.
+  //
+  Seed = 0x12345678;
+  for (Index = 0; Index < (NETBUF_BENCHMARK_BUFFER_SIZE + sizeof (UINT32)) / sizeof (UINT32); Index++) {
+    Seed          = Seed * 1664525 + 1013904223;
+    Buffer[Index] = Seed;
+  }
+
+  Print (L"Checksum throughput on a %d MiB buffer:\n", NETBUF_BENCHMARK_BUFFER_SIZE / SIZE_1MB);
+
+  Match = TRUE;
+  for (Offset = 0; Offset < 2; Offset++) {
+    Match = (BOOLEAN) (Match &&
+            MeasureChecksum (
+              Offset == 0 ? L"Reference (aligned)" : L"Reference (odd)",
+              FALSE,
+              (UINT8 *) Buffer + Offset,
+              NETBUF_BENCHMARK_BUFFER_SIZE
+              ) ==
+            MeasureChecksum (
+              Offset == 0 ? L"NetLib (aligned)" : L"NetLib (odd)",
+              TRUE,
+              (UINT8 *) Buffer + Offset,
+              NETBUF_BENCHMARK_BUFFER_SIZE
+              ));
+  }
+
+  //
+  // Short and odd lengths at every alignment exercise the head and tail handling.
+  //
+  for (Offset = 0; Offset < 64; Offset++) {
+    Match = (BOOLEAN) (Match &&
+            (NetblockChecksum ((UINT8 *) Buffer + Offset, NETBUF_BENCHMARK_DATAGRAM_SIZE - Offset) ==
+             ReferenceChecksum ((UINT8 *) Buffer + Offset, NETBUF_BENCHMARK_DATAGRAM_SIZE - Offset)));
+  }
+
+  Print (L"Checksum results %s\n", Match ? L"match" : L"MISMATCH");
+
+  Print (
+    L"Delivery of %d-byte datagrams to %d receivers:\n",
+    NETBUF_BENCHMARK_DATAGRAM_SIZE,
+    NETBUF_BENCHMARK_RECEIVERS
+    );
+
+  Status = MeasureDatagrams (L"NetbufClone", NetbufClone, (UINT8 *) Buffer);
+  if (!EFI_ERROR (Status)) {
+    Status = MeasureDatagrams (L"NetbufDuplicate", DuplicateDatagram, (UINT8 *) Buffer);
+  }
+
+  FreePool (Buffer);
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return Match ? EFI_SUCCESS : EFI_CRC_ERROR;
+}
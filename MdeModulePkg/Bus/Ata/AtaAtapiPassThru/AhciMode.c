@@ -1108,6 +1108,451 @@ Exit:
   return Status;
 }
 
+/**
+  Build the NCQ commands of a queued transfer, one command per command slot.
+
+  The sector count of an FPDMA QUEUED command is carried in the Features
+  registers and the tag in bits 7:3 of the Sector Count register.
+
+  @param[in]  PciIo               The PCI IO protocol instance.
+  @param[in]  AhciRegisters       The pointer to the EFI_AHCI_REGISTERS.
+  @param[in]  Port                The number of port.
+  @param[in]  PortMultiplier      The number of port multiplier.
+  @param[in]  Read                The transfer direction.
+  @param[in]  AtaCommandBlock     The EFI_ATA_COMMAND_BLOCK data of the whole transfer.
+  @param[in]  DataPhysicalAddr    The pci bus master address of the data buffer.
+  @param[in]  DataCount           The data count to be transferred.
+
+  @return The bit mask of the command slots used by the transfer.
+
+**/
+UINT32
+EFIAPI
+AhciBuildNcqCommands (
+  IN     EFI_PCI_IO_PROTOCOL        *PciIo,
+  IN     EFI_AHCI_REGISTERS         *AhciRegisters,
+  IN     UINT8                      Port,
+  IN     UINT8                      PortMultiplier,
+  IN     BOOLEAN                    Read,
+  IN     EFI_ATA_COMMAND_BLOCK      *AtaCommandBlock,
+  IN     EFI_PHYSICAL_ADDRESS       DataPhysicalAddr,
+  IN     UINT32                     DataCount
+  )
+{
+  EFI_AHCI_NCQ_COMMAND_TABLE *CommandTable;
+  EFI_AHCI_COMMAND_LIST      *CommandList;
+  EFI_ATA_COMMAND_BLOCK      Acb;
+  UINT32                     SectorCount;
+  UINT32                     SectorSize;
+  UINT32                     SlotSectors;
+  UINT32                     Sectors;
+  UINT64                     Lba;
+  UINT32                     Slot;
+  UINT32                     SlotMask;
+  UINT32                     PrdtIndex;
+  UINT32                     RemainedData;
+  EFI_PHYSICAL_ADDRESS       MemAddr;
+  DATA_64                    Data64;
+  UINT32                     Offset;
+
+  SectorCount = ((UINT32) AtaCommandBlock->AtaFeaturesExp << 8) | AtaCommandBlock->AtaFeatures;
+  if (SectorCount == 0) {
+    SectorCount = 0x10000;
+  }
+  SectorSize = DataCount / SectorCount;
+  Lba        = AtaCommandBlock->AtaSectorNumber |
+               LShiftU64 (AtaCommandBlock->AtaCylinderLow, 8) |
+               LShiftU64 (AtaCommandBlock->AtaCylinderHigh, 16) |
+               LShiftU64 (AtaCommandBlock->AtaSectorNumberExp, 24) |
+               LShiftU64 (AtaCommandBlock->AtaCylinderLowExp, 32) |
+               LShiftU64 (AtaCommandBlock->AtaCylinderHighExp, 40);
+
+  //
+  // Spread the sectors evenly over the command slots, without going below the
+  // minimum data size of a single command.
+  //
+  SlotSectors = (SectorCount + AhciRegisters->NcqCommandSlotNumber - 1) / AhciRegisters->NcqCommandSlotNumber;
+  if (SlotSectors * SectorSize < EFI_AHCI_NCQ_MIN_DATA_PER_CMD) {
+    SlotSectors = EFI_AHCI_NCQ_MIN_DATA_PER_CMD / SectorSize;
+  }
+
+  ZeroMem ((VOID *)((UINTN) AhciRegisters->AhciRFis + sizeof (EFI_AHCI_RECEIVED_FIS) * Port), sizeof (EFI_AHCI_RECEIVED_FIS));
+
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
+  AhciAndReg (PciIo, Offset, (UINT32)~(EFI_AHCI_PORT_CMD_DLAE | EFI_AHCI_PORT_CMD_ATAPI));
+
+  SlotMask = 0;
+  MemAddr  = DataPhysicalAddr;
+  for (Slot = 0; SectorCount > 0; Slot++) {
+    Sectors      = MIN (SlotSectors, SectorCount);
+    SectorCount -= Sectors;
+
+    CopyMem (&Acb, AtaCommandBlock, sizeof (EFI_ATA_COMMAND_BLOCK));
+    Acb.AtaFeatures        = (UINT8) Sectors;
+    Acb.AtaFeaturesExp     = (UINT8) (Sectors >> 8);
+    Acb.AtaSectorCount     = (UINT8) (Slot << 3);
+    Acb.AtaSectorCountExp  = 0;
+    Acb.AtaSectorNumber    = (UINT8) Lba;
+    Acb.AtaCylinderLow     = (UINT8) RShiftU64 (Lba, 8);
+    Acb.AtaCylinderHigh    = (UINT8) RShiftU64 (Lba, 16);
+    Acb.AtaSectorNumberExp = (UINT8) RShiftU64 (Lba, 24);
+    Acb.AtaCylinderLowExp  = (UINT8) RShiftU64 (Lba, 32);
+    Acb.AtaCylinderHighExp = (UINT8) RShiftU64 (Lba, 40);
+
+    CommandTable = &AhciRegisters->AhciNcqCommandTable[Slot];
+    ZeroMem (CommandTable, sizeof (EFI_AHCI_NCQ_COMMAND_TABLE));
+    AhciBuildCommandFis (&CommandTable->CommandFis, &Acb);
+    //
+    // Only the LBA bit and the caller's FUA bit are valid in the Device register.
+    //
+    CommandTable->CommandFis.AhciCFisDevHead = (UINT8) ((AtaCommandBlock->AtaDeviceHead & BIT7) | BIT6);
+    CommandTable->CommandFis.AhciCFisPmNum   = PortMultiplier;
+
+    RemainedData = Sectors * SectorSize;
+    for (PrdtIndex = 0; RemainedData > 0; PrdtIndex++) {
+      ASSERT (PrdtIndex < EFI_AHCI_NCQ_MAX_PRDT);
+      Data64.Uint64 = MemAddr;
+      CommandTable->PrdtTable[PrdtIndex].AhciPrdtDba  = Data64.Uint32.Lower32;
+      CommandTable->PrdtTable[PrdtIndex].AhciPrdtDbau = Data64.Uint32.Upper32;
+      if (RemainedData < EFI_AHCI_MAX_DATA_PER_PRDT) {
+        CommandTable->PrdtTable[PrdtIndex].AhciPrdtDbc = RemainedData - 1;
+        MemAddr     += RemainedData;
+        RemainedData = 0;
+      } else {
+        CommandTable->PrdtTable[PrdtIndex].AhciPrdtDbc = EFI_AHCI_MAX_DATA_PER_PRDT - 1;
+        MemAddr      += EFI_AHCI_MAX_DATA_PER_PRDT;
+        RemainedData -= EFI_AHCI_MAX_DATA_PER_PRDT;
+      }
+    }
+    CommandTable->PrdtTable[PrdtIndex - 1].AhciPrdtIoc = 1;
+
+    CommandList = &AhciRegisters->AhciCmdList[Slot];
+    ZeroMem (CommandList, sizeof (EFI_AHCI_COMMAND_LIST));
+    CommandList->AhciCmdCfl   = EFI_AHCI_FIS_REGISTER_H2D_LENGTH / 4;
+    CommandList->AhciCmdW     = Read ? 0 : 1;
+    CommandList->AhciCmdPrdtl = PrdtIndex;
+    CommandList->AhciCmdPmp   = PortMultiplier;
+    Data64.Uint64 = (UINT64)(UINTN) &AhciRegisters->AhciNcqCommandTablePciAddr[Slot];
+    CommandList->AhciCmdCtba  = Data64.Uint32.Lower32;
+    CommandList->AhciCmdCtbau = Data64.Uint32.Upper32;
+
+    SlotMask |= (UINT32) (1 << Slot);
+    Lba      += Sectors;
+  }
+
+  return SlotMask;
+}
+
+/**
+  Check whether the NCQ commands of a queued transfer have completed.
+
+  The device clears the PxSACT bit of every command it completes, so the
+  transfer is done when none of its command slots is active any more.
+
+  @param[in]       PciIo             The PCI IO protocol instance.
+  @param[in]       Port              The number of port.
+  @param[in]       SlotMask          The bit mask of the command slots in use.
+  @param[in, out]  Task              Optional. Pointer to the ATA_NONBLOCK_TASK used by
+                                     non-blocking mode. If NULL, then just try once.
+
+  @retval EFI_NOT_READY     Some commands are still active.
+  @retval EFI_TIMEOUT       The retry times out.
+  @retval EFI_DEVICE_ERROR  The device reported an error.
+  @retval EFI_SUCCESS       All the commands completed successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+AhciCheckNcqComplete (
+  IN     EFI_PCI_IO_PROTOCOL       *PciIo,
+  IN     UINT8                     Port,
+  IN     UINT32                    SlotMask,
+  IN OUT ATA_NONBLOCK_TASK         *Task
+  )
+{
+  UINT32     Offset;
+  UINT32     Value;
+
+  if (Task != NULL) {
+    Task->RetryTimes--;
+  }
+
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_IS;
+  Value  = AhciReadReg (PciIo, Offset);
+  if ((Value & (EFI_AHCI_PORT_IS_TFES | EFI_AHCI_PORT_IS_HBFS | EFI_AHCI_PORT_IS_HBDS | EFI_AHCI_PORT_IS_IFS)) != 0) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SACT;
+  Value  = AhciReadReg (PciIo, Offset);
+  if ((Value & SlotMask) == 0) {
+    return EFI_SUCCESS;
+  }
+
+  if ((Task != NULL) && !Task->InfiniteWait && (Task->RetryTimes == 0)) {
+    return EFI_TIMEOUT;
+  } else {
+    return EFI_NOT_READY;
+  }
+}
+
+/**
+  Recover the device from an NCQ error.
+
+  After a failed NCQ command the device aborts every command until the
+  NCQ Command Error log is read, so read it with the port restarted.
+
+  @param[in]  PciIo               The PCI IO protocol instance.
+  @param[in]  AhciRegisters       The pointer to the EFI_AHCI_REGISTERS.
+  @param[in]  Port                The number of port.
+  @param[in]  PortMultiplier      The number of port multiplier.
+  @param[in]  Timeout             The timeout value, uses 100ns as a unit.
+
+**/
+VOID
+EFIAPI
+AhciNcqErrorRecovery (
+  IN     EFI_PCI_IO_PROTOCOL        *PciIo,
+  IN     EFI_AHCI_REGISTERS         *AhciRegisters,
+  IN     UINT8                      Port,
+  IN     UINT8                      PortMultiplier,
+  IN     UINT64                     Timeout
+  )
+{
+  EFI_ATA_COMMAND_BLOCK      Acb;
+  EFI_ATA_STATUS_BLOCK       Asb;
+  VOID                       *Buffer;
+  EFI_STATUS                 Status;
+
+  Buffer = AllocateZeroPool (512);
+  if (Buffer == NULL) {
+    return;
+  }
+
+  ZeroMem (&Acb, sizeof (EFI_ATA_COMMAND_BLOCK));
+  Acb.AtaCommand      = ATA_CMD_READ_LOG_EXT;
+  Acb.AtaSectorNumber = 0x10;
+  Acb.AtaSectorCount  = 1;
+
+  Status = AhciPioTransfer (
+             PciIo,
+             AhciRegisters,
+             Port,
+             PortMultiplier,
+             NULL,
+             0,
+             TRUE,
+             &Acb,
+             &Asb,
+             Buffer,
+             512,
+             Timeout,
+             NULL
+             );
+  DEBUG ((EFI_D_ERROR, "AhciNcqErrorRecovery: Port %d NCQ error log read %r, failing tag %d\n",
+    Port, Status, ((UINT8 *) Buffer)[0] & 0x1F));
+
+  FreePool (Buffer);
+}
+
+/**
+  Start an NCQ (READ/WRITE FPDMA QUEUED) data transfer on specific port.
+
+  The transfer is split into several NCQ commands which are issued together
+  in different command slots, so that the device works on all of them in
+  parallel.
+
+  @param[in]       Instance            The ATA_ATAPI_PASS_THRU_INSTANCE protocol instance.
+  @param[in]       AhciRegisters       The pointer to the EFI_AHCI_REGISTERS.
+  @param[in]       Port                The number of port.
+  @param[in]       PortMultiplier      The number of port multiplier.
+  @param[in]       Read                The transfer direction.
+  @param[in]       AtaCommandBlock     The EFI_ATA_COMMAND_BLOCK data.
+  @param[in, out]  AtaStatusBlock      The EFI_ATA_STATUS_BLOCK data.
+  @param[in, out]  MemoryAddr          The pointer to the data buffer.
+  @param[in]       DataCount           The data count to be transferred.
+  @param[in]       Timeout             The timeout value of data transfer, uses 100ns as a unit.
+  @param[in]       Task                Optional. Pointer to the ATA_NONBLOCK_TASK
+                                       used by non-blocking mode.
+
+  @retval EFI_DEVICE_ERROR    The NCQ data transfer abort with error occurs.
+  @retval EFI_TIMEOUT         The operation is time out.
+  @retval EFI_UNSUPPORTED     The HBA doesn't support NCQ.
+  @retval EFI_SUCCESS         The NCQ data transfer executes successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+AhciFpdmaTransfer (
+  IN     ATA_ATAPI_PASS_THRU_INSTANCE *Instance,
+  IN     EFI_AHCI_REGISTERS         *AhciRegisters,
+  IN     UINT8                      Port,
+  IN     UINT8                      PortMultiplier,
+  IN     BOOLEAN                    Read,
+  IN     EFI_ATA_COMMAND_BLOCK      *AtaCommandBlock,
+  IN OUT EFI_ATA_STATUS_BLOCK       *AtaStatusBlock,
+  IN OUT VOID                       *MemoryAddr,
+  IN     UINT32                     DataCount,
+  IN     UINT64                     Timeout,
+  IN     ATA_NONBLOCK_TASK          *Task
+  )
+{
+  EFI_STATUS                    Status;
+  UINT32                        Offset;
+  EFI_PHYSICAL_ADDRESS          PhyAddr;
+  VOID                          *Map;
+  UINTN                         MapLength;
+  EFI_PCI_IO_PROTOCOL_OPERATION Flag;
+  UINT32                        SlotMask;
+  UINT64                        Delay;
+  BOOLEAN                       InfiniteWait;
+  EFI_PCI_IO_PROTOCOL           *PciIo;
+  EFI_TPL                       OldTpl;
+
+  Map   = NULL;
+  PciIo = Instance->PciIo;
+
+  if (PciIo == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((AhciRegisters->NcqCommandSlotNumber == 0) || (DataCount == 0)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Before starting the Blocking BlockIO operation, push to finish all non-blocking
+  // BlockIO tasks.
+  // Delay 100us to simulate the blocking time out checking.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  while ((Task == NULL) && (!IsListEmpty (&Instance->NonBlockingTaskList))) {
+    AsyncNonBlockingTransferRoutine (NULL, Instance);
+    //
+    // Stall for 100us.
+    //
+    MicroSecondDelay (100);
+  }
+  gBS->RestoreTPL (OldTpl);
+
+  if ((Task == NULL) || (!Task->IsStart)) {
+    //
+    // Mark the Task to indicate that it has been started.
+    //
+    if (Task != NULL) {
+      Task->IsStart = TRUE;
+    }
+    if (Read) {
+      Flag = EfiPciIoOperationBusMasterWrite;
+    } else {
+      Flag = EfiPciIoOperationBusMasterRead;
+    }
+
+    MapLength = DataCount;
+    Status = PciIo->Map (
+                      PciIo,
+                      Flag,
+                      MemoryAddr,
+                      &MapLength,
+                      &PhyAddr,
+                      &Map
+                      );
+
+    if (EFI_ERROR (Status) || (DataCount != MapLength)) {
+      return EFI_BAD_BUFFER_SIZE;
+    }
+
+    SlotMask = AhciBuildNcqCommands (
+                 PciIo,
+                 AhciRegisters,
+                 Port,
+                 PortMultiplier,
+                 Read,
+                 AtaCommandBlock,
+                 PhyAddr,
+                 DataCount
+                 );
+
+    if (Task != NULL) {
+      Task->Map         = Map;
+      Task->NcqSlotMask = SlotMask;
+    }
+
+    Status = AhciStartPort (PciIo, Port, Timeout);
+    if (EFI_ERROR (Status)) {
+      goto Exit;
+    }
+
+    //
+    // The PxSACT bits must be set before the matching PxCI bits.
+    //
+    Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SACT;
+    AhciWriteReg (PciIo, Offset, SlotMask);
+    Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CI;
+    AhciWriteReg (PciIo, Offset, SlotMask);
+  } else {
+    SlotMask = Task->NcqSlotMask;
+  }
+
+  //
+  // Wait for all the queued commands to complete.
+  //
+  if (Task != NULL) {
+    Status = AhciCheckNcqComplete (PciIo, Port, SlotMask, Task);
+  } else {
+    InfiniteWait = (BOOLEAN) (Timeout == 0);
+    Delay        = DivU64x32 (Timeout, 1000) + 1;
+    do {
+      Status = AhciCheckNcqComplete (PciIo, Port, SlotMask, NULL);
+      if (Status != EFI_NOT_READY) {
+        break;
+      }
+
+      //
+      // Stall for 100 microseconds.
+      //
+      MicroSecondDelay (100);
+
+      Delay--;
+      if (Delay == 0) {
+        Status = EFI_TIMEOUT;
+      }
+    } while (InfiniteWait || (Delay > 0));
+  }
+
+Exit:
+  if ((Task == NULL) || (Status != EFI_NOT_READY)) {
+    AhciDumpPortStatus (PciIo, AhciRegisters, Port, AtaStatusBlock);
+
+    AhciStopCommand (
+      PciIo,
+      Port,
+      Timeout
+      );
+
+    AhciDisableFisReceive (
+      PciIo,
+      Port,
+      Timeout
+      );
+
+    PciIo->Unmap (
+             PciIo,
+             (Task != NULL) ? Task->Map : Map
+             );
+
+    if (Status == EFI_DEVICE_ERROR) {
+      AhciNcqErrorRecovery (PciIo, AhciRegisters, Port, PortMultiplier, Timeout);
+    }
+
+    if ((AtaStatusBlock != NULL) && (Status != EFI_SUCCESS)) {
+      AtaStatusBlock->AtaStatus |= BIT0;
+    }
+  }
+
+  return Status;
+}
+
 /**
   Start a non data transfer on specific port.
 
@@ -1269,28 +1714,26 @@ AhciStopCommand (
 }
 
 /**
-  Start command for give slot on specific port.
+  Clear the port status, enable the FIS receive and start the command list
+  processing on specific port.
 
   @param  PciIo              The PCI IO protocol instance.
   @param  Port               The number of port.
-  @param  CommandSlot        The number of Command Slot.
   @param  Timeout            The timeout value of start, uses 100ns as a unit.
 
-  @retval EFI_DEVICE_ERROR   The command start unsuccessfully.
+  @retval EFI_DEVICE_ERROR   The port start unsuccessfully.
   @retval EFI_TIMEOUT        The operation is time out.
-  @retval EFI_SUCCESS        The command start successfully.
+  @retval EFI_SUCCESS        The port start successfully.
 
 **/
 EFI_STATUS
 EFIAPI
-AhciStartCommand (
+AhciStartPort (
   IN  EFI_PCI_IO_PROTOCOL       *PciIo,
   IN  UINT8                     Port,
-  IN  UINT8                     CommandSlot,
   IN  UINT64                    Timeout
   )
 {
-  UINT32     CmdSlotBit;
   EFI_STATUS Status;
   UINT32     PortStatus;
   UINT32     StartCmd;
@@ -1303,8 +1746,6 @@ AhciStartCommand (
   //
   Capability = AhciReadReg(PciIo, EFI_AHCI_CAPABILITY_OFFSET);
 
-  CmdSlotBit = (UINT32) (1 << CommandSlot);
-
   AhciClearPortStatus (
     PciIo,
     Port
@@ -1351,6 +1792,42 @@ AhciStartCommand (
   Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
   AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_ST | StartCmd);
 
+  return EFI_SUCCESS;
+}
+
+/**
+  Start command for give slot on specific port.
+
+  @param  PciIo              The PCI IO protocol instance.
+  @param  Port               The number of port.
+  @param  CommandSlot        The number of Command Slot.
+  @param  Timeout            The timeout value of start, uses 100ns as a unit.
+
+  @retval EFI_DEVICE_ERROR   The command start unsuccessfully.
+  @retval EFI_TIMEOUT        The operation is time out.
+  @retval EFI_SUCCESS        The command start successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+AhciStartCommand (
+  IN  EFI_PCI_IO_PROTOCOL       *PciIo,
+  IN  UINT8                     Port,
+  IN  UINT8                     CommandSlot,
+  IN  UINT64                    Timeout
+  )
+{
+  UINT32     CmdSlotBit;
+  EFI_STATUS Status;
+  UINT32     Offset;
+
+  CmdSlotBit = (UINT32) (1 << CommandSlot);
+
+  Status = AhciStartPort (PciIo, Port, Timeout);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   //
   // Setting the command
   //
@@ -2175,6 +2652,50 @@ AhciCreateTransferDescriptor (
   }
   AhciRegisters->AhciCommandTablePciAddr = (EFI_AHCI_COMMAND_TABLE *)(UINTN)AhciCommandTablePciAddr;
 
+  //
+  // Allocate one command table per command slot for NCQ. NCQ is left disabled
+  // if the HBA doesn't support it or the tables cannot be allocated.
+  //
+  AhciRegisters->NcqCommandSlotNumber = 0;
+  if ((Capability & EFI_AHCI_CAP_SNCQ) != 0) {
+    Buffer = NULL;
+    MaxCommandTableSize = MaxCommandSlotNumber * sizeof (EFI_AHCI_NCQ_COMMAND_TABLE);
+    Status = PciIo->AllocateBuffer (
+                      PciIo,
+                      AllocateAnyPages,
+                      EfiBootServicesData,
+                      EFI_SIZE_TO_PAGES ((UINTN) MaxCommandTableSize),
+                      &Buffer,
+                      0
+                      );
+    if (!EFI_ERROR (Status)) {
+      ZeroMem (Buffer, (UINTN)MaxCommandTableSize);
+      Bytes  = (UINTN)MaxCommandTableSize;
+      Status = PciIo->Map (
+                        PciIo,
+                        EfiPciIoOperationBusMasterCommonBuffer,
+                        Buffer,
+                        &Bytes,
+                        &AhciCommandTablePciAddr,
+                        &AhciRegisters->MapNcqCommandTable
+                        );
+      if (EFI_ERROR (Status) || (Bytes != MaxCommandTableSize) ||
+          ((!Support64Bit) && (AhciCommandTablePciAddr > 0x100000000ULL))) {
+        if (!EFI_ERROR (Status)) {
+          PciIo->Unmap (PciIo, AhciRegisters->MapNcqCommandTable);
+        }
+        PciIo->FreeBuffer (PciIo, EFI_SIZE_TO_PAGES ((UINTN) MaxCommandTableSize), Buffer);
+      } else {
+        AhciRegisters->AhciNcqCommandTable        = Buffer;
+        AhciRegisters->AhciNcqCommandTablePciAddr = (EFI_AHCI_NCQ_COMMAND_TABLE *)(UINTN)AhciCommandTablePciAddr;
+        AhciRegisters->MaxNcqCommandTableSize     = MaxCommandTableSize;
+        AhciRegisters->NcqCommandSlotNumber       = MaxCommandSlotNumber;
+      }
+    }
+    DEBUG ((EFI_D_INFO, "AHCI: NCQ %a with %d command slots\n",
+      (AhciRegisters->NcqCommandSlotNumber != 0) ? "enabled" : "unavailable", MaxCommandSlotNumber));
+  }
+
   return EFI_SUCCESS;
   //
   // Map error or unable to map the whole CmdList buffer into a contiguous region.
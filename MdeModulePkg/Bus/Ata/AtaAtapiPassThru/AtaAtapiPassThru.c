@@ -365,6 +365,21 @@ AtaPassThruPassThruExecute (
                      Task
                      );
           break;
+        case EFI_ATA_PASS_THRU_PROTOCOL_FPDMA:
+          Status = AhciFpdmaTransfer (
+                     Instance,
+                     &Instance->AhciRegisters,
+                     (UINT8)Port,
+                     (UINT8)PortMultiplierPort,
+                     (BOOLEAN)(Packet->InTransferLength != 0),
+                     Packet->Acb,
+                     Packet->Asb,
+                     (Packet->InTransferLength != 0) ? Packet->InDataBuffer : Packet->OutDataBuffer,
+                     (Packet->InTransferLength != 0) ? Packet->InTransferLength : Packet->OutTransferLength,
+                     Packet->Timeout,
+                     Task
+                     );
+          break;
         default :
           return EFI_UNSUPPORTED;
       }
@@ -988,6 +1003,17 @@ AtaAtapiPassThruStop (
   //
   if (Instance->Mode == EfiAtaAhciMode) {
     AhciRegisters = &Instance->AhciRegisters;
+    if (AhciRegisters->AhciNcqCommandTable != NULL) {
+      PciIo->Unmap (
+               PciIo,
+               AhciRegisters->MapNcqCommandTable
+               );
+      PciIo->FreeBuffer (
+               PciIo,
+               EFI_SIZE_TO_PAGES ((UINTN) AhciRegisters->MaxNcqCommandTableSize),
+               AhciRegisters->AhciNcqCommandTable
+               );
+    }
     PciIo->Unmap (
              PciIo,
              AhciRegisters->MapCommandTable
@@ -1404,6 +1430,22 @@ AtaPassThruPassThru (
     return EFI_BAD_BUFFER_SIZE;
   }
 
+  //
+  // Reject NCQ commands up front when the controller can't queue them, so that
+  // the caller can fall back to a non-queued command even in non-blocking mode.
+  // Each command slot can describe at most EFI_AHCI_NCQ_MAX_PRDT - 1 full PRDT
+  // entries plus the sector left over when the transfer is spread over the slots.
+  //
+  if (Packet->Protocol == EFI_ATA_PASS_THRU_PROTOCOL_FPDMA) {
+    if ((Instance->Mode != EfiAtaAhciMode) || (Instance->AhciRegisters.NcqCommandSlotNumber == 0)) {
+      return EFI_UNSUPPORTED;
+    }
+    if (MAX (Packet->InTransferLength, Packet->OutTransferLength) >
+        MultU64x32 (Instance->AhciRegisters.NcqCommandSlotNumber, (EFI_AHCI_NCQ_MAX_PRDT - 1) * EFI_AHCI_MAX_DATA_PER_PRDT)) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+
   //
   // For non-blocking mode, queue the Task into the list.
   //
@@ -84,12 +84,17 @@ ATA_DEVICE gAtaDeviceTemplate = {
   NULL,                        // Asb
   FALSE,                       // UdmaValid
   FALSE,                       // Lba48Bit
+  FALSE,                       // NcqValid
   NULL,                        // IdentifyData
   NULL,                        // ControllerNameTable
   {L'\0', },                   // ModelName
   {NULL, NULL},                // AtaTaskList
   {NULL, NULL},                // AtaSubTaskList
-  FALSE                        // Abort
+  FALSE,                       // Abort
+  0,                           // NcqReadBytes
+  0,                           // NcqReadTime
+  0,                           // ReadBytes
+  0                            // ReadTime
 };
 
 /**
@@ -465,6 +470,18 @@ UnregisterAtaDevice (
     AtaDevice = ATA_DEVICE_FROM_BLOCK_IO2 (BlockIo2);
   }
 
+  if ((AtaDevice->NcqReadTime != 0) || (AtaDevice->ReadTime != 0)) {
+    DEBUG ((
+      EFI_D_INFO,
+      "AtaBus - Port %x read throughput: NCQ %Ld MB/s (%Ld bytes), non-NCQ %Ld MB/s (%Ld bytes)\n",
+      AtaDevice->Port,
+      (AtaDevice->NcqReadTime != 0) ? DivU64x64Remainder (MultU64x32 (AtaDevice->NcqReadBytes, 1000), AtaDevice->NcqReadTime, NULL) : (UINT64) 0,
+      AtaDevice->NcqReadBytes,
+      (AtaDevice->ReadTime != 0) ? DivU64x64Remainder (MultU64x32 (AtaDevice->ReadBytes, 1000), AtaDevice->ReadTime, NULL) : (UINT64) 0,
+      AtaDevice->ReadBytes
+      ));
+  }
+
   //
   // Close the child handle
   //
@@ -993,6 +1010,48 @@ AtaBlockIoReset (
 }
 
 
+/**
+  Return the time elapsed since a performance counter value, in nanoseconds.
+
+  The counter may count up or down, and may wrap around at the end of the
+  range returned by GetPerformanceCounterProperties(). The read is assumed
+  to take less than one counter period.
+
+  @param[in]  StartCounter  The performance counter value at the start.
+
+  @return The elapsed time in nanoseconds.
+
+**/
+STATIC
+UINT64
+AtaElapsedTime (
+  IN UINT64                       StartCounter
+  )
+{
+  UINT64                          StartValue;
+  UINT64                          EndValue;
+  UINT64                          EndCounter;
+  UINT64                          Delta;
+
+  EndCounter = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  if (StartValue < EndValue) {
+    if (EndCounter >= StartCounter) {
+      Delta = EndCounter - StartCounter;
+    } else {
+      Delta = (EndValue - StartCounter) + (EndCounter - StartValue) + 1;
+    }
+  } else {
+    if (EndCounter <= StartCounter) {
+      Delta = StartCounter - EndCounter;
+    } else {
+      Delta = (StartCounter - EndValue) + (StartValue - EndCounter) + 1;
+    }
+  }
+
+  return GetTimeInNanoSecond (Delta);
+}
+
 /**
   Read/Write BufferSize bytes from Lba from/into Buffer.
 
@@ -1038,6 +1097,8 @@ BlockIoReadWrite (
   UINTN                             BlockSize;
   UINTN                             NumberOfBlocks;
   UINTN                             IoAlign;
+  UINT64                            StartCounter;
+  UINT64                            Elapsed;
 
   if (IsBlockIo2) {
    Media     = ((EFI_BLOCK_IO2_PROTOCOL *) This)->Media;
@@ -1083,11 +1144,27 @@ BlockIoReadWrite (
 
   OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
 
+  StartCounter = GetPerformanceCounter ();
+
   //
   // Invoke low level AtaDevice Access Routine.
   //
   Status = AccessAtaDevice (AtaDevice, Buffer, Lba, NumberOfBlocks, IsWrite, Token);
 
+  //
+  // Account the blocking reads for the NCQ/non-NCQ throughput comparison.
+  //
+  if (!EFI_ERROR (Status) && !IsWrite && ((Token == NULL) || (Token->Event == NULL))) {
+    Elapsed = AtaElapsedTime (StartCounter);
+    if (AtaDevice->NcqValid && (BufferSize >= ATA_NCQ_MIN_TRANSFER_SIZE)) {
+      AtaDevice->NcqReadBytes += BufferSize;
+      AtaDevice->NcqReadTime  += Elapsed;
+    } else {
+      AtaDevice->ReadBytes    += BufferSize;
+      AtaDevice->ReadTime     += Elapsed;
+    }
+  }
+
   gBS->RestoreTPL (OldTpl);
 
   return Status;
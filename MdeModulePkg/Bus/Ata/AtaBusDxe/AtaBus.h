@@ -74,6 +74,12 @@
 //
 #define MAX_48BIT_TRANSFER_BLOCK_NUM      0xFFFF
 
+//
+// The minimum transfer size to use NCQ (READ FPDMA QUEUED) for, so that the
+// transfer can be split over several command slots.
+//
+#define ATA_NCQ_MIN_TRANSFER_SIZE         SIZE_256KB
+
 //
 // The maximum model name in ATA identify data
 //
@@ -121,6 +127,7 @@ typedef struct {
 
   BOOLEAN                               UdmaValid;
   BOOLEAN                               Lba48Bit;
+  BOOLEAN                               NcqValid;
 
   //
   // Cached data for ATA identify data
@@ -133,6 +140,15 @@ typedef struct {
   LIST_ENTRY                            AtaTaskList;
   LIST_ENTRY                            AtaSubTaskList;
   BOOLEAN                               Abort;
+
+  //
+  // Read throughput statistics of the blocking reads, for the NCQ and
+  // the non-queued transfers.
+  //
+  UINT64                                NcqReadBytes;
+  UINT64                                NcqReadTime;
+  UINT64                                ReadBytes;
+  UINT64                                ReadTime;
 } ATA_DEVICE;
 
 //
@@ -30,6 +30,7 @@
 #define ATA_CMD_TRUST_RECEIVE_DMA 0x5D
 #define ATA_CMD_TRUST_SEND        0x5E
 #define ATA_CMD_TRUST_SEND_DMA    0x5F
+#define ATA_CMD_READ_FPDMA_QUEUED 0x60
 
 //
 // Look up table (UdmaValid, IsWrite) for EFI_ATA_PASS_THRU_CMD_PROTOCOL
@@ -344,6 +345,19 @@ IdentifyAtaDevice (
     AtaDevice->Lba48Bit = FALSE;
   }
 
+  //
+  // Check whether the WORD 76 (Serial ATA capabilities) reports NCQ support. NCQ
+  // commands always use 48-bit addressing and DMA.
+  //
+  AtaDevice->NcqValid = FALSE;
+  if (AtaDevice->UdmaValid && AtaDevice->Lba48Bit &&
+      (IdentifyData->serial_ata_capabilities != 0) &&
+      (IdentifyData->serial_ata_capabilities != 0xFFFF) &&
+      ((IdentifyData->serial_ata_capabilities & BIT8) != 0)) {
+    AtaDevice->NcqValid = TRUE;
+    DEBUG ((EFI_D_INFO, "AtaBus - NCQ supported, queue depth %d\n", (IdentifyData->queue_depth & 0x1F) + 1));
+  }
+
   //
   // Block Media Information:
   //
@@ -478,8 +492,10 @@ TransferAtaDevice (
   IN EFI_EVENT                            Event OPTIONAL
   )
 {
+  EFI_STATUS                        Status;
   EFI_ATA_COMMAND_BLOCK             *Acb;
   EFI_ATA_PASS_THRU_COMMAND_PACKET  *Packet;
+  BOOLEAN                           UseNcq;
 
   //
   // Ensure AtaDevice->UdmaValid, AtaDevice->Lba48Bit and IsWrite are valid boolean values
@@ -506,6 +522,22 @@ TransferAtaDevice (
     Acb->AtaDeviceHead = (UINT8) (Acb->AtaDeviceHead | RShiftU64 (StartLba, 24));
   }
 
+  //
+  // Large reads are issued as READ FPDMA QUEUED, which the pass thru driver may
+  // split over several command slots. The sector count goes into the Features
+  // registers and the Device register only carries the LBA bit.
+  //
+  UseNcq = (BOOLEAN) (AtaDevice->NcqValid && !IsWrite &&
+                      (MultU64x32 (TransferLength, AtaDevice->BlockMedia.BlockSize) >= ATA_NCQ_MIN_TRANSFER_SIZE));
+  if (UseNcq) {
+    Acb->AtaCommand        = ATA_CMD_READ_FPDMA_QUEUED;
+    Acb->AtaFeatures       = (UINT8) TransferLength;
+    Acb->AtaFeaturesExp    = (UINT8) (TransferLength >> 8);
+    Acb->AtaSectorCount    = 0;
+    Acb->AtaSectorCountExp = 0;
+    Acb->AtaDeviceHead     = BIT6;
+  }
+
   //
   // Prepare for ATA pass through packet.
   //
@@ -524,6 +556,9 @@ TransferAtaDevice (
   }
 
   Packet->Protocol = mAtaPassThruCmdProtocols[AtaDevice->UdmaValid][IsWrite];
+  if (UseNcq) {
+    Packet->Protocol = EFI_ATA_PASS_THRU_PROTOCOL_FPDMA;
+  }
   Packet->Length = EFI_ATA_PASS_THRU_LENGTH_SECTOR_COUNT;
   //
   // |------------------------|-----------------|------------------------|-----------------|
@@ -558,7 +593,22 @@ TransferAtaDevice (
     Packet->Timeout  = EFI_TIMER_PERIOD_SECONDS (DivU64x32 (MultU64x32 (TransferLength, AtaDevice->BlockMedia.BlockSize), 3300000) + 31);
   }
 
-  return AtaDevicePassThru (AtaDevice, TaskPacket, Event);
+  Status = AtaDevicePassThru (AtaDevice, TaskPacket, Event);
+  if (UseNcq && (Status == EFI_UNSUPPORTED)) {
+    //
+    // The ATA pass thru driver or the controller can't queue the command, so
+    // stop using NCQ for this device and retry with a normal DMA command.
+    //
+    DEBUG ((EFI_D_INFO, "AtaBus - NCQ unsupported by the controller, fall back to DMA\n"));
+    AtaDevice->NcqValid = FALSE;
+    if (TaskPacket != NULL) {
+      FreeAlignedBuffer (TaskPacket->Asb, sizeof (EFI_ATA_STATUS_BLOCK));
+      FreePool (TaskPacket->Acb);
+    }
+    Status = TransferAtaDevice (AtaDevice, TaskPacket, Buffer, StartLba, TransferLength, IsWrite, Event);
+  }
+
+  return Status;
 }
 
 /**
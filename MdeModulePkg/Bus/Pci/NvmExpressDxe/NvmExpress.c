@@ -432,6 +432,8 @@ UnregisterNvmeNamespace (
     gBS->Stall (100);
   }
 
+  NvmeDumpStatistics (Device);
+
   //
   // Close the child handle
   //
@@ -45,6 +45,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiDriverEntryPoint.h>
+#include <Library/TimerLib.h>
 
 typedef struct _NVME_CONTROLLER_PRIVATE_DATA NVME_CONTROLLER_PRIVATE_DATA;
 typedef struct _NVME_DEVICE_PRIVATE_DATA     NVME_DEVICE_PRIVATE_DATA;
@@ -64,8 +65,13 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gNvmExpressDriverSupportedEfiV
 #define NVME_ASQ_SIZE                             1     // Number of admin submission queue entries, which is 0-based
 #define NVME_ACQ_SIZE                             1     // Number of admin completion queue entries, which is 0-based
 
-#define NVME_CSQ_SIZE                             1     // Number of I/O submission queue entries, which is 0-based
-#define NVME_CCQ_SIZE                             1     // Number of I/O completion queue entries, which is 0-based
+//
+// Number of synchronous I/O submission/completion queue entries, which is 0-based.
+// Both queues fit into 4kB and are further clipped to CAP.MQES at creation time.
+// The blocking BlockIo path keeps up to NVME_CSQ_SIZE commands in flight.
+//
+#define NVME_CSQ_SIZE                             63
+#define NVME_CCQ_SIZE                             63
 
 //
 // Number of asynchronous I/O submission queue entries, which is 0-based.
@@ -87,6 +93,14 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gNvmExpressDriverSupportedEfiV
 //
 #define NVME_GENERIC_TIMEOUT                      EFI_TIMER_PERIOD_SECONDS (5)
 
+//
+// Byte offset of the PRP list owned by command Index of a queued transfer.
+// Each list page holds ListsPerPage lists of EFI_SIZE_TO_PAGES (CmdBytes) entries.
+//
+#define NVME_QUEUED_PRP_LIST_OFFSET(Index, ListsPerPage, CmdBytes)      \
+  (((Index) / (ListsPerPage)) * EFI_PAGE_SIZE +                          \
+   ((Index) % (ListsPerPage)) * EFI_SIZE_TO_PAGES (CmdBytes) * sizeof (UINT64))
+
 //
 // Nvme async transfer timer interval, set by experience.
 //
@@ -147,6 +161,11 @@ struct _NVME_CONTROLLER_PRIVATE_DATA {
   NVME_CQHDBL                         CqHdbl[NVME_MAX_QUEUES];
   UINT16                              AsyncSqHead;
 
+  //
+  // Actual 0-based size of the synchronous I/O queue pair (queue #1).
+  //
+  UINT16                              SyncQueueSize;
+
   UINT8                               Pt[NVME_MAX_QUEUES];
   UINT16                              Cid[NVME_MAX_QUEUES];
 
@@ -209,6 +228,15 @@ struct _NVME_DEVICE_PRIVATE_DATA {
 
   NVME_CONTROLLER_PRIVATE_DATA             *Controller;
 
+  //
+  // Blocking BlockIo statistics, dumped when the namespace is unregistered.
+  //
+  UINT64                                   ReadBytes;
+  UINT64                                   WriteBytes;
+  UINT64                                   ReadTime;
+  UINT64                                   WriteTime;
+  UINT64                                   QueueDepthSum;
+  UINT64                                   QueueDepthSamples;
 };
 
 //
@@ -722,6 +750,55 @@ NvmeDumpStatus (
   IN NVME_CQ             *Cq
   );
 
+/**
+  Reset the NVMe controller after a blocking command timed out, aborting all
+  outstanding asynchronous requests.
+
+  @param[in] Private        The pointer to the NVME_CONTROLLER_PRIVATE_DATA
+                            data structure.
+
+  @retval EFI_TIMEOUT       The controller was reset successfully.
+  @return Others            Fail to reset the controller.
+
+**/
+EFI_STATUS
+NvmeResetAfterTimeout (
+  IN NVME_CONTROLLER_PRIVATE_DATA    *Private
+  );
+
+/**
+  Transfer a large block range with many NVMe read/write commands in flight
+  on the synchronous I/O queue.
+
+  The data buffer is mapped once. Each command that spans more than two pages
+  gets its own PRP list, a slice of the PRP list pages allocated for the
+  request.
+
+  @param[in] Device             The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param[in] Write              TRUE for a write request, FALSE for a read request.
+  @param[in] Buffer             The data buffer.
+  @param[in] Lba                The start block number.
+  @param[in] Blocks             Total block number to be transferred.
+  @param[in] MaxTransferBlocks  The maximum block number of a single command.
+
+  @retval EFI_SUCCESS           All blocks were transferred.
+  @retval EFI_UNSUPPORTED       The request cannot be queued, the caller should
+                                fall back to issuing one command at a time.
+  @retval EFI_DEVICE_ERROR      A command completed with an error.
+  @retval EFI_TIMEOUT           The commands timed out and the controller was reset.
+  @retval EFI_OUT_OF_RESOURCES  The PRP list could not be allocated.
+
+**/
+EFI_STATUS
+NvmeQueuedTransfer (
+  IN NVME_DEVICE_PRIVATE_DATA       *Device,
+  IN BOOLEAN                        Write,
+  IN VOID                           *Buffer,
+  IN UINT64                         Lba,
+  IN UINTN                          Blocks,
+  IN UINT32                         MaxTransferBlocks
+  );
+
 /**
   Register the shutdown notification through the ResetNotification protocol.
 
@@ -75,6 +75,9 @@ ReadSectors (
                                NULL
                                );
 
+  Device->QueueDepthSum++;
+  Device->QueueDepthSamples++;
+
   return Status;
 }
 
@@ -144,9 +147,99 @@ WriteSectors (
                                NULL
                                );
 
+  Device->QueueDepthSum++;
+  Device->QueueDepthSamples++;
+
   return Status;
 }
 
+/**
+  Return the time elapsed since a performance counter value was sampled.
+
+  The counter may count up or down, and may wrap around at the end of the
+  range returned by GetPerformanceCounterProperties(). The transfer is
+  assumed to take less than one counter period.
+
+  @param  StartCounter           The performance counter value at the start.
+
+  @return The elapsed time in nanoseconds.
+
+**/
+STATIC
+UINT64
+NvmeElapsedTime (
+  IN UINT64                             StartCounter
+  )
+{
+  UINT64                           Counter;
+  UINT64                           StartValue;
+  UINT64                           EndValue;
+  UINT64                           Delta;
+
+  Counter = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  if (StartValue < EndValue) {
+    if (Counter >= StartCounter) {
+      Delta = Counter - StartCounter;
+    } else {
+      Delta = (EndValue - StartCounter) + (Counter - StartValue) + 1;
+    }
+  } else {
+    if (Counter <= StartCounter) {
+      Delta = StartCounter - Counter;
+    } else {
+      Delta = (StartCounter - EndValue) + (StartValue - Counter) + 1;
+    }
+  }
+
+  return GetTimeInNanoSecond (Delta);
+}
+
+/**
+  Dump the blocking BlockIo throughput and queue depth statistics of a namespace.
+
+  @param[in]  Device          The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+
+**/
+VOID
+NvmeDumpStatistics (
+  IN NVME_DEVICE_PRIVATE_DATA       *Device
+  )
+{
+  UINT64                           ReadRate;
+  UINT64                           WriteRate;
+  UINT64                           Depth;
+
+  if (Device->QueueDepthSamples == 0) {
+    return;
+  }
+
+  //
+  // Bytes per nanosecond * 1000 is MB/s.
+  //
+  ReadRate  = 0;
+  WriteRate = 0;
+  if (Device->ReadTime != 0) {
+    ReadRate = DivU64x64Remainder (MultU64x32 (Device->ReadBytes, 1000), Device->ReadTime, NULL);
+  }
+  if (Device->WriteTime != 0) {
+    WriteRate = DivU64x64Remainder (MultU64x32 (Device->WriteBytes, 1000), Device->WriteTime, NULL);
+  }
+  Depth = DivU64x64Remainder (MultU64x32 (Device->QueueDepthSum, 100), Device->QueueDepthSamples, NULL);
+
+  DEBUG ((
+    EFI_D_INFO,
+    "NvmExpress: Namespace %d read %Ld bytes (%Ld MB/s), written %Ld bytes (%Ld MB/s), average queue depth %Ld.%02Ld\n",
+    Device->NamespaceId,
+    Device->ReadBytes,
+    ReadRate,
+    Device->WriteBytes,
+    WriteRate,
+    DivU64x32 (Depth, 100),
+    (UINT64)ModU64x32 (Depth, 100)
+    ));
+}
+
 /**
   Read some blocks from the device.
 
@@ -174,6 +267,7 @@ NvmeRead (
   UINTN                            OrginalBlocks;
   BOOLEAN                          IsEmpty;
   EFI_TPL                          OldTpl;
+  UINT64                           StartCounter;
 
   //
   // Wait for the device's asynchronous I/O queue to become empty.
@@ -201,23 +295,45 @@ NvmeRead (
     MaxTransferBlocks = 1024;
   }
 
-  while (Blocks > 0) {
-    if (Blocks > MaxTransferBlocks) {
-      Status = ReadSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
+  StartCounter = GetPerformanceCounter ();
 
-      Blocks -= MaxTransferBlocks;
-      Buffer  = (VOID *)(UINTN)((UINT64)(UINTN)Buffer + MaxTransferBlocks * BlockSize);
-      Lba    += MaxTransferBlocks;
-    } else {
-      Status = ReadSectors (Device, (UINT64)(UINTN)Buffer, Lba, (UINT32)Blocks);
+  //
+  // Keep many commands in flight for requests larger than a single command,
+  // falling back to one command at a time when the request cannot be queued.
+  //
+  Status = EFI_UNSUPPORTED;
+  if (Blocks > MaxTransferBlocks) {
+    Status = NvmeQueuedTransfer (Device, FALSE, Buffer, Lba, Blocks, MaxTransferBlocks);
+    if (!EFI_ERROR (Status)) {
       Blocks = 0;
     }
+  }
 
-    if (EFI_ERROR(Status)) {
-      break;
+  if (Status == EFI_UNSUPPORTED) {
+    Status = EFI_SUCCESS;
+    while (Blocks > 0) {
+      if (Blocks > MaxTransferBlocks) {
+        Status = ReadSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
+
+        Blocks -= MaxTransferBlocks;
+        Buffer  = (VOID *)(UINTN)((UINT64)(UINTN)Buffer + MaxTransferBlocks * BlockSize);
+        Lba    += MaxTransferBlocks;
+      } else {
+        Status = ReadSectors (Device, (UINT64)(UINTN)Buffer, Lba, (UINT32)Blocks);
+        Blocks = 0;
+      }
+
+      if (EFI_ERROR(Status)) {
+        break;
+      }
     }
   }
 
+  if (!EFI_ERROR (Status)) {
+    Device->ReadBytes += MultU64x32 (OrginalBlocks, BlockSize);
+    Device->ReadTime  += NvmeElapsedTime (StartCounter);
+  }
+
   DEBUG ((EFI_D_VERBOSE, "%a: Lba = 0x%08Lx, Original = 0x%08Lx, "
     "Remaining = 0x%08Lx, BlockSize = 0x%x, Status = %r\n", __FUNCTION__, Lba,
     (UINT64)OrginalBlocks, (UINT64)Blocks, BlockSize, Status));
@@ -252,6 +368,7 @@ NvmeWrite (
   UINTN                            OrginalBlocks;
   BOOLEAN                          IsEmpty;
   EFI_TPL                          OldTpl;
+  UINT64                           StartCounter;
 
   //
   // Wait for the device's asynchronous I/O queue to become empty.
@@ -279,23 +396,45 @@ NvmeWrite (
     MaxTransferBlocks = 1024;
   }
 
-  while (Blocks > 0) {
-    if (Blocks > MaxTransferBlocks) {
-      Status = WriteSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
+  StartCounter = GetPerformanceCounter ();
 
-      Blocks -= MaxTransferBlocks;
-      Buffer  = (VOID *)(UINTN)((UINT64)(UINTN)Buffer + MaxTransferBlocks * BlockSize);
-      Lba    += MaxTransferBlocks;
-    } else {
-      Status = WriteSectors (Device, (UINT64)(UINTN)Buffer, Lba, (UINT32)Blocks);
+  //
+  // Keep many commands in flight for requests larger than a single command,
+  // falling back to one command at a time when the request cannot be queued.
+  //
+  Status = EFI_UNSUPPORTED;
+  if (Blocks > MaxTransferBlocks) {
+    Status = NvmeQueuedTransfer (Device, TRUE, Buffer, Lba, Blocks, MaxTransferBlocks);
+    if (!EFI_ERROR (Status)) {
       Blocks = 0;
     }
+  }
 
-    if (EFI_ERROR(Status)) {
-      break;
+  if (Status == EFI_UNSUPPORTED) {
+    Status = EFI_SUCCESS;
+    while (Blocks > 0) {
+      if (Blocks > MaxTransferBlocks) {
+        Status = WriteSectors (Device, (UINT64)(UINTN)Buffer, Lba, MaxTransferBlocks);
+
+        Blocks -= MaxTransferBlocks;
+        Buffer  = (VOID *)(UINTN)((UINT64)(UINTN)Buffer + MaxTransferBlocks * BlockSize);
+        Lba    += MaxTransferBlocks;
+      } else {
+        Status = WriteSectors (Device, (UINT64)(UINTN)Buffer, Lba, (UINT32)Blocks);
+        Blocks = 0;
+      }
+
+      if (EFI_ERROR(Status)) {
+        break;
+      }
     }
   }
 
+  if (!EFI_ERROR (Status)) {
+    Device->WriteBytes += MultU64x32 (OrginalBlocks, BlockSize);
+    Device->WriteTime += NvmeElapsedTime (StartCounter);
+  }
+
   DEBUG ((EFI_D_VERBOSE, "%a: Lba = 0x%08Lx, Original = 0x%08Lx, "
     "Remaining = 0x%08Lx, BlockSize = 0x%x, Status = %r\n", __FUNCTION__, Lba,
     (UINT64)OrginalBlocks, (UINT64)Blocks, BlockSize, Status));
@@ -414,4 +414,15 @@ NvmeStorageSecuritySendData (
   IN VOID                                     *PayloadBuffer
   );
 
+/**
+  Dump the blocking BlockIo throughput and queue depth statistics of a namespace.
+
+  @param[in]  Device          The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+
+**/
+VOID
+NvmeDumpStatistics (
+  IN NVME_DEVICE_PRIVATE_DATA       *Device
+  );
+
 #endif
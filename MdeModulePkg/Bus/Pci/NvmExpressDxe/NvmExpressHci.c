@@ -711,7 +711,7 @@ NvmeCreateIoCompletionQueue (
     CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
 
     if (Index == 1) {
-      QueueSize = NVME_CCQ_SIZE;
+      QueueSize = Private->SyncQueueSize;
     } else {
       if (Private->Cap.Mqes > NVME_ASYNC_CCQ_SIZE) {
         QueueSize = NVME_ASYNC_CCQ_SIZE;
@@ -780,7 +780,7 @@ NvmeCreateIoSubmissionQueue (
     CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
 
     if (Index == 1) {
-      QueueSize = NVME_CSQ_SIZE;
+      QueueSize = Private->SyncQueueSize;
     } else {
       if (Private->Cap.Mqes > NVME_ASYNC_CSQ_SIZE) {
         QueueSize = NVME_ASYNC_CSQ_SIZE;
@@ -915,6 +915,15 @@ NvmeControllerInit (
   Private->CqHdbl[2].Cqh = 0;
   Private->AsyncSqHead   = 0;
 
+  //
+  // The synchronous I/O submission and completion queues share one size so
+  // that a full submission queue can never overflow the completion queue.
+  //
+  Private->SyncQueueSize = MIN (NVME_CSQ_SIZE, NVME_CCQ_SIZE);
+  if (Private->Cap.Mqes < Private->SyncQueueSize) {
+    Private->SyncQueueSize = Private->Cap.Mqes;
+  }
+
   Status = NvmeDisableController (Private);
 
   if (EFI_ERROR(Status)) {
@@ -409,6 +409,59 @@ AbortAsyncPassThruTasks (
   return Status;
 }
 
+/**
+  Reset the NVMe controller after a blocking command timed out, aborting all
+  outstanding asynchronous requests.
+
+  @param[in] Private        The pointer to the NVME_CONTROLLER_PRIVATE_DATA
+                            data structure.
+
+  @retval EFI_TIMEOUT       The controller was reset successfully.
+  @return Others            Fail to reset the controller.
+
+**/
+EFI_STATUS
+NvmeResetAfterTimeout (
+  IN NVME_CONTROLLER_PRIVATE_DATA    *Private
+  )
+{
+  EFI_STATUS                         Status;
+
+  //
+  // Disable the timer to trigger the process of async transfers temporarily.
+  //
+  Status = gBS->SetTimer (Private->TimerEvent, TimerCancel, 0);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Reset the NVMe controller.
+  //
+  Status = NvmeControllerInit (Private);
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  Status = AbortAsyncPassThruTasks (Private);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Re-enable the timer to trigger the process of async transfers.
+  //
+  Status = gBS->SetTimer (Private->TimerEvent, TimerPeriodic, NVME_HC_ASYNC_TIMER);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Return EFI_TIMEOUT to indicate a timeout occurs for NVMe PassThru command.
+  //
+  return EFI_TIMEOUT;
+}
+
 
 /**
   Sends an NVM Express Command Packet to an NVM Express controller or namespace. This function supports
@@ -693,6 +746,9 @@ NvmExpressPassThru (
   if ((Event != NULL) && (QueueId != 0)) {
     Private->SqTdbl[QueueId].Sqt =
       (Private->SqTdbl[QueueId].Sqt + 1) % (NVME_ASYNC_CSQ_SIZE + 1);
+  } else if (QueueId == 1) {
+    Private->SqTdbl[QueueId].Sqt =
+      (Private->SqTdbl[QueueId].Sqt + 1) % (Private->SyncQueueSize + 1);
   } else {
     Private->SqTdbl[QueueId].Sqt ^= 1;
   }
@@ -793,40 +849,17 @@ NvmExpressPassThru (
     //
     DEBUG ((DEBUG_ERROR, "NvmExpressPassThru: Timeout occurs for an NVMe command.\n"));
 
-    //
-    // Disable the timer to trigger the process of async transfers temporarily.
-    //
-    Status = gBS->SetTimer (Private->TimerEvent, TimerCancel, 0);
-    if (EFI_ERROR (Status)) {
-      goto EXIT;
-    }
-
-    //
-    // Reset the NVMe controller.
-    //
-    Status = NvmeControllerInit (Private);
-    if (!EFI_ERROR (Status)) {
-      Status = AbortAsyncPassThruTasks (Private);
-      if (!EFI_ERROR (Status)) {
-        //
-        // Re-enable the timer to trigger the process of async transfers.
-        //
-        Status = gBS->SetTimer (Private->TimerEvent, TimerPeriodic, NVME_HC_ASYNC_TIMER);
-        if (!EFI_ERROR (Status)) {
-          //
-          // Return EFI_TIMEOUT to indicate a timeout occurs for NVMe PassThru command.
-          //
-          Status = EFI_TIMEOUT;
-        }
-      }
-    } else {
-      Status = EFI_DEVICE_ERROR;
-    }
-
+    Status = NvmeResetAfterTimeout (Private);
     goto EXIT;
   }
 
-  if ((Private->CqHdbl[QueueId].Cqh ^= 1) == 0) {
+  if (QueueId == 1) {
+    Private->CqHdbl[QueueId].Cqh =
+      (Private->CqHdbl[QueueId].Cqh + 1) % (Private->SyncQueueSize + 1);
+    if (Private->CqHdbl[QueueId].Cqh == 0) {
+      Private->Pt[QueueId] ^= 1;
+    }
+  } else if ((Private->CqHdbl[QueueId].Cqh ^= 1) == 0) {
     Private->Pt[QueueId] ^= 1;
   }
 
@@ -881,6 +914,290 @@ EXIT:
   return Status;
 }
 
+/**
+  Transfer a large block range with many NVMe read/write commands in flight
+  on the synchronous I/O queue.
+
+  The data buffer is mapped once and the PRP lists of all the commands are
+  built up front in a single allocation. Each command owns a slice of the PRP
+  list pages which never crosses a page boundary, so no PRP list chaining is
+  needed. The submission queue is refilled as completions are reaped.
+
+  @param[in] Device             The pointer to the NVME_DEVICE_PRIVATE_DATA data structure.
+  @param[in] Write              TRUE for a write request, FALSE for a read request.
+  @param[in] Buffer             The data buffer.
+  @param[in] Lba                The start block number.
+  @param[in] Blocks             Total block number to be transferred.
+  @param[in] MaxTransferBlocks  The maximum block number of a single command.
+
+  @retval EFI_SUCCESS           All blocks were transferred.
+  @retval EFI_UNSUPPORTED       The request cannot be queued, the caller should
+                                fall back to issuing one command at a time.
+  @retval EFI_DEVICE_ERROR      A command completed with an error.
+  @retval EFI_TIMEOUT           The commands timed out and the controller was reset.
+  @retval EFI_OUT_OF_RESOURCES  The PRP list could not be allocated.
+
+**/
+EFI_STATUS
+NvmeQueuedTransfer (
+  IN NVME_DEVICE_PRIVATE_DATA       *Device,
+  IN BOOLEAN                        Write,
+  IN VOID                           *Buffer,
+  IN UINT64                         Lba,
+  IN UINTN                          Blocks,
+  IN UINT32                         MaxTransferBlocks
+  )
+{
+  NVME_CONTROLLER_PRIVATE_DATA      *Private;
+  EFI_PCI_IO_PROTOCOL               *PciIo;
+  EFI_STATUS                        Status;
+  EFI_STATUS                        CmdStatus;
+  EFI_EVENT                         TimerEvent;
+  NVME_SQ                           *Sq;
+  NVME_CQ                           *Cq;
+  UINT32                            BlockSize;
+  UINT32                            CmdBlocks;
+  UINTN                             CmdBytes;
+  UINTN                             CmdCount;
+  UINTN                             PrpEntryNo;
+  UINTN                             ListsPerPage;
+  UINTN                             PrpListNo;
+  VOID                              *PrpListHost;
+  EFI_PHYSICAL_ADDRESS              PrpListPhyAddr;
+  VOID                              *MapPrpList;
+  VOID                              *MapData;
+  EFI_PHYSICAL_ADDRESS              PhyAddr;
+  EFI_PHYSICAL_ADDRESS              CmdAddr;
+  UINTN                             MapLength;
+  UINTN                             TransferLength;
+  UINTN                             Offset;
+  UINTN                             FirstPage;
+  UINTN                             LastPage;
+  UINTN                             Entry;
+  UINT64                            *PrpList;
+  UINTN                             Next;
+  UINTN                             Outstanding;
+  UINTN                             Reaped;
+  UINTN                             Index;
+  UINT32                            Data;
+  UINT16                            QueueSize;
+
+  Private   = Device->Controller;
+  PciIo     = Private->PciIo;
+  BlockSize = Device->Media.BlockSize;
+  QueueSize = Private->SyncQueueSize + 1;
+
+  if ((Private->SyncQueueSize < 2) || (Blocks <= MaxTransferBlocks)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Limit each command to what a single PRP list page can describe.
+  //
+  PrpEntryNo = EFI_PAGE_SIZE / sizeof (UINT64);
+  CmdBlocks  = MaxTransferBlocks;
+  if ((UINTN)CmdBlocks * BlockSize > PrpEntryNo * EFI_PAGE_SIZE) {
+    CmdBlocks = (UINT32)(PrpEntryNo * EFI_PAGE_SIZE / BlockSize);
+  }
+  CmdBytes     = (UINTN)CmdBlocks * BlockSize;
+  CmdCount     = (Blocks + CmdBlocks - 1) / CmdBlocks;
+  ListsPerPage = PrpEntryNo / EFI_SIZE_TO_PAGES (CmdBytes);
+  PrpListNo    = (CmdCount + ListsPerPage - 1) / ListsPerPage;
+
+  TransferLength = Blocks * BlockSize;
+  MapLength      = TransferLength;
+  Status = PciIo->Map (
+                    PciIo,
+                    Write ? EfiPciIoOperationBusMasterRead : EfiPciIoOperationBusMasterWrite,
+                    Buffer,
+                    &MapLength,
+                    &PhyAddr,
+                    &MapData
+                    );
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+  if (MapLength != TransferLength) {
+    PciIo->Unmap (PciIo, MapData);
+    return EFI_UNSUPPORTED;
+  }
+
+  PrpListHost = NULL;
+  MapPrpList  = NULL;
+  TimerEvent  = NULL;
+
+  Status = PciIo->AllocateBuffer (
+                    PciIo,
+                    AllocateAnyPages,
+                    EfiBootServicesData,
+                    PrpListNo,
+                    &PrpListHost,
+                    0
+                    );
+  if (EFI_ERROR (Status)) {
+    PrpListHost = NULL;
+    Status      = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  MapLength = EFI_PAGES_TO_SIZE (PrpListNo);
+  Status = PciIo->Map (
+                    PciIo,
+                    EfiPciIoOperationBusMasterCommonBuffer,
+                    PrpListHost,
+                    &MapLength,
+                    &PrpListPhyAddr,
+                    &MapPrpList
+                    );
+  if (EFI_ERROR (Status) || (MapLength != EFI_PAGES_TO_SIZE (PrpListNo))) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  Status = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &TimerEvent);
+  if (EFI_ERROR (Status)) {
+    TimerEvent = NULL;
+    goto EXIT;
+  }
+
+  //
+  // Fill the PRP list slice of every command that spans more than two pages.
+  //
+  Offset = (UINTN)(PhyAddr & EFI_PAGE_MASK);
+  for (Index = 0; Index < CmdCount; Index++) {
+    FirstPage = (Offset + Index * CmdBytes) >> EFI_PAGE_SHIFT;
+    LastPage  = (Offset + MIN ((Index + 1) * CmdBytes, TransferLength) - 1) >> EFI_PAGE_SHIFT;
+    if (LastPage - FirstPage < 2) {
+      continue;
+    }
+
+    PrpList = (UINT64 *)((UINT8 *)PrpListHost + NVME_QUEUED_PRP_LIST_OFFSET (Index, ListsPerPage, CmdBytes));
+    for (Entry = 0; Entry < LastPage - FirstPage; Entry++) {
+      PrpList[Entry] = (PhyAddr & ~(UINT64)EFI_PAGE_MASK) + LShiftU64 (FirstPage + Entry + 1, EFI_PAGE_SHIFT);
+    }
+  }
+
+  Status      = EFI_SUCCESS;
+  Next        = 0;
+  Outstanding = 0;
+
+  while ((Outstanding > 0) || (!EFI_ERROR (Status) && (Next < CmdCount))) {
+    //
+    // Refill the submission queue, keeping one entry free to tell a full
+    // queue from an empty one. Stop submitting after the first error.
+    //
+    if (!EFI_ERROR (Status) && (Next < CmdCount) && (Outstanding < Private->SyncQueueSize)) {
+      while ((Next < CmdCount) && (Outstanding < Private->SyncQueueSize)) {
+        Sq = Private->SqBuffer[1] + Private->SqTdbl[1].Sqt;
+        ZeroMem (Sq, sizeof (NVME_SQ));
+
+        CmdAddr   = PhyAddr + Next * CmdBytes;
+        FirstPage = (Offset + Next * CmdBytes) >> EFI_PAGE_SHIFT;
+        LastPage  = (Offset + MIN ((Next + 1) * CmdBytes, TransferLength) - 1) >> EFI_PAGE_SHIFT;
+
+        Sq->Opc    = Write ? NVME_IO_WRITE_OPC : NVME_IO_READ_OPC;
+        Sq->Cid    = Private->Cid[1]++;
+        Sq->Nsid   = Device->NamespaceId;
+        Sq->Prp[0] = CmdAddr;
+        if (LastPage - FirstPage == 1) {
+          Sq->Prp[1] = (CmdAddr + EFI_PAGE_SIZE) & ~(UINT64)EFI_PAGE_MASK;
+        } else if (LastPage - FirstPage > 1) {
+          Sq->Prp[1] = PrpListPhyAddr + NVME_QUEUED_PRP_LIST_OFFSET (Next, ListsPerPage, CmdBytes);
+        }
+
+        Sq->Payload.Raw.Cdw10 = (UINT32)(Lba + Next * CmdBlocks);
+        Sq->Payload.Raw.Cdw11 = (UINT32)RShiftU64 (Lba + Next * CmdBlocks, 32);
+        Sq->Payload.Raw.Cdw12 = ((UINT32)MIN (CmdBlocks, Blocks - Next * CmdBlocks) - 1) & 0xFFFF;
+        if (Write) {
+          //
+          // Set Force Unit Access bit (bit 30) to use write-through behaviour
+          //
+          Sq->Payload.Raw.Cdw12 |= BIT30;
+        }
+
+        Private->SqTdbl[1].Sqt = (Private->SqTdbl[1].Sqt + 1) % QueueSize;
+        Outstanding++;
+        Next++;
+      }
+
+      Data = ReadUnaligned32 ((UINT32*)&Private->SqTdbl[1]);
+      Status = PciIo->Mem.Write (
+                   PciIo,
+                   EfiPciIoWidthUint32,
+                   NVME_BAR,
+                   NVME_SQTDBL_OFFSET(1, Private->Cap.Dstrd),
+                   1,
+                   &Data
+                   );
+      if (EFI_ERROR (Status)) {
+        goto EXIT;
+      }
+
+      Device->QueueDepthSum += Outstanding;
+      Device->QueueDepthSamples++;
+
+      gBS->SetTimer (TimerEvent, TimerRelative, NVME_GENERIC_TIMEOUT);
+    }
+
+    //
+    // Reap all the completions posted so far.
+    //
+    Reaped = 0;
+    Cq     = Private->CqBuffer[1] + Private->CqHdbl[1].Cqh;
+    while ((Outstanding > 0) && (Cq->Pt != Private->Pt[1])) {
+      if ((Cq->Sct != 0) || (Cq->Sc != 0)) {
+        DEBUG_CODE_BEGIN();
+          NvmeDumpStatus(Cq);
+        DEBUG_CODE_END();
+        Status = EFI_DEVICE_ERROR;
+      }
+
+      Private->CqHdbl[1].Cqh = (Private->CqHdbl[1].Cqh + 1) % QueueSize;
+      if (Private->CqHdbl[1].Cqh == 0) {
+        Private->Pt[1] ^= 1;
+      }
+      Cq = Private->CqBuffer[1] + Private->CqHdbl[1].Cqh;
+      Outstanding--;
+      Reaped++;
+    }
+
+    if (Reaped != 0) {
+      Data = ReadUnaligned32 ((UINT32*)&Private->CqHdbl[1]);
+      CmdStatus = PciIo->Mem.Write (
+                      PciIo,
+                      EfiPciIoWidthUint32,
+                      NVME_BAR,
+                      NVME_CQHDBL_OFFSET(1, Private->Cap.Dstrd),
+                      1,
+                      &Data
+                      );
+      if (EFI_ERROR (CmdStatus)) {
+        Status = CmdStatus;
+        goto EXIT;
+      }
+      gBS->SetTimer (TimerEvent, TimerRelative, NVME_GENERIC_TIMEOUT);
+    } else if (!EFI_ERROR (gBS->CheckEvent (TimerEvent))) {
+      DEBUG ((DEBUG_ERROR, "NvmeQueuedTransfer: Timeout occurs with %Ld NVMe commands outstanding.\n", (UINT64)Outstanding));
+      Status = NvmeResetAfterTimeout (Private);
+      goto EXIT;
+    }
+  }
+
+EXIT:
+  if (TimerEvent != NULL) {
+    gBS->CloseEvent (TimerEvent);
+  }
+  if (MapPrpList != NULL) {
+    PciIo->Unmap (PciIo, MapPrpList);
+  }
+  if (PrpListHost != NULL) {
+    PciIo->FreeBuffer (PciIo, PrpListNo, PrpListHost);
+  }
+  PciIo->Unmap (PciIo, MapData);
+
+  return Status;
+}
+
 /**
   Used to retrieve the next namespace ID for this NVM Express controller.
 
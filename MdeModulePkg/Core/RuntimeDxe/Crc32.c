@@ -20,8 +20,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 
 #include <Uefi.h>
-
-UINT32  mCrcTable[256];
+#include <Library/BaseLib.h>
 
 /**
   Calculate CRC32 for target data.
@@ -43,73 +42,10 @@ RuntimeDriverCalculateCrc32 (
   OUT UINT32  *CrcOut
   )
 {
-  UINT32  Crc;
-  UINTN   Index;
-  UINT8   *Ptr;
-
   if (Data == NULL || DataSize == 0 || CrcOut == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  Crc = 0xffffffff;
-  for (Index = 0, Ptr = Data; Index < DataSize; Index++, Ptr++) {
-    Crc = (Crc >> 8) ^ mCrcTable[(UINT8) Crc ^ *Ptr];
-  }
-
-  *CrcOut = Crc ^ 0xffffffff;
+  *CrcOut = CalculateCrc32 (Data, DataSize);
   return EFI_SUCCESS;
 }
-
-
-/**
-  This internal function reverses bits for 32bit data.
-
-  @param  Value                 The data to be reversed.
-
-  @return                       Data reversed.
-
-**/
-UINT32
-ReverseBits (
-  UINT32  Value
-  )
-{
-  UINTN   Index;
-  UINT32  NewValue;
-
-  NewValue = 0;
-  for (Index = 0; Index < 32; Index++) {
-    if ((Value & (1 << Index)) != 0) {
-      NewValue = NewValue | (1 << (31 - Index));
-    }
-  }
-
-  return NewValue;
-}
-
-/**
-  Initialize CRC32 table.
-
-**/
-VOID
-RuntimeDriverInitializeCrc32Table (
-  VOID
-  )
-{
-  UINTN   TableEntry;
-  UINTN   Index;
-  UINT32  Value;
-
-  for (TableEntry = 0; TableEntry < 256; TableEntry++) {
-    Value = ReverseBits ((UINT32) TableEntry);
-    for (Index = 0; Index < 8; Index++) {
-      if ((Value & 0x80000000) != 0) {
-        Value = (Value << 1) ^ 0x04c11db7;
-      } else {
-        Value = Value << 1;
-      }
-    }
-
-    mCrcTable[TableEntry] = ReverseBits (Value);
-  }
-}
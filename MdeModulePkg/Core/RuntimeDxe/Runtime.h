@@ -103,15 +103,6 @@ RuntimeDriverSetVirtualAddressMap (
   IN EFI_MEMORY_DESCRIPTOR  *VirtualMap
   );
 
-/**
-  Initialize CRC32 table.
-
-**/
-VOID
-RuntimeDriverInitializeCrc32Table (
-  VOID
-  );
-
 /**
   Install Runtime AP. This code includes the EfiRuntimeLib, but it only
   functions at RT in physical mode.
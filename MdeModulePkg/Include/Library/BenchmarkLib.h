@@ -0,0 +1,57 @@
+/** @file
+  Library used by the benchmark applications to time a run and print its
+  throughput.
+
+  Copyright (c) 2026 Baikal Electronics JSC
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+#ifndef __BENCHMARK_LIB_H__
+#define __BENCHMARK_LIB_H__
+
+/**
+  Convert the interval between two performance counter values to nanoseconds.
+
+  Both count up and count down performance counters are handled.
+
+  @param[in]  Start        The value returned by GetPerformanceCounter() at the
+                           start of the interval.
+  @param[in]  End          The value returned by GetPerformanceCounter() at the
+                           end of the interval.
+
+  @return The length of the interval in nanoseconds.
+**/
+UINT64
+EFIAPI
+BenchmarkElapsedNanoSecond (
+  IN UINT64                       Start,
+  IN UINT64                       End
+  );
+
+/**
+  Print a label followed by the throughput of a run and a new line.
+
+  The throughput is printed in GB/s when it is at least 1 GB/s and in MB/s
+  otherwise, with two decimals.
+
+  If Label is NULL, then ASSERT.
+
+  @param[in]  Label        The text printed before the throughput.
+  @param[in]  Bytes        The number of bytes processed by the run.
+  @param[in]  Elapsed      The time taken by the run, in nanoseconds.
+**/
+VOID
+EFIAPI
+BenchmarkPrintThroughput (
+  IN CONST CHAR16                 *Label,
+  IN UINT64                       Bytes,
+  IN UINT64                       Elapsed
+  );
+
+#endif
@@ -0,0 +1,75 @@
+/** @file
+  EDKII Managed Network Statistics Protocol.
+
+  The MNP driver produces this protocol on the controller handle of each
+  network device it manages. It reports the frames the driver received from and
+  transmitted to the device in the layout of EFI_SIMPLE_NETWORK_PROTOCOL.Statistics(),
+  so that the counters are available when the NIC driver doesn't implement it.
+
+Copyright (c) 2026 Baikal Electronics JSC
+This program and the accompanying materials are licensed and made available under
+the terms and conditions of the BSD License that accompanies this distribution.
+The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php.
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef __MANAGED_NETWORK_STATISTICS_H__
+#define __MANAGED_NETWORK_STATISTICS_H__
+
+#include <Protocol/SimpleNetwork.h>
+
+#define EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL_GUID \
+  { \
+    0xff405583, 0xd3ac, 0x4b91, { 0xa2, 0xe0, 0x78, 0x2a, 0xbf, 0xd9, 0x3e, 0x41 } \
+  }
+
+typedef struct _EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL  EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL;
+
+/**
+  Resets or collects the statistics of the frames the MNP driver received from
+  and transmitted to a network device.
+
+  The function follows EFI_SIMPLE_NETWORK_PROTOCOL.Statistics(). If StatisticsSize
+  is too small for all the statistics, a partial table is returned in
+  StatisticsTable, StatisticsSize is set to the required size and
+  EFI_BUFFER_TOO_SMALL is returned. The counters the driver doesn't maintain
+  are set to all ones.
+
+  @param[in]      This             A pointer to the EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL instance.
+  @param[in]      Reset            Set to TRUE to reset the statistics of the device.
+  @param[in, out] StatisticsSize   On input the size, in bytes, of StatisticsTable. On output
+                                   the size, in bytes, of the resulting table of statistics.
+  @param[out]     StatisticsTable  A pointer to the EFI_NETWORK_STATISTICS structure that
+                                   receives the statistics.
+
+  @retval EFI_SUCCESS            The requested operation succeeded.
+  @retval EFI_BUFFER_TOO_SMALL   StatisticsSize is not NULL and is smaller than the table.
+                                 The required size is returned in StatisticsSize.
+  @retval EFI_INVALID_PARAMETER  This is NULL, or StatisticsSize is NULL and
+                                 StatisticsTable is not NULL.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_MANAGED_NETWORK_STATISTICS)(
+  IN     EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL  *This,
+  IN     BOOLEAN                                    Reset,
+  IN OUT UINTN                                      *StatisticsSize   OPTIONAL,
+     OUT EFI_NETWORK_STATISTICS                     *StatisticsTable  OPTIONAL
+  );
+
+///
+/// The EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL reports the traffic counters
+/// of the MNP driver for a network device.
+///
+struct _EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL {
+  EDKII_MANAGED_NETWORK_STATISTICS  Statistics;
+};
+
+extern EFI_GUID gEdkiiManagedNetworkStatisticsProtocolGuid;
+
+#endif
@@ -2,7 +2,7 @@
 
   This library registers CRC32 guided section handler 
   to parse CRC32 encapsulation section and extract raw data.
-  It uses UEFI boot service CalculateCrc32 to authenticate 32 bit CRC value.
+  It uses BaseLib CalculateCrc32 to authenticate 32 bit CRC value.
 
 Copyright (c) 2007 - 2011, Intel Corporation. All rights reserved.<BR>
 This program and the accompanying materials                          
@@ -19,6 +19,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Guid/Crc32GuidedSectionExtraction.h>
 #include <Protocol/SecurityPolicy.h>
 #include <Library/ExtractGuidedSectionLib.h>
+#include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/UefiBootServicesTableLib.h>
@@ -192,8 +193,8 @@ Crc32GuidedSectionHandler (
     //
     // Calculate CRC32 Checksum of Image
     //
-    Status = gBS->CalculateCrc32 (*OutputBuffer, OutputBufferSize, &Crc32Checksum);
-    if (Status == EFI_SUCCESS) {
+    if (OutputBufferSize != 0) {
+      Crc32Checksum = CalculateCrc32 (*OutputBuffer, OutputBufferSize);
       if (Crc32Checksum != SectionCrc32Checksum) {
         //
         // If Crc32 checksum is not matched, AUTH tested failed bit is set.
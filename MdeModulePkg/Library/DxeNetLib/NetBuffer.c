@@ -1648,6 +1648,10 @@ NetbufQueFlush (
 /**
   Compute the checksum for a bulk of data.
 
+  The data is added as aligned 32-bit words into a 64-bit accumulator, 16 bytes
+  per iteration, and the carries are folded back in at the end. This gives the
+  same one's complement sum as adding 16-bit words one by one.
+
   @param[in]   Bulk                  Pointer to the data.
   @param[in]   Len                   Length of the data, in bytes.
 
@@ -1661,29 +1665,65 @@ NetblockChecksum (
   IN UINT32                 Len
   )
 {
-  register UINT32           Sum;
+  UINT64                    Sum;
 
-  Sum = 0;
+  if (Len == 0) {
+    return 0;
+  }
 
   //
-  // Add left-over byte, if any
+  // The one's complement sum doesn't depend on the byte order. If the data
+  // starts at an odd address, sum it from the next byte on, which pairs
+  // every byte the other way round, then swap the result back and add the
+  // first byte.
   //
-  if (Len % 2 != 0) {
-    Sum += *(Bulk + Len - 1);
+  if (((UINTN) Bulk & 0x01) != 0) {
+    Sum = (UINT64) SwapBytes16 (NetblockChecksum (Bulk + 1, Len - 1)) + *Bulk;
+    return (UINT16) ((Sum & 0xffff) + RShiftU64 (Sum, 16));
+  }
+
+  Sum = 0;
+  if ((((UINTN) Bulk & 0x02) != 0) && (Len >= 2)) {
+    Sum  += *(UINT16 *) Bulk;
+    Bulk += 2;
+    Len  -= 2;
+  }
+
+  while (Len >= 16) {
+    Sum  += ((UINT32 *) Bulk)[0];
+    Sum  += ((UINT32 *) Bulk)[1];
+    Sum  += ((UINT32 *) Bulk)[2];
+    Sum  += ((UINT32 *) Bulk)[3];
+    Bulk += 16;
+    Len  -= 16;
+  }
+
+  while (Len >= 4) {
+    Sum  += *(UINT32 *) Bulk;
+    Bulk += 4;
+    Len  -= 4;
   }
 
-  while (Len > 1) {
-    Sum += *(UINT16 *) Bulk;
+  if (Len >= 2) {
+    Sum  += *(UINT16 *) Bulk;
     Bulk += 2;
-    Len -= 2;
+    Len  -= 2;
   }
 
   //
-  // Fold 32-bit sum to 16 bits
+  // Add left-over byte, if any
   //
-  while ((Sum >> 16) != 0) {
-    Sum = (Sum & 0xffff) + (Sum >> 16);
+  if (Len != 0) {
+    Sum += *Bulk;
+  }
 
+  //
+  // Fold 64-bit sum to 16 bits
+  //
+  Sum = (Sum & 0xffffffff) + RShiftU64 (Sum, 32);
+  Sum = (Sum & 0xffffffff) + RShiftU64 (Sum, 32);
+  while (RShiftU64 (Sum, 16) != 0) {
+    Sum = (Sum & 0xffff) + RShiftU64 (Sum, 16);
   }
 
   return (UINT16) Sum;
@@ -17,6 +17,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <PiPei.h>
 #include <Guid/Crc32GuidedSectionExtraction.h>
 #include <Library/ExtractGuidedSectionLib.h>
+#include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
 
@@ -33,90 +34,6 @@ typedef struct {
   UINT32                    CRC32Checksum;       ///< 32bit CRC check sum
 } CRC32_SECTION2_HEADER;
 
-/**
-  This internal function reverses bits for 32bit data.
-
-  @param  Value                 The data to be reversed.
-
-  @return                       Data reversed.
-
-**/
-UINT32
-PeiCrc32GuidedSectionExtractLibReverseBits (
-  UINT32  Value
-  )
-{
-  UINTN   Index;
-  UINT32  NewValue;
-
-  NewValue = 0;
-  for (Index = 0; Index < 32; Index++) {
-    if ((Value & (1 << Index)) != 0) {
-      NewValue = NewValue | (1 << (31 - Index));
-    }
-  }
-
-  return NewValue;
-}
-
-/**
-  Calculate CRC32 for target data.
-
-  @param  Data                  The target data.
-  @param  DataSize              The target data size.
-  @param  CrcOut                The CRC32 for target data.
-
-  @retval EFI_SUCCESS           The CRC32 for target data is calculated successfully.
-  @retval EFI_INVALID_PARAMETER Some parameter is not valid, so the CRC32 is not
-                                calculated.
-
-**/
-EFI_STATUS
-EFIAPI
-PeiCrc32GuidedSectionExtractLibCalculateCrc32 (
-  IN  VOID    *Data,
-  IN  UINTN   DataSize,
-  OUT UINT32  *CrcOut
-  )
-{
-  UINT32  CrcTable[256];
-  UINTN   TableEntry;
-  UINTN   Index;
-  UINT32  Value;
-  UINT32  Crc;
-  UINT8   *Ptr;
-
-  if (Data == NULL || DataSize == 0 || CrcOut == NULL) {
-    return EFI_INVALID_PARAMETER;
-  }
-  
-  //
-  // Initialize CRC32 table.
-  //
-  for (TableEntry = 0; TableEntry < 256; TableEntry++) {
-    Value = PeiCrc32GuidedSectionExtractLibReverseBits ((UINT32) TableEntry);
-    for (Index = 0; Index < 8; Index++) {
-      if ((Value & 0x80000000) != 0) {
-        Value = (Value << 1) ^ 0x04c11db7;
-      } else {
-        Value = Value << 1;
-      }
-    }
-    CrcTable[TableEntry] = PeiCrc32GuidedSectionExtractLibReverseBits (Value);
-  }
-
-  //
-  // Compute CRC
-  //
-  Crc = 0xffffffff;
-  for (Index = 0, Ptr = Data; Index < DataSize; Index++, Ptr++) {
-    Crc = (Crc >> 8) ^ CrcTable[(UINT8) Crc ^ *Ptr];
-  }
-
-  *CrcOut = Crc ^ 0xffffffff;
-  return EFI_SUCCESS;
-}
-
 /**
 
   GetInfo gets raw data size and attribute of the input guided section.
@@ -203,7 +120,6 @@ Crc32GuidedSectionHandler (
   OUT       UINT32  *AuthenticationStatus
   )
 {
-  EFI_STATUS  Status;
   UINT32      SectionCrc32Checksum;
   UINT32      Crc32Checksum;
   UINT32      OutputBufferSize;
@@ -262,8 +178,8 @@ Crc32GuidedSectionHandler (
   //
   // Calculate CRC32 Checksum of Image
   //
-  Status = PeiCrc32GuidedSectionExtractLibCalculateCrc32 (*OutputBuffer, OutputBufferSize, &Crc32Checksum);
-  if (Status == EFI_SUCCESS) {
+  if (OutputBufferSize != 0) {
+    Crc32Checksum = CalculateCrc32 (*OutputBuffer, OutputBufferSize);
     if (Crc32Checksum != SectionCrc32Checksum) {
       //
       // If Crc32 checksum is not matched, AUTH tested failed bit is set.
@@ -182,6 +182,7 @@ DiskIoDriverBindingStart (
   
   InitializeListHead (&Instance->TaskQueue);
   EfiInitializeLock (&Instance->TaskQueueLock, TPL_NOTIFY);
+  EfiInitializeLock (&Instance->BouncePoolLock, TPL_NOTIFY);
   Instance->SharedWorkingBuffer = AllocateAlignedPages (
                                     EFI_SIZE_TO_PAGES (PcdGet32 (PcdDiskIoDataBufferBlockNum) * Instance->BlockIo->Media->BlockSize),
                                     Instance->BlockIo->Media->IoAlign
@@ -191,6 +192,8 @@ DiskIoDriverBindingStart (
     goto ErrorExit;
   }
 
+  DiskIoCreateCache (Instance);
+
   //
   // Install protocol interfaces for the Disk IO device.
   //
@@ -219,6 +222,7 @@ ErrorExit:
     }
 
     if (Instance != NULL) {
+      DiskIoFreeCache (Instance);
       FreePool (Instance);
     }
 
@@ -327,6 +331,27 @@ DiskIoDriverBindingStop (
       EFI_SIZE_TO_PAGES (PcdGet32 (PcdDiskIoDataBufferBlockNum) * Instance->BlockIo->Media->BlockSize)
       );
 
+    DEBUG ((
+      EFI_D_INFO,
+      "DiskIo: Subtasks %Ld (%Ld merged), bounce copies %Ld, bounce pool hit/miss %Ld/%Ld, cache hit/miss %Ld/%Ld\n",
+      Instance->Statistics.Subtasks,
+      Instance->Statistics.MergedSubtasks,
+      Instance->Statistics.BounceCopies,
+      Instance->Statistics.BouncePoolHits,
+      Instance->Statistics.BouncePoolMisses,
+      Instance->Statistics.CacheHits,
+      Instance->Statistics.CacheMisses
+      ));
+
+    while (Instance->BouncePoolCount > 0) {
+      Instance->BouncePoolCount--;
+      FreeAlignedPages (
+        Instance->BouncePool[Instance->BouncePoolCount],
+        EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize)
+        );
+    }
+    DiskIoFreeCache (Instance);
+
     Status = gBS->CloseProtocol (
                     ControllerHandle,
                     &gEfiBlockIoProtocolGuid,
@@ -351,6 +376,296 @@ DiskIoDriverBindingStop (
 }
 
 
+/**
+  Create the metadata cache of the device.
+
+  The cache holds single blocks read by the small blocking requests. It is only
+  created on non-removable media, as a cache hit doesn't give the Block I/O
+  driver a chance to detect a media change, and not on logical partitions, whose
+  reads already go through the cache of the Disk I/O device of the whole disk.
+  Failing to allocate the cache isn't fatal, the requests are then always sent
+  to the device.
+
+  Only the writes done through this Disk I/O device drop the cached blocks. A
+  write sent straight to the Block I/O or Block I/O 2 protocol of the device
+  isn't seen, so a consumer doing that must not mix it with reads through Disk
+  I/O of the blocks it writes.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCreateCache (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  )
+{
+  UINTN                       Index;
+  UINT32                      BlockSize;
+
+  Instance->CacheBlockNum = 0;
+  if (Instance->BlockIo->Media->RemovableMedia || Instance->BlockIo->Media->LogicalPartition ||
+      (PcdGet32 (PcdDiskIoMetadataCacheBlockNum) == 0)) {
+    return;
+  }
+
+  BlockSize           = Instance->BlockIo->Media->BlockSize;
+  Instance->Cache     = AllocateZeroPool (PcdGet32 (PcdDiskIoMetadataCacheBlockNum) * sizeof (DISK_IO_CACHE_BLOCK));
+  Instance->CacheData = AllocatePool (PcdGet32 (PcdDiskIoMetadataCacheBlockNum) * BlockSize);
+  if ((Instance->Cache == NULL) || (Instance->CacheData == NULL)) {
+    DiskIoFreeCache (Instance);
+    return;
+  }
+
+  Instance->CacheBlockNum   = PcdGet32 (PcdDiskIoMetadataCacheBlockNum);
+  Instance->CacheMediaId    = Instance->BlockIo->Media->MediaId;
+  Instance->CacheGeneration = 0;
+  Instance->CacheAsyncWrite = FALSE;
+  for (Index = 0; Index < Instance->CacheBlockNum; Index++) {
+    Instance->Cache[Index].Data = Instance->CacheData + Index * BlockSize;
+  }
+}
+
+/**
+  Free the metadata cache of the device.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoFreeCache (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  )
+{
+  if (Instance->Cache != NULL) {
+    FreePool (Instance->Cache);
+    Instance->Cache = NULL;
+  }
+  if (Instance->CacheData != NULL) {
+    FreePool (Instance->CacheData);
+    Instance->CacheData = NULL;
+  }
+  Instance->CacheBlockNum = 0;
+}
+
+/**
+  Drop the cached blocks of the device.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCacheInvalidate (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  )
+{
+  Instance->CacheGeneration++;
+}
+
+/**
+  Get the current generation of the cached blocks of the device.
+
+  The generation is taken before a block is read from the device and given to
+  DiskIoCacheInsert(), so that a block written through this device while it is
+  read is never served from the cache.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+
+  @return The generation of the cached blocks.
+**/
+UINT64
+DiskIoCacheGeneration (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  )
+{
+  //
+  // Drop everything when the Block I/O driver has detected a media change.
+  //
+  if (Instance->BlockIo->Media->MediaId != Instance->CacheMediaId) {
+    Instance->CacheMediaId = Instance->BlockIo->Media->MediaId;
+    DiskIoCacheInvalidate (Instance);
+  }
+  return Instance->CacheGeneration;
+}
+
+/**
+  Look up a block in the metadata cache.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId      ID of the medium to access.
+  @param Lba          The logical block address of the block.
+  @param Buffer       The buffer to receive the block data on a cache hit.
+
+  @retval TRUE        The block is cached and copied to Buffer.
+  @retval FALSE       The block is not cached.
+**/
+BOOLEAN
+DiskIoCacheLookup (
+  IN  DISK_IO_PRIVATE_DATA    *Instance,
+  IN  UINT32                  MediaId,
+  IN  EFI_LBA                 Lba,
+  OUT UINT8                   *Buffer
+  )
+{
+  UINTN                       Index;
+  UINT64                      Generation;
+  DISK_IO_CACHE_BLOCK         *Block;
+
+  if ((Instance->CacheBlockNum == 0) || (MediaId != Instance->BlockIo->Media->MediaId) ||
+      Instance->CacheAsyncWrite) {
+    return FALSE;
+  }
+
+  Generation = DiskIoCacheGeneration (Instance);
+  for (Index = 0; Index < Instance->CacheBlockNum; Index++) {
+    Block = &Instance->Cache[Index];
+    if (Block->Valid && (Block->Generation == Generation) && (Block->Lba == Lba) && (Block->MediaId == MediaId)) {
+      Block->LastUsed = ++Instance->CacheStamp;
+      CopyMem (Buffer, Block->Data, Instance->BlockIo->Media->BlockSize);
+      Instance->Statistics.CacheHits++;
+      return TRUE;
+    }
+  }
+
+  Instance->Statistics.CacheMisses++;
+  return FALSE;
+}
+
+/**
+  Insert a block into the metadata cache, replacing a stale or the least
+  recently used one.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId      ID of the medium the block is read from.
+  @param Lba          The logical block address of the block.
+  @param Buffer       The block data.
+  @param Generation   The generation returned by DiskIoCacheGeneration() before
+                      the block was read.
+**/
+VOID
+DiskIoCacheInsert (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN UINT32                   MediaId,
+  IN EFI_LBA                  Lba,
+  IN UINT8                    *Buffer,
+  IN UINT64                   Generation
+  )
+{
+  UINTN                       Index;
+  DISK_IO_CACHE_BLOCK         *Block;
+
+  if ((Instance->CacheBlockNum == 0) || Instance->CacheAsyncWrite ||
+      (Generation != DiskIoCacheGeneration (Instance))) {
+    return;
+  }
+
+  Block = &Instance->Cache[0];
+  for (Index = 0; Index < Instance->CacheBlockNum; Index++) {
+    if (!Instance->Cache[Index].Valid || (Instance->Cache[Index].Generation != Generation)) {
+      Block = &Instance->Cache[Index];
+      break;
+    }
+    if (Instance->Cache[Index].LastUsed < Block->LastUsed) {
+      Block = &Instance->Cache[Index];
+    }
+  }
+
+  CopyMem (Block->Data, Buffer, Instance->BlockIo->Media->BlockSize);
+  Block->Valid      = TRUE;
+  Block->MediaId    = MediaId;
+  Block->Lba        = Lba;
+  Block->Generation = Generation;
+  Block->LastUsed   = ++Instance->CacheStamp;
+}
+
+/**
+  Allocate an aligned working buffer.
+
+  The one block buffers used by the non-blocking unaligned requests are taken
+  from a small per device pool when possible.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Size         The size in bytes of the buffer.
+
+  @return A pointer to the working buffer, or NULL if there is not enough memory.
+**/
+VOID *
+DiskIoAllocateWorkingBuffer (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN UINTN                    Size
+  )
+{
+  VOID                        *Buffer;
+  UINT32                      IoAlign;
+
+  Buffer = NULL;
+  if (EFI_SIZE_TO_PAGES (Size) == EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize)) {
+    EfiAcquireLock (&Instance->BouncePoolLock);
+    if (Instance->BouncePoolCount > 0) {
+      Instance->BouncePoolCount--;
+      Buffer = Instance->BouncePool[Instance->BouncePoolCount];
+      Instance->Statistics.BouncePoolHits++;
+    } else {
+      Instance->Statistics.BouncePoolMisses++;
+    }
+    EfiReleaseLock (&Instance->BouncePoolLock);
+  }
+
+  if (Buffer == NULL) {
+    IoAlign = Instance->BlockIo->Media->IoAlign;
+    Buffer  = AllocateAlignedPages (EFI_SIZE_TO_PAGES (Size), (IoAlign == 0) ? 1 : IoAlign);
+  }
+  return Buffer;
+}
+
+/**
+  Free a working buffer allocated by DiskIoAllocateWorkingBuffer().
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Buffer       The working buffer.
+  @param Size         The size in bytes of the buffer.
+**/
+VOID
+DiskIoFreeWorkingBuffer (
+  IN DISK_IO_PRIVATE_DATA     *Instance,
+  IN VOID                     *Buffer,
+  IN UINTN                    Size
+  )
+{
+  if (EFI_SIZE_TO_PAGES (Size) == EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize)) {
+    EfiAcquireLock (&Instance->BouncePoolLock);
+    if (Instance->BouncePoolCount < DISK_IO_BOUNCE_POOL_SIZE) {
+      Instance->BouncePool[Instance->BouncePoolCount] = Buffer;
+      Instance->BouncePoolCount++;
+      Buffer = NULL;
+    }
+    EfiReleaseLock (&Instance->BouncePoolLock);
+  }
+
+  if (Buffer != NULL) {
+    FreeAlignedPages (Buffer, EFI_SIZE_TO_PAGES (Size));
+  }
+}
+
+/**
+  Get the number of bytes a subtask transfers from or to the device.
+
+  Subtasks using a working buffer access whole blocks, with the requested data
+  starting at Offset in the first block.
+
+  @param BlockSize    The block size of the device.
+  @param Subtask      Subtask.
+
+  @return The number of bytes of the Block I/O request.
+**/
+UINTN
+DiskIoSubtaskTransferSize (
+  IN UINT32                   BlockSize,
+  IN DISK_IO_SUBTASK          *Subtask
+  )
+{
+  if (Subtask->Length == 0) {
+    return 0;
+  }
+  return ((Subtask->Offset + Subtask->Length + BlockSize - 1) / BlockSize) * BlockSize;
+}
+
 /**
   Destroy the sub task.
 
@@ -377,11 +692,10 @@ DiskIoDestroySubtask (
 
   if (!Subtask->Blocking) {
     if (Subtask->WorkingBuffer != NULL) {
-      FreeAlignedPages (
-        Subtask->WorkingBuffer, 
-        Subtask->Length < Instance->BlockIo->Media->BlockSize
-        ? EFI_SIZE_TO_PAGES (Instance->BlockIo->Media->BlockSize)
-        : EFI_SIZE_TO_PAGES (Subtask->Length)
+      DiskIoFreeWorkingBuffer (
+        Instance,
+        Subtask->WorkingBuffer,
+        DiskIoSubtaskTransferSize (Instance->BlockIo->Media->BlockSize, Subtask)
         );
     }
     if (Subtask->BlockIo2Token.Event != NULL) {
@@ -542,6 +856,7 @@ DiskIoCreateSubtaskList (
   UINT8                 *BufferPtr;
   UINTN                 Length;
   UINTN                 DataBufferSize;
+  UINT64                BlockNum;
   DISK_IO_SUBTASK       *Subtask;
   VOID                  *WorkingBuffer;
   LIST_ENTRY            *Link;
@@ -569,12 +884,44 @@ DiskIoCreateSubtaskList (
     return TRUE;
   }
 
+  //
+  // A read which is not block aligned, or whose buffer is not aligned, is done
+  // through the working buffer as a single Block I/O request covering all the
+  // blocks, instead of separate UnderRun, Aligned and OverRun requests.
+  //
+  BlockNum = DivU64x32 (UnderRun + (UINT64) BufferSize + BlockSize - 1, BlockSize);
+  if (!Write &&
+      ((UnderRun != 0) || ((BufferSize % BlockSize) != 0) || (ALIGN_POINTER (BufferPtr, IoAlign) != BufferPtr)) &&
+      (BlockNum <= PcdGet32 (PcdDiskIoDataBufferBlockNum))) {
+    if (Blocking) {
+      WorkingBuffer = SharedWorkingBuffer;
+    } else {
+      WorkingBuffer = DiskIoAllocateWorkingBuffer (Instance, (UINTN) BlockNum * BlockSize);
+      if (WorkingBuffer == NULL) {
+        goto Done;
+      }
+    }
+
+    Subtask = DiskIoCreateSubtask (FALSE, Lba, UnderRun, BufferSize, WorkingBuffer, BufferPtr, Blocking);
+    if (Subtask == NULL) {
+      if (!Blocking) {
+        DiskIoFreeWorkingBuffer (Instance, WorkingBuffer, (UINTN) BlockNum * BlockSize);
+      }
+      goto Done;
+    }
+    InsertTailList (Subtasks, &Subtask->Link);
+    if (BlockNum > 1) {
+      Instance->Statistics.MergedSubtasks++;
+    }
+    return TRUE;
+  }
+
   if (UnderRun != 0) {
     Length = MIN (BlockSize - UnderRun, BufferSize);
     if (Blocking) {
       WorkingBuffer = SharedWorkingBuffer;
     } else {
-      WorkingBuffer = AllocateAlignedPages (EFI_SIZE_TO_PAGES (BlockSize), IoAlign);
+      WorkingBuffer = DiskIoAllocateWorkingBuffer (Instance, BlockSize);
       if (WorkingBuffer == NULL) {
         goto Done;
       }
@@ -610,7 +957,7 @@ DiskIoCreateSubtaskList (
     if (Blocking) {
       WorkingBuffer = SharedWorkingBuffer;
     } else {
-      WorkingBuffer = AllocateAlignedPages (EFI_SIZE_TO_PAGES (BlockSize), IoAlign);
+      WorkingBuffer = DiskIoAllocateWorkingBuffer (Instance, BlockSize);
       if (WorkingBuffer == NULL) {
         goto Done;
       }
@@ -825,6 +1172,9 @@ DiskIo2ReadWriteDisk (
   BOOLEAN                Blocking;
   BOOLEAN                SubtaskBlocking;
   LIST_ENTRY             *SubtasksPtr;
+  UINTN                  TransferSize;
+  BOOLEAN                Cacheable;
+  UINT64                 Generation;
 
   Task      = NULL;
   BlockIo   = Instance->BlockIo;
@@ -839,6 +1189,17 @@ DiskIo2ReadWriteDisk (
     //
     while (!DiskIo2RemoveCompletedTask (Instance));
 
+    //
+    // The non-blocking writes are all done, so the blocks read from now on can
+    // be cached again.
+    //
+    OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+    if (Instance->CacheAsyncWrite) {
+      Instance->CacheAsyncWrite = FALSE;
+      DiskIoCacheInvalidate (Instance);
+    }
+    gBS->RestoreTPL (OldTpl);
+
     SubtasksPtr = &Subtasks;
   } else {
     DiskIo2RemoveCompletedTask (Instance);
@@ -869,6 +1230,17 @@ DiskIo2ReadWriteDisk (
   ASSERT (!IsListEmpty (SubtasksPtr));
 
   OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  if (Write) {
+    //
+    // Drop the cached blocks before the subtasks are queued, which also covers
+    // the blocking reads that are reading the blocks this write changes. Nothing
+    // is cached while a non-blocking write may still be in flight.
+    //
+    DiskIoCacheInvalidate (Instance);
+    if (!Blocking) {
+      Instance->CacheAsyncWrite = TRUE;
+    }
+  }
   for ( Link = GetFirstNode (SubtasksPtr), NextLink = GetNextNode (SubtasksPtr, Link)
       ; !IsNull (SubtasksPtr, Link)
       ; Link = NextLink, NextLink = GetNextNode (SubtasksPtr, NextLink)
@@ -877,7 +1249,12 @@ DiskIo2ReadWriteDisk (
     Subtask->Task   = Task;
     SubtaskBlocking = Subtask->Blocking;
 
-    ASSERT ((Subtask->Length % Media->BlockSize == 0) || (Subtask->Length < Media->BlockSize));
+    ASSERT ((Subtask->Length % Media->BlockSize == 0) || (Subtask->WorkingBuffer != NULL));
+    TransferSize = DiskIoSubtaskTransferSize (Media->BlockSize, Subtask);
+    Instance->Statistics.Subtasks++;
+    if (Subtask->WorkingBuffer != NULL) {
+      Instance->Statistics.BounceCopies++;
+    }
 
     if (Subtask->Write) {
       //
@@ -895,7 +1272,7 @@ DiskIo2ReadWriteDisk (
                             BlockIo,
                             MediaId,
                             Subtask->Lba,
-                            (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
+                            TransferSize,
                             (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
                             );
       } else {
@@ -904,7 +1281,7 @@ DiskIo2ReadWriteDisk (
                              MediaId,
                              Subtask->Lba,
                              &Subtask->BlockIo2Token,
-                             (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
+                             TransferSize,
                              (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
                              );
       }
@@ -914,13 +1291,25 @@ DiskIo2ReadWriteDisk (
       // Read
       //
       if (SubtaskBlocking) {
-        Status = BlockIo->ReadBlocks (
-                            BlockIo,
-                            MediaId,
-                            Subtask->Lba,
-                            (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
-                            (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
-                            );
+        //
+        // Small reads within one block are served from the metadata cache.
+        //
+        Cacheable = (BOOLEAN) ((Subtask->WorkingBuffer != NULL) && (TransferSize == Media->BlockSize));
+        if (Cacheable && DiskIoCacheLookup (Instance, MediaId, Subtask->Lba, Subtask->WorkingBuffer)) {
+          Status = EFI_SUCCESS;
+        } else {
+          Generation = DiskIoCacheGeneration (Instance);
+          Status = BlockIo->ReadBlocks (
+                              BlockIo,
+                              MediaId,
+                              Subtask->Lba,
+                              TransferSize,
+                              (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
+                              );
+          if (!EFI_ERROR (Status) && Cacheable) {
+            DiskIoCacheInsert (Instance, MediaId, Subtask->Lba, Subtask->WorkingBuffer, Generation);
+          }
+        }
         if (!EFI_ERROR (Status) && (Subtask->WorkingBuffer != NULL)) {
           CopyMem (Subtask->Buffer, Subtask->WorkingBuffer + Subtask->Offset, Subtask->Length);
         }
@@ -930,7 +1319,7 @@ DiskIo2ReadWriteDisk (
                              MediaId,
                              Subtask->Lba,
                              &Subtask->BlockIo2Token,
-                             (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
+                             TransferSize,
                              (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
                              );
       }
@@ -1119,6 +1508,7 @@ DiskIo2FlushDiskEx (
   DISK_IO_PRIVATE_DATA            *Private;
 
   Private = DISK_IO_PRIVATE_DATA_FROM_DISK_IO2 (This);
+  DiskIoCacheInvalidate (Private);
 
   if ((Token != NULL) && (Token->Event != NULL)) {
     Task = AllocatePool (sizeof (DISK_IO2_FLUSH_TASK));
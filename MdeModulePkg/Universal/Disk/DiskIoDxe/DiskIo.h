@@ -30,6 +30,38 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
+//
+// Number of one block working buffers kept for reuse by the non-blocking
+// unaligned requests.
+//
+#define DISK_IO_BOUNCE_POOL_SIZE        8
+
+//
+// One block cached for the small blocking reads. The block is only valid while
+// Generation equals the generation of the cache of the device.
+//
+typedef struct {
+  BOOLEAN                         Valid;
+  UINT32                          MediaId;
+  EFI_LBA                         Lba;
+  UINT64                          Generation;
+  UINT64                          LastUsed;
+  UINT8                           *Data;
+} DISK_IO_CACHE_BLOCK;
+
+//
+// Subtask, bounce buffer and cache statistics, dumped in debug builds.
+//
+typedef struct {
+  UINT64                          Subtasks;
+  UINT64                          MergedSubtasks;
+  UINT64                          BounceCopies;
+  UINT64                          BouncePoolHits;
+  UINT64                          BouncePoolMisses;
+  UINT64                          CacheHits;
+  UINT64                          CacheMisses;
+} DISK_IO_STATISTICS;
+
 #define DISK_IO_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('d', 's', 'k', 'I')
 typedef struct {
   UINT32                          Signature;
@@ -43,6 +75,24 @@ typedef struct {
 
   EFI_LOCK                        TaskQueueLock;
   LIST_ENTRY                      TaskQueue;
+
+  EFI_LOCK                        BouncePoolLock;
+  UINTN                           BouncePoolCount;
+  VOID                            *BouncePool[DISK_IO_BOUNCE_POOL_SIZE];
+
+  UINTN                           CacheBlockNum;
+  UINT32                          CacheMediaId;
+  UINT64                          CacheGeneration;
+  //
+  // Set when a non-blocking write is queued, cleared once all the non-blocking
+  // requests are done. Nothing is cached while it is set.
+  //
+  BOOLEAN                         CacheAsyncWrite;
+  DISK_IO_CACHE_BLOCK             *Cache;
+  UINT8                           *CacheData;
+  UINT64                          CacheStamp;
+
+  DISK_IO_STATISTICS              Statistics;
 } DISK_IO_PRIVATE_DATA;
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO(a)  CR (a, DISK_IO_PRIVATE_DATA, DiskIo,  DISK_IO_PRIVATE_DATA_SIGNATURE)
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO2(a) CR (a, DISK_IO_PRIVATE_DATA, DiskIo2, DISK_IO_PRIVATE_DATA_SIGNATURE)
@@ -165,6 +215,31 @@ DiskIoDriverBindingStop (
   IN  EFI_HANDLE                     *ChildHandleBuffer
   );
 
+/**
+  Create the metadata cache of the device.
+
+  The cache holds single blocks read by the small blocking requests. It is only
+  created on non-removable media that isn't a logical partition. Failing to
+  allocate the cache isn't fatal, the requests are then always sent to the
+  device.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoCreateCache (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  );
+
+/**
+  Free the metadata cache of the device.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoFreeCache (
+  IN DISK_IO_PRIVATE_DATA     *Instance
+  );
+
 //
 // Disk I/O Protocol Interface
 //
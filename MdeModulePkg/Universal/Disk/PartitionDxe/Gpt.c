@@ -573,12 +573,12 @@ PartitionCheckGptEntryArrayCRC (
 
   Size    = PartHeader->NumberOfPartitionEntries * PartHeader->SizeOfPartitionEntry;
 
-  Status  = gBS->CalculateCrc32 (Ptr, Size, &Crc);
-  if (EFI_ERROR (Status)) {
+  if (Size == 0) {
     DEBUG ((EFI_D_ERROR, "CheckPEntryArrayCRC: Crc calculation failed\n"));
     FreePool (Ptr);
     return FALSE;
   }
+  Crc = CalculateCrc32 (Ptr, Size);
 
   FreePool (Ptr);
 
@@ -791,7 +791,7 @@ PartitionSetCrcAltSize (
   UINT32  Crc;
 
   Hdr->CRC32 = 0;
-  gBS->CalculateCrc32 ((UINT8 *) Hdr, Size, &Crc);
+  Crc        = CalculateCrc32 ((UINT8 *) Hdr, Size);
   Hdr->CRC32 = Crc;
 }
 
@@ -836,7 +836,6 @@ PartitionCheckCrcAltSize (
 {
   UINT32      Crc;
   UINT32      OrgCrc;
-  EFI_STATUS  Status;
 
   Crc = 0;
 
@@ -857,11 +856,7 @@ PartitionCheckCrcAltSize (
   OrgCrc      = Hdr->CRC32;
   Hdr->CRC32  = 0;
 
-  Status      = gBS->CalculateCrc32 ((UINT8 *) Hdr, Size, &Crc);
-  if (EFI_ERROR (Status)) {
-    DEBUG ((EFI_D_ERROR, "CheckCrc32: Crc calculation failed\n"));
-    return FALSE;
-  }
+  Crc         = CalculateCrc32 ((UINT8 *) Hdr, Size);
   //
   // set results
   //
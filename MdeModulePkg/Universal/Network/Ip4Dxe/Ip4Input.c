@@ -1136,7 +1136,7 @@ Ip4OnRecyclePacket (
   RemoveEntryList (&Wrap->Link);
   EfiReleaseLock (&Wrap->IpInstance->RecycleLock);
 
-  ASSERT (!NET_BUF_SHARED (Wrap->Packet));
+  ASSERT (Wrap->Packet->RefCnt == 1);
   NetbufFree (Wrap->Packet);
 
   gBS->CloseEvent (Wrap->RxData.RecycleSignal);
@@ -1169,8 +1169,13 @@ Ip4WrapRxData (
   EFI_IP4_RECEIVE_DATA      *RxData;
   EFI_STATUS                Status;
   BOOLEAN                   RawData;
+  IP4_HEAD                  *Head;
 
-  Wrap = AllocatePool (IP4_RXDATA_WRAP_SIZE (Packet->BlockOpNum));
+  //
+  // Leave room behind the fragment table for a private copy of the IP head,
+  // used when the packet data is shared with other IP4 children.
+  //
+  Wrap = AllocatePool (IP4_RXDATA_WRAP_SIZE (Packet->BlockOpNum) + IP4_MAX_HEADLEN);
 
   if (Wrap == NULL) {
     return NULL;
@@ -1206,8 +1211,18 @@ Ip4WrapRxData (
   // The application expects a network byte order header.
   //
   if (!RawData) {
-    RxData->HeaderLength  = (Packet->Ip.Ip4->HeadLen << 2);
-    RxData->Header        = (EFI_IP4_HEADER *) Ip4NtohHead (Packet->Ip.Ip4);
+    //
+    // The head is converted in place, don't touch the one other children
+    // may still see.
+    //
+    Head = Packet->Ip.Ip4;
+    if (NET_BUF_SHARED (Packet)) {
+      Head = (IP4_HEAD *) ((UINT8 *) Wrap + IP4_RXDATA_WRAP_SIZE (Packet->BlockOpNum));
+      CopyMem (Head, Packet->Ip.Ip4, Packet->Ip.Ip4->HeadLen << 2);
+    }
+
+    RxData->HeaderLength  = (Head->HeadLen << 2);
+    RxData->Header        = (EFI_IP4_HEADER *) Ip4NtohHead (Head);
     RxData->OptionsLength = RxData->HeaderLength - IP4_MIN_HEADLEN;
     RxData->Options       = NULL;
 
@@ -1251,8 +1266,6 @@ Ip4InstanceDeliverPacket (
   IP4_RXDATA_WRAP           *Wrap;
   NET_BUF                   *Packet;
   NET_BUF                   *Dup;
-  UINT8                     *Head;
-  UINT32                    HeadLen;
 
   //
   // Deliver a packet if there are both a packet and a receive token.
@@ -1262,9 +1275,12 @@ Ip4InstanceDeliverPacket (
 
     Packet = NET_LIST_HEAD (&IpInstance->Received, NET_BUF, List);
 
-    if (!NET_BUF_SHARED (Packet)) {
+    if (!NET_BUF_SHARED (Packet) || !IpInstance->ConfigData.RawData) {
       //
       // If this is the only instance that wants the packet, wrap it up.
+      // Otherwise each instance holds its own clone of the net buffer and
+      // only the data is shared, the data is read only to the receivers so
+      // hand the clone up as is. Ip4WrapRxData() gives it a private IP head.
       //
       Wrap = Ip4WrapRxData (IpInstance, Packet);
 
@@ -1276,35 +1292,15 @@ Ip4InstanceDeliverPacket (
 
     } else {
       //
-      // Create a duplicated packet if this packet is shared
+      // Create a duplicated packet if this packet is shared, a raw data
+      // receiver gets the packet with its IP head.
       //
-      if (IpInstance->ConfigData.RawData) {
-        HeadLen = 0;
-      } else {
-        HeadLen = IP4_MAX_HEADLEN;
-      }
-
-      Dup = NetbufDuplicate (Packet, NULL, HeadLen);
+      Dup = NetbufDuplicate (Packet, NULL, 0);
 
       if (Dup == NULL) {
         return EFI_OUT_OF_RESOURCES;
       }
 
-      if (!IpInstance->ConfigData.RawData) {
-        //
-        // Copy the IP head over. The packet to deliver up is
-        // headless. Trim the head off after copy. The IP head
-        // may be not continuous before the data.
-        //
-        Head = NetbufAllocSpace (Dup, IP4_MAX_HEADLEN, NET_BUF_HEAD);
-        ASSERT (Head != NULL);
-        
-        Dup->Ip.Ip4 = (IP4_HEAD *) Head;
-
-        CopyMem (Head, Packet->Ip.Ip4, Packet->Ip.Ip4->HeadLen << 2);
-        NetbufTrim (Dup, IP4_MAX_HEADLEN, TRUE);
-      }
-
       Wrap = Ip4WrapRxData (IpInstance, Dup);
 
       if (Wrap == NULL) {
@@ -96,6 +96,37 @@ MnpAddFreeNbuf (
 }
 
 
+/**
+  Release the free net buffers in MnpDeviceData->FreeNbufQue until no more
+  than Count net buffers are allocated.
+
+  @param[in, out]  MnpDeviceData         Pointer to the MNP_DEVICE_DATA.
+  @param[in]       Count                 Number of NET_BUFFERs to keep.
+
+**/
+VOID
+MnpTrimFreeNbuf (
+  IN OUT MNP_DEVICE_DATA   *MnpDeviceData,
+  IN     UINTN             Count
+  )
+{
+  EFI_TPL  OldTpl;
+  NET_BUF  *Nbuf;
+
+  NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  while ((MnpDeviceData->NbufCnt > Count) && (MnpDeviceData->FreeNbufQue.BufNum > 0)) {
+    Nbuf = NetbufQueRemove (&MnpDeviceData->FreeNbufQue);
+    NetbufFree (Nbuf);
+    MnpDeviceData->NbufCnt--;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+
 /**
   Allocate a free NET_BUF from MnpDeviceData->FreeNbufQue. If there is none
   in the queue, first try to allocate some and add them into the queue, then
@@ -126,7 +157,7 @@ MnpAllocNbuf (
   // Check whether there are available buffers, or else try to add some.
   //
   if (FreeNbufQue->BufNum == 0) {
-    if ((MnpDeviceData->NbufCnt + MNP_NET_BUFFER_INCREASEMENT) > MNP_MAX_NET_BUFFER_NUM) {
+    if ((MnpDeviceData->NbufCnt + MnpDeviceData->NbufIncrement) > MNP_MAX_NET_BUFFER_NUM) {
       DEBUG (
         (EFI_D_ERROR,
         "MnpAllocNbuf: The maximum NET_BUF size is reached for MNP driver instance %p.\n",
@@ -137,7 +168,7 @@ MnpAllocNbuf (
       goto ON_EXIT;
     }
 
-    Status = MnpAddFreeNbuf (MnpDeviceData, MNP_NET_BUFFER_INCREASEMENT);
+    Status = MnpAddFreeNbuf (MnpDeviceData, MnpDeviceData->NbufIncrement);
     if (EFI_ERROR (Status)) {
       DEBUG (
         (EFI_D_ERROR,
@@ -147,7 +178,7 @@ MnpAllocNbuf (
 
       //
       // Don't return NULL, perhaps MnpAddFreeNbuf does add some NET_BUFs but
-      // the amount is less than MNP_NET_BUFFER_INCREASEMENT.
+      // the amount is less than NbufIncrement.
       //
     }
   }
@@ -443,6 +474,7 @@ MnpInitializeDeviceData (
   // Copy the MNP Protocol interfaces from the template.
   //
   CopyMem (&MnpDeviceData->VlanConfig, &mVlanConfigProtocolTemplate, sizeof (EFI_VLAN_CONFIG_PROTOCOL));
+  MnpDeviceData->StatisticsProtocol.Statistics = MnpStatistics;
 
   //
   // Open the Simple Network protocol.
@@ -496,6 +528,8 @@ MnpInitializeDeviceData (
   // Initialize the FreeNetBufQue and pre-allocate some NET_BUFs.
   //
   NetbufQueInit (&MnpDeviceData->FreeNbufQue);
+  MnpDeviceData->NbufIncrement = MNP_NET_BUFFER_INCREASEMENT;
+  MnpDeviceData->PollInterval  = MNP_SYS_POLL_INTERVAL;
   Status = MnpAddFreeNbuf (MnpDeviceData, MNP_INIT_NET_BUFFER_NUM);
   if (EFI_ERROR (Status)) {
     DEBUG ((EFI_D_ERROR, "MnpInitializeDeviceData: MnpAddFreeNbuf failed, %r.\n", Status));
@@ -1279,7 +1313,8 @@ MnpStart (
     //
     TimerOpType = EnableSystemPoll ? TimerPeriodic : TimerCancel;
 
-    Status      = gBS->SetTimer (MnpDeviceData->PollTimer, TimerOpType, MNP_SYS_POLL_INTERVAL);
+    MnpDeviceData->PollInterval = MNP_SYS_POLL_INTERVAL;
+    Status      = gBS->SetTimer (MnpDeviceData->PollTimer, TimerOpType, MnpDeviceData->PollInterval);
     if (EFI_ERROR (Status)) {
       DEBUG ((EFI_D_ERROR, "MnpStart: gBS->SetTimer for PollTimer failed, %r.\n", Status));
 
@@ -1359,6 +1394,17 @@ MnpStop (
   //
   Status = gBS->SetTimer (MnpDeviceData->MediaDetectTimer, TimerCancel, 0);
 
+  DEBUG (
+    (EFI_D_INFO,
+    "MnpStop: Rx %Ld/%Ld dropped, Tx %Ld/%Ld dropped, %d NET_BUFs allocated, %Ld NET_BUF shortages.\n",
+    MnpDeviceData->Statistics.RxDroppedFrames,
+    MnpDeviceData->Statistics.RxTotalFrames,
+    MnpDeviceData->Statistics.TxDroppedFrames,
+    MnpDeviceData->Statistics.TxTotalFrames,
+    (UINT32) MnpDeviceData->NbufCnt,
+    MnpDeviceData->RxNbufShortage)
+    );
+
   //
   // Stop the simple network.
   //
@@ -184,6 +184,21 @@ MnpDriverBindingStart (
     return Status;
   }
 
+  //
+  // Install the Managed Network Statistics Protocol
+  //
+  Status = gBS->InstallMultipleProtocolInterfaces (
+                  &ControllerHandle,
+                  &gEdkiiManagedNetworkStatisticsProtocolGuid,
+                  &MnpDeviceData->StatisticsProtocol,
+                  NULL
+                  );
+  if (EFI_ERROR (Status)) {
+    MnpDestroyDeviceData (MnpDeviceData, This->DriverBindingHandle);
+    FreePool (MnpDeviceData);
+    return Status;
+  }
+
   //
   // Check whether NIC driver has already produced VlanConfig protocol
   //
@@ -280,6 +295,13 @@ Exit:
              );
     }
 
+    gBS->UninstallMultipleProtocolInterfaces (
+           MnpDeviceData->ControllerHandle,
+           &gEdkiiManagedNetworkStatisticsProtocolGuid,
+           &MnpDeviceData->StatisticsProtocol,
+           NULL
+           );
+
     //
     // Destroy Mnp Device Data
     //
@@ -386,6 +408,13 @@ MnpDriverBindingStop (
              );
     }
 
+    gBS->UninstallMultipleProtocolInterfaces (
+           MnpDeviceData->ControllerHandle,
+           &gEdkiiManagedNetworkStatisticsProtocolGuid,
+           &MnpDeviceData->StatisticsProtocol,
+           NULL
+           );
+
     //
     // Destroy Mnp Device Data
     //
@@ -22,6 +22,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Protocol/SimpleNetwork.h>
 #include <Protocol/ServiceBinding.h>
 #include <Protocol/VlanConfig.h>
+#include <Protocol/ManagedNetworkStatistics.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -76,6 +77,29 @@ typedef struct {
 
   EFI_EVENT                     PollTimer;
   BOOLEAN                       EnableSystemPoll;
+  //
+  // Current period of the system poll timer, shortened while packets are
+  // arriving and doubled up to MNP_SYS_POLL_INTERVAL when the link is idle.
+  //
+  UINT64                        PollInterval;
+  //
+  // Number of NET_BUFs added to FreeNbufQue when it runs empty, doubled
+  // each time the receive path fails to get a NET_BUF.
+  //
+  UINTN                         NbufIncrement;
+  //
+  // Number of times the receive path failed to get a NET_BUF, and its value
+  // at the previous system poll.
+  //
+  UINT64                        RxNbufShortage;
+  UINT64                        LastRxNbufShortage;
+
+  //
+  // Statistics of the packets received and transmitted through this device,
+  // reported by StatisticsProtocol.
+  //
+  EFI_NETWORK_STATISTICS        Statistics;
+  EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL  StatisticsProtocol;
 
   EFI_EVENT                     TimeoutCheckTimer;
   EFI_EVENT                     MediaDetectTimer;
@@ -102,6 +126,14 @@ typedef struct {
   MNP_DEVICE_DATA_SIGNATURE \
   )
 
+#define MNP_DEVICE_DATA_FROM_STATISTICS(a) \
+  CR ( \
+  (a), \
+  MNP_DEVICE_DATA, \
+  StatisticsProtocol, \
+  MNP_DEVICE_DATA_SIGNATURE \
+  )
+
 #define MNP_SERVICE_DATA_SIGNATURE  SIGNATURE_32 ('M', 'n', 'p', 'S')
 
 typedef struct {
@@ -21,11 +21,15 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define NET_ETHER_FCS_SIZE            4
 
 #define MNP_SYS_POLL_INTERVAL         (10 * TICKS_PER_MS)   // 10 milliseconds
+#define MNP_SYS_POLL_INTERVAL_MIN     (TICKS_PER_MS / 4)    // 250 microseconds
+#define MNP_RX_BATCH_SIZE             64
 #define MNP_TIMEOUT_CHECK_INTERVAL    (50 * TICKS_PER_MS)   // 50 milliseconds
 #define MNP_MEDIA_DETECT_INTERVAL     (500 * TICKS_PER_MS)  // 500 milliseconds
 #define MNP_TX_TIMEOUT_TIME           (500 * TICKS_PER_MS)  // 500 milliseconds
 #define MNP_INIT_NET_BUFFER_NUM       512
 #define MNP_NET_BUFFER_INCREASEMENT   64
+#define MNP_MAX_NET_BUFFER_INCREASEMENT 1024
+#define MNP_MAX_RX_NET_BUFFER_NUM     4096  // Limit of the growth on NET_BUF shortage in the receive path.
 #define MNP_MAX_NET_BUFFER_NUM        65536
 #define MNP_TX_BUFFER_INCREASEMENT    32    // Same as the recycling Q length for xmit_done in UNDI command.
 #define MNP_MAX_TX_BUFFER_NUM         65536
@@ -437,6 +441,57 @@ MnpReceivePacket (
   IN OUT MNP_DEVICE_DATA   *MnpDeviceData
   );
 
+/**
+  Receive and deliver all the packets pending in Snp, at most
+  MNP_RX_BATCH_SIZE of them in one call.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Received             Pointer to the number of packets received.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval EFI_NOT_STARTED       The simple network protocol is not started.
+  @retval EFI_NOT_READY         No packet received.
+  @retval EFI_DEVICE_ERROR      An unexpected error occurs.
+
+**/
+EFI_STATUS
+MnpReceivePacketBatch (
+  IN OUT MNP_DEVICE_DATA   *MnpDeviceData,
+     OUT UINTN             *Received
+  );
+
+/**
+  Add Count of net buffers to MnpDeviceData->FreeNbufQue. The length of the net
+  buffer is specified by MnpDeviceData->BufferLength.
+
+  @param[in, out]  MnpDeviceData         Pointer to the MNP_DEVICE_DATA.
+  @param[in]       Count                 Number of NET_BUFFERs to add.
+
+  @retval EFI_SUCCESS           The specified amount of NET_BUFs are allocated
+                                and added to MnpDeviceData->FreeNbufQue.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate a NET_BUF structure.
+
+**/
+EFI_STATUS
+MnpAddFreeNbuf (
+  IN OUT MNP_DEVICE_DATA   *MnpDeviceData,
+  IN     UINTN             Count
+  );
+
+/**
+  Release the free net buffers in MnpDeviceData->FreeNbufQue until no more
+  than Count net buffers are allocated.
+
+  @param[in, out]  MnpDeviceData         Pointer to the MNP_DEVICE_DATA.
+  @param[in]       Count                 Number of NET_BUFFERs to keep.
+
+**/
+VOID
+MnpTrimFreeNbuf (
+  IN OUT MNP_DEVICE_DATA   *MnpDeviceData,
+  IN     UINTN             Count
+  );
+
 /**
   Allocate a free NET_BUF from MnpDeviceData->FreeNbufQue. If there is none
   in the queue, first try to allocate some and add them into the queue, then
@@ -886,6 +941,39 @@ MnpPoll (
   IN EFI_MANAGED_NETWORK_PROTOCOL    *This
   );
 
+/**
+  Resets or collects the statistics of the frames the MNP driver received from
+  and transmitted to a network device.
+
+  The function follows EFI_SIMPLE_NETWORK_PROTOCOL.Statistics(). If StatisticsSize
+  is too small for all the statistics, a partial table is returned in
+  StatisticsTable, StatisticsSize is set to the required size and
+  EFI_BUFFER_TOO_SMALL is returned. The counters the driver doesn't maintain
+  are set to all ones.
+
+  @param[in]      This             A pointer to the EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL instance.
+  @param[in]      Reset            Set to TRUE to reset the statistics of the device.
+  @param[in, out] StatisticsSize   On input the size, in bytes, of StatisticsTable. On output
+                                   the size, in bytes, of the resulting table of statistics.
+  @param[out]     StatisticsTable  A pointer to the EFI_NETWORK_STATISTICS structure that
+                                   receives the statistics.
+
+  @retval EFI_SUCCESS            The requested operation succeeded.
+  @retval EFI_BUFFER_TOO_SMALL   StatisticsSize is not NULL and is smaller than the table.
+                                 The required size is returned in StatisticsSize.
+  @retval EFI_INVALID_PARAMETER  This is NULL, or StatisticsSize is NULL and
+                                 StatisticsTable is not NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpStatistics (
+  IN     EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL  *This,
+  IN     BOOLEAN                                    Reset,
+  IN OUT UINTN                                      *StatisticsSize   OPTIONAL,
+     OUT EFI_NETWORK_STATISTICS                     *StatisticsTable  OPTIONAL
+  );
+
 /**
   Configure the Snp receive filters according to the instances' receive filter
   settings.
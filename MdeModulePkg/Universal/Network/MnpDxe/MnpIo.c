@@ -291,6 +291,13 @@ MnpSyncSendPacket (
 
 SIGNAL_TOKEN:
 
+  MnpDeviceData->Statistics.TxTotalFrames++;
+  if (EFI_ERROR (Token->Status)) {
+    MnpDeviceData->Statistics.TxDroppedFrames++;
+  } else {
+    MnpDeviceData->Statistics.TxGoodFrames++;
+  }
+
   gBS->SignalEvent (Token->Event);
 
   //
@@ -511,6 +518,7 @@ MnpQueueRcvdPacket (
     //
     MnpRecycleRxData (NULL, (VOID *) OldRxDataWrap);
     Instance->RcvdPacketQueueSize--;
+    Instance->MnpServiceData->MnpDeviceData->Statistics.RxDroppedFrames++;
   }
 
   //
@@ -883,8 +891,11 @@ MnpReceivePacket (
 
     if (MnpDeviceData->RxNbufCache == NULL) {
       //
-      // No available buffer in the buffer pool.
+      // No available buffer in the buffer pool, the packets pending in Snp
+      // will be lost if this persists. They are still queued in Snp, so count
+      // a shortage rather than a dropped frame.
       //
+      MnpDeviceData->RxNbufShortage++;
       return EFI_DEVICE_ERROR;
     }
 
@@ -914,6 +925,8 @@ MnpReceivePacket (
     return Status;
   }
 
+  MnpDeviceData->Statistics.RxTotalFrames++;
+
   //
   // Sanity check.
   //
@@ -924,6 +937,7 @@ MnpReceivePacket (
       HeaderSize,
       BufLen)
       );
+    MnpDeviceData->Statistics.RxDroppedFrames++;
     return EFI_DEVICE_ERROR;
   }
 
@@ -972,12 +986,14 @@ MnpReceivePacket (
     // RefCnt > 2 indicates there is at least one receiver of this packet.
     // Free the current RxNbufCache and allocate a new one.
     //
+    MnpDeviceData->Statistics.RxGoodFrames++;
     MnpFreeNbuf (MnpDeviceData, Nbuf);
 
     Nbuf                       = MnpAllocNbuf (MnpDeviceData);
     MnpDeviceData->RxNbufCache = Nbuf;
     if (Nbuf == NULL) {
       DEBUG ((EFI_D_ERROR, "MnpReceivePacket: Alloc packet for receiving cache failed.\n"));
+      MnpDeviceData->RxNbufShortage++;
       return EFI_DEVICE_ERROR;
     }
 
@@ -1008,6 +1024,49 @@ EXIT:
 }
 
 
+/**
+  Receive and deliver all the packets pending in Snp, at most
+  MNP_RX_BATCH_SIZE of them in one call.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+  @param[out]      Received             Pointer to the number of packets received.
+
+  @retval EFI_SUCCESS           At least one packet is received.
+  @retval EFI_NOT_STARTED       The simple network protocol is not started.
+  @retval EFI_NOT_READY         No packet received.
+  @retval EFI_DEVICE_ERROR      An unexpected error occurs.
+
+**/
+EFI_STATUS
+MnpReceivePacketBatch (
+  IN OUT MNP_DEVICE_DATA   *MnpDeviceData,
+     OUT UINTN             *Received
+  )
+{
+  EFI_STATUS  Status;
+
+  *Received = 0;
+
+  do {
+    Status = MnpReceivePacket (MnpDeviceData);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    (*Received)++;
+  } while (*Received < MNP_RX_BATCH_SIZE);
+
+  if ((*Received != 0) && (Status == EFI_NOT_READY)) {
+    //
+    // Snp is drained, report the packets already received.
+    //
+    Status = EFI_SUCCESS;
+  }
+
+  return Status;
+}
+
+
 /**
   Remove the received packets if timeout occurs.
 
@@ -1069,6 +1128,7 @@ MnpCheckPacketTimeout (
           DEBUG ((EFI_D_WARN, "MnpCheckPacketTimeout: Received packet timeout.\n"));
           MnpRecycleRxData (NULL, RxDataWrap);
           Instance->RcvdPacketQueueSize--;
+          MnpDeviceData->Statistics.RxDroppedFrames++;
         }
       }
 
@@ -1124,17 +1184,68 @@ MnpSystemPoll (
   )
 {
   MNP_DEVICE_DATA  *MnpDeviceData;
+  UINTN            Received;
+  UINT64           Interval;
 
   MnpDeviceData = (MNP_DEVICE_DATA *) Context;
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
 
   //
-  // Try to receive packets from Snp.
+  // Try to receive all the pending packets from Snp.
   //
-  MnpReceivePacket (MnpDeviceData);
+  MnpReceivePacketBatch (MnpDeviceData, &Received);
 
   //
   // Dispatch the DPC queued by the NotifyFunction of rx token's events.
   //
   DispatchDpc ();
+
+  //
+  // Grow the buffer pool if the receive path ran out of NET_BUFs since the
+  // last poll, and double the step so that a sustained burst catches up
+  // quickly. Other drops, such as a full receive queue, don't need buffers.
+  //
+  if (MnpDeviceData->RxNbufShortage != MnpDeviceData->LastRxNbufShortage) {
+    MnpDeviceData->LastRxNbufShortage = MnpDeviceData->RxNbufShortage;
+
+    if ((MnpDeviceData->NbufCnt + MnpDeviceData->NbufIncrement) <= MNP_MAX_RX_NET_BUFFER_NUM) {
+      MnpAddFreeNbuf (MnpDeviceData, MnpDeviceData->NbufIncrement);
+    }
+
+    if (MnpDeviceData->NbufIncrement < MNP_MAX_NET_BUFFER_INCREASEMENT) {
+      MnpDeviceData->NbufIncrement *= 2;
+    }
+  }
+
+  if (!MnpDeviceData->EnableSystemPoll) {
+    return ;
+  }
+
+  //
+  // Poll fast while packets are flowing and back off exponentially to
+  // MNP_SYS_POLL_INTERVAL when the link is idle.
+  //
+  if (Received != 0) {
+    Interval = MNP_SYS_POLL_INTERVAL_MIN;
+  } else if (MnpDeviceData->PollInterval < MNP_SYS_POLL_INTERVAL) {
+    Interval = MultU64x32 (MnpDeviceData->PollInterval, 2);
+    if (Interval > MNP_SYS_POLL_INTERVAL) {
+      Interval = MNP_SYS_POLL_INTERVAL;
+    }
+  } else {
+    //
+    // The link has been idle for a whole poll period, give back the NET_BUFs
+    // added for the last burst.
+    //
+    Interval = MNP_SYS_POLL_INTERVAL;
+    MnpDeviceData->NbufIncrement = MNP_NET_BUFFER_INCREASEMENT;
+    if (MnpDeviceData->NbufCnt > MNP_INIT_NET_BUFFER_NUM) {
+      MnpTrimFreeNbuf (MnpDeviceData, MNP_INIT_NET_BUFFER_NUM);
+    }
+  }
+
+  if (Interval != MnpDeviceData->PollInterval) {
+    MnpDeviceData->PollInterval = Interval;
+    gBS->SetTimer (MnpDeviceData->PollTimer, TimerPeriodic, Interval);
+  }
 }
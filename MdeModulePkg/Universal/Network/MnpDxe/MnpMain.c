@@ -765,6 +765,7 @@ MnpPoll (
   EFI_STATUS         Status;
   MNP_INSTANCE_DATA  *Instance;
   EFI_TPL            OldTpl;
+  UINTN              Received;
 
   if (This == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -780,9 +781,9 @@ MnpPoll (
   }
 
   //
-  // Try to receive packets.
+  // Try to receive all the pending packets.
   //
-  Status = MnpReceivePacket (Instance->MnpServiceData->MnpDeviceData);
+  Status = MnpReceivePacketBatch (Instance->MnpServiceData->MnpDeviceData, &Received);
 
   //
   // Dispatch the DPC queued by the NotifyFunction of rx token's events.
@@ -794,3 +795,87 @@ ON_EXIT:
 
   return Status;
 }
+
+/**
+  Resets or collects the statistics of the frames the MNP driver received from
+  and transmitted to a network device.
+
+  The function follows EFI_SIMPLE_NETWORK_PROTOCOL.Statistics(). If StatisticsSize
+  is too small for all the statistics, a partial table is returned in
+  StatisticsTable, StatisticsSize is set to the required size and
+  EFI_BUFFER_TOO_SMALL is returned. The counters the driver doesn't maintain
+  are set to all ones.
+
+  @param[in]      This             A pointer to the EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL instance.
+  @param[in]      Reset            Set to TRUE to reset the statistics of the device.
+  @param[in, out] StatisticsSize   On input the size, in bytes, of StatisticsTable. On output
+                                   the size, in bytes, of the resulting table of statistics.
+  @param[out]     StatisticsTable  A pointer to the EFI_NETWORK_STATISTICS structure that
+                                   receives the statistics.
+
+  @retval EFI_SUCCESS            The requested operation succeeded.
+  @retval EFI_BUFFER_TOO_SMALL   StatisticsSize is not NULL and is smaller than the table.
+                                 The required size is returned in StatisticsSize.
+  @retval EFI_INVALID_PARAMETER  This is NULL, or StatisticsSize is NULL and
+                                 StatisticsTable is not NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpStatistics (
+  IN     EDKII_MANAGED_NETWORK_STATISTICS_PROTOCOL  *This,
+  IN     BOOLEAN                                    Reset,
+  IN OUT UINTN                                      *StatisticsSize   OPTIONAL,
+     OUT EFI_NETWORK_STATISTICS                     *StatisticsTable  OPTIONAL
+  )
+{
+  MNP_DEVICE_DATA         *MnpDeviceData;
+  EFI_NETWORK_STATISTICS  Table;
+  UINTN                   Size;
+  EFI_TPL                 OldTpl;
+
+  if (This == NULL || (StatisticsSize == NULL && StatisticsTable != NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  MnpDeviceData = MNP_DEVICE_DATA_FROM_STATISTICS (This);
+
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  //
+  // Only the frame counters are maintained, report the others as unsupported.
+  //
+  SetMem (&Table, sizeof (Table), 0xFF);
+  Table.RxTotalFrames   = MnpDeviceData->Statistics.RxTotalFrames;
+  Table.RxGoodFrames    = MnpDeviceData->Statistics.RxGoodFrames;
+  Table.RxDroppedFrames = MnpDeviceData->Statistics.RxDroppedFrames;
+  Table.TxTotalFrames   = MnpDeviceData->Statistics.TxTotalFrames;
+  Table.TxGoodFrames    = MnpDeviceData->Statistics.TxGoodFrames;
+  Table.TxDroppedFrames = MnpDeviceData->Statistics.TxDroppedFrames;
+
+  if (Reset) {
+    ZeroMem (&MnpDeviceData->Statistics, sizeof (EFI_NETWORK_STATISTICS));
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (StatisticsSize == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Like SNP, only return the counters that fit in the table as a whole.
+  //
+  Size = OFFSET_OF (EFI_NETWORK_STATISTICS, TxDroppedFrames) + sizeof (UINT64);
+  if (StatisticsTable != NULL) {
+    CopyMem (StatisticsTable, &Table, MIN (*StatisticsSize, Size) & ~(sizeof (UINT64) - 1));
+  }
+
+  if (StatisticsTable == NULL || *StatisticsSize < Size) {
+    *StatisticsSize = Size;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  *StatisticsSize = Size;
+  return EFI_SUCCESS;
+}
@@ -115,6 +115,9 @@ Mtftp4RrqSendAck (
   Ack->Ack.OpCode   = HTONS (EFI_MTFTP4_OPCODE_ACK);
   Ack->Ack.Block[0] = HTONS (BlkNo);
 
+  Instance->AckedBlock       = Instance->TotalBlock;
+  Instance->UnexpectedBlocks = 0;
+
   return Mtftp4SendPacket (Instance, Packet);
 }
 
@@ -178,6 +181,8 @@ Mtftp4RrqSaveBlock (
     return Status;
   }
 
+  Instance->TotalBlock = TotalBlock;
+
   if (Token->CheckPacket != NULL) {
     Status = Token->CheckPacket (&Instance->Mtftp4, Token, (UINT16) Len, Packet);
 
@@ -265,10 +270,21 @@ Mtftp4RrqHandleData (
   //
   // If we are active and received an unexpected packet, retransmit
   // the last ACK then restart receiving. If we are passive, save
-  // the block.
+  // the block. When a window of blocks is in flight, acknowledge the
+  // last in-order block once so that the server restarts the window
+  // from there, and ignore the rest of the window. A whole window of
+  // unexpected blocks means the server is resending it because our ACK
+  // was lost, so acknowledge again, at most once per window (RFC 7440).
   //
   if (Instance->Master && (Expected != BlockNum)) {
-    Mtftp4Retransmit (Instance);
+    if (Instance->AckedBlock != Instance->TotalBlock) {
+      Mtftp4RrqSendAck (Instance, (UINT16) (Expected - 1));
+    } else if (Instance->WindowSize == 1) {
+      Mtftp4Retransmit (Instance);
+    } else if (++Instance->UnexpectedBlocks >= Instance->WindowSize) {
+      Mtftp4RrqSendAck (Instance, (UINT16) (Expected - 1));
+    }
+
     return EFI_SUCCESS;
   }
 
@@ -280,9 +296,10 @@ Mtftp4RrqHandleData (
 
   //
   // Reset the passive client's timer whenever it received a
-  // valid data packet.
+  // valid data packet. So does the active client within a window
+  // as it doesn't send an ACK for every block.
   //
-  if (!Instance->Master) {
+  if (!Instance->Master || (Instance->WindowSize > 1)) {
     Mtftp4SetTimeout (Instance);
   }
 
@@ -307,6 +324,13 @@ Mtftp4RrqHandleData (
 
     } else {
       BlockNum = (UINT16) (Expected - 1);
+
+      //
+      // Only acknowledge the last block of each window.
+      //
+      if ((Instance->TotalBlock - Instance->AckedBlock) < Instance->WindowSize) {
+        return EFI_SUCCESS;
+      }
     }
 
     Mtftp4RrqSendAck (Instance, BlockNum);
@@ -324,6 +348,7 @@ Mtftp4RrqHandleData (
   2. The server can only use smaller blksize than that is requested
   3. The server can only use the same timeout as requested
   4. The server doesn't change its multicast channel.
+  5. The server can only use smaller windowsize than that is requested
 
   @param  This                  The downloading Mtftp session
   @param  Reply                 The options in the OACK packet
@@ -357,6 +382,13 @@ Mtftp4RrqOackValid (
     return FALSE;
   }
 
+  //
+  // Server can only specify a smaller window size to be used.
+  //
+  if (((Reply->Exist & MTFTP4_WINDOWSIZE_EXIST) != 0) && (Reply->WindowSize > Request->WindowSize)) {
+    return FALSE;
+  }
+
   //
   // The server can send ",,master" to client to change its master
   // setting. But if it use the specific multicast channel, it can't
@@ -614,6 +646,13 @@ Mtftp4RrqHandleOack (
     if (Reply.Timeout != 0) {
       Instance->Timeout = Reply.Timeout;
     }
+
+    //
+    // The window size is only used by the unicast download.
+    //
+    if (Reply.WindowSize != 0) {
+      Instance->WindowSize = Reply.WindowSize;
+    }
   }
   
   //
@@ -1518,9 +1518,11 @@ Udp4InstanceDeliverDgram (
 
     if (NET_BUF_SHARED (Wrap->Packet)) {
       //
-      // Duplicate the Packet if it is shared between instances.
+      // Clone the Packet if it is shared between instances. The receivers
+      // only read the data, so the blocks are shared and only the net
+      // buffer itself is made private to this instance.
       //
-      Dup = NetbufDuplicate (Wrap->Packet, NULL, 0);
+      Dup = NetbufClone (Wrap->Packet);
       if (Dup == NULL) {
         return;
       }
@@ -353,9 +353,9 @@ EfiPxeBcStart (
 
 
   //
-  // Configure block size for TFTP as a default value to handle all link layers.
+  // Configure block size for TFTP as the largest one the link MTU allows.
   // 
-  Private->BlockSize   = MIN (Private->Ip4MaxPacketSize, PXEBC_DEFAULT_PACKET_SIZE) -
+  Private->BlockSize   = Private->Ip4MaxPacketSize -
                            PXEBC_DEFAULT_UDP_OVERHEAD_SIZE - PXEBC_DEFAULT_TFTP_OVERHEAD_SIZE;
   //
   // If PcdTftpBlockSize is set to non-zero, override the default value.
@@ -363,6 +363,16 @@ EfiPxeBcStart (
   if (PcdGet64 (PcdTftpBlockSize) != 0) {
     Private->BlockSize   = (UINTN) PcdGet64 (PcdTftpBlockSize);
   }
+
+  //
+  // Request the TFTP windowsize option for downloads, RFC 7440 allows 1 to
+  // 65535 blocks.
+  //
+  Private->WindowSize  = PcdGet16 (PcdTftpWindowSize);
+  if (Private->WindowSize == 0) {
+    DEBUG ((EFI_D_WARN, "EfiPxeBcStart: PcdTftpWindowSize 0 is out of range, windowsize option disabled.\n"));
+    Private->WindowSize = 1;
+  }
   
   Private->AddressIsOk = FALSE;
 
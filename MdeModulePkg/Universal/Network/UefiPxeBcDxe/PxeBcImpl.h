@@ -99,6 +99,7 @@ struct _PXEBC_PRIVATE_DATA {
   BOOLEAN                                   AddressIsOk;
   UINT32                                    Ip4MaxPacketSize;
   UINTN                                     BlockSize;
+  UINTN                                     WindowSize;
   UINTN                                     FileSize;
 
   UINT8                                     OptionBuffer[PXEBC_DHCP4_MAX_OPTION_SIZE];
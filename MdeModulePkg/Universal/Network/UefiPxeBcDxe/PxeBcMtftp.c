@@ -18,7 +18,8 @@ CHAR8 *mMtftpOptions[PXE_MTFTP_OPTION_MAXIMUM_INDEX] = {
   "blksize",
   "timeout",
   "tsize",
-  "multicast"
+  "multicast",
+  "windowsize"
 };
 
 
@@ -242,9 +243,10 @@ PxeBcTftpReadFile (
 {
   EFI_MTFTP4_PROTOCOL *Mtftp4;
   EFI_MTFTP4_TOKEN    Token;
-  EFI_MTFTP4_OPTION   ReqOpt[1];
+  EFI_MTFTP4_OPTION   ReqOpt[2];
   UINT32              OptCnt;
   UINT8               OptBuf[128];
+  UINT8               WindowSizeBuf[8];
   EFI_STATUS          Status;
 
   Status                    = EFI_DEVICE_ERROR;
@@ -266,6 +268,13 @@ PxeBcTftpReadFile (
     OptCnt++;
   }
 
+  if (Private->WindowSize > 1) {
+    ReqOpt[OptCnt].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_WINDOWSIZE_INDEX];
+    ReqOpt[OptCnt].ValueStr  = WindowSizeBuf;
+    UtoA10 (Private->WindowSize, (CHAR8 *) ReqOpt[OptCnt].ValueStr, sizeof (WindowSizeBuf));
+    OptCnt++;
+  }
+
   Token.Event         = NULL;
   Token.OverrideData  = NULL;
   Token.Filename      = Filename;
@@ -153,6 +153,15 @@
 ///
 #define HTTP_HEADER_TRANSFER_ENCODING  "Transfer-Encoding"
 
+///
+/// Connection Header
+/// The Connection general-header field allows the sender to specify options that are
+/// desired for that particular connection. HTTP/1.1 defines the "close" connection option
+/// for the sender to signal that the connection will be closed after completion of the
+/// response, HTTP/1.0 clients use "keep-alive" to ask for a persistent connection.
+///
+#define HTTP_HEADER_CONNECTION         "Connection"
+
 
 ///
 /// User Agent Request Header
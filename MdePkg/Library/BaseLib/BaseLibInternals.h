@@ -1830,6 +1830,39 @@ InternalFlushCacheRange (
   IN      UINTN                     Length
   );
 
+#elif defined (MDE_CPU_AARCH64)
+
+/**
+  Checks whether the CPU implements the CRC32 instructions.
+
+  @retval TRUE   The CRC32 instructions are implemented.
+  @retval FALSE  The CRC32 instructions are not implemented.
+
+**/
+BOOLEAN
+EFIAPI
+InternalAArch64HasCrc32 (
+  VOID
+  );
+
+/**
+  Updates a CRC32 value with the data of a buffer, using the CRC32 instructions.
+
+  @param  Crc         The CRC32 value to update, not inverted at the end.
+  @param  Buffer      The pointer to the buffer.
+  @param  Length      The size, in bytes, of Buffer.
+
+  @return The updated CRC32 value.
+
+**/
+UINT32
+EFIAPI
+InternalAArch64Crc32 (
+  IN      UINT32                    Crc,
+  IN      CONST UINT8               *Buffer,
+  IN      UINTN                     Length
+  );
+
 #else
 
 #endif
@@ -0,0 +1,235 @@
+/** @file
+  A shell application that measures the throughput of the HTTP boot download.
+
+  It downloads a file through the LoadFile protocol produced by HttpBootDxe and
+  reports the transfer rate in MB/s. The file is normally served from a local
+  HTTP server (for example "python -m http.server" in the directory holding the
+  image) so that the result reflects the firmware network stack rather than the
+  server or the link.
+
+  Usage: HttpBootBenchmark [Url]
+
+  If Url is omitted the boot file URI offered by the DHCP server is used.
+
+  Copyright (c) 2026 Baikal Electronics JSC
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Uefi.h>
+#include <Protocol/LoadFile.h>
+#include <Protocol/DevicePath.h>
+#include <Protocol/ShellParameters.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/TimerLib.h>
+#include <Library/PrintLib.h>
+#include <Library/BenchmarkLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+/**
+  Find the first LoadFile instance whose device path ends in a URI node, which
+  is how HttpBootDxe publishes its IPv4 and IPv6 boot children.
+
+  @param[out]  LoadFile     The LoadFile protocol of the HTTP boot child.
+
+  @retval EFI_SUCCESS       An HTTP boot LoadFile instance was found.
+  @retval EFI_NOT_FOUND     There is no HTTP boot LoadFile instance.
+
+**/
+EFI_STATUS
+FindHttpBootLoadFile (
+  OUT EFI_LOAD_FILE_PROTOCOL       **LoadFile
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_HANDLE                       *Handles;
+  UINTN                            HandleCount;
+  UINTN                            Index;
+  EFI_DEVICE_PATH_PROTOCOL         *DevicePath;
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiLoadFileProtocolGuid,
+                  NULL,
+                  &HandleCount,
+                  &Handles
+                  );
+  if (EFI_ERROR (Status)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = EFI_NOT_FOUND;
+  for (Index = 0; Index < HandleCount; Index++) {
+    DevicePath = DevicePathFromHandle (Handles[Index]);
+    if (DevicePath == NULL) {
+      continue;
+    }
+
+    while (!IsDevicePathEnd (DevicePath)) {
+      if ((DevicePathType (DevicePath) == MESSAGING_DEVICE_PATH) &&
+          (DevicePathSubType (DevicePath) == MSG_URI_DP)) {
+        break;
+      }
+      DevicePath = NextDevicePathNode (DevicePath);
+    }
+
+    if (!IsDevicePathEnd (DevicePath)) {
+      Status = gBS->HandleProtocol (Handles[Index], &gEfiLoadFileProtocolGuid, (VOID **) LoadFile);
+      if (!EFI_ERROR (Status)) {
+        break;
+      }
+    }
+  }
+
+  FreePool (Handles);
+  return Status;
+}
+
+/**
+  Build the file path passed to LoadFile: a single URI node followed by an end
+  node. An empty URI node asks HttpBootDxe to use the DHCP offered boot file.
+
+  @param[in]  Url           The ASCII URL of the file, or NULL.
+
+  @return The file path, or NULL if it could not be allocated.
+
+**/
+EFI_DEVICE_PATH_PROTOCOL *
+BuildUriFilePath (
+  IN  CHAR8                        *Url   OPTIONAL
+  )
+{
+  EFI_DEVICE_PATH_PROTOCOL         *UriNode;
+  EFI_DEVICE_PATH_PROTOCOL         *FilePath;
+  UINTN                            UrlLength;
+
+  UrlLength = (Url == NULL) ? 0 : AsciiStrLen (Url);
+  UriNode   = CreateDeviceNode (
+                MESSAGING_DEVICE_PATH,
+                MSG_URI_DP,
+                (UINT16) (sizeof (EFI_DEVICE_PATH_PROTOCOL) + UrlLength)
+                );
+  if (UriNode == NULL) {
+    return NULL;
+  }
+  CopyMem (((URI_DEVICE_PATH *) UriNode)->Uri, Url, UrlLength);
+
+  FilePath = AppendDevicePathNode (NULL, UriNode);
+  FreePool (UriNode);
+  return FilePath;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_SHELL_PARAMETERS_PROTOCOL  *ShellParameters;
+  EFI_LOAD_FILE_PROTOCOL         *LoadFile;
+  EFI_DEVICE_PATH_PROTOCOL       *FilePath;
+  CHAR8                          *Url;
+  UINTN                          UrlSize;
+  VOID                           *Buffer;
+  UINTN                          BufferSize;
+  UINT64                         Start;
+  UINT64                         End;
+  UINT64                         Elapsed;
+  CHAR16                         Label[64];
+
+  Url    = NULL;
+  Status = gBS->HandleProtocol (ImageHandle, &gEfiShellParametersProtocolGuid, (VOID **) &ShellParameters);
+  if (!EFI_ERROR (Status) && ShellParameters->Argc > 1) {
+    UrlSize = StrLen (ShellParameters->Argv[1]) + 1;
+    Url     = AllocatePool (UrlSize);
+    if (Url == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    UnicodeStrToAsciiStrS (ShellParameters->Argv[1], Url, UrlSize);
+  }
+
+  Status = FindHttpBootLoadFile (&LoadFile);
+  if (EFI_ERROR (Status)) {
+    Print (L"HttpBootBenchmark: No HTTP boot device found\n");
+    goto ON_EXIT;
+  }
+
+  FilePath = BuildUriFilePath (Url);
+  if (FilePath == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ON_EXIT;
+  }
+
+  //
+  // The first call discovers the boot file and returns its size.
+  //
+  BufferSize = 0;
+  Buffer     = NULL;
+  Status     = LoadFile->LoadFile (LoadFile, FilePath, TRUE, &BufferSize, NULL);
+  if (Status != EFI_BUFFER_TOO_SMALL && Status != EFI_WARN_FILE_SYSTEM) {
+    Print (L"HttpBootBenchmark: Unable to get the file size - %r\n", Status);
+    goto ON_EXIT_PATH;
+  }
+
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (BufferSize));
+  if (Buffer == NULL) {
+    Print (L"HttpBootBenchmark: Unable to allocate %d byte buffer\n", BufferSize);
+    Status = EFI_OUT_OF_RESOURCES;
+    goto ON_EXIT_PATH;
+  }
+
+  Start  = GetPerformanceCounter ();
+  Status = LoadFile->LoadFile (LoadFile, FilePath, TRUE, &BufferSize, Buffer);
+  End    = GetPerformanceCounter ();
+  if (EFI_ERROR (Status)) {
+    Print (L"HttpBootBenchmark: Download failed - %r\n", Status);
+    FreePages (Buffer, EFI_SIZE_TO_PAGES (BufferSize));
+    goto ON_EXIT_PATH;
+  }
+
+  Elapsed = BenchmarkElapsedNanoSecond (Start, End);
+  UnicodeSPrint (Label, sizeof (Label), L"Downloaded %d bytes in %ld us,", BufferSize, DivU64x32 (Elapsed, 1000));
+  BenchmarkPrintThroughput (Label, BufferSize, Elapsed);
+
+  //
+  // A RAM disk image has been registered by HttpBootDxe and now owns the
+  // buffer, any other file is only needed for the measurement.
+  //
+  if (Status != EFI_WARN_FILE_SYSTEM) {
+    FreePages (Buffer, EFI_SIZE_TO_PAGES (BufferSize));
+  }
+  Status = EFI_SUCCESS;
+
+ON_EXIT_PATH:
+  FreePool (FilePath);
+
+ON_EXIT:
+  if (Url != NULL) {
+    FreePool (Url);
+  }
+  return Status;
+}
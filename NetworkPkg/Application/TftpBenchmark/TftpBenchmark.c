@@ -0,0 +1,324 @@
+/** @file
+  A shell application that measures the throughput of MTFTP4 downloads.
+
+  It downloads a file from a TFTP server with several blksize and windowsize
+  combinations and reports the transfer rate of each one in MB/s. The file is
+  normally served from a local TFTP server that implements RFC 7440 (for
+  example "in.tftpd" from tftp-hpa or dnsmasq with --enable-tftp) so that the
+  result reflects the firmware network stack rather than the server or the
+  link. The data is discarded as it arrives, only the packet count is kept.
+
+  Usage: TftpBenchmark ServerIp FileName [WindowSize]
+
+  Without WindowSize the windowsize values 1, 4 and 16 are measured. The
+  network interface must have been configured, e.g. by "ifconfig -s eth0 dhcp".
+
+  Copyright (c) 2026 Baikal Electronics JSC
+  This program and the accompanying materials
+  are licensed and made available under the terms and conditions of the BSD License
+  which accompanies this distribution.  The full text of the license may be found at
+  http://opensource.org/licenses/bsd-license.php
+
+  THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+  WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <Uefi.h>
+#include <Protocol/ServiceBinding.h>
+#include <Protocol/Mtftp4.h>
+#include <Protocol/SimpleNetwork.h>
+#include <Protocol/ShellParameters.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PrintLib.h>
+#include <Library/NetLib.h>
+#include <Library/TimerLib.h>
+#include <Library/BenchmarkLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+#define TFTP_BENCHMARK_DEFAULT_BLKSIZE   512
+#define TFTP_BENCHMARK_HEADER_OVERHEAD   (20 + 8 + 4)
+
+typedef struct {
+  UINT16          BlockSize;
+  UINT16          WindowSize;
+} TFTP_BENCHMARK_RUN;
+
+///
+/// The RFC 1350 baseline, then the MTU sized blksize with growing windows.
+/// A BlockSize of zero stands for the largest one the MTU allows.
+///
+TFTP_BENCHMARK_RUN  mDefaultRuns[] = {
+  { TFTP_BENCHMARK_DEFAULT_BLKSIZE, 1 },
+  { 0,                              1 },
+  { 0,                              4 },
+  { 0,                              16 }
+};
+
+/**
+  Count the payload of each DATA packet, the data itself is not kept.
+
+  @param[in]  This       MTFTP4 protocol interface
+  @param[in]  Token      The token of the download, Context points to the count
+  @param[in]  PacketLen  Length of the packet
+  @param[in]  Packet     Address of the packet
+
+  @retval  EFI_SUCCESS  All packets are accepted.
+
+**/
+EFI_STATUS
+EFIAPI
+TftpBenchmarkCheckPacket (
+  IN EFI_MTFTP4_PROTOCOL  *This,
+  IN EFI_MTFTP4_TOKEN     *Token,
+  IN UINT16               PacketLen,
+  IN EFI_MTFTP4_PACKET    *Packet
+  )
+{
+  if ((NTOHS (Packet->OpCode) == EFI_MTFTP4_OPCODE_DATA) &&
+      (PacketLen > sizeof (Packet->Data.OpCode) + sizeof (Packet->Data.Block))) {
+    *(UINT64 *) Token->Context += PacketLen - sizeof (Packet->Data.OpCode) - sizeof (Packet->Data.Block);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the largest TFTP block size that fits in a single frame of the network
+  interface.
+
+  @param[in]  ControllerHandle  The handle carrying the MTFTP4 service binding.
+
+  @return The block size derived from the MTU, or 512 if it is not known.
+
+**/
+UINT16
+TftpBenchmarkGetBlockSize (
+  IN  EFI_HANDLE                   ControllerHandle
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_SIMPLE_NETWORK_PROTOCOL      *Snp;
+
+  Status = gBS->HandleProtocol (ControllerHandle, &gEfiSimpleNetworkProtocolGuid, (VOID **) &Snp);
+  if (EFI_ERROR (Status) || (Snp->Mode == NULL) ||
+      (Snp->Mode->MaxPacketSize <= TFTP_BENCHMARK_HEADER_OVERHEAD + TFTP_BENCHMARK_DEFAULT_BLKSIZE)) {
+    return TFTP_BENCHMARK_DEFAULT_BLKSIZE;
+  }
+
+  return (UINT16) MIN (Snp->Mode->MaxPacketSize - TFTP_BENCHMARK_HEADER_OVERHEAD, 65464);
+}
+
+/**
+  Download the file once with the given options and print the transfer rate.
+
+  @param[in]  Mtftp4        The configured MTFTP4 instance.
+  @param[in]  FileName      The ASCII name of the file on the server.
+  @param[in]  BlockSize     The blksize option to request.
+  @param[in]  WindowSize    The windowsize option to request.
+
+  @retval EFI_SUCCESS       The file was downloaded.
+  @retval other             The download failed.
+
+**/
+EFI_STATUS
+TftpBenchmarkRun (
+  IN EFI_MTFTP4_PROTOCOL           *Mtftp4,
+  IN CHAR8                         *FileName,
+  IN UINT16                        BlockSize,
+  IN UINT16                        WindowSize
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_MTFTP4_TOKEN                 Token;
+  EFI_MTFTP4_OPTION                ReqOpt[2];
+  UINT8                            BlkSizeBuf[8];
+  UINT8                            WindowSizeBuf[8];
+  UINT64                           Received;
+  UINT64                           Start;
+  UINT64                           End;
+  UINT64                           Elapsed;
+  CHAR16                           Label[80];
+
+  AsciiSPrint ((CHAR8 *) BlkSizeBuf, sizeof (BlkSizeBuf), "%d", BlockSize);
+  AsciiSPrint ((CHAR8 *) WindowSizeBuf, sizeof (WindowSizeBuf), "%d", WindowSize);
+  ReqOpt[0].OptionStr = (UINT8 *) "blksize";
+  ReqOpt[0].ValueStr  = BlkSizeBuf;
+  ReqOpt[1].OptionStr = (UINT8 *) "windowsize";
+  ReqOpt[1].ValueStr  = WindowSizeBuf;
+
+  //
+  // No buffer is given, MTFTP4 then only hands the packets to CheckPacket.
+  //
+  Received = 0;
+  ZeroMem (&Token, sizeof (Token));
+  Token.Filename    = (UINT8 *) FileName;
+  Token.OptionCount = (WindowSize > 1) ? 2 : 1;
+  Token.OptionList  = ReqOpt;
+  Token.CheckPacket = TftpBenchmarkCheckPacket;
+  Token.Context     = &Received;
+
+  Start  = GetPerformanceCounter ();
+  Status = Mtftp4->ReadFile (Mtftp4, &Token);
+  End    = GetPerformanceCounter ();
+  if (EFI_ERROR (Status)) {
+    Print (L"blksize %5d windowsize %5d: download failed - %r\n", BlockSize, WindowSize, Status);
+    return Status;
+  }
+
+  Elapsed = BenchmarkElapsedNanoSecond (Start, End);
+  UnicodeSPrint (
+    Label,
+    sizeof (Label),
+    L"blksize %5d windowsize %5d: %ld bytes in %ld us,",
+    BlockSize,
+    WindowSize,
+    Received,
+    DivU64x32 (Elapsed, 1000)
+    );
+  BenchmarkPrintThroughput (Label, Received, Elapsed);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the application.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_SHELL_PARAMETERS_PROTOCOL  *ShellParameters;
+  EFI_MTFTP4_CONFIG_DATA         ConfigData;
+  EFI_MTFTP4_PROTOCOL            *Mtftp4;
+  EFI_HANDLE                     *Handles;
+  UINTN                          HandleCount;
+  EFI_HANDLE                     ChildHandle;
+  CHAR8                          *FileName;
+  UINTN                          FileNameSize;
+  UINT16                         MtuBlockSize;
+  UINTN                          WindowSize;
+  TFTP_BENCHMARK_RUN             Runs[2];
+  TFTP_BENCHMARK_RUN             *RunList;
+  UINTN                          RunCount;
+  UINTN                          Index;
+
+  Status = gBS->HandleProtocol (ImageHandle, &gEfiShellParametersProtocolGuid, (VOID **) &ShellParameters);
+  if (EFI_ERROR (Status) || ShellParameters->Argc < 3) {
+    Print (L"Usage: TftpBenchmark ServerIp FileName [WindowSize]\n");
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ZeroMem (&ConfigData, sizeof (ConfigData));
+  ConfigData.UseDefaultSetting = TRUE;
+  ConfigData.InitialServerPort = 69;
+  ConfigData.TryCount          = 6;
+  ConfigData.TimeoutValue      = 4;
+  Status = NetLibStrToIp4 (ShellParameters->Argv[1], &ConfigData.ServerIp);
+  if (EFI_ERROR (Status)) {
+    Print (L"TftpBenchmark: Invalid server address '%s'\n", ShellParameters->Argv[1]);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  RunList  = mDefaultRuns;
+  RunCount = ARRAY_SIZE (mDefaultRuns);
+  if (ShellParameters->Argc > 3) {
+    WindowSize = StrDecimalToUintn (ShellParameters->Argv[3]);
+    if ((WindowSize == 0) || (WindowSize > 65535)) {
+      Print (L"TftpBenchmark: Invalid window size '%s'\n", ShellParameters->Argv[3]);
+      return EFI_INVALID_PARAMETER;
+    }
+    Runs[0].BlockSize  = 0;
+    Runs[0].WindowSize = 1;
+    Runs[1].BlockSize  = 0;
+    Runs[1].WindowSize = (UINT16) WindowSize;
+    RunList  = Runs;
+    RunCount = ARRAY_SIZE (Runs);
+  }
+
+  FileNameSize = StrLen (ShellParameters->Argv[2]) + 1;
+  FileName     = AllocatePool (FileNameSize);
+  if (FileName == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  UnicodeStrToAsciiStrS (ShellParameters->Argv[2], FileName, FileNameSize);
+
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiMtftp4ServiceBindingProtocolGuid,
+                  NULL,
+                  &HandleCount,
+                  &Handles
+                  );
+  if (EFI_ERROR (Status) || (HandleCount == 0)) {
+    Print (L"TftpBenchmark: No MTFTP4 capable network interface found\n");
+    Status = EFI_NOT_FOUND;
+    goto ON_EXIT;
+  }
+
+  ChildHandle = NULL;
+  Status = NetLibCreateServiceChild (
+             Handles[0],
+             ImageHandle,
+             &gEfiMtftp4ServiceBindingProtocolGuid,
+             &ChildHandle
+             );
+  if (EFI_ERROR (Status)) {
+    goto ON_EXIT_HANDLES;
+  }
+
+  Status = gBS->HandleProtocol (ChildHandle, &gEfiMtftp4ProtocolGuid, (VOID **) &Mtftp4);
+  if (!EFI_ERROR (Status)) {
+    Status = Mtftp4->Configure (Mtftp4, &ConfigData);
+  }
+  if (EFI_ERROR (Status)) {
+    Print (L"TftpBenchmark: Unable to configure MTFTP4 - %r\n", Status);
+    goto ON_EXIT_CHILD;
+  }
+
+  MtuBlockSize = TftpBenchmarkGetBlockSize (Handles[0]);
+  for (Index = 0; Index < RunCount; Index++) {
+    Status = TftpBenchmarkRun (
+               Mtftp4,
+               FileName,
+               (RunList[Index].BlockSize == 0) ? MtuBlockSize : RunList[Index].BlockSize,
+               RunList[Index].WindowSize
+               );
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  Mtftp4->Configure (Mtftp4, NULL);
+
+ON_EXIT_CHILD:
+  NetLibDestroyServiceChild (
+    Handles[0],
+    ImageHandle,
+    &gEfiMtftp4ServiceBindingProtocolGuid,
+    ChildHandle
+    );
+
+ON_EXIT_HANDLES:
+  FreePool (Handles);
+
+ON_EXIT:
+  FreePool (FileName);
+  return Status;
+}
@@ -70,6 +70,10 @@ DnsDestroyInstance (
   if (Instance->UdpIo!= NULL) {
     UdpIoFreeIo (Instance->UdpIo);
   }
+
+  if (Instance->DnsServerList != NULL) {
+    FreePool (Instance->DnsServerList);
+  }
   
   FreePool (Instance);
 }
@@ -352,11 +356,13 @@ DnsUnload (
   DNS4_SERVER_IP                  *ItemServerIp4;
   DNS6_CACHE                      *ItemCache6;
   DNS6_SERVER_IP                  *ItemServerIp6;
+  DNS_NEGATIVE_CACHE              *ItemNegative;
 
   ItemCache4    = NULL;
   ItemServerIp4 = NULL;
   ItemCache6    = NULL;
   ItemServerIp6 = NULL;
+  ItemNegative  = NULL;
   
   //
   // Disconnect the driver specified by ImageHandle
@@ -409,6 +415,18 @@ DnsUnload (
       ItemServerIp6 = NET_LIST_USER_STRUCT (Entry, DNS6_SERVER_IP, AllServerLink);
       FreePool (ItemServerIp6);
     }
+
+    while (!IsListEmpty (&mDriverData->Dns4NegativeCacheList)) {
+      Entry = NetListRemoveHead (&mDriverData->Dns4NegativeCacheList);
+      ItemNegative = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+      FreeDnsNegativeCache (ItemNegative);
+    }
+
+    while (!IsListEmpty (&mDriverData->Dns6NegativeCacheList)) {
+      Entry = NetListRemoveHead (&mDriverData->Dns6NegativeCacheList);
+      ItemNegative = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+      FreeDnsNegativeCache (ItemNegative);
+    }
     
     FreePool (mDriverData);
   }
@@ -497,8 +515,10 @@ DnsDriverEntryPoint (
   }
 
   InitializeListHead (&mDriverData->Dns4CacheList);
+  InitializeListHead (&mDriverData->Dns4NegativeCacheList);
   InitializeListHead (&mDriverData->Dns4ServerList);
   InitializeListHead (&mDriverData->Dns6CacheList);
+  InitializeListHead (&mDriverData->Dns6NegativeCacheList);
   InitializeListHead (&mDriverData->Dns6ServerList);
   
   return Status;
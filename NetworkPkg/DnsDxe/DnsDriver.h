@@ -41,9 +41,11 @@ struct _DNS_DRIVER_DATA {
   EFI_EVENT                     Timer; /// Ticking timer for DNS cache update.
   
   LIST_ENTRY                    Dns4CacheList;
+  LIST_ENTRY                    Dns4NegativeCacheList;
   LIST_ENTRY                    Dns4ServerList;
 
   LIST_ENTRY                    Dns6CacheList;
+  LIST_ENTRY                    Dns6NegativeCacheList;
   LIST_ENTRY                    Dns6ServerList;
 };
 
@@ -84,7 +86,8 @@ struct _DNS_INSTANCE {
   EFI_DNS4_CONFIG_DATA          Dns4CfgData;
   EFI_DNS6_CONFIG_DATA          Dns6CfgData;
 
-  EFI_IP_ADDRESS                SessionDnsServer;
+  UINTN                         DnsServerCount;
+  EFI_IP_ADDRESS                *DnsServerList; /// Every query is sent to all of them.
 
   NET_MAP                       Dns4TxTokens;
   NET_MAP                       Dns6TxTokens;
@@ -692,7 +692,12 @@ Dns4ConfigUdp (
   UdpConfig.RemotePort         = DNS_SERVER_PORT;
 
   CopyMem (&UdpConfig.StationAddress, &Config->StationIp, sizeof (EFI_IPv4_ADDRESS));
-  CopyMem (&UdpConfig.RemoteAddress, &Instance->SessionDnsServer.v4, sizeof (EFI_IPv4_ADDRESS));
+
+  //
+  // Leave the remote address open, every query is sent to all the DNS
+  // servers of the instance and the first valid answer is taken.
+  //
+  ZeroMem (&UdpConfig.RemoteAddress, sizeof (EFI_IPv4_ADDRESS));
 
   Status = UdpIo->Protocol.Udp4->Configure (UdpIo->Protocol.Udp4, &UdpConfig);
 
@@ -735,7 +740,12 @@ Dns6ConfigUdp (
   UdpConfig.StationPort        = Config->LocalPort;
   UdpConfig.RemotePort         = DNS_SERVER_PORT;
   CopyMem (&UdpConfig.StationAddress, &Config->StationIp, sizeof (EFI_IPv6_ADDRESS));
-  CopyMem (&UdpConfig.RemoteAddress, &Instance->SessionDnsServer.v6, sizeof (EFI_IPv6_ADDRESS));
+
+  //
+  // Leave the remote address open, every query is sent to all the DNS
+  // servers of the instance and the first valid answer is taken.
+  //
+  ZeroMem (&UdpConfig.RemoteAddress, sizeof (EFI_IPv6_ADDRESS));
 
   Status = UdpIo->Protocol.Udp6->Configure (UdpIo->Protocol.Udp6, &UdpConfig);
 
@@ -929,6 +939,139 @@ UpdateDns6Cache (
   return EFI_SUCCESS;
 }
 
+/**
+  Check whether a negative cache entry is for a host name looked up with the
+  DNS server list of an instance.
+
+  @param  Item               The negative cache entry.
+  @param  Instance           The DNS instance.
+  @param  HostName           The host name.
+
+  @retval TRUE               The entry matches.
+  @retval FALSE              The entry doesn't match.
+
+**/
+BOOLEAN
+IsDnsNegativeCacheMatch (
+  IN DNS_NEGATIVE_CACHE     *Item,
+  IN DNS_INSTANCE           *Instance,
+  IN CHAR16                 *HostName
+  )
+{
+  return (BOOLEAN) (Item->DnsServerCount == Instance->DnsServerCount &&
+                    CompareMem (Item->DnsServerList, Instance->DnsServerList, Item->DnsServerCount * sizeof (EFI_IP_ADDRESS)) == 0 &&
+                    StrCmp (HostName, Item->HostName) == 0);
+}
+
+/**
+  Add a failed host name lookup of an instance to a shared negative cache, or
+  restart the timeout of the existing entry.
+
+  @param  NegativeCacheList  Dns4 or Dns6 negative cache list.
+  @param  Instance           The DNS instance the lookup was done by.
+  @param  HostName           The host name that failed to resolve.
+  @param  FailStatus         The status the lookup completed with.
+
+  @retval EFI_SUCCESS            The negative cache is updated.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate the entry.
+
+**/
+EFI_STATUS
+UpdateDnsNegativeCache (
+  IN LIST_ENTRY             *NegativeCacheList,
+  IN DNS_INSTANCE           *Instance,
+  IN CHAR16                 *HostName,
+  IN EFI_STATUS             FailStatus
+  )
+{
+  DNS_NEGATIVE_CACHE        *Item;
+  LIST_ENTRY                *Entry;
+
+  NET_LIST_FOR_EACH (Entry, NegativeCacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+    if (IsDnsNegativeCacheMatch (Item, Instance, HostName)) {
+      Item->Timeout = DNS_NEGATIVE_CACHE_TIMEOUT;
+      Item->Status  = FailStatus;
+      return EFI_SUCCESS;
+    }
+  }
+
+  Item = AllocateZeroPool (sizeof (DNS_NEGATIVE_CACHE));
+  if (Item == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Item->HostName      = AllocateCopyPool (StrSize (HostName), HostName);
+  Item->DnsServerList = AllocateCopyPool (Instance->DnsServerCount * sizeof (EFI_IP_ADDRESS), Instance->DnsServerList);
+  if (Item->HostName == NULL || Item->DnsServerList == NULL) {
+    FreeDnsNegativeCache (Item);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Item->DnsServerCount = Instance->DnsServerCount;
+  Item->Timeout        = DNS_NEGATIVE_CACHE_TIMEOUT;
+  Item->Status         = FailStatus;
+
+  InsertTailList (NegativeCacheList, &Item->AllCacheLink);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Look a host name up in a shared negative cache, among the lookups done with
+  the same DNS server list as the instance.
+
+  @param  NegativeCacheList  Dns4 or Dns6 negative cache list.
+  @param  Instance           The DNS instance to look the host name up for.
+  @param  HostName           The host name to look up.
+  @param  FailStatus         The status the cached lookup completed with.
+
+  @retval TRUE               The host name recently failed to resolve.
+  @retval FALSE              The host name is not in the negative cache.
+
+**/
+BOOLEAN
+GetDnsNegativeCache (
+  IN     LIST_ENTRY         *NegativeCacheList,
+  IN     DNS_INSTANCE       *Instance,
+  IN     CHAR16             *HostName,
+     OUT EFI_STATUS         *FailStatus
+  )
+{
+  DNS_NEGATIVE_CACHE        *Item;
+  LIST_ENTRY                *Entry;
+
+  NET_LIST_FOR_EACH (Entry, NegativeCacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+    if (IsDnsNegativeCacheMatch (Item, Instance, HostName)) {
+      *FailStatus = Item->Status;
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Free an entry of a negative cache.
+
+  @param  Item               The entry to free.
+
+**/
+VOID
+FreeDnsNegativeCache (
+  IN DNS_NEGATIVE_CACHE     *Item
+  )
+{
+  if (Item->HostName != NULL) {
+    FreePool (Item->HostName);
+  }
+  if (Item->DnsServerList != NULL) {
+    FreePool (Item->DnsServerList);
+  }
+  FreePool (Item);
+}
+
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server. 
 
@@ -1039,6 +1182,121 @@ AddDns6ServerIp (
   return EFI_SUCCESS;
 }
 
+/**
+  Set the DNS servers an instance sends its queries to.
+
+  @param  Instance          The DNS instance.
+  @param  ServerCount       Number of servers in ServerList.
+  @param  ServerList        EFI_IPv4_ADDRESS or EFI_IPv6_ADDRESS list of the
+                            servers, depending on the IP version of the instance.
+
+  @retval EFI_SUCCESS           The server list is set.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the server list.
+
+**/
+EFI_STATUS
+DnsSetServerList (
+  IN OUT DNS_INSTANCE          *Instance,
+  IN     UINTN                 ServerCount,
+  IN     VOID                  *ServerList
+  )
+{
+  EFI_IP_ADDRESS               *List;
+  UINTN                        Index;
+
+  ASSERT (ServerCount != 0 && ServerList != NULL);
+
+  //
+  // The servers a query failed on are tracked in a bit mask, ignore the servers
+  // it can't hold.
+  //
+  ServerCount = MIN (ServerCount, DNS_MAX_SERVER_COUNT);
+
+  List = AllocateZeroPool (ServerCount * sizeof (EFI_IP_ADDRESS));
+  if (List == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  for (Index = 0; Index < ServerCount; Index++) {
+    if (Instance->Service->IpVersion == IP_VERSION_4) {
+      IP4_COPY_ADDRESS (&List[Index].v4, (EFI_IPv4_ADDRESS *) ServerList + Index);
+    } else {
+      IP6_COPY_ADDRESS (&List[Index].v6, (EFI_IPv6_ADDRESS *) ServerList + Index);
+    }
+  }
+
+  if (Instance->DnsServerList != NULL) {
+    FreePool (Instance->DnsServerList);
+  }
+
+  Instance->DnsServerCount = ServerCount;
+  Instance->DnsServerList  = List;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Fill in the UDP access point of one of the DNS servers of an instance.
+
+  @param  Instance          The DNS instance.
+  @param  Index             Index of the server in the server list.
+  @param  EndPoint          The UDP access point to fill in.
+
+**/
+VOID
+DnsGetServerEndPoint (
+  IN     DNS_INSTANCE          *Instance,
+  IN     UINTN                 Index,
+     OUT UDP_END_POINT         *EndPoint
+  )
+{
+  //
+  // UdpIo takes the addresses of the access point in host byte order.
+  //
+  ZeroMem (EndPoint, sizeof (UDP_END_POINT));
+  EndPoint->RemotePort = DNS_SERVER_PORT;
+
+  if (Instance->Service->IpVersion == IP_VERSION_4) {
+    EndPoint->RemoteAddr.Addr[0] = NTOHL (EFI_IP4 (Instance->DnsServerList[Index].v4));
+  } else {
+    IP6_COPY_ADDRESS (&EndPoint->RemoteAddr.v6, &Instance->DnsServerList[Index].v6);
+    Ip6Swap128 (&EndPoint->RemoteAddr.v6);
+  }
+}
+
+/**
+  Check whether a packet came from one of the DNS servers of an instance.
+
+  @param  Instance          The DNS instance.
+  @param  EndPoint          The UDP access point the packet was received on.
+  @param  ServerIndex       Index of the server in the server list.
+
+  @retval TRUE              The packet came from a server of the instance.
+  @retval FALSE             The packet came from somewhere else.
+
+**/
+BOOLEAN
+IsDnsServer (
+  IN     DNS_INSTANCE          *Instance,
+  IN     UDP_END_POINT         *EndPoint,
+     OUT UINTN                 *ServerIndex
+  )
+{
+  UDP_END_POINT                Server;
+  UINTN                        Index;
+
+  for (Index = 0; Index < Instance->DnsServerCount; Index++) {
+    DnsGetServerEndPoint (Instance, Index, &Server);
+    if (EndPoint->RemotePort == Server.RemotePort &&
+        CompareMem (&EndPoint->RemoteAddr, &Server.RemoteAddr, sizeof (EFI_IP_ADDRESS)) == 0) {
+      *ServerIndex = Index;
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
 /**
   Find out whether the response is valid or invalid.
 
@@ -1100,6 +1358,7 @@ IsValidDnsResponse (
 
   @param  Instance              The DNS instance
   @param  RxString              Received buffer.
+  @param  ServerIndex           Index of the DNS server the response came from.
   @param  Completed             Flag to indicate that Dns response is valid. 
   
   @retval EFI_SUCCESS           Parse Dns Response successfully.
@@ -1110,6 +1369,7 @@ EFI_STATUS
 ParseDnsResponse (
   IN OUT DNS_INSTANCE              *Instance,
   IN     UINT8                     *RxString,
+  IN     UINTN                     ServerIndex,
      OUT BOOLEAN                   *Completed
   )
 {
@@ -1130,6 +1390,7 @@ ParseDnsResponse (
   UINT32                RRCount;
   UINT32                AnswerSectionNum;
   UINT32                CNameTtl;
+  UINT32                AllServers;
   
   EFI_IPv4_ADDRESS      *HostAddr4;
   EFI_IPv6_ADDRESS      *HostAddr6;
@@ -1241,6 +1502,27 @@ ParseDnsResponse (
       Status = EFI_NOT_FOUND; 
     } else {
       Status = EFI_DEVICE_ERROR;
+
+      //
+      // The query went to all the servers, one of them failing doesn't mean
+      // another one can't answer. Wait for the others unless all of them
+      // have failed. A server that sends its error again, e.g. for a
+      // retransmitted query, is only counted once.
+      //
+      AllServers = (UINT32) (LShiftU64 (1, Instance->DnsServerCount) - 1);
+      if (Instance->Service->IpVersion == IP_VERSION_4) {
+        Dns4TokenEntry->FailedServers |= (UINT32) LShiftU64 (1, ServerIndex);
+        if (Dns4TokenEntry->FailedServers != AllServers) {
+          *Completed = FALSE;
+          goto ON_EXIT;
+        }
+      } else {
+        Dns6TokenEntry->FailedServers |= (UINT32) LShiftU64 (1, ServerIndex);
+        if (Dns6TokenEntry->FailedServers != AllServers) {
+          *Completed = FALSE;
+          goto ON_EXIT;
+        }
+      }
     }
     
     goto ON_COMPLETE;
@@ -1586,6 +1868,10 @@ ON_COMPLETE:
   
   if (Instance->Service->IpVersion == IP_VERSION_4) {
     ASSERT (Dns4TokenEntry != NULL);
+    if (Status == EFI_NOT_FOUND && !Dns4TokenEntry->GeneralLookUp && Instance->Dns4CfgData.EnableDnsCache) {
+      UpdateDnsNegativeCache (&mDriverData->Dns4NegativeCacheList, Instance, Dns4TokenEntry->QueryHostName, Status);
+    }
+
     Dns4RemoveTokenEntry (&Instance->Dns4TxTokens, Dns4TokenEntry);
     Dns4TokenEntry->Token->Status = Status;
     if (Dns4TokenEntry->Token->Event != NULL) {
@@ -1594,6 +1880,10 @@ ON_COMPLETE:
     }
   } else {
     ASSERT (Dns6TokenEntry != NULL);
+    if (Status == EFI_NOT_FOUND && !Dns6TokenEntry->GeneralLookUp && Instance->Dns6CfgData.EnableDnsCache) {
+      UpdateDnsNegativeCache (&mDriverData->Dns6NegativeCacheList, Instance, Dns6TokenEntry->QueryHostName, Status);
+    }
+
     Dns6RemoveTokenEntry (&Instance->Dns6TxTokens, Dns6TokenEntry);
     Dns6TokenEntry->Token->Status = Status;
     if (Dns6TokenEntry->Token->Event != NULL) {
@@ -1630,6 +1920,7 @@ DnsOnPacketReceived (
   UINT8                     *RcvString;
 
   BOOLEAN                   Completed;
+  UINTN                     ServerIndex;
   
   Instance  = (DNS_INSTANCE *) Context;
   NET_CHECK_SIGNATURE (Instance, DNS_INSTANCE_SIGNATURE);
@@ -1646,6 +1937,14 @@ DnsOnPacketReceived (
   if (Packet->TotalSize <= sizeof (DNS_HEADER)) {
     goto ON_EXIT;
   }
+
+  //
+  // The UDP child isn't connected, drop whatever doesn't come from one of
+  // the DNS servers.
+  //
+  if (!IsDnsServer (Instance, EndPoint, &ServerIndex)) {
+    goto ON_EXIT;
+  }
   
   RcvString = NetbufGetByte (Packet, 0, NULL);
   ASSERT (RcvString != NULL);
@@ -1653,7 +1952,7 @@ DnsOnPacketReceived (
   //
   // Parse Dns Response
   //
-  ParseDnsResponse (Instance, RcvString, &Completed);
+  ParseDnsResponse (Instance, RcvString, ServerIndex, &Completed);
 
 ON_EXIT:
 
@@ -1661,7 +1960,12 @@ ON_EXIT:
     NetbufFree (Packet);
   }
 
-  if (!Completed) {
+  //
+  // Keep receiving while there are queries waiting for an answer.
+  //
+  if (!Completed ||
+      !NetMapIsEmpty (&Instance->Dns4TxTokens) ||
+      !NetMapIsEmpty (&Instance->Dns6TxTokens)) {
     UdpIoRecvDatagram (Instance->UdpIo, DnsOnPacketReceived, Instance, 0);
   }
 }
@@ -1750,11 +2054,7 @@ DoDnsQuery (
   //
   // Transmit the DNS packet.
   //
-  NET_GET_REF (Packet);
-
-  Status = UdpIoSendDatagram (Instance->UdpIo, Packet, NULL, NULL, DnsOnPacketSent, Instance);
-  
-  return Status;
+  return DnsRetransmit (Instance, Packet);
 }
 
 /**
@@ -1851,12 +2151,12 @@ ConstructDNSQuery (
 }
 
 /**
-  Retransmit the packet.
+  Retransmit the packet to all the DNS servers of the instance.
 
   @param  Instance              The DNS instance
   @param  Packet                Retransmit the packet 
 
-  @retval EFI_SUCCESS           The packet is retransmitted.
+  @retval EFI_SUCCESS           The packet is retransmitted to at least one server.
   @retval Others                Failed to retransmit.
 
 **/
@@ -1867,30 +2167,36 @@ DnsRetransmit (
   )
 {
   EFI_STATUS      Status;
-  
-  UINT8           *Buffer;
+  EFI_STATUS      SendStatus;
+  UDP_END_POINT   EndPoint;
+  UINTN           Index;
 
   ASSERT (Packet != NULL);
 
-  //
-  // Set the requests to the listening port, other packets to the connected port
-  //
-  Buffer = NetbufGetByte (Packet, 0, NULL);
-  ASSERT (Buffer != NULL);
+  Status = EFI_NOT_FOUND;
 
-  NET_GET_REF (Packet);
+  for (Index = 0; Index < Instance->DnsServerCount; Index++) {
+    DnsGetServerEndPoint (Instance, Index, &EndPoint);
 
-  Status = UdpIoSendDatagram (
-             Instance->UdpIo,
-             Packet,
-             NULL,
-             NULL,
-             DnsOnPacketSent,
-             Instance
-             );
+    NET_GET_REF (Packet);
 
-  if (EFI_ERROR (Status)) {
-    NET_PUT_REF (Packet);
+    SendStatus = UdpIoSendDatagram (
+                   Instance->UdpIo,
+                   Packet,
+                   &EndPoint,
+                   NULL,
+                   DnsOnPacketSent,
+                   Instance
+                   );
+
+    if (EFI_ERROR (SendStatus)) {
+      NET_PUT_REF (Packet);
+      if (EFI_ERROR (Status)) {
+        Status = SendStatus;
+      }
+    } else {
+      Status = EFI_SUCCESS;
+    }
   }
 
   return Status;
@@ -1955,6 +2261,10 @@ DnsOnTimerRetransmit (
           //
           // Maximum retries reached, clean the Token up.
           //
+          if (!Dns4TokenEntry->GeneralLookUp && Instance->Dns4CfgData.EnableDnsCache) {
+            UpdateDnsNegativeCache (&mDriverData->Dns4NegativeCacheList, Instance, Dns4TokenEntry->QueryHostName, EFI_TIMEOUT);
+          }
+
           Dns4RemoveTokenEntry (&Instance->Dns4TxTokens, Dns4TokenEntry);
           Dns4TokenEntry->Token->Status = EFI_TIMEOUT;
           gBS->SignalEvent (Dns4TokenEntry->Token->Event);
@@ -1999,6 +2309,10 @@ DnsOnTimerRetransmit (
           //
           // Maximum retries reached, clean the Token up.
           //
+          if (!Dns6TokenEntry->GeneralLookUp && Instance->Dns6CfgData.EnableDnsCache) {
+            UpdateDnsNegativeCache (&mDriverData->Dns6NegativeCacheList, Instance, Dns6TokenEntry->QueryHostName, EFI_TIMEOUT);
+          }
+
           Dns6RemoveTokenEntry (&Instance->Dns6TxTokens, Dns6TokenEntry);
           Dns6TokenEntry->Token->Status = EFI_TIMEOUT;
           gBS->SignalEvent (Dns6TokenEntry->Token->Event);
@@ -2036,6 +2350,7 @@ DnsOnTimerUpdate (
   LIST_ENTRY                 *Next;
   DNS4_CACHE                 *Item4;
   DNS6_CACHE                 *Item6;
+  DNS_NEGATIVE_CACHE         *NegativeItem;
 
   Item4 = NULL;
   Item6 = NULL;
@@ -2077,5 +2392,24 @@ DnsOnTimerUpdate (
       Entry = Entry->ForwardLink;
     }
   }
+
+  //
+  // Age the negative caches, failed lookups are only remembered briefly.
+  //
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns4NegativeCacheList) {
+    NegativeItem = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+    if (--NegativeItem->Timeout == 0) {
+      RemoveEntryList (&NegativeItem->AllCacheLink);
+      FreeDnsNegativeCache (NegativeItem);
+    }
+  }
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &mDriverData->Dns6NegativeCacheList) {
+    NegativeItem = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+    if (--NegativeItem->Timeout == 0) {
+      RemoveEntryList (&NegativeItem->AllCacheLink);
+      FreeDnsNegativeCache (NegativeItem);
+    }
+  }
 }
 
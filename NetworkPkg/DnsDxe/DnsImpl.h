@@ -90,6 +90,18 @@ extern EFI_DNS6_PROTOCOL             mDns6Protocol;
 
 #define DNS_TIME_TO_GETMAP       5
 
+//
+// Seconds a failed host name lookup, either a name error or a timeout, is
+// remembered so that retries don't wait for the servers again.
+//
+#define DNS_NEGATIVE_CACHE_TIMEOUT  10
+
+//
+// Maximum number of DNS servers an instance sends its queries to. The failed
+// servers of a query are tracked in a UINT32 bit mask.
+//
+#define DNS_MAX_SERVER_COUNT        32
+
 #pragma pack(1)
 
 typedef union _DNS_FLAGS  DNS_FLAGS;
@@ -104,6 +116,18 @@ typedef struct {
   EFI_DNS6_CACHE_ENTRY   DnsCache;     
 } DNS6_CACHE;
 
+//
+// A failed lookup is only valid for the DNS server list it was sent to.
+//
+typedef struct {
+  LIST_ENTRY             AllCacheLink;
+  CHAR16                 *HostName;
+  UINTN                  DnsServerCount;
+  EFI_IP_ADDRESS         *DnsServerList;
+  UINT32                 Timeout;
+  EFI_STATUS             Status;
+} DNS_NEGATIVE_CACHE;
+
 typedef struct {
   LIST_ENTRY             AllServerLink;
   EFI_IPv4_ADDRESS       Dns4ServerIp;     
@@ -119,6 +143,7 @@ typedef struct {
   CHAR16                     *QueryHostName;
   EFI_IPv4_ADDRESS           QueryIpAddress;
   BOOLEAN                    GeneralLookUp;
+  UINT32                     FailedServers;   ///< Bit N is set once server N answered with an error.
   EFI_DNS4_COMPLETION_TOKEN  *Token;
 } DNS4_TOKEN_ENTRY;
 
@@ -127,6 +152,7 @@ typedef struct {
   CHAR16                     *QueryHostName;
   EFI_IPv6_ADDRESS           QueryIpAddress;
   BOOLEAN                    GeneralLookUp;
+  UINT32                     FailedServers;   ///< Bit N is set once server N answered with an error.
   EFI_DNS6_COMPLETION_TOKEN  *Token;
 } DNS6_TOKEN_ENTRY;
 
@@ -521,6 +547,59 @@ UpdateDns6Cache (
   IN EFI_DNS6_CACHE_ENTRY   DnsCacheEntry
   );
 
+/**
+  Add a failed host name lookup of an instance to a shared negative cache, or
+  restart the timeout of the existing entry.
+
+  @param  NegativeCacheList  Dns4 or Dns6 negative cache list.
+  @param  Instance           The DNS instance the lookup was done by.
+  @param  HostName           The host name that failed to resolve.
+  @param  FailStatus         The status the lookup completed with.
+
+  @retval EFI_SUCCESS            The negative cache is updated.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate the entry.
+
+**/
+EFI_STATUS
+UpdateDnsNegativeCache (
+  IN LIST_ENTRY             *NegativeCacheList,
+  IN DNS_INSTANCE           *Instance,
+  IN CHAR16                 *HostName,
+  IN EFI_STATUS             FailStatus
+  );
+
+/**
+  Look a host name up in a shared negative cache, among the lookups done with
+  the same DNS server list as the instance.
+
+  @param  NegativeCacheList  Dns4 or Dns6 negative cache list.
+  @param  Instance           The DNS instance to look the host name up for.
+  @param  HostName           The host name to look up.
+  @param  FailStatus         The status the cached lookup completed with.
+
+  @retval TRUE               The host name recently failed to resolve.
+  @retval FALSE              The host name is not in the negative cache.
+
+**/
+BOOLEAN
+GetDnsNegativeCache (
+  IN     LIST_ENTRY         *NegativeCacheList,
+  IN     DNS_INSTANCE       *Instance,
+  IN     CHAR16             *HostName,
+     OUT EFI_STATUS         *FailStatus
+  );
+
+/**
+  Free an entry of a negative cache.
+
+  @param  Item               The entry to free.
+
+**/
+VOID
+FreeDnsNegativeCache (
+  IN DNS_NEGATIVE_CACHE     *Item
+  );
+
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server. 
 
@@ -555,6 +634,58 @@ AddDns6ServerIp (
   IN EFI_IPv6_ADDRESS           ServerIp
   );
 
+/**
+  Set the DNS servers an instance sends its queries to.
+
+  @param  Instance          The DNS instance.
+  @param  ServerCount       Number of servers in ServerList.
+  @param  ServerList        EFI_IPv4_ADDRESS or EFI_IPv6_ADDRESS list of the
+                            servers, depending on the IP version of the instance.
+
+  @retval EFI_SUCCESS           The server list is set.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the server list.
+
+**/
+EFI_STATUS
+DnsSetServerList (
+  IN OUT DNS_INSTANCE          *Instance,
+  IN     UINTN                 ServerCount,
+  IN     VOID                  *ServerList
+  );
+
+/**
+  Fill in the UDP access point of one of the DNS servers of an instance.
+
+  @param  Instance          The DNS instance.
+  @param  Index             Index of the server in the server list.
+  @param  EndPoint          The UDP access point to fill in.
+
+**/
+VOID
+DnsGetServerEndPoint (
+  IN     DNS_INSTANCE          *Instance,
+  IN     UINTN                 Index,
+     OUT UDP_END_POINT         *EndPoint
+  );
+
+/**
+  Check whether a packet came from one of the DNS servers of an instance.
+
+  @param  Instance          The DNS instance.
+  @param  EndPoint          The UDP access point the packet was received on.
+  @param  ServerIndex       Index of the server in the server list.
+
+  @retval TRUE              The packet came from a server of the instance.
+  @retval FALSE             The packet came from somewhere else.
+
+**/
+BOOLEAN
+IsDnsServer (
+  IN     DNS_INSTANCE          *Instance,
+  IN     UDP_END_POINT         *EndPoint,
+     OUT UINTN                 *ServerIndex
+  );
+
 /**
   Find out whether the response is valid or invalid.
 
@@ -582,6 +713,7 @@ IsValidDnsResponse (
 
   @param  Instance              The DNS instance
   @param  RxString              Received buffer.
+  @param  ServerIndex           Index of the DNS server the response came from.
   @param  Completed             Flag to indicate that Dns response is valid. 
   
   @retval EFI_SUCCESS           Parse Dns Response successfully.
@@ -592,6 +724,7 @@ EFI_STATUS
 ParseDnsResponse (
   IN OUT DNS_INSTANCE              *Instance,
   IN     UINT8                     *RxString,
+  IN     UINTN                     ServerIndex,
      OUT BOOLEAN                   *Completed
   );
 
@@ -195,6 +195,7 @@ Dns4Configure (
 
   UINT32                    ServerListCount;
   EFI_IPv4_ADDRESS          *ServerList;                  
+  UINTN                     Index;
 
   Status     = EFI_SUCCESS;
   ServerList = NULL;
@@ -214,7 +215,11 @@ Dns4Configure (
   Instance = DNS_INSTANCE_FROM_THIS_PROTOCOL4 (This);
 
   if (DnsConfigData == NULL) {
-    ZeroMem (&Instance->SessionDnsServer, sizeof (EFI_IP_ADDRESS));
+    if (Instance->DnsServerList != NULL) {
+      FreePool (Instance->DnsServerList);
+      Instance->DnsServerList = NULL;
+    }
+    Instance->DnsServerCount = 0;
     
     //
     // Reset the Instance if ConfigData is NULL
@@ -275,15 +280,12 @@ Dns4Configure (
       
       OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
 
-      CopyMem (&Instance->SessionDnsServer.v4, &ServerList[0], sizeof (EFI_IPv4_ADDRESS));
+      Status = DnsSetServerList (Instance, ServerListCount, ServerList);
+      FreePool (ServerList);
     } else {
-      CopyMem (&Instance->SessionDnsServer.v4, &DnsConfigData->DnsServerList[0], sizeof (EFI_IPv4_ADDRESS));
+      Status = DnsSetServerList (Instance, DnsConfigData->DnsServerListCount, DnsConfigData->DnsServerList);
     }
 
-    //
-    // Config UDP
-    //
-    Status = Dns4ConfigUdp (Instance, Instance->UdpIo);
     if (EFI_ERROR (Status)) {
       if (Instance->Dns4CfgData.DnsServerList != NULL) {
         FreePool (Instance->Dns4CfgData.DnsServerList);
@@ -293,9 +295,9 @@ Dns4Configure (
     }
 
     //
-    // Add configured DNS server used by this instance to ServerList.
+    // Config UDP
     //
-    Status = AddDns4ServerIp (&mDriverData->Dns4ServerList, Instance->SessionDnsServer.v4);
+    Status = Dns4ConfigUdp (Instance, Instance->UdpIo);
     if (EFI_ERROR (Status)) {
       if (Instance->Dns4CfgData.DnsServerList != NULL) {
         FreePool (Instance->Dns4CfgData.DnsServerList);
@@ -303,6 +305,20 @@ Dns4Configure (
       }
       goto ON_EXIT;
     }
+
+    //
+    // Add configured DNS servers used by this instance to ServerList.
+    //
+    for (Index = 0; Index < Instance->DnsServerCount; Index++) {
+      Status = AddDns4ServerIp (&mDriverData->Dns4ServerList, Instance->DnsServerList[Index].v4);
+      if (EFI_ERROR (Status)) {
+        if (Instance->Dns4CfgData.DnsServerList != NULL) {
+          FreePool (Instance->Dns4CfgData.DnsServerList);
+          Instance->Dns4CfgData.DnsServerList = NULL;
+        }
+        goto ON_EXIT;
+      }
+    }
     
     Instance->State = DNS_STATE_CONFIGED;
   }
@@ -448,6 +464,19 @@ Dns4HostNameToIp (
       Status = Token->Status;
       goto ON_EXIT;
     } 
+
+    //
+    // The name recently failed to resolve, complete the token with the same
+    // error rather than waiting on the servers again.
+    //
+    if (GetDnsNegativeCache (&mDriverData->Dns4NegativeCacheList, Instance, HostName, &Token->Status)) {
+      if (Token->Event != NULL) {
+        gBS->SignalEvent (Token->Event);
+        DispatchDpc ();
+      }
+
+      goto ON_EXIT;
+    }
   }
 
   //
@@ -1024,6 +1053,7 @@ Dns6Configure (
 
   UINT32                    ServerListCount;
   EFI_IPv6_ADDRESS          *ServerList; 
+  UINTN                     Index;
 
   Status     = EFI_SUCCESS;
   ServerList = NULL;
@@ -1043,7 +1073,11 @@ Dns6Configure (
   Instance = DNS_INSTANCE_FROM_THIS_PROTOCOL6 (This);
 
   if (DnsConfigData == NULL) {
-    ZeroMem (&Instance->SessionDnsServer, sizeof (EFI_IP_ADDRESS));
+    if (Instance->DnsServerList != NULL) {
+      FreePool (Instance->DnsServerList);
+      Instance->DnsServerList = NULL;
+    }
+    Instance->DnsServerCount = 0;
 
     //
     // Reset the Instance if ConfigData is NULL
@@ -1098,9 +1132,18 @@ Dns6Configure (
 
       OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
 
-      CopyMem (&Instance->SessionDnsServer.v6, &ServerList[0], sizeof (EFI_IPv6_ADDRESS));
+      Status = DnsSetServerList (Instance, ServerListCount, ServerList);
+      FreePool (ServerList);
     } else {
-      CopyMem (&Instance->SessionDnsServer.v6, &DnsConfigData->DnsServerList[0], sizeof (EFI_IPv6_ADDRESS));
+      Status = DnsSetServerList (Instance, DnsConfigData->DnsServerCount, DnsConfigData->DnsServerList);
+    }
+
+    if (EFI_ERROR (Status)) {
+      if (Instance->Dns6CfgData.DnsServerList != NULL) {
+        FreePool (Instance->Dns6CfgData.DnsServerList);
+        Instance->Dns6CfgData.DnsServerList = NULL;
+      }
+      goto ON_EXIT;
     }
 
     //
@@ -1118,15 +1161,17 @@ Dns6Configure (
     }
 
     //
-    // Add configured DNS server used by this instance to ServerList.
+    // Add configured DNS servers used by this instance to ServerList.
     //
-    Status = AddDns6ServerIp (&mDriverData->Dns6ServerList, Instance->SessionDnsServer.v6);
-    if (EFI_ERROR (Status)) {
-      if (Instance->Dns6CfgData.DnsServerList != NULL) {
-        FreePool (Instance->Dns6CfgData.DnsServerList);
-        Instance->Dns6CfgData.DnsServerList = NULL;
+    for (Index = 0; Index < Instance->DnsServerCount; Index++) {
+      Status = AddDns6ServerIp (&mDriverData->Dns6ServerList, Instance->DnsServerList[Index].v6);
+      if (EFI_ERROR (Status)) {
+        if (Instance->Dns6CfgData.DnsServerList != NULL) {
+          FreePool (Instance->Dns6CfgData.DnsServerList);
+          Instance->Dns6CfgData.DnsServerList = NULL;
+        }
+        goto ON_EXIT;
       }
-      goto ON_EXIT;
     }
     
     Instance->State = DNS_STATE_CONFIGED;
@@ -1275,6 +1320,19 @@ Dns6HostNameToIp (
       Status = Token->Status;
       goto ON_EXIT;
     } 
+
+    //
+    // The name recently failed to resolve, complete the token with the same
+    // error rather than waiting on the servers again.
+    //
+    if (GetDnsNegativeCache (&mDriverData->Dns6NegativeCacheList, Instance, HostName, &Token->Status)) {
+      if (Token->Event != NULL) {
+        gBS->SignalEvent (Token->Event);
+        DispatchDpc ();
+      }
+
+      goto ON_EXIT;
+    }
   }
 
   //
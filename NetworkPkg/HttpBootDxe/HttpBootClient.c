@@ -916,6 +916,9 @@ HttpBootGetBootFile (
   CHAR16                     *Url;
   BOOLEAN                    IdentityMode;
   UINTN                      ReceivedSize;
+  UINT8                      *BodyBuffer;
+  UINTN                      BodySize;
+  HTTP_BOOT_ENTITY_DATA      *NewEntityData;
   
   ASSERT (Private != NULL);
   ASSERT (Private->HttpCreated);
@@ -968,12 +971,13 @@ HttpBootGetBootFile (
   //
 
   //
-  // 2.1 Build HTTP header for the request, 3 header is needed to download a boot file:
+  // 2.1 Build HTTP header for the request, 4 header is needed to download a boot file:
   //       Host
   //       Accept
   //       User-Agent
+  //       Connection
   //
-  HttpIoHeader = HttpBootCreateHeader (3);
+  HttpIoHeader = HttpBootCreateHeader (4);
   if (HttpIoHeader == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
     goto ERROR_2;
@@ -1025,6 +1029,22 @@ HttpBootGetBootFile (
     goto ERROR_3;
   }
 
+  //
+  // Add HTTP header field 4: Connection
+  // The size probe (HEAD) and the download (GET) go through the same HTTP
+  // child, ask the server to keep the connection open so that the download
+  // does not pay for another TCP and TLS handshake. HTTP/1.1 servers do so by
+  // default, HTTP/1.0 servers only when asked.
+  //
+  Status = HttpBootSetHeader (
+             HttpIoHeader,
+             HTTP_HEADER_CONNECTION,
+             "keep-alive"
+             );
+  if (EFI_ERROR (Status)) {
+    goto ERROR_3;
+  }
+
   //
   // 2.2 Build the rest of HTTP request info.
   //
@@ -1157,10 +1177,42 @@ HttpBootGetBootFile (
       // In identity transfer-coding there is no need to parse the message body,
       // just download the message body to the user provided buffer directly.
       //
+      BodyBuffer = Buffer;
+      BodySize   = *BufferSize;
+      if (Cache != NULL && ContentLength != 0) {
+        //
+        // The caller doesn't provide a buffer, but the entity length is known,
+        // so allocate a single cache block for the whole message-body up front
+        // and download into it directly too.
+        //
+        NewEntityData = AllocatePool (sizeof (HTTP_BOOT_ENTITY_DATA));
+        if (NewEntityData == NULL) {
+          Status = EFI_OUT_OF_RESOURCES;
+          goto ERROR_6;
+        }
+        NewEntityData->Block = AllocatePool (ContentLength);
+        if (NewEntityData->Block == NULL) {
+          FreePool (NewEntityData);
+          Status = EFI_OUT_OF_RESOURCES;
+          goto ERROR_6;
+        }
+        NewEntityData->DataStart  = NewEntityData->Block;
+        NewEntityData->DataLength = ContentLength;
+        InsertTailList (&Cache->EntityDataList, &NewEntityData->Link);
+
+        BodyBuffer = NewEntityData->Block;
+        BodySize   = ContentLength;
+      }
+
+      //
+      // Each receive asks for the rest of the message-body, so the HTTP driver
+      // hands over everything the TCP receive window holds at once.
+      //
+      BodySize     = MIN (BodySize, ContentLength);
       ReceivedSize = 0;
-      while (ReceivedSize < ContentLength) {
-        ResponseBody.Body       = (CHAR8*) Buffer + ReceivedSize;
-        ResponseBody.BodyLength = *BufferSize - ReceivedSize;
+      while (ReceivedSize < BodySize) {
+        ResponseBody.Body       = (CHAR8*) BodyBuffer + ReceivedSize;
+        ResponseBody.BodyLength = BodySize - ReceivedSize;
         Status = HttpIoRecvResponse (
                    &Private->HttpIo,
                    FALSE,
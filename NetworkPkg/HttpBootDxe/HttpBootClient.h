@@ -18,7 +18,12 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #define HTTP_BOOT_REQUEST_TIMEOUT            5000      // 5 seconds in uints of millisecond.
 #define HTTP_BOOT_RESPONSE_TIMEOUT           5000      // 5 seconds in uints of millisecond.
-#define HTTP_BOOT_BLOCK_SIZE                 1500
+//
+// Receive block used when the message-body has to be parsed (chunked
+// transfer-coding). It is sized for bulk transfers so that one receive
+// drains a good part of the TCP window instead of a single segment.
+//
+#define HTTP_BOOT_BLOCK_SIZE                 SIZE_64KB
 
 
 
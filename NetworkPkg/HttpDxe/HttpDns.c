@@ -14,6 +14,184 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #include "HttpDriver.h"
 
+/**
+  Free an entry of the negative cache.
+
+  @param[in]  Item                The entry to free.
+
+**/
+VOID
+HttpDnsFreeNegativeCacheEntry (
+  IN HTTP_DNS_NEGATIVE_CACHE      *Item
+  )
+{
+  RemoveEntryList (&Item->Link);
+  gBS->CloseEvent (Item->Timer);
+  FreePool (Item->HostName);
+  if (Item->DnsServerList != NULL) {
+    FreePool (Item->DnsServerList);
+  }
+  FreePool (Item);
+}
+
+/**
+  Find the negative cache entry of a host name, dropping the expired entries
+  on the way.
+
+  @param[in]  Service             Pointer to the HTTP service.
+  @param[in]  IpVersion           IP_VERSION_4 or IP_VERSION_6.
+  @param[in]  HostName            Pointer to buffer containing hostname.
+  @param[in]  DnsServerListSize   Size in bytes of the DNS server list.
+  @param[in]  DnsServerList       The DNS servers the host name is looked up with.
+
+  @return The entry, or NULL if the host name is not in the negative cache.
+
+**/
+HTTP_DNS_NEGATIVE_CACHE *
+HttpDnsFindNegativeCache (
+  IN HTTP_SERVICE                 *Service,
+  IN UINT8                        IpVersion,
+  IN CHAR16                       *HostName,
+  IN UINTN                        DnsServerListSize,
+  IN VOID                         *DnsServerList
+  )
+{
+  LIST_ENTRY                      *Entry;
+  LIST_ENTRY                      *Next;
+  HTTP_DNS_NEGATIVE_CACHE         *Item;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &Service->DnsNegativeCache) {
+    Item = NET_LIST_USER_STRUCT (Entry, HTTP_DNS_NEGATIVE_CACHE, Link);
+    if (gBS->CheckEvent (Item->Timer) == EFI_SUCCESS) {
+      HttpDnsFreeNegativeCacheEntry (Item);
+      continue;
+    }
+
+    if (Item->IpVersion == IpVersion &&
+        Item->DnsServerListSize == DnsServerListSize &&
+        CompareMem (Item->DnsServerList, DnsServerList, DnsServerListSize) == 0 &&
+        StrCmp (Item->HostName, HostName) == 0) {
+      return Item;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Look a host name up in the negative cache of the HTTP service.
+
+  @param[in]  Service             Pointer to the HTTP service.
+  @param[in]  IpVersion           IP_VERSION_4 or IP_VERSION_6.
+  @param[in]  HostName            Pointer to buffer containing hostname.
+  @param[in]  DnsServerListSize   Size in bytes of the DNS server list.
+  @param[in]  DnsServerList       The DNS servers the host name is looked up with.
+  @param[out] Status              The status the cached lookup failed with.
+
+  @retval TRUE                    The host name recently failed to resolve with these DNS servers.
+  @retval FALSE                   The host name is not in the negative cache.
+
+**/
+BOOLEAN
+HttpDnsGetNegativeCache (
+  IN     HTTP_SERVICE             *Service,
+  IN     UINT8                    IpVersion,
+  IN     CHAR16                   *HostName,
+  IN     UINTN                    DnsServerListSize,
+  IN     VOID                     *DnsServerList,
+     OUT EFI_STATUS               *Status
+  )
+{
+  HTTP_DNS_NEGATIVE_CACHE         *Item;
+
+  Item = HttpDnsFindNegativeCache (Service, IpVersion, HostName, DnsServerListSize, DnsServerList);
+  if (Item == NULL) {
+    return FALSE;
+  }
+
+  *Status = Item->Status;
+  return TRUE;
+}
+
+/**
+  Remember a failed host name lookup in the negative cache of the HTTP service.
+
+  @param[in]  Service             Pointer to the HTTP service.
+  @param[in]  IpVersion           IP_VERSION_4 or IP_VERSION_6.
+  @param[in]  HostName            Pointer to buffer containing hostname.
+  @param[in]  DnsServerListSize   Size in bytes of the DNS server list.
+  @param[in]  DnsServerList       The DNS servers the host name was looked up with.
+  @param[in]  Status              The status the lookup failed with.
+
+**/
+VOID
+HttpDnsSetNegativeCache (
+  IN HTTP_SERVICE                 *Service,
+  IN UINT8                        IpVersion,
+  IN CHAR16                       *HostName,
+  IN UINTN                        DnsServerListSize,
+  IN VOID                         *DnsServerList,
+  IN EFI_STATUS                   Status
+  )
+{
+  HTTP_DNS_NEGATIVE_CACHE         *Item;
+  EFI_STATUS                      TimerStatus;
+
+  Item = HttpDnsFindNegativeCache (Service, IpVersion, HostName, DnsServerListSize, DnsServerList);
+  if (Item == NULL) {
+    Item = AllocateZeroPool (sizeof (HTTP_DNS_NEGATIVE_CACHE));
+    if (Item == NULL) {
+      return;
+    }
+
+    Item->IpVersion         = IpVersion;
+    Item->DnsServerListSize = DnsServerListSize;
+    Item->HostName          = AllocateCopyPool (StrSize (HostName), HostName);
+    if (DnsServerListSize != 0) {
+      Item->DnsServerList   = AllocateCopyPool (DnsServerListSize, DnsServerList);
+    }
+    TimerStatus = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &Item->Timer);
+    if (Item->HostName == NULL || (DnsServerListSize != 0 && Item->DnsServerList == NULL) ||
+        EFI_ERROR (TimerStatus)) {
+      if (Item->HostName != NULL) {
+        FreePool (Item->HostName);
+      }
+      if (Item->DnsServerList != NULL) {
+        FreePool (Item->DnsServerList);
+      }
+      if (!EFI_ERROR (TimerStatus)) {
+        gBS->CloseEvent (Item->Timer);
+      }
+      FreePool (Item);
+      return;
+    }
+
+    InsertTailList (&Service->DnsNegativeCache, &Item->Link);
+  }
+
+  Item->Status = Status;
+  gBS->SetTimer (Item->Timer, TimerRelative, EFI_TIMER_PERIOD_SECONDS (HTTP_DNS_NEGATIVE_CACHE_TIMEOUT));
+}
+
+/**
+  Free the negative cache of the HTTP service.
+
+  @param[in]  Service             Pointer to the HTTP service.
+
+**/
+VOID
+HttpDnsFreeNegativeCache (
+  IN HTTP_SERVICE                 *Service
+  )
+{
+  LIST_ENTRY                      *Entry;
+  LIST_ENTRY                      *Next;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &Service->DnsNegativeCache) {
+    HttpDnsFreeNegativeCacheEntry (NET_LIST_USER_STRUCT (Entry, HTTP_DNS_NEGATIVE_CACHE, Link));
+  }
+}
+
 /**
   Retrieve the host address using the EFI_DNS4_PROTOCOL.
 
@@ -82,6 +260,13 @@ HttpDns4 (
 
   Dns4Handle = NULL;
   Dns4       = NULL;
+
+  //
+  // Don't set up a DNS child to repeat a lookup that just failed.
+  //
+  if (HttpDnsGetNegativeCache (Service, IP_VERSION_4, HostName, DnsServerListCount * sizeof (EFI_IPv4_ADDRESS), DnsServerList, &Status)) {
+    goto Exit;
+  }
   
   //
   // Create a DNS child instance and get the protocol.
@@ -176,6 +361,8 @@ HttpDns4 (
     //
     IP4_COPY_ADDRESS (IpAddress, Token.RspData.H2AData->IpList);
     Status = EFI_SUCCESS;
+  } else if (Status == EFI_NOT_FOUND || Status == EFI_TIMEOUT) {
+    HttpDnsSetNegativeCache (Service, IP_VERSION_4, HostName, DnsServerListCount * sizeof (EFI_IPv4_ADDRESS), DnsServerList, Status);
   }
 
 Exit:
@@ -285,6 +472,13 @@ HttpDns6 (
     }
   }
 
+  //
+  // Don't set up a DNS child to repeat a lookup that just failed.
+  //
+  if (HttpDnsGetNegativeCache (Service, IP_VERSION_6, HostName, DnsServerListCount * sizeof (EFI_IPv6_ADDRESS), DnsServerList, &Status)) {
+    goto Exit;
+  }
+
   //
   // Create a DNSv6 child instance and get the protocol.
   //
@@ -373,6 +567,8 @@ HttpDns6 (
     //
     IP6_COPY_ADDRESS (IpAddress, Token.RspData.H2AData->IpList);
     Status = EFI_SUCCESS;
+  } else if (Status == EFI_NOT_FOUND || Status == EFI_TIMEOUT) {
+    HttpDnsSetNegativeCache (Service, IP_VERSION_6, HostName, DnsServerListCount * sizeof (EFI_IPv6_ADDRESS), DnsServerList, Status);
   }
   
 Exit:
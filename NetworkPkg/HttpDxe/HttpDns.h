@@ -15,6 +15,62 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #ifndef __EFI_HTTP_DNS_H__
 #define __EFI_HTTP_DNS_H__
 
+/**
+  Look a host name up in the negative cache of the HTTP service.
+
+  @param[in]  Service             Pointer to the HTTP service.
+  @param[in]  IpVersion           IP_VERSION_4 or IP_VERSION_6.
+  @param[in]  HostName            Pointer to buffer containing hostname.
+  @param[in]  DnsServerListSize   Size in bytes of the DNS server list.
+  @param[in]  DnsServerList       The DNS servers the host name is looked up with.
+  @param[out] Status              The status the cached lookup failed with.
+
+  @retval TRUE                    The host name recently failed to resolve with these DNS servers.
+  @retval FALSE                   The host name is not in the negative cache.
+
+**/
+BOOLEAN
+HttpDnsGetNegativeCache (
+  IN     HTTP_SERVICE             *Service,
+  IN     UINT8                    IpVersion,
+  IN     CHAR16                   *HostName,
+  IN     UINTN                    DnsServerListSize,
+  IN     VOID                     *DnsServerList,
+     OUT EFI_STATUS               *Status
+  );
+
+/**
+  Remember a failed host name lookup in the negative cache of the HTTP service.
+
+  @param[in]  Service             Pointer to the HTTP service.
+  @param[in]  IpVersion           IP_VERSION_4 or IP_VERSION_6.
+  @param[in]  HostName            Pointer to buffer containing hostname.
+  @param[in]  DnsServerListSize   Size in bytes of the DNS server list.
+  @param[in]  DnsServerList       The DNS servers the host name was looked up with.
+  @param[in]  Status              The status the lookup failed with.
+
+**/
+VOID
+HttpDnsSetNegativeCache (
+  IN HTTP_SERVICE                 *Service,
+  IN UINT8                        IpVersion,
+  IN CHAR16                       *HostName,
+  IN UINTN                        DnsServerListSize,
+  IN VOID                         *DnsServerList,
+  IN EFI_STATUS                   Status
+  );
+
+/**
+  Free the negative cache of the HTTP service.
+
+  @param[in]  Service             Pointer to the HTTP service.
+
+**/
+VOID
+HttpDnsFreeNegativeCache (
+  IN HTTP_SERVICE                 *Service
+  );
+
 /**
   Retrieve the host address using the EFI_DNS4_PROTOCOL.
 
@@ -73,6 +73,7 @@ HttpCreateService (
   HttpService->ControllerHandle = Controller;
   HttpService->ChildrenNumber = 0;
   InitializeListHead (&HttpService->ChildrenList);
+  InitializeListHead (&HttpService->DnsNegativeCache);
   
   *ServiceData = HttpService;
   return EFI_SUCCESS;
@@ -481,6 +482,7 @@ ON_ERROR:
   if (HttpService != NULL) {
     HttpCleanService (HttpService, UsingIpv6);
     if (HttpService->Tcp4ChildHandle == NULL && HttpService->Tcp6ChildHandle == NULL) {
+      HttpDnsFreeNegativeCache (HttpService);
       FreePool (HttpService);
     }
   }
@@ -578,6 +580,7 @@ HttpDxeStop (
                &gEfiHttpServiceBindingProtocolGuid,
                ServiceBinding
                );
+        HttpDnsFreeNegativeCache (HttpService);
         FreePool (HttpService);
       }
       Status = EFI_SUCCESS;
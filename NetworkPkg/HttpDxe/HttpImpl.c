@@ -248,6 +248,7 @@ EfiHttpRequest (
   BOOLEAN                       Configure;
   BOOLEAN                       ReConfigure;
   BOOLEAN                       TlsConfigure;
+  BOOLEAN                       SameHost;
   CHAR8                         *RequestMsg;
   CHAR8                         *Url;
   UINTN                         UrlLen;
@@ -269,6 +270,7 @@ EfiHttpRequest (
   Wrap = NULL;
   FileUrl = NULL;
   TlsConfigure = FALSE;
+  SameHost = FALSE;
 
   if ((This == NULL) || (Token == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -486,8 +488,11 @@ EfiHttpRequest (
       } else {
         //
         // Need close existing TCP instance and create a new TCP instance for data transmit.
+        // Only the port or the scheme may have changed, in which case the host
+        // address resolved for the previous call is still good.
         //
         if (HttpInstance->RemoteHost != NULL) {
+          SameHost = (BOOLEAN) (AsciiStrCmp (HttpInstance->RemoteHost, HostName) == 0);
           FreePool (HttpInstance->RemoteHost);
           HttpInstance->RemoteHost = NULL;
           HttpInstance->RemotePort = 0;
@@ -499,11 +504,15 @@ EfiHttpRequest (
   if (Configure) {
     //
     // Parse Url for IPv4 or IPv6 address, if failed, perform DNS resolution.
+    // The address of the previous call is reused if the host is the same.
     //
-    if (!HttpInstance->LocalAddressIsIPv6) {
-      Status = NetLibAsciiStrToIp4 (HostName, &HttpInstance->RemoteAddr);
-    } else {
-      Status = HttpUrlGetIp6 (Url, UrlParser, &HttpInstance->RemoteIpv6Addr);
+    Status = EFI_SUCCESS;
+    if (!SameHost) {
+      if (!HttpInstance->LocalAddressIsIPv6) {
+        Status = NetLibAsciiStrToIp4 (HostName, &HttpInstance->RemoteAddr);
+      } else {
+        Status = HttpUrlGetIp6 (Url, UrlParser, &HttpInstance->RemoteIpv6Addr);
+      }
     }
 
     if (EFI_ERROR (Status)) {
@@ -976,6 +985,7 @@ HttpResponseWorker (
   HTTP_TOKEN_WRAP               *ValueInItem;
   UINTN                         HdrLen;
   NET_FRAGMENT                  Fragment;
+  EFI_HTTP_HEADER               *Header;
 
   if (Wrap == NULL || Wrap->HttpInstance == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -1178,6 +1188,14 @@ HttpResponseWorker (
       FreePool (HttpHeaders);
       HttpHeaders = NULL;
 
+      //
+      // The server closes the connection after this response, the next request
+      // has to open a new one instead of reusing it.
+      //
+      Header = HttpFindHeader (HttpMsg->HeaderCount, HttpMsg->Headers, HTTP_HEADER_CONNECTION);
+      if ((Header != NULL) && (AsciiStriCmp (Header->FieldValue, "close") == 0)) {
+        HttpInstance->ConnectionClose = TRUE;
+      }
 
       //
       // Init message-body parser by header information.
@@ -989,7 +989,8 @@ HttpCreateConnection (
   }
   
   if (!EFI_ERROR (Status)) {
-    HttpInstance->State = HTTP_STATE_TCP_CONNECTED;
+    HttpInstance->State           = HTTP_STATE_TCP_CONNECTED;
+    HttpInstance->ConnectionClose = FALSE;
   }
 
   return Status;
@@ -1088,7 +1089,7 @@ HttpConfigureTcp4 (
   IP4_COPY_ADDRESS (&Tcp4AP->RemoteAddress, &HttpInstance->RemoteAddr);
 
   Tcp4Option = Tcp4CfgData->ControlOption;
-  Tcp4Option->ReceiveBufferSize      = HTTP_BUFFER_SIZE_DEAULT;
+  Tcp4Option->ReceiveBufferSize      = HTTP_RCV_BUFFER_SIZE;
   Tcp4Option->SendBufferSize         = HTTP_BUFFER_SIZE_DEAULT;
   Tcp4Option->MaxSynBackLog          = HTTP_MAX_SYN_BACK_LOG;
   Tcp4Option->ConnectionTimeout      = HTTP_CONNECTION_TIMEOUT;
@@ -1098,6 +1099,7 @@ HttpConfigureTcp4 (
   Tcp4Option->KeepAliveTime          = HTTP_KEEP_ALIVE_TIME;
   Tcp4Option->KeepAliveInterval      = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp4Option->EnableNagle            = TRUE;
+  Tcp4Option->EnableWindowScaling    = TRUE;
   Tcp4CfgData->ControlOption         = Tcp4Option;
 
   Status = HttpInstance->Tcp4->Configure (HttpInstance->Tcp4, Tcp4CfgData);
@@ -1159,7 +1161,7 @@ HttpConfigureTcp6 (
   IP6_COPY_ADDRESS (&Tcp6Ap->RemoteAddress , &HttpInstance->RemoteIpv6Addr);
 
   Tcp6Option = Tcp6CfgData->ControlOption;
-  Tcp6Option->ReceiveBufferSize  = HTTP_BUFFER_SIZE_DEAULT;
+  Tcp6Option->ReceiveBufferSize  = HTTP_RCV_BUFFER_SIZE;
   Tcp6Option->SendBufferSize     = HTTP_BUFFER_SIZE_DEAULT;
   Tcp6Option->MaxSynBackLog      = HTTP_MAX_SYN_BACK_LOG;
   Tcp6Option->ConnectionTimeout  = HTTP_CONNECTION_TIMEOUT;
@@ -1169,6 +1171,7 @@ HttpConfigureTcp6 (
   Tcp6Option->KeepAliveTime      = HTTP_KEEP_ALIVE_TIME;
   Tcp6Option->KeepAliveInterval  = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp6Option->EnableNagle        = TRUE;
+  Tcp6Option->EnableWindowScaling = TRUE;
 
   Status = HttpInstance->Tcp6->Configure (HttpInstance->Tcp6, Tcp6CfgData);
   if (EFI_ERROR (Status)) {
@@ -1229,9 +1232,13 @@ HttpConnectTcp4 (
     return Status;
   }
 
-  if (Tcp4State == Tcp4StateEstablished) {
+  //
+  // Keep using an established connection unless the server announced that it
+  // closes it after the last response.
+  //
+  if (Tcp4State == Tcp4StateEstablished && !HttpInstance->ConnectionClose) {
     return EFI_SUCCESS;
-  } else if (Tcp4State > Tcp4StateEstablished ) {
+  } else if (Tcp4State >= Tcp4StateEstablished) {
     HttpCloseConnection(HttpInstance);
   }
 
@@ -1321,9 +1328,13 @@ HttpConnectTcp6 (
      return Status;
   }
 
-  if (Tcp6State == Tcp6StateEstablished) {
+  //
+  // Keep using an established connection unless the server announced that it
+  // closes it after the last response.
+  //
+  if (Tcp6State == Tcp6StateEstablished && !HttpInstance->ConnectionClose) {
     return EFI_SUCCESS;
-  } else if (Tcp6State > Tcp6StateEstablished ) {
+  } else if (Tcp6State >= Tcp6StateEstablished) {
     HttpCloseConnection(HttpInstance);
   }
 
@@ -1715,13 +1726,19 @@ HttpTcpTransmit (
 /**
   Receive the HTTP response by processing the associated HTTP token.
 
+  The queued response tokens are started in order and one at a time, since
+  each of them continues the message body where the previous one stopped.
+  A token which completes immediately, e.g. from the cached body, lets the
+  next one start as well.
+
   @param[in]  Map                The container of Rx4Token or Rx6Token.
   @param[in]  Item               Current item to check against.
   @param[in]  Context            The Token to check againist.
 
-  @retval EFI_SUCCESS            The HTTP response is queued into TCP receive
-                                 queue.
-  @retval Others                 Other error as indicated.
+  @retval EFI_SUCCESS            The HTTP response completed, continue with
+                                 the next queued one.
+  @retval EFI_ABORTED            The HTTP response is queued into TCP receive
+                                 queue, stop the iteration.
 
 **/
 EFI_STATUS
@@ -1732,10 +1749,20 @@ HttpTcpReceive (
   IN VOID                   *Context
   )
 {
+  EFI_HTTP_TOKEN            *Token;
+
+  Token = (EFI_HTTP_TOKEN *) Item->Key;
+
   //
   // Process the queued HTTP response.
   //
-  return HttpResponseWorker ((HTTP_TOKEN_WRAP *) Item->Value);
+  HttpResponseWorker ((HTTP_TOKEN_WRAP *) Item->Value);
+
+  if (NetMapFindKey (Map, Token) != NULL) {
+    return EFI_ABORTED;
+  }
+
+  return EFI_SUCCESS;
 }
 
 /**
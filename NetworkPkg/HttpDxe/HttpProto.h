@@ -45,6 +45,13 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define HTTP_TOS_DEAULT              8
 #define HTTP_TTL_DEAULT              255
 #define HTTP_BUFFER_SIZE_DEAULT      65535
+//
+// The receive buffer, and so the advertised window, is sized for bulk
+// downloads: it lets the server keep a whole window in flight while the
+// receive tokens are being completed and requeued. TCP clamps it to its
+// own maximum.
+//
+#define HTTP_RCV_BUFFER_SIZE         SIZE_2MB
 #define HTTP_MAX_SYN_BACK_LOG        5
 #define HTTP_CONNECTION_TIMEOUT      60
 #define HTTP_RESPONSE_TIMEOUT        5
@@ -56,6 +63,22 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 
 #define HTTP_URL_BUFFER_LEN          4096
 
+//
+// Seconds a failed host name lookup is remembered, so that reconnects to a
+// host that doesn't resolve don't create and configure a DNS child each time.
+//
+#define HTTP_DNS_NEGATIVE_CACHE_TIMEOUT  10
+
+typedef struct {
+  LIST_ENTRY                    Link;
+  UINT8                         IpVersion;
+  CHAR16                        *HostName;
+  UINTN                         DnsServerListSize;
+  VOID                          *DnsServerList;   // The DNS servers the lookup was sent to.
+  EFI_STATUS                    Status;
+  EFI_EVENT                     Timer;            // Signaled once the entry expires.
+} HTTP_DNS_NEGATIVE_CACHE;
+
 typedef struct _HTTP_SERVICE {
   UINT32                        Signature;
   EFI_SERVICE_BINDING_PROTOCOL  ServiceBinding;
@@ -67,6 +90,7 @@ typedef struct _HTTP_SERVICE {
   LIST_ENTRY                    ChildrenList;
   UINTN                         ChildrenNumber;
   INTN                          State;
+  LIST_ENTRY                    DnsNegativeCache;
 } HTTP_SERVICE;
 
 typedef struct {
@@ -117,6 +141,7 @@ typedef struct _HTTP_PROTOCOL {
   CHAR8                         *RemoteHost;
   UINT16                        RemotePort;
   EFI_IPv4_ADDRESS              RemoteAddr;
+  BOOLEAN                       ConnectionClose; // Server asked to close the connection.
   
   EFI_HANDLE                    Tcp6ChildHandle;
   EFI_TCP6_PROTOCOL             *Tcp6;
@@ -529,9 +554,10 @@ HttpTcpTransmit (
   @param[in]  Item               Current item to check against.
   @param[in]  Context            The Token to check againist.
 
-  @retval EFI_SUCCESS            The HTTP response is queued into TCP receive
-                                 queue.
-  @retval Others                 Other error as indicated.
+  @retval EFI_SUCCESS            The HTTP response completed, continue with
+                                 the next queued one.
+  @retval EFI_ABORTED            The HTTP response is queued into TCP receive
+                                 queue, stop the iteration.
 
 **/
 EFI_STATUS
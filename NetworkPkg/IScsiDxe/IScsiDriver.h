@@ -653,6 +653,23 @@ IScsiExtScsiPassThruFunction (
   IN EFI_EVENT                                                Event     OPTIONAL
   );
 
+/**
+  Notification function of the poll timer for the nonblocking requests. It sends
+  out the queued requests as long as the command window of the target is open,
+  then receives the PDUs of the target until the oldest outstanding command
+  completes.
+
+  @param[in]  Event    The poll timer event.
+  @param[in]  Context  The iSCSI driver data.
+
+**/
+VOID
+EFIAPI
+IScsiOnAsyncTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
 /**
   Used to retrieve the list of legal Target IDs and LUNs for SCSI devices on
   a SCSI channel. These can either be the list SCSI devices that are actually
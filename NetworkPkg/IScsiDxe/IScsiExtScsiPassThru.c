@@ -86,8 +86,11 @@ IScsiExtScsiPassThruFunction (
   IN EFI_EVENT                                                Event     OPTIONAL
   )
 {
-  EFI_STATUS         Status;
-  ISCSI_DRIVER_DATA  *Private;
+  EFI_STATUS          Status;
+  ISCSI_DRIVER_DATA   *Private;
+  ISCSI_ASYNC_REQUEST *Request;
+  EFI_TPL             OldTpl;
+  BOOLEAN             WasIdle;
   
   if (Target[0] != 0) {
     return EFI_INVALID_PARAMETER;
@@ -97,23 +100,181 @@ IScsiExtScsiPassThruFunction (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet);
+  Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (This);
+
+  if (Event != NULL) {
+    if ((Private->Session->State == SESSION_STATE_FAILED) && (EfiGetCurrentTpl () <= TPL_CALLBACK)) {
+      //
+      // The login blocks, so the poll timer leaves a failed session alone.
+      // Reinstate it here, keeping the poll timer off in the meantime.
+      //
+      OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+      Status = IScsiSessionReinstatement (Private->Session);
+      gBS->RestoreTPL (OldTpl);
+      if (EFI_ERROR (Status)) {
+        return EFI_DEVICE_ERROR;
+      }
+    }
+
+    //
+    // Nonblocking request. It may be issued at TPL_NOTIFY, where the TCP I/O is
+    // not allowed, so just queue it here. The poll timer sends it out and
+    // signals Event when it completes.
+    //
+    Request = AllocateZeroPool (sizeof (ISCSI_ASYNC_REQUEST));
+    if (Request == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    CopyMem (Request->Target, Target, TARGET_MAX_BYTES);
+    Request->Lun    = Lun;
+    Request->Packet = Packet;
+    Request->Event  = Event;
+
+    OldTpl  = gBS->RaiseTPL (TPL_NOTIFY);
+    WasIdle = IsListEmpty (&Private->AsyncRequestList);
+    InsertTailList (&Private->AsyncRequestList, &Request->Link);
+    if (WasIdle) {
+      gBS->SetTimer (Private->AsyncTimer, TimerPeriodic, ISCSI_ASYNC_POLL_INTERVAL);
+    }
+    gBS->RestoreTPL (OldTpl);
+
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Keep the poll timer off the connection while this request is in progress.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+
+  Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet, NULL);
   if ((Status != EFI_SUCCESS) && (Status != EFI_NOT_READY)) {
     //
     // Try to reinstate the session and re-execute the Scsi command.
     //
-    Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (This);
     if (EFI_ERROR (IScsiSessionReinstatement (Private->Session))) {
-      return EFI_DEVICE_ERROR;
+      Status = EFI_DEVICE_ERROR;
+    } else {
+      Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet, NULL);
     }
-
-    Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet);
   }
 
+  gBS->RestoreTPL (OldTpl);
+
   return Status;
 }
 
 
+/**
+  Notification function of the poll timer for the nonblocking requests. It sends
+  out the queued requests as long as the command window of the target is open,
+  then processes the PDUs the target has sent so far. It does not wait for the
+  outstanding commands to complete, which lets the target work on several of
+  them at once.
+
+  @param[in]  Event    The poll timer event.
+  @param[in]  Context  The iSCSI driver data.
+
+**/
+VOID
+EFIAPI
+IScsiOnAsyncTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ISCSI_DRIVER_DATA   *Private;
+  ISCSI_SESSION       *Session;
+  ISCSI_CONNECTION    *Conn;
+  ISCSI_ASYNC_REQUEST *Request;
+  EFI_STATUS          Status;
+  EFI_TPL             OldTpl;
+
+  Private = (ISCSI_DRIVER_DATA *) Context;
+  Session = Private->Session;
+
+  if ((Session == NULL) || (Session->State != SESSION_STATE_LOGGED_IN)) {
+    //
+    // The session is reinstated by the next request issued below TPL_NOTIFY,
+    // not here, as the login blocks.
+    //
+    IScsiFlushAsyncRequests (Private);
+    gBS->SetTimer (Event, TimerCancel, 0);
+    return;
+  }
+
+  //
+  // Send out the queued requests.
+  //
+  Status = EFI_SUCCESS;
+  while (TRUE) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if (IsListEmpty (&Private->AsyncRequestList)) {
+      gBS->RestoreTPL (OldTpl);
+      break;
+    }
+
+    Request = NET_LIST_HEAD (&Private->AsyncRequestList, ISCSI_ASYNC_REQUEST, Link);
+    RemoveEntryList (&Request->Link);
+    gBS->RestoreTPL (OldTpl);
+
+    Status = IScsiExecuteScsiCommand (
+               &Private->IScsiExtScsiPassThru,
+               Request->Target,
+               Request->Lun,
+               Request->Packet,
+               Request->Event
+               );
+    if (Status == EFI_NOT_READY) {
+      //
+      // The command window is closed, retry when some commands complete.
+      //
+      OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+      InsertHeadList (&Private->AsyncRequestList, &Request->Link);
+      gBS->RestoreTPL (OldTpl);
+      Status = EFI_SUCCESS;
+      break;
+    }
+
+    if (EFI_ERROR (Status)) {
+      Request->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+      gBS->SignalEvent (Request->Event);
+    }
+
+    FreePool (Request);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (!EFI_ERROR (Status) && !IsListEmpty (&Session->TcbList)) {
+    Conn = NET_LIST_USER_STRUCT_S (
+             Session->Conns.ForwardLink,
+             ISCSI_CONNECTION,
+             Link,
+             ISCSI_CONNECTION_SIGNATURE
+             );
+
+    Status = IScsiPollTcbs (Conn);
+  }
+
+  if (EFI_ERROR (Status)) {
+    //
+    // The connection is out of sync with the target. Fail the outstanding
+    // commands, the session is reinstated by the next request.
+    //
+    IScsiSessionAbort (Session);
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (IsListEmpty (&Session->TcbList) && IsListEmpty (&Private->AsyncRequestList)) {
+    gBS->SetTimer (Event, TimerCancel, 0);
+  }
+  gBS->RestoreTPL (OldTpl);
+}
+
+
 /**
   Used to retrieve the list of legal Target IDs and LUNs for SCSI devices on
   a SCSI channel. These can either be the list SCSI devices that are actually
@@ -148,6 +148,9 @@ struct _ISCSI_CONNECTION {
   BOOLEAN           PartialReqSent;
   BOOLEAN           PartialRspRcvd;
 
+  BOOLEAN           RxProbed;       ///< RxProbe holds the first byte of the next PDU.
+  UINT8             RxProbe;
+
   BOOLEAN           TransitInitiated;
   BOOLEAN           ParamNegotiated;
 
@@ -172,6 +175,20 @@ struct _ISCSI_CONNECTION {
 
 #define ISCSI_DRIVER_DATA_SIGNATURE SIGNATURE_32 ('I', 'S', 'D', 'A')
 
+//
+// Period of the timer that sends the queued nonblocking requests and completes
+// the outstanding ones.
+//
+#define ISCSI_ASYNC_POLL_INTERVAL   EFI_TIMER_PERIOD_MILLISECONDS (1)
+
+typedef struct {
+  LIST_ENTRY                                  Link;
+  UINT8                                       Target[TARGET_MAX_BYTES];
+  UINT64                                      Lun;
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet;
+  EFI_EVENT                                   Event;
+} ISCSI_ASYNC_REQUEST;
+
 #define ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU(PassThru) \
   CR ( \
   PassThru, \
@@ -202,6 +219,9 @@ struct _ISCSI_DRIVER_DATA {
   EFI_DEVICE_PATH_PROTOCOL        *DevicePath;
   EFI_HANDLE                      ChildHandle;  
   ISCSI_SESSION                   *Session;
+
+  EFI_EVENT                       AsyncTimer;
+  LIST_ENTRY                      AsyncRequestList;   ///< Nonblocking requests not sent yet.
 };
 
 #endif
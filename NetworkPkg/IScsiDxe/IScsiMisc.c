@@ -1609,6 +1609,23 @@ IScsiCreateDriverData (
     return NULL;
   }
 
+  //
+  // Create the timer to drive the nonblocking EXT SCSI PASS THRU requests.
+  //
+  InitializeListHead (&Private->AsyncRequestList);
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  IScsiOnAsyncTimer,
+                  Private,
+                  &Private->AsyncTimer
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (Private->ExitBootServiceEvent);
+    FreePool (Private);
+    return NULL;
+  }
+
   Private->ExtScsiPassThruHandle = NULL;
   CopyMem(&Private->IScsiExtScsiPassThru, &gIScsiExtScsiPassThruProtocolTemplate, sizeof(EFI_EXT_SCSI_PASS_THRU_PROTOCOL));
 
@@ -1616,7 +1633,9 @@ IScsiCreateDriverData (
   // 0 is designated to the TargetId, so use another value for the AdapterId.
   //
   Private->ExtScsiPassThruMode.AdapterId  = 2;
-  Private->ExtScsiPassThruMode.Attributes = EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_PHYSICAL | EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL;
+  Private->ExtScsiPassThruMode.Attributes = EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_PHYSICAL |
+                                            EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL |
+                                            EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_NONBLOCKIO;
   Private->ExtScsiPassThruMode.IoAlign    = 4;
   Private->IScsiExtScsiPassThru.Mode      = &Private->ExtScsiPassThruMode;
 
@@ -1624,6 +1643,35 @@ IScsiCreateDriverData (
 }
 
 
+/**
+  Fail the nonblocking requests that are not sent out yet and signal their events.
+
+  @param[in]  Private  The iSCSI driver data.
+
+**/
+VOID
+IScsiFlushAsyncRequests (
+  IN ISCSI_DRIVER_DATA  *Private
+  )
+{
+  ISCSI_ASYNC_REQUEST *Request;
+  EFI_TPL             OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  while (!IsListEmpty (&Private->AsyncRequestList)) {
+    Request = NET_LIST_HEAD (&Private->AsyncRequestList, ISCSI_ASYNC_REQUEST, Link);
+    RemoveEntryList (&Request->Link);
+
+    Request->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+    gBS->SignalEvent (Request->Event);
+    FreePool (Request);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+
 /**
   Clean the iSCSI driver data.
 
@@ -1670,6 +1718,9 @@ EXIT:
 
   gBS->CloseEvent (Private->ExitBootServiceEvent);
 
+  gBS->CloseEvent (Private->AsyncTimer);
+  IScsiFlushAsyncRequests (Private);
+
   mCallbackInfo->Current = NULL;
 
   FreePool (Private);
@@ -2352,6 +2403,7 @@ IScsiOnExitBootService (
 
   Private = (ISCSI_DRIVER_DATA *) Context;
   gBS->CloseEvent (Private->ExitBootServiceEvent);
+  gBS->SetTimer (Private->AsyncTimer, TimerCancel, 0);
 
   if (Private->Session != NULL) {
     IScsiSessionAbort (Private->Session);
@@ -365,6 +365,17 @@ IScsiCleanDriverData (
   IN ISCSI_DRIVER_DATA  *Private
   );
 
+/**
+  Fail the nonblocking requests that are not sent out yet and signal their events.
+
+  @param[in]  Private  The iSCSI driver data.
+
+**/
+VOID
+IScsiFlushAsyncRequests (
+  IN ISCSI_DRIVER_DATA  *Private
+  );
+
 /**
   Check wheather the Controller handle is configured to use DHCP protocol.
 
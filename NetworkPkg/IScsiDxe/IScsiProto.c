@@ -1275,6 +1275,8 @@ IScsiNbufExtFree (
   @param[out] Pdu          The received iSCSI pdu.
   @param[in]  Context      The context used to describe information on the caller provided
                            buffer to receive data segment of the iSCSI pdu. It is optional.
+                           If it is NULL, the data segment of an iSCSI SCSI data is received
+                           into the buffer of the request the initiator task tag refers to.
   @param[in]  HeaderDigest Whether there will be header digest received.
   @param[in]  DataDigest   Whether there will be data digest.
   @param[in]  TimeoutEvent The timeout event. It is optional.
@@ -1306,6 +1308,8 @@ IScsiReceivePdu (
   UINT32          FragmentCount;
   NET_BUF         *DataSeg;
   UINT32          PadAndCRC32[2];
+  ISCSI_TCB       *Tcb;
+  ISCSI_IN_BUFFER_CONTEXT TcbContext;
 
   NbufList = AllocatePool (sizeof (LIST_ENTRY));
   if (NbufList == NULL) {
@@ -1334,7 +1338,26 @@ IScsiReceivePdu (
   //
   // First step, receive the BHS of the PDU.
   //
-  Status = TcpIoReceive (&Conn->TcpIo, PduHdr, FALSE, TimeoutEvent);
+  if (Conn->RxProbed) {
+    //
+    // The first byte is received by IScsiProbePdu() already.
+    //
+    Conn->RxProbed    = FALSE;
+    Header[0]         = Conn->RxProbe;
+    Fragment[0].Len   = Len - 1;
+    Fragment[0].Bulk  = Header + 1;
+
+    DataSeg = NetbufFromExt (&Fragment[0], 1, 0, 0, IScsiNbufExtFree, NULL);
+    if (DataSeg == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto ON_EXIT;
+    }
+
+    Status = TcpIoReceive (&Conn->TcpIo, DataSeg, FALSE, TimeoutEvent);
+    NetbufFree (DataSeg);
+  } else {
+    Status = TcpIoReceive (&Conn->TcpIo, PduHdr, FALSE, TimeoutEvent);
+  }
 
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
@@ -1369,6 +1392,18 @@ IScsiReceivePdu (
     // if the PDU is an iSCSI SCSI data.
     //
     InDataOffset = ISCSI_GET_BUFFER_OFFSET (Header);
+    if (Context == NULL) {
+      Tcb = IScsiFindTcbByITT (
+              &Conn->Session->TcbList,
+              NTOHL (((ISCSI_BASIC_HEADER *) Header)->InitiatorTaskTag)
+              );
+      if ((Tcb != NULL) && (Tcb->Packet != NULL)) {
+        TcbContext.InData    = (UINT8 *) Tcb->Packet->InDataBuffer;
+        TcbContext.InDataLen = Tcb->Packet->InTransferLength;
+        Context              = &TcbContext;
+      }
+    }
+
     if ((Context == NULL) || ((InDataOffset + Len) > Context->InDataLen)) {
       Status = EFI_PROTOCOL_ERROR;
       goto ON_EXIT;
@@ -2115,17 +2150,15 @@ IScsiFindTcbByITT (
   ISCSI_TCB       *Tcb;
   LIST_ENTRY      *Entry;
 
-  Tcb = NULL;
-
   NET_LIST_FOR_EACH (Entry, TcbList) {
     Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
 
     if (Tcb->InitiatorTaskTag == InitiatorTaskTag) {
-      break;
+      return Tcb;
     }
   }
 
-  return Tcb;
+  return NULL;
 }
 
 
@@ -2894,6 +2927,339 @@ IScsiOnNopInRcvd (
 }
 
 
+/**
+  Complete a nonblocking SCSI command: update the status of its request packet,
+  destroy the task control block and signal the event of the request.
+
+  @param[in]  Tcb            The task control block of the nonblocking command.
+  @param[in]  Status         The result of the command.
+
+**/
+VOID
+IScsiCompleteAsyncTcb (
+  IN ISCSI_TCB   *Tcb,
+  IN EFI_STATUS  Status
+  )
+{
+  EFI_EVENT  Event;
+
+  if (Status == EFI_BAD_BUFFER_SIZE) {
+    Tcb->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_DATA_OVERRUN_UNDERRUN;
+  } else if (Status == EFI_TIMEOUT) {
+    Tcb->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_TIMEOUT_COMMAND;
+  } else if (EFI_ERROR (Status)) {
+    Tcb->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+  }
+
+  Event = Tcb->Event;
+  IScsiDelTcb (Tcb);
+
+  gBS->SignalEvent (Event);
+}
+
+
+/**
+  Receive a PDU of the outstanding SCSI commands and dispatch it to the task
+  control block by the initiator task tag. The nonblocking command whose status
+  arrives is completed and its event is signaled.
+
+  @param[in]  Conn             The iSCSI connection.
+  @param[in]  WaitTcb          The task control block being waited for. The PDUs
+                               not related to a command are dispatched to it.
+  @param[in]  TimeoutEvent     The timeout event. It is optional.
+  @param[out] Done             Whether the status of WaitTcb is transferred.
+
+  @retval EFI_SUCCES           The PDU is received and processed.
+  @retval EFI_BAD_BUFFER_SIZE  The buffer of the blocking WaitTcb was not the
+                               proper size for the request.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiReceiveTcbPdu (
+  IN  ISCSI_CONNECTION  *Conn,
+  IN  ISCSI_TCB         *WaitTcb,
+  IN  EFI_EVENT         TimeoutEvent OPTIONAL,
+  OUT BOOLEAN           *Done
+  )
+{
+  EFI_STATUS              Status;
+  NET_BUF                 *Pdu;
+  UINT8                   *PduHdr;
+  UINT8                   Opcode;
+  ISCSI_TCB               *Tcb;
+
+  *Done = FALSE;
+
+  //
+  // Try to receive PDU from target. The data of a SCSI Data In PDU lands in
+  // the buffer of the command it belongs to.
+  //
+  Status = IScsiReceivePdu (Conn, &Pdu, NULL, FALSE, FALSE, TimeoutEvent);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  PduHdr = NetbufGetByte (Pdu, 0, NULL);
+  if (PduHdr == NULL) {
+    NetbufFree (Pdu);
+    return EFI_PROTOCOL_ERROR;
+  }
+
+  Opcode = ISCSI_GET_OPCODE (PduHdr);
+  Tcb    = WaitTcb;
+
+  if ((Opcode == ISCSI_OPCODE_SCSI_DATA_IN) ||
+      (Opcode == ISCSI_OPCODE_R2T) ||
+      (Opcode == ISCSI_OPCODE_SCSI_RSP)
+      ) {
+    //
+    // Several commands may be outstanding, route the PDU to its own one.
+    //
+    Tcb = IScsiFindTcbByITT (
+            &Conn->Session->TcbList,
+            NTOHL (((ISCSI_BASIC_HEADER *) PduHdr)->InitiatorTaskTag)
+            );
+    if (Tcb == NULL) {
+      NetbufFree (Pdu);
+      return EFI_PROTOCOL_ERROR;
+    }
+  }
+
+  switch (Opcode) {
+  case ISCSI_OPCODE_SCSI_DATA_IN:
+    Status = IScsiOnDataInRcvd (Pdu, Tcb, Tcb->Packet);
+    break;
+
+  case ISCSI_OPCODE_R2T:
+    Status = IScsiOnR2TRcvd (Pdu, Tcb, Tcb->Lun, Tcb->Packet);
+    break;
+
+  case ISCSI_OPCODE_SCSI_RSP:
+    Status = IScsiOnScsiRspRcvd (Pdu, Tcb, Tcb->Packet);
+    break;
+
+  case ISCSI_OPCODE_NOP_IN:
+    Status = IScsiOnNopInRcvd (Pdu, Tcb);
+    break;
+
+  case ISCSI_OPCODE_VENDOR_T0:
+  case ISCSI_OPCODE_VENDOR_T1:
+  case ISCSI_OPCODE_VENDOR_T2:
+    //
+    // These messages are vendor specific. Skip them.
+    //
+    break;
+
+  default:
+    Status = EFI_PROTOCOL_ERROR;
+    break;
+  }
+
+  NetbufFree (Pdu);
+
+  if ((!EFI_ERROR (Status) || (Status == EFI_BAD_BUFFER_SIZE)) && Tcb->StatusXferd) {
+    *Done = (BOOLEAN) (Tcb == WaitTcb);
+
+    if (Tcb->Event != NULL) {
+      //
+      // A nonblocking command gets its status, complete it.
+      //
+      IScsiCompleteAsyncTcb (Tcb, Status);
+      Status = EFI_SUCCESS;
+    }
+  }
+
+  return Status;
+}
+
+
+/**
+  Receive the PDUs of the outstanding SCSI commands and dispatch them to the
+  task control blocks by the initiator task tag, until the status of WaitTcb
+  is transferred. The nonblocking commands whose status arrives in the meantime
+  are completed and their events are signaled.
+
+  @param[in]  Conn             The iSCSI connection.
+  @param[in]  WaitTcb          The task control block to wait for.
+
+  @retval EFI_SUCCES           The status of WaitTcb is transferred.
+  @retval EFI_BAD_BUFFER_SIZE  The buffer of the blocking WaitTcb was not the
+                               proper size for the request.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiWaitForTcb (
+  IN ISCSI_CONNECTION  *Conn,
+  IN ISCSI_TCB         *WaitTcb
+  )
+{
+  EFI_STATUS              Status;
+  EFI_EVENT               TimeoutEvent;
+  UINT64                  Timeout;
+  BOOLEAN                 Done;
+
+  Status        = EFI_SUCCESS;
+  TimeoutEvent  = NULL;
+  Timeout       = 0;
+  Done          = FALSE;
+
+  if (WaitTcb->Packet->Timeout != 0) {
+    Timeout = MultU64x32 (WaitTcb->Packet->Timeout, 4);
+  }
+
+  while (!Done) {
+    //
+    // Start the timeout timer.
+    //
+    if (Timeout != 0) {
+      Status = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, Timeout);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      TimeoutEvent = Conn->TimeoutEvent;
+    }
+
+    Status = IScsiReceiveTcbPdu (Conn, WaitTcb, TimeoutEvent, &Done);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (TimeoutEvent != NULL) {
+    gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
+  }
+
+  return Status;
+}
+
+
+/**
+  Check whether the target has started to send a PDU, without waiting for it.
+  The first byte of the PDU is received and kept in the connection, where
+  IScsiReceivePdu() picks it up.
+
+  @param[in]  Conn             The iSCSI connection.
+
+  @retval EFI_SUCCES           A PDU is arriving.
+  @retval EFI_NOT_READY        Nothing is received from the target.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiProbePdu (
+  IN ISCSI_CONNECTION  *Conn
+  )
+{
+  EFI_STATUS              Status;
+  NET_FRAGMENT            Fragment;
+  NET_BUF                 *Probe;
+
+  if (Conn->RxProbed) {
+    return EFI_SUCCESS;
+  }
+
+  Fragment.Len  = 1;
+  Fragment.Bulk = &Conn->RxProbe;
+
+  Probe = NetbufFromExt (&Fragment, 1, 0, 0, IScsiNbufExtFree, NULL);
+  if (Probe == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Signal the timeout event beforehand, so the receive is canceled at once
+  // unless TCP has the data already. Clear it in case it is not consumed.
+  //
+  gBS->SignalEvent (Conn->TimeoutEvent);
+  Status = TcpIoReceive (&Conn->TcpIo, Probe, FALSE, Conn->TimeoutEvent);
+  gBS->CheckEvent (Conn->TimeoutEvent);
+
+  NetbufFree (Probe);
+
+  if (Status == EFI_TIMEOUT) {
+    return EFI_NOT_READY;
+  } else if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Conn->RxProbed = TRUE;
+  return EFI_SUCCESS;
+}
+
+
+/**
+  Process the PDUs the target has sent for the outstanding SCSI commands,
+  without waiting for more. Only the rest of a PDU which has started to arrive
+  is waited for. The nonblocking commands whose status arrives are completed
+  and their events are signaled.
+
+  @param[in]  Conn             The iSCSI connection.
+
+  @retval EFI_SUCCES           No more PDU is arriving.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiPollTcbs (
+  IN ISCSI_CONNECTION  *Conn
+  )
+{
+  EFI_STATUS              Status;
+  EFI_EVENT               TimeoutEvent;
+  ISCSI_TCB               *Tcb;
+  BOOLEAN                 Done;
+
+  Status = EFI_SUCCESS;
+
+  while (!IsListEmpty (&Conn->Session->TcbList)) {
+    Status = IScsiProbePdu (Conn);
+    if (Status == EFI_NOT_READY) {
+      Status = EFI_SUCCESS;
+      break;
+    } else if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    //
+    // The rest of the PDU is on the way, bound the wait by the timeout of the
+    // oldest command.
+    //
+    Tcb          = NET_LIST_HEAD (&Conn->Session->TcbList, ISCSI_TCB, Link);
+    TimeoutEvent = NULL;
+    if (Tcb->Packet->Timeout != 0) {
+      Status = gBS->SetTimer (
+                      Conn->TimeoutEvent,
+                      TimerRelative,
+                      MultU64x32 (Tcb->Packet->Timeout, 4)
+                      );
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      TimeoutEvent = Conn->TimeoutEvent;
+    }
+
+    Status = IScsiReceiveTcbPdu (Conn, Tcb, TimeoutEvent, &Done);
+
+    if (TimeoutEvent != NULL) {
+      gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  return Status;
+}
+
+
 /**
   Execute the SCSI command issued through the EXT SCSI PASS THRU protocol.
 
@@ -2902,9 +3268,13 @@ IScsiOnNopInRcvd (
   @param[in]       Lun       The LUN.
   @param[in, out]  Packet    The request packet containing IO request, SCSI command
                              buffer and buffers to read/write.
+  @param[in]       Event     If it is NULL, wait for the command to complete. Otherwise
+                             return once the command is sent out; the command is
+                             completed by IScsiPollTcbs() or IScsiWaitForTcb() and
+                             Event is signaled then.
                              
   @retval EFI_SUCCES           The SCSI command is executed and the result is updated to 
-                               the Packet.
+                               the Packet, or the nonblocking command is sent out.
   @retval EFI_DEVICE_ERROR     Session state was not as required.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
   @retval EFI_PROTOCOL_ERROR   There is no such data in the net buffer.
@@ -2917,28 +3287,24 @@ IScsiExecuteScsiCommand (
   IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
   IN UINT8                                           *Target,
   IN UINT64                                          Lun,
-  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event     OPTIONAL
   )
 {
   EFI_STATUS              Status;
   ISCSI_DRIVER_DATA       *Private;
   ISCSI_SESSION           *Session;
-  EFI_EVENT               TimeoutEvent;
   ISCSI_CONNECTION        *Conn;
   ISCSI_TCB               *Tcb;
   NET_BUF                 *Pdu;
   ISCSI_XFER_CONTEXT      *XferContext;
   UINT8                   *Data;
-  ISCSI_IN_BUFFER_CONTEXT InBufferContext;
-  UINT64                  Timeout;
   UINT8                   *PduHdr;
 
   Private       = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
   Session       = Private->Session;
   Status        = EFI_SUCCESS;
   Tcb           = NULL;
-  TimeoutEvent  = NULL;
-  Timeout       = 0;
 
   if (Session->State != SESSION_STATE_LOGGED_IN) {
     Status = EFI_DEVICE_ERROR;
@@ -2952,14 +3318,27 @@ IScsiExecuteScsiCommand (
            ISCSI_CONNECTION_SIGNATURE
            );
 
-  if (Packet->Timeout != 0) {
-    Timeout = MultU64x32 (Packet->Timeout, 4);
+  if (Event == NULL) {
+    //
+    // The command window may be closed by the outstanding nonblocking commands.
+    // Complete them in order until the target can accept this one.
+    //
+    while (ISCSI_SEQ_GT (Session->CmdSN, Session->MaxCmdSN) && !IsListEmpty (&Session->TcbList)) {
+      Status = IScsiWaitForTcb (Conn, NET_LIST_HEAD (&Session->TcbList, ISCSI_TCB, Link));
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+    }
   }
 
   Status = IScsiNewTcb (Conn, &Tcb);
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
   }
+
+  Tcb->Lun    = Lun;
+  Tcb->Packet = Packet;
+
   //
   // Encapsulate the SCSI request packet into an iSCSI SCSI Command PDU.
   //
@@ -3010,78 +3389,20 @@ IScsiExecuteScsiCommand (
     }
   }
 
-  InBufferContext.InData    = (UINT8 *) Packet->InDataBuffer;
-  InBufferContext.InDataLen = Packet->InTransferLength;
-
-  while (!Tcb->StatusXferd) {
+  if (Event != NULL) {
     //
-    // Start the timeout timer.
-    //
-    if (Timeout != 0) {
-      Status = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, Timeout);
-      if (EFI_ERROR (Status)) {
-        goto ON_EXIT;
-      }
-
-      TimeoutEvent = Conn->TimeoutEvent;
-    }
-
-    //
-    // Try to receive PDU from target.
+    // Leave the nonblocking command outstanding. Its R2Ts, data and status are
+    // processed by IScsiPollTcbs() or IScsiWaitForTcb() later, along with the
+    // other commands.
     //
-    Status = IScsiReceivePdu (Conn, &Pdu, &InBufferContext, FALSE, FALSE, TimeoutEvent);
-    if (EFI_ERROR (Status)) {
-      goto ON_EXIT;
-    }
-
-    PduHdr = NetbufGetByte (Pdu, 0, NULL);
-    if (PduHdr == NULL) {
-      Status = EFI_PROTOCOL_ERROR;
-      NetbufFree (Pdu);
-      goto ON_EXIT;
-    }
-    switch (ISCSI_GET_OPCODE (PduHdr)) {
-    case ISCSI_OPCODE_SCSI_DATA_IN:
-      Status = IScsiOnDataInRcvd (Pdu, Tcb, Packet);
-      break;
-
-    case ISCSI_OPCODE_R2T:
-      Status = IScsiOnR2TRcvd (Pdu, Tcb, Lun, Packet);
-      break;
-
-    case ISCSI_OPCODE_SCSI_RSP:
-      Status = IScsiOnScsiRspRcvd (Pdu, Tcb, Packet);
-      break;
-
-    case ISCSI_OPCODE_NOP_IN:
-      Status = IScsiOnNopInRcvd (Pdu, Tcb);
-      break;
-
-    case ISCSI_OPCODE_VENDOR_T0:
-    case ISCSI_OPCODE_VENDOR_T1:
-    case ISCSI_OPCODE_VENDOR_T2:
-      //
-      // These messages are vendor specific. Skip them.
-      //
-      break;
-
-    default:
-      Status = EFI_PROTOCOL_ERROR;
-      break;
-    }
-
-    NetbufFree (Pdu);
-
-    if (EFI_ERROR (Status)) {
-      break;
-    }
+    Tcb->Event = Event;
+    Tcb        = NULL;
+    goto ON_EXIT;
   }
 
-ON_EXIT:
+  Status = IScsiWaitForTcb (Conn, Tcb);
 
-  if (TimeoutEvent != NULL) {
-    gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
-  }
+ON_EXIT:
 
   if (Tcb != NULL) {
     IScsiDelTcb (Tcb);
@@ -3155,8 +3476,8 @@ IScsiSessionInit (
   Session->MaxConnections       = ISCSI_MAX_CONNS_PER_SESSION;
   Session->InitialR2T           = FALSE;
   Session->ImmediateData        = TRUE;
-  Session->MaxBurstLength       = 262144;
-  Session->FirstBurstLength     = MAX_RECV_DATA_SEG_LEN_IN_FFP;
+  Session->MaxBurstLength       = MAX_BURST_LENGTH;
+  Session->FirstBurstLength     = FIRST_BURST_LENGTH;
   Session->DefaultTime2Wait     = 2;
   Session->DefaultTime2Retain   = 20;
   Session->MaxOutstandingR2T    = DEFAULT_MAX_OUTSTANDING_R2T;
@@ -3180,6 +3501,9 @@ IScsiSessionAbort (
 {
   ISCSI_CONNECTION  *Conn;
   EFI_GUID          *ProtocolGuid;
+  LIST_ENTRY        *Entry;
+  LIST_ENTRY        *NextEntry;
+  ISCSI_TCB         *Tcb;
 
   if (Session->State != SESSION_STATE_LOGGED_IN) {
     return ;
@@ -3187,6 +3511,16 @@ IScsiSessionAbort (
 
   ASSERT (!IsListEmpty (&Session->Conns));
 
+  //
+  // The outstanding nonblocking commands are lost together with the connection.
+  //
+  NET_LIST_FOR_EACH_SAFE (Entry, NextEntry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+    if (Tcb->Event != NULL) {
+      IScsiCompleteAsyncTcb (Tcb, EFI_ABORTED);
+    }
+  }
+
   while (!IsListEmpty (&Session->Conns)) {
     Conn = NET_LIST_USER_STRUCT_S (
              Session->Conns.ForwardLink,
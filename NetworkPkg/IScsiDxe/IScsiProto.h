@@ -34,8 +34,10 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define ISCSI_MAX_CONNS_PER_SESSION             1
 
 #define DEFAULT_MAX_RECV_DATA_SEG_LEN           8192
-#define MAX_RECV_DATA_SEG_LEN_IN_FFP            65536
+#define MAX_RECV_DATA_SEG_LEN_IN_FFP            262144
 #define DEFAULT_MAX_OUTSTANDING_R2T             1
+#define MAX_BURST_LENGTH                        16776192
+#define FIRST_BURST_LENGTH                      262144
 
 #define ISCSI_VERSION_MAX                       0x00
 #define ISCSI_VERSION_MIN                       0x00
@@ -614,6 +616,10 @@ typedef struct _ISCSI_TCB {
   ISCSI_XFER_CONTEXT  XferContext;
 
   ISCSI_CONNECTION    *Conn;
+
+  UINT64                                      Lun;
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet;
+  EFI_EVENT                                   Event;  ///< Signaled on completion of a nonblocking request.
 } ISCSI_TCB;
 
 typedef struct _ISCSI_KEY_VALUE_PAIR {
@@ -972,6 +978,62 @@ IScsiNormalizeName (
   IN     UINTN      Len
   );
 
+/**
+  Find the task control block by the initator task tag.
+
+  @param[in]  TcbList         The tcb list.
+  @param[in]  InitiatorTaskTag The initiator task tag.
+
+  @return The task control block found.
+  @retval NULL The task control block cannot be found.
+
+**/
+ISCSI_TCB *
+IScsiFindTcbByITT (
+  IN LIST_ENTRY      *TcbList,
+  IN UINT32          InitiatorTaskTag
+  );
+
+/**
+  Receive the PDUs of the outstanding SCSI commands and dispatch them to the
+  task control blocks by the initiator task tag, until the status of WaitTcb
+  is transferred. The nonblocking commands whose status arrives in the meantime
+  are completed and their events are signaled.
+
+  @param[in]  Conn             The iSCSI connection.
+  @param[in]  WaitTcb          The task control block to wait for.
+
+  @retval EFI_SUCCES           The status of WaitTcb is transferred.
+  @retval EFI_BAD_BUFFER_SIZE  The buffer of the blocking WaitTcb was not the
+                               proper size for the request.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiWaitForTcb (
+  IN ISCSI_CONNECTION  *Conn,
+  IN ISCSI_TCB         *WaitTcb
+  );
+
+/**
+  Process the PDUs the target has sent for the outstanding SCSI commands,
+  without waiting for more. Only the rest of a PDU which has started to arrive
+  is waited for. The nonblocking commands whose status arrives are completed
+  and their events are signaled.
+
+  @param[in]  Conn             The iSCSI connection.
+
+  @retval EFI_SUCCES           No more PDU is arriving.
+  @retval EFI_PROTOCOL_ERROR   Some kind of iSCSI protocol error occurred.
+  @retval Others               Other errors as indicated.
+
+**/
+EFI_STATUS
+IScsiPollTcbs (
+  IN ISCSI_CONNECTION  *Conn
+  );
+
 /**
   Execute the SCSI command issued through the EXT SCSI PASS THRU protocol.
 
@@ -980,9 +1042,13 @@ IScsiNormalizeName (
   @param[in]       Lun       The LUN.
   @param[in, out]  Packet    The request packet containing IO request, SCSI command
                              buffer and buffers to read/write.
+  @param[in]       Event     If it is NULL, wait for the command to complete. Otherwise
+                             return once the command is sent out; the command is
+                             completed by IScsiPollTcbs() or IScsiWaitForTcb() and
+                             Event is signaled then.
                              
   @retval EFI_SUCCES           The SCSI command is executed and the result is updated to 
-                               the Packet.
+                               the Packet, or the nonblocking command is sent out.
   @retval EFI_DEVICE_ERROR     Session state was not as required.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
   @retval EFI_NOT_READY        The target can not accept new commands.
@@ -994,7 +1060,8 @@ IScsiExecuteScsiCommand (
   IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
   IN UINT8                                           *Target,
   IN UINT64                                          Lun,
-  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event     OPTIONAL
   );
 
 /**
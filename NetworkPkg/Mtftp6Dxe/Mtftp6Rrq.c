@@ -60,6 +60,8 @@ Mtftp6RrqSendAck (
   //
   Instance->CurRetry = 0;
   Instance->LastPacket = Packet;
+  Instance->AckedBlock = Instance->TotalBlock;
+  Instance->UnexpectedBlocks = 0;
 
   return Mtftp6TransmitPacket (Instance, Packet);
 }
@@ -126,6 +128,8 @@ Mtftp6RrqSaveBlock (
     return Status;
   }
 
+  Instance->TotalBlock = TotalBlock;
+
   if (Token->CheckPacket != NULL) {
     //
     // Callback to the check packet routine with the received packet.
@@ -232,7 +236,11 @@ Mtftp6RrqHandleData (
   //
   // If we are active and received an unexpected packet, retransmit
   // the last ACK then restart receiving. If we are passive, save
-  // the block.
+  // the block. When a window of blocks is in flight, acknowledge the
+  // last in-order block once so that the server restarts the window
+  // from there, and ignore the rest of the window. A whole window of
+  // unexpected blocks means the server is resending it because our ACK
+  // was lost, so acknowledge again, at most once per window (RFC 7440).
   //
   if (Instance->IsMaster && (Expected != BlockNum)) {
     //
@@ -242,7 +250,14 @@ Mtftp6RrqHandleData (
     NetbufFree (*UdpPacket);
     *UdpPacket = NULL;
 
-    Mtftp6TransmitPacket (Instance, Instance->LastPacket);
+    if (Instance->AckedBlock != Instance->TotalBlock) {
+      Mtftp6RrqSendAck (Instance, (UINT16) (Expected - 1));
+    } else if (Instance->WindowSize == 1) {
+      Mtftp6TransmitPacket (Instance, Instance->LastPacket);
+    } else if (++Instance->UnexpectedBlocks >= Instance->WindowSize) {
+      Mtftp6RrqSendAck (Instance, (UINT16) (Expected - 1));
+    }
+
     return EFI_SUCCESS;
   }
 
@@ -254,9 +269,12 @@ Mtftp6RrqHandleData (
 
   //
   // Reset the passive client's timer whenever it received a valid data packet.
+  // So does the active client within a window as it doesn't ACK every block.
   //
   if (!Instance->IsMaster) {
     Instance->PacketToLive = Instance->Timeout * 2;
+  } else if (Instance->WindowSize > 1) {
+    Instance->PacketToLive = Instance->Timeout;
   }
 
   //
@@ -280,6 +298,13 @@ Mtftp6RrqHandleData (
 
     } else {
       BlockNum     = (UINT16) (Expected - 1);
+
+      //
+      // Only acknowledge the last block of each window.
+      //
+      if ((Instance->TotalBlock - Instance->AckedBlock) < Instance->WindowSize) {
+        return EFI_SUCCESS;
+      }
     }
     //
     // Free the received packet before send new packet in ReceiveNotify,
@@ -302,6 +327,7 @@ Mtftp6RrqHandleData (
   2. The server can only use smaller blksize than that is requested.
   3. The server can only use the same timeout as requested.
   4. The server doesn't change its multicast channel.
+  5. The server can only use smaller windowsize than that is requested.
 
   @param[in]  Instance              The pointer to the Mtftp6 instance.
   @param[in]  ReplyInfo             The pointer to options information in reply packet.
@@ -335,6 +361,13 @@ Mtftp6RrqOackValid (
     return FALSE;
   }
 
+  //
+  // Server can only specify a smaller window size to be used.
+  //
+  if (((ReplyInfo->BitMap & MTFTP6_OPT_WINDOWSIZE_BIT) != 0) && (ReplyInfo->WindowSize > RequestInfo->WindowSize)) {
+    return FALSE;
+  }
+
   //
   // The server can send ",,master" to client to change its master
   // setting. But if it use the specific multicast channel, it can't
@@ -628,6 +661,13 @@ Mtftp6RrqHandleOack (
     if (ExtInfo.Timeout != 0) {
       Instance->Timeout = ExtInfo.Timeout;
     }
+
+    //
+    // The window size is only used by the unicast download.
+    //
+    if (ExtInfo.WindowSize != 0) {
+      Instance->WindowSize = ExtInfo.WindowSize;
+    }
   }
 
   //
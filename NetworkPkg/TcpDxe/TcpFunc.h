@@ -366,6 +366,22 @@ TcpRetransmit (
   IN TCP_SEQNO Seq
   );
 
+/**
+  Retransmit the next hole in the sequence space reported by SACK.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Ack     The first unacknowledged sequence number.
+
+  @retval 1       A hole was retransmitted.
+  @retval 0       There is no hole to retransmit, or an error occurred.
+
+**/
+INTN
+TcpSackRetransmit (
+  IN TCP_CB    *Tcb,
+  IN TCP_SEQNO Ack
+  );
+
 /**
   Check whether to send data/SYN/FIN and piggyback an ACK.
 
@@ -70,7 +70,13 @@ TcpFastRecover (
     //
     // Step 2: Entering fast retransmission
     //
-    TcpRetransmit (Tcb, Tcb->SndUna);
+    if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK)) {
+      Tcb->SndRxtNxt = Tcb->SndUna;
+      TcpSackRetransmit (Tcb, Tcb->SndUna);
+    } else {
+      TcpRetransmit (Tcb, Tcb->SndUna);
+    }
+
     Tcb->CWnd = Tcb->Ssthresh + 3 * Tcb->SndMss;
 
     DEBUG (
@@ -95,7 +101,14 @@ TcpFastRecover (
     // Step 4 is skipped here only to be executed later
     // by TcpToSendData
     //
-    Tcb->CWnd += Tcb->SndMss;
+    // If SACK tells there is another hole, retransmit it
+    // in place of the new data the CWnd inflation allows.
+    //
+    if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK) ||
+        (TcpSackRetransmit (Tcb, Tcb->SndUna) == 0)) {
+      Tcb->CWnd += Tcb->SndMss;
+    }
+
     DEBUG (
       (EFI_D_NET,
       "TcpFastRecover: received another duplicated ACK (%d) for TCB %p\n",
@@ -132,9 +145,15 @@ TcpFastRecover (
       //
       // Step 5 - Partial ACK:
       // fast retransmit the first unacknowledge field
-      // , then deflate the CWnd
+      // , then deflate the CWnd. With SACK, the first
+      // unacknowledged field may have been retransmitted
+      // already, retransmit the next hole then.
       //
-      TcpRetransmit (Tcb, Seg->Ack);
+      if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK)) {
+        TcpSackRetransmit (Tcb, Seg->Ack);
+      } else {
+        TcpRetransmit (Tcb, Seg->Ack);
+      }
       Acked = TCP_SUB_SEQ (Seg->Ack, Tcb->SndUna);
 
       //
@@ -211,6 +230,156 @@ TcpFastLossRecover (
   }
 }
 
+/**
+  Update the SACK scoreboard with the blocks received from the peer. A
+  segment on the SndQue is marked as SACKed if a block covers all of it.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Seg      Segment that carries the SACK option.
+  @param[in]       Option   The options parsed from the segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB     *Tcb,
+  IN     TCP_SEG    *Seg,
+  IN     TCP_OPTION *Option
+  )
+{
+  LIST_ENTRY      *Entry;
+  TCP_SEG         *Node;
+  TCP_SACK_BLOCK  *Block;
+  TCP_SEQNO       MaxSndNxt;
+  UINT8           Index;
+
+  MaxSndNxt = TcpGetMaxSndNxt (Tcb);
+
+  for (Index = 0; Index < Option->SackNum; Index++) {
+    Block = &Option->Sack[Index];
+
+    //
+    // Ignore the D-SACK blocks and the invalid ones.
+    //
+    if (TCP_SEQ_LEQ (Block->Left, Seg->Ack) ||
+        TCP_SEQ_LEQ (Block->Right, Block->Left) ||
+        TCP_SEQ_GT (Block->Right, MaxSndNxt)) {
+
+      continue;
+    }
+
+    NET_LIST_FOR_EACH (Entry, &Tcb->SndQue) {
+      Node = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+
+      if (TCP_SEQ_LEQ (Block->Right, Node->Seq)) {
+        break;
+      }
+
+      if (TCP_SEQ_LEQ (Block->Left, Node->Seq) && TCP_SEQ_LEQ (Node->End, Block->Right)) {
+        Node->Sacked = TRUE;
+      }
+    }
+
+    if (TCP_SEQ_GT (Block->Right, Tcb->SndSackMax)) {
+      Tcb->SndSackMax = Block->Right;
+    }
+  }
+}
+
+/**
+  Auto-tune the receive buffer. Once per RTT, measure how much data was
+  received during the last RTT and grow the receive buffer to twice the
+  largest amount seen, so that the advertised window doesn't limit a peer
+  on a path with a large bandwidth-delay product.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+VOID
+TcpRcvSpaceAdjust (
+  IN OUT TCP_CB *Tcb
+  )
+{
+  UINT32  Rtt;
+  UINT32  Space;
+
+  //
+  // The window can't be advertised beyond 64K without window scale.
+  //
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_WS)) {
+    return;
+  }
+
+  Rtt = MAX (Tcb->SRtt >> TCP_RTT_SHIFT, 1);
+  if (TCP_SUB_TIME (mTcpTick, Tcb->RcvSpaceTime) < Rtt) {
+    return;
+  }
+
+  Space             = TCP_SUB_SEQ (Tcb->RcvNxt, Tcb->RcvSpaceSeq);
+  Tcb->RcvSpaceSeq  = Tcb->RcvNxt;
+  Tcb->RcvSpaceTime = mTcpTick;
+
+  if (Space <= Tcb->RcvSpace) {
+    return;
+  }
+
+  Tcb->RcvSpace = Space;
+  Space         = MIN (Space, TCP_RCV_BUF_SIZE_MAX / 2) * 2;
+
+  if (Space > GET_RCV_BUFFSIZE (Tcb->Sk)) {
+    DEBUG (
+      (EFI_D_NET,
+      "TcpRcvSpaceAdjust: grow the receive buffer to %d for TCB %p\n",
+      Space,
+      Tcb)
+      );
+
+    SET_RCV_BUFFSIZE (Tcb->Sk, Space);
+  }
+}
+
+/**
+  Check whether a segment can take the receive fast path, that is, the
+  header prediction: it is the next in-sequence data segment on an
+  established connection, and it carries nothing but the data and an ACK
+  that neither acknowledges new data nor changes the send window.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Nbuf     Pointer to the headless buffer of the segment.
+  @param[in]  Option   The options parsed from the segment.
+
+  @retval TRUE         The segment can be processed by the fast path.
+  @retval FALSE        The segment needs the full processing.
+
+**/
+BOOLEAN
+TcpPredictSegment (
+  IN TCP_CB     *Tcb,
+  IN NET_BUF    *Nbuf,
+  IN TCP_OPTION *Option
+  )
+{
+  TCP_SEG *Seg;
+
+  Seg = TCPSEG_NETBUF (Nbuf);
+
+  return (BOOLEAN) (
+           (Tcb->State == TCP_ESTABLISHED) &&
+           ((Seg->Flag & (TCP_FLG_SYN | TCP_FLG_FIN | TCP_FLG_RST | TCP_FLG_URG | TCP_FLG_ACK)) == TCP_FLG_ACK) &&
+           (Nbuf->TotalSize != 0) &&
+           (Seg->Seq == Tcb->RcvNxt) &&
+           TCP_SEQ_LEQ (Seg->End, Tcb->RcvWl2 + Tcb->RcvWnd) &&
+           IsListEmpty (&Tcb->RcvQue) &&
+           (Seg->Ack == Tcb->SndUna) &&
+           (Seg->Ack == Tcb->SndNxt) &&
+           (Seg->Ack == Tcb->SndWl2) &&
+           (Seg->Wnd == Tcb->SndWnd) &&
+           (Tcb->CongestState == TCP_CONGEST_OPEN) &&
+           !Tcb->ProbeTimerOn &&
+           !TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_RCVD_URG | TCP_CTRL_RTT_ON) &&
+           (!TCP_FLG_ON (Option->Flag, TCP_OPTION_RCVD_TS) || TCP_TIME_LEQ (Tcb->TsRecent, Option->TSVal))
+           );
+}
+
 /**
   Compute the RTT as specified in RFC2988.
 
@@ -552,6 +721,7 @@ TcpDeliverData (
     NetbufFree (Nbuf);
   }
 
+  TcpRcvSpaceAdjust (Tcb);
   return 0;
 }
 
@@ -581,6 +751,12 @@ TcpQueueData (
   Seg   = TCPSEG_NETBUF (Nbuf);
   Head  = &Tcb->RcvQue;
 
+  //
+  // Remember the latest segment, it is reported
+  // first in the SACK option.
+  //
+  Tcb->RcvSackSeq = Seg->Seq;
+
   //
   // Fast path to process normal case. That is,
   // no out-of-order segments are received.
@@ -823,6 +999,49 @@ TcpInput (
   NetbufTrim (Nbuf, (Head->HeadLen << 2), NET_BUF_HEAD);
   Nbuf->Tcp = NULL;
 
+  //
+  // Receive fast path: the next in-sequence data segment of a
+  // bulk transfer is delivered to the socket directly, skipping
+  // the state machine below.
+  //
+  if (TcpPredictSegment (Tcb, Nbuf, &Option)) {
+
+    //
+    // The ACK of a predicted segment doesn't advance SndUna, so its
+    // TSEcr echoes an old segment and isn't used to update the RTT.
+    //
+    if (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_TS) &&
+        (Seg->Seq == Tcb->RcvWl2)) {
+
+      Tcb->TsRecent     = Option.TSVal;
+      Tcb->TsRecentAge  = mTcpTick;
+    }
+
+    if (Tcb->IpInfo->IpVersion == IP_VERSION_6 && Tcb->Tick == 0) {
+      Tcp6RefreshNeighbor (Tcb, Src, TCP6_KEEP_NEIGHBOR_TIME * TICKS_PER_SECOND);
+      Tcb->Tick = TCP6_REFRESH_NEIGHBOR_TICK;
+    }
+
+    TcpClearTimer (Tcb, TCP_TIMER_REXMIT);
+    Tcb->DupAck = 0;
+    Tcb->SndWl1 = Seg->Seq;
+
+    Tcb->Idle   = 0;
+    TcpSetKeepaliveTimer (Tcb);
+
+    Tcb->RcvNxt = Seg->End;
+
+    if (TCP_FLG_ON (Seg->Flag, TCP_FLG_PSH)) {
+
+      TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_ACK_NOW);
+    }
+
+    SockDataRcvd (Tcb->Sk, Nbuf, 0);
+    TcpRcvSpaceAdjust (Tcb);
+
+    goto StepOutput;
+  }
+
   //
   // Process the segment in LISTEN state.
   //
@@ -1211,6 +1430,15 @@ TcpInput (
     TcpSetTimer (Tcb, TCP_TIMER_REXMIT, Tcb->Rto);
   }
 
+  //
+  // Update the SACK scoreboard before the loss recovery uses it.
+  //
+  if (TCP_FLG_ON (Option.Flag, TCP_OPTION_RCVD_SACK) &&
+      TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK)) {
+
+    TcpSackUpdate (Tcb, Seg, &Option);
+  }
+
   //
   // Count duplicate acks.
   //
@@ -1259,6 +1487,10 @@ TcpInput (
     TcpAdjustSndQue (Tcb, Seg->Ack);
     Tcb->SndUna = Seg->Ack;
 
+    if (TCP_SEQ_LT (Tcb->SndSackMax, Seg->Ack)) {
+      Tcb->SndSackMax = Seg->Ack;
+    }
+
     if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SND_URG) &&
         TCP_SEQ_LT (Tcb->SndUp, Seg->Ack))
     {
@@ -1515,6 +1747,8 @@ StepSix:
     TcpInsertTcb (Tcb);
   }
 
+StepOutput:
+
   if ((Tcb->State != TCP_CLOSED) &&
       (TcpToSendData (Tcb, 0) == 0) &&
       (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_ACK_NOW) || (Nbuf->TotalSize != 0)))
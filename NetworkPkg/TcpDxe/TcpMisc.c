@@ -80,6 +80,9 @@ TcpInitTcbLocal (
   Tcb->SndWl2 = Tcb->Iss;
   Tcb->SndWnd = 536;
 
+  Tcb->SndSackMax = Tcb->Iss;
+  Tcb->SndRxtNxt  = Tcb->Iss;
+
   Tcb->RcvWnd = GET_RCV_BUFFSIZE (Tcb->Sk);
 
   //
@@ -143,6 +146,11 @@ TcpInitTcbPeer (
 
   Tcb->RcvWl2 = Tcb->RcvNxt;
 
+  Tcb->RcvSackSeq   = Tcb->RcvNxt;
+  Tcb->RcvSpaceSeq  = Tcb->RcvNxt;
+  Tcb->RcvSpaceTime = mTcpTick;
+  Tcb->RcvSpace     = 0;
+
   if (TCP_FLG_ON (Opt->Flag, TCP_OPTION_RCVD_WS) && !TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_WS)) {
 
     Tcb->SndWndScale  = Opt->WndScale;
@@ -171,6 +179,14 @@ TcpInitTcbPeer (
     //
     Tcb->SndMss -= TCP_OPTION_TS_ALIGNED_LEN;
   }
+
+  if (TCP_FLG_ON (Opt->Flag, TCP_OPTION_RCVD_SACK_PERM)) {
+
+    TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_SACK);
+  } else {
+
+    TCP_CLEAR_FLG (Tcb->CtrlFlag, TCP_CTRL_SACK);
+  }
 }
 
 /**
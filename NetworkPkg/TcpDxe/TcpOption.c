@@ -71,6 +71,9 @@ TcpPutUint32 (
 /**
   Compute the window scale value according to the given buffer size.
 
+  The receive buffer may be grown by auto-tuning after the connection is
+  established, so the scale is large enough for TCP_RCV_BUF_SIZE_MAX.
+
   @param[in]  Tcb Pointer to the TCP_CB of this TCP instance.
 
   @return         The scale value.
@@ -86,7 +89,7 @@ TcpComputeScale (
 
   ASSERT ((Tcb != NULL) && (Tcb->Sk != NULL));
 
-  BufSize = GET_RCV_BUFFSIZE (Tcb->Sk);
+  BufSize = MAX (GET_RCV_BUFFSIZE (Tcb->Sk), TCP_RCV_BUF_SIZE_MAX);
 
   Scale   = 0;
   while ((Scale < TCP_OPTION_MAX_WS) && ((UINT32) (TCP_OPTION_MAX_WIN << Scale) < BufSize)) {
@@ -165,6 +168,26 @@ TcpSynBuildOption (
     TcpPutUint32 (Data, TCP_OPTION_WS_FAST | TcpComputeScale (Tcb));
   }
 
+  //
+  // Build SACK permitted option if we are doing active
+  // open or we have received it from peer.
+  //
+  if (!TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_ACK) ||
+      TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK)
+      ) {
+
+    Data = NetbufAllocSpace (
+             Nbuf,
+             TCP_OPTION_SACK_PERM_ALIGNED_LEN,
+             NET_BUF_HEAD
+             );
+
+    ASSERT (Data != NULL);
+
+    Len += TCP_OPTION_SACK_PERM_ALIGNED_LEN;
+    TcpPutUint32 (Data, TCP_OPTION_SACK_PERM_FAST);
+  }
+
   //
   // Build the MSS option.
   //
@@ -177,6 +200,112 @@ TcpSynBuildOption (
   return Len;
 }
 
+/**
+  Get the range of contiguous sequence space on the reassemble queue that
+  starts at the given entry.
+
+  @param[in]   Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]   Entry   The entry on Tcb->RcvQue that starts the range.
+  @param[out]  Block   The sequence space of the range.
+
+  @return      The first entry on Tcb->RcvQue after the range.
+
+**/
+LIST_ENTRY *
+TcpGetRcvRange (
+  IN     TCP_CB         *Tcb,
+  IN     LIST_ENTRY     *Entry,
+     OUT TCP_SACK_BLOCK *Block
+  )
+{
+  TCP_SEG *Seg;
+
+  Seg          = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+  Block->Left  = Seg->Seq;
+  Block->Right = Seg->End;
+
+  for (Entry = Entry->ForwardLink; Entry != &Tcb->RcvQue; Entry = Entry->ForwardLink) {
+    Seg = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+
+    if (Seg->Seq != Block->Right) {
+      break;
+    }
+
+    Block->Right = Seg->End;
+  }
+
+  return Entry;
+}
+
+/**
+  Build the SACK option that reports the out-of-order data held on the
+  reassemble queue. As RFC2018 requires, the first block contains the most
+  recently received segment, and the rest follow in sequence order.
+
+  @param[in]  Tcb       Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Nbuf      Pointer to the buffer to store the options.
+  @param[in]  MaxBlock  The maximum number of SACK blocks to build.
+
+  @return               The length of the SACK option.
+
+**/
+UINT16
+TcpBuildSackOption (
+  IN TCP_CB  *Tcb,
+  IN NET_BUF *Nbuf,
+  IN UINT8   MaxBlock
+  )
+{
+  TCP_SACK_BLOCK  Block[TCP_OPTION_MAX_SACK_BLOCK];
+  TCP_SACK_BLOCK  Range;
+  LIST_ENTRY      *Entry;
+  UINT8           *Data;
+  UINT8           Count;
+  UINT8           Index;
+  UINT16          Len;
+
+  ASSERT (MaxBlock <= TCP_OPTION_MAX_SACK_BLOCK);
+
+  Count = 0;
+  Entry = Tcb->RcvQue.ForwardLink;
+
+  while (Entry != &Tcb->RcvQue) {
+    Entry = TcpGetRcvRange (Tcb, Entry, &Range);
+
+    if (TCP_SEQ_LEQ (Range.Left, Tcb->RcvSackSeq) && TCP_SEQ_LT (Tcb->RcvSackSeq, Range.Right)) {
+      CopyMem (&Block[Count++], &Range, sizeof (TCP_SACK_BLOCK));
+      break;
+    }
+  }
+
+  Entry = Tcb->RcvQue.ForwardLink;
+
+  while ((Entry != &Tcb->RcvQue) && (Count < MaxBlock)) {
+    Entry = TcpGetRcvRange (Tcb, Entry, &Range);
+
+    if ((Count == 0) || (Range.Left != Block[0].Left)) {
+      CopyMem (&Block[Count++], &Range, sizeof (TCP_SACK_BLOCK));
+    }
+  }
+
+  if (Count == 0) {
+    return 0;
+  }
+
+  Len  = (UINT16) (TCP_OPTION_SACK_ALIGNED_LEN + Count * TCP_OPTION_SACK_BLOCK_LEN);
+  Data = NetbufAllocSpace (Nbuf, Len, NET_BUF_HEAD);
+  ASSERT (Data != NULL);
+
+  TcpPutUint32 (Data, TCP_OPTION_SACK_FAST | (TCP_OPTION_SACK_LEN + Count * TCP_OPTION_SACK_BLOCK_LEN));
+
+  for (Index = 0; Index < Count; Index++) {
+    TcpPutUint32 (Data + 4 + Index * TCP_OPTION_SACK_BLOCK_LEN, Block[Index].Left);
+    TcpPutUint32 (Data + 8 + Index * TCP_OPTION_SACK_BLOCK_LEN, Block[Index].Right);
+  }
+
+  return Len;
+}
+
 /**
   Build the TCP option in synchronized states.
 
@@ -194,9 +323,11 @@ TcpBuildOption (
 {
   UINT8   *Data;
   UINT16  Len;
+  UINT32  DataLen;
 
   ASSERT ((Tcb != NULL) && (Nbuf != NULL) && (Nbuf->Tcp == NULL));
-  Len = 0;
+  Len     = 0;
+  DataLen = Nbuf->TotalSize;
 
   //
   // Build the Timestamp option.
@@ -219,6 +350,24 @@ TcpBuildOption (
     TcpPutUint32 (Data + 8, Tcb->TsRecent);
   }
 
+  //
+  // Build the SACK option if there is out-of-order data. It is
+  // only carried by segments without data, the SndMss doesn't
+  // leave room for it in a full sized data segment.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK) &&
+      (DataLen == 0) &&
+      !IsListEmpty (&Tcb->RcvQue) &&
+      !TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_RST)
+      ) {
+
+    Len = (UINT16) (Len + TcpBuildSackOption (
+                           Tcb,
+                           Nbuf,
+                           (UINT8) ((Len == 0) ? TCP_OPTION_MAX_SACK_BLOCK : TCP_OPTION_MAX_SACK_BLOCK - 1)
+                           ));
+  }
+
   return Len;
 }
 
@@ -244,6 +393,7 @@ TcpParseOption (
   UINT8 Cur;
   UINT8 Type;
   UINT8 Len;
+  UINTN Index;
 
   ASSERT ((Tcp != NULL) && (Option != NULL));
 
@@ -319,6 +469,45 @@ TcpParseOption (
       Cur += TCP_OPTION_TS_LEN;
       break;
 
+    case TCP_OPTION_SACK_PERM:
+      Len = Head[Cur + 1];
+
+      if ((Len != TCP_OPTION_SACK_PERM_LEN) || (TotalLen - Cur < TCP_OPTION_SACK_PERM_LEN)) {
+
+        return -1;
+      }
+
+      TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK_PERM);
+
+      Cur += TCP_OPTION_SACK_PERM_LEN;
+      break;
+
+    case TCP_OPTION_SACK:
+      Len = Head[Cur + 1];
+
+      if ((Len < TCP_OPTION_SACK_LEN + TCP_OPTION_SACK_BLOCK_LEN) ||
+          ((Len - TCP_OPTION_SACK_LEN) % TCP_OPTION_SACK_BLOCK_LEN != 0) ||
+          (TotalLen - Cur < Len)) {
+
+        return -1;
+      }
+
+      Option->SackNum = 0;
+      for (Index = Cur + TCP_OPTION_SACK_LEN; Index < Cur + Len; Index += TCP_OPTION_SACK_BLOCK_LEN) {
+        if (Option->SackNum == TCP_OPTION_MAX_SACK_BLOCK) {
+          break;
+        }
+
+        Option->Sack[Option->SackNum].Left  = TcpGetUint32 (&Head[Index]);
+        Option->Sack[Option->SackNum].Right = TcpGetUint32 (&Head[Index + 4]);
+        Option->SackNum++;
+      }
+
+      TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK);
+
+      Cur = (UINT8) (Cur + Len);
+      break;
+
     case TCP_OPTION_NOP:
       Cur++;
       break;
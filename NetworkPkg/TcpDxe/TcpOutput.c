@@ -731,6 +731,67 @@ OnError:
   return -1;
 }
 
+/**
+  Retransmit the next hole in the sequence space reported by SACK, as the
+  loss recovery of RFC6675 does. The first unacknowledged segment is always
+  a hole, the other holes are the segments not SACKed below the highest
+  SACKed sequence. Each hole is retransmitted once per recovery, the search
+  continues from Tcb->SndRxtNxt.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Ack     The first unacknowledged sequence number.
+
+  @retval 1       A hole was retransmitted.
+  @retval 0       There is no hole to retransmit, or an error occurred.
+
+**/
+INTN
+TcpSackRetransmit (
+  IN TCP_CB    *Tcb,
+  IN TCP_SEQNO Ack
+  )
+{
+  LIST_ENTRY      *Entry;
+  TCP_SEG         *Seg;
+  TCP_SEQNO       Seq;
+  TCP_SEQNO       End;
+
+  NET_LIST_FOR_EACH (Entry, &Tcb->SndQue) {
+    Seg = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+
+    if (TCP_SEQ_LEQ (Seg->End, Ack) || Seg->Sacked) {
+      continue;
+    }
+
+    Seq = TCP_SEQ_LT (Seg->Seq, Ack) ? Ack : Seg->Seq;
+    End = Seg->End;
+
+    if ((Seq != Ack) && TCP_SEQ_GEQ (Seq, Tcb->SndSackMax)) {
+      break;
+    }
+
+    if (TCP_SEQ_LT (Seq, Tcb->SndRxtNxt)) {
+      continue;
+    }
+
+    if (TcpRetransmit (Tcb, Seq) != 0) {
+      return 0;
+    }
+
+    DEBUG (
+      (EFI_D_NET,
+      "TcpSackRetransmit: retransmit hole at %d for TCB %p\n",
+      Seq,
+      Tcb)
+      );
+
+    Tcb->SndRxtNxt = End;
+    return 1;
+  }
+
+  return 0;
+}
+
 /**
   Verify that all the segments in SndQue are in good shape.
 
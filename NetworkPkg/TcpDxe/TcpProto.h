@@ -78,6 +78,7 @@
 #define TCP_CTRL_TIMER_ON        0x1000 ///< At least one of the timer is on.
 #define TCP_CTRL_RTT_ON          0x2000 ///< The RTT measurement is on.
 #define TCP_CTRL_ACK_NOW         0x4000 ///< Send the ACK now, don't delay.
+#define TCP_CTRL_SACK            0x8000 ///< Both ends permit SACK option.
 
 //
 // Timer related values
@@ -119,6 +120,7 @@
 //
 #define TCP_RCV_BUF_SIZE         (2 * 1024 * 1024)
 #define TCP_RCV_BUF_SIZE_MIN     (8 * 1024)
+#define TCP_RCV_BUF_SIZE_MAX     (8 * 1024 * 1024)  ///< Limit of receive buffer auto-tuning.
 #define TCP_SND_BUF_SIZE         (2 * 1024 * 1024)
 #define TCP_SND_BUF_SIZE_MIN     (8 * 1024)
 #define TCP_BACKLOG              10
@@ -223,6 +225,7 @@ typedef struct _TCP_SEG {
   UINT8     Flag; ///< TCP header flags.
   UINT16    Urg;  ///< Valid if URG flag is set.
   UINT32    Wnd;  ///< TCP window size field.
+  BOOLEAN   Sacked; ///< Segment on SndQue that is SACKed by the peer.
 } TCP_SEG;
 
 ///
@@ -294,6 +297,22 @@ struct _TCP_CONTROL_BLOCK {
   UINT32            TsRecent;     ///< TsRecent to echo to the remote peer.
   UINT32            TsRecentAge;  ///< When this TsRecent is updated.
 
+  //
+  // RFC2018 and RFC6675 defined variables, about selective
+  // acknowledgment
+  //
+  TCP_SEQNO         RcvSackSeq;   ///< Seq of the latest out-of-order segment queued.
+  TCP_SEQNO         SndSackMax;   ///< Highest sequence number SACKed by the peer.
+  TCP_SEQNO         SndRxtNxt;    ///< Where to look for the next hole to retxmit.
+
+  //
+  // Receive buffer auto-tuning, the buffer grows to twice
+  // the amount of data received in one RTT.
+  //
+  TCP_SEQNO         RcvSpaceSeq;  ///< RcvNxt when the current measurement started.
+  UINT32            RcvSpaceTime; ///< mTcpTick when the current measurement started.
+  UINT32            RcvSpace;     ///< Most data received in one RTT so far.
+
   //
   // RFC2988 defined variables. about RTT measurement
   //
@@ -190,7 +190,8 @@ TcpRexmitTimeout (
   IN OUT TCP_CB *Tcb
   )
 {
-  UINT32  FlightSize;
+  UINT32      FlightSize;
+  LIST_ENTRY  *Entry;
 
   DEBUG (
     (EFI_D_WARN,
@@ -226,6 +227,16 @@ TcpRexmitTimeout (
     return ;
   }
 
+  //
+  // The peer may discard the data it has SACKed, so RFC2018
+  // requires to forget the SACK information on timeout.
+  //
+  NET_LIST_FOR_EACH (Entry, &Tcb->SndQue) {
+    TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List))->Sacked = FALSE;
+  }
+
+  Tcb->SndSackMax = Tcb->SndUna;
+
   TcpBackoffRto (Tcb);
   TcpRetransmit (Tcb, Tcb->SndUna);
   TcpSetTimer (Tcb, TCP_TIMER_REXMIT, Tcb->Rto);
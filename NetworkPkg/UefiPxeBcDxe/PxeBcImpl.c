@@ -225,6 +225,16 @@ EfiPxeBcStart (
     Private->BlockSize   = (UINTN) PcdGet64 (PcdTftpBlockSize);
   }
 
+  //
+  // Request the TFTP windowsize option for downloads, RFC 7440 allows 1 to
+  // 65535 blocks.
+  //
+  Private->WindowSize = PcdGet16 (PcdTftpWindowSize);
+  if (Private->WindowSize == 0) {
+    DEBUG ((EFI_D_WARN, "EfiPxeBcStart: PcdTftpWindowSize 0 is out of range, windowsize option disabled.\n"));
+    Private->WindowSize = 1;
+  }
+
   //
   // Create event for UdpRead/UdpWrite timeout since they are both blocking API.
   //
@@ -19,7 +19,8 @@ CHAR8 *mMtftpOptions[PXE_MTFTP_OPTION_MAXIMUM_INDEX] = {
   "blksize",
   "timeout",
   "tsize",
-  "multicast"
+  "multicast",
+  "windowsize"
 };
 
 
@@ -257,9 +258,10 @@ PxeBcMtftp6ReadFile (
 {
   EFI_MTFTP6_PROTOCOL                 *Mtftp6;
   EFI_MTFTP6_TOKEN                    Token;
-  EFI_MTFTP6_OPTION                   ReqOpt[1];
+  EFI_MTFTP6_OPTION                   ReqOpt[2];
   UINT32                              OptCnt;
   UINT8                               OptBuf[128];
+  UINT8                               WindowSizeBuf[8];
   EFI_STATUS                          Status;
 
   Status                    = EFI_DEVICE_ERROR;
@@ -279,6 +281,13 @@ PxeBcMtftp6ReadFile (
     OptCnt++;
   }
 
+  if (Private->WindowSize > 1) {
+    ReqOpt[OptCnt].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_WINDOWSIZE_INDEX];
+    ReqOpt[OptCnt].ValueStr  = WindowSizeBuf;
+    PxeBcUintnToAscDec (Private->WindowSize, ReqOpt[OptCnt].ValueStr, sizeof (WindowSizeBuf));
+    OptCnt++;
+  }
+
   Token.Event         = NULL;
   Token.OverrideData  = NULL;
   Token.Filename      = Filename;
@@ -703,9 +712,10 @@ PxeBcMtftp4ReadFile (
 {
   EFI_MTFTP4_PROTOCOL *Mtftp4;
   EFI_MTFTP4_TOKEN    Token;
-  EFI_MTFTP4_OPTION   ReqOpt[1];
+  EFI_MTFTP4_OPTION   ReqOpt[2];
   UINT32              OptCnt;
   UINT8               OptBuf[128];
+  UINT8               WindowSizeBuf[8];
   EFI_STATUS          Status;
 
   Status                    = EFI_DEVICE_ERROR;
@@ -725,6 +735,13 @@ PxeBcMtftp4ReadFile (
     OptCnt++;
   }
 
+  if (Private->WindowSize > 1) {
+    ReqOpt[OptCnt].OptionStr = (UINT8 *) mMtftpOptions[PXE_MTFTP_OPTION_WINDOWSIZE_INDEX];
+    ReqOpt[OptCnt].ValueStr  = WindowSizeBuf;
+    PxeBcUintnToAscDec (Private->WindowSize, ReqOpt[OptCnt].ValueStr, sizeof (WindowSizeBuf));
+    OptCnt++;
+  }
+
   Token.Event         = NULL;
   Token.OverrideData  = NULL;
   Token.Filename      = Filename;
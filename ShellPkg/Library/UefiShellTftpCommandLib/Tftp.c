@@ -164,6 +164,7 @@ GetFileSize (
   @param[in]   AsciiFilePath  Path of the file, ASCII encoded
   @param[in]   FileSize       Size of the file in number of bytes
   @param[in]   BlockSize      Value of the TFTP blksize option
+  @param[in]   WindowSize     Value of the TFTP windowsize option
   @param[out]  Data           Address where to store the address of the buffer
                               where the data of the file were downloaded in
                               case of success.
@@ -182,9 +183,26 @@ DownloadFile (
   IN   CONST CHAR8          *AsciiFilePath,
   IN   UINTN                FileSize,
   IN   UINT16               BlockSize,
+  IN   UINT16               WindowSize,
   OUT  VOID                 **Data
   );
 
+/**
+  Get the largest TFTP block size that fits in a single Ethernet frame of the
+  network interface, so that every DATA packet travels unfragmented.
+
+  @param[in]  ControllerHandle  Controller handle.
+
+  @return  The block size derived from the media MTU, or MTFTP_DEFAULT_BLKSIZE
+           if the MTU of the interface cannot be retrieved.
+
+**/
+STATIC
+UINT16
+GetNicBlockSize (
+  IN  EFI_HANDLE  ControllerHandle
+  );
+
 /**
   Update the progress of a file download
   This procedure is called each time a new TFTP packet is received.
@@ -226,6 +244,7 @@ STATIC CONST SHELL_PARAM_ITEM ParamList[] = {
   {L"-c", TypeValue},
   {L"-t", TypeValue},
   {L"-s", TypeValue},
+  {L"-w", TypeValue},
   {NULL , TypeMax}
   };
 
@@ -238,6 +257,22 @@ STATIC CONST SHELL_PARAM_ITEM ParamList[] = {
 ///
 #define MTFTP_MIN_BLKSIZE          8
 #define MTFTP_MAX_BLKSIZE          65464
+///
+/// IPv4, UDP and TFTP DATA header overhead used to derive the block size
+/// from the media MTU.
+///
+#define MTFTP_BLKSIZE_OVERHEAD     (20 + 8 + 4)
+///
+/// The default windowsize (1) of tftp is the lock-step behavior of RFC1350,
+/// the valid range of the windowsize option is defined in the RFC7440.
+///
+#define MTFTP_DEFAULT_WINDOWSIZE   1
+#define MTFTP_MIN_WINDOWSIZE       1
+#define MTFTP_MAX_WINDOWSIZE       65535
+///
+/// Window size requested when none is specified on the command line.
+///
+#define MTFTP_REQUEST_WINDOWSIZE   4
 
 
 /**
@@ -287,6 +322,8 @@ ShellCommandRunTftp (
   VOID                    *Data;
   SHELL_FILE_HANDLE       FileHandle;
   UINT16                  BlockSize;
+  UINT16                  NicBlockSize;
+  UINT16                  WindowSize;
 
   ShellStatus         = SHELL_INVALID_PARAMETER;
   ProblemParam        = NULL;
@@ -294,7 +331,8 @@ ShellCommandRunTftp (
   AsciiRemoteFilePath = NULL;
   Handles             = NULL;
   FileSize            = 0;
-  BlockSize           = MTFTP_DEFAULT_BLKSIZE;
+  BlockSize           = 0;
+  WindowSize          = MTFTP_REQUEST_WINDOWSIZE;
 
   //
   // Initialize the Shell library (we must be in non-auto-init...)
@@ -434,6 +472,20 @@ ShellCommandRunTftp (
     }
   }
 
+  ValueStr = ShellCommandLineGetValue (CheckPackage, L"-w");
+  if (ValueStr != NULL) {
+    if (!StringToUint16 (ValueStr, &WindowSize)) {
+      goto Error;
+    }
+    if (WindowSize < MTFTP_MIN_WINDOWSIZE || WindowSize > MTFTP_MAX_WINDOWSIZE) {
+      ShellPrintHiiEx (
+        -1, -1, NULL, STRING_TOKEN (STR_GEN_PARAM_INV),
+        gShellTftpHiiHandle, L"tftp", ValueStr
+      );
+      goto Error;
+    }
+  }
+
   //
   // Locate all MTFTP4 Service Binding protocols
   //
@@ -508,7 +560,23 @@ ShellCommandRunTftp (
       goto NextHandle;
     }
 
-    Status = DownloadFile (Mtftp4, RemoteFilePath, AsciiRemoteFilePath, FileSize, BlockSize, &Data);
+    //
+    // Without an explicit block size, use the largest one the MTU allows.
+    //
+    NicBlockSize = BlockSize;
+    if (NicBlockSize == 0) {
+      NicBlockSize = GetNicBlockSize (ControllerHandle);
+    }
+
+    Status = DownloadFile (
+               Mtftp4,
+               RemoteFilePath,
+               AsciiRemoteFilePath,
+               FileSize,
+               NicBlockSize,
+               WindowSize,
+               &Data
+               );
     if (EFI_ERROR (Status)) {
       ShellPrintHiiEx (
         -1, -1, NULL, STRING_TOKEN (STR_TFTP_ERR_DOWNLOAD),
@@ -874,6 +942,7 @@ Error :
   @param[in]   AsciiFilePath  Path of the file, ASCII encoded
   @param[in]   FileSize       Size of the file in number of bytes
   @param[in]   BlockSize      Value of the TFTP blksize option
+  @param[in]   WindowSize     Value of the TFTP windowsize option
   @param[out]  Data           Address where to store the address of the buffer
                               where the data of the file were downloaded in
                               case of success.
@@ -892,6 +961,7 @@ DownloadFile (
   IN   CONST CHAR8          *AsciiFilePath,
   IN   UINTN                FileSize,
   IN   UINT16               BlockSize,
+  IN   UINT16               WindowSize,
   OUT  VOID                 **Data
   )
 {
@@ -900,8 +970,10 @@ DownloadFile (
   VOID                  *Buffer;
   DOWNLOAD_CONTEXT      *TftpContext;
   EFI_MTFTP4_TOKEN      Mtftp4Token;
-  EFI_MTFTP4_OPTION     ReqOpt;
-  UINT8                 OptBuf[10];
+  EFI_MTFTP4_OPTION     ReqOpt[2];
+  UINT8                 BlkSizeBuf[10];
+  UINT8                 WindowSizeBuf[10];
+  UINT32                OptCount;
 
   // Downloaded file can be large. BS.AllocatePages() is more faster
   // than AllocatePool() and avoid fragmentation.
@@ -934,13 +1006,25 @@ DownloadFile (
   Mtftp4Token.Buffer      = Buffer;
   Mtftp4Token.CheckPacket = CheckPacket;
   Mtftp4Token.Context     = (VOID*)TftpContext;
+
+  OptCount = 0;
   if (BlockSize != MTFTP_DEFAULT_BLKSIZE) {
-    ReqOpt.OptionStr = (UINT8 *) "blksize";
-    AsciiSPrint ((CHAR8 *)OptBuf, sizeof (OptBuf), "%d", BlockSize);
-    ReqOpt.ValueStr  = OptBuf;
+    ReqOpt[OptCount].OptionStr = (UINT8 *) "blksize";
+    AsciiSPrint ((CHAR8 *)BlkSizeBuf, sizeof (BlkSizeBuf), "%d", BlockSize);
+    ReqOpt[OptCount].ValueStr  = BlkSizeBuf;
+    OptCount++;
+  }
+
+  if (WindowSize != MTFTP_DEFAULT_WINDOWSIZE) {
+    ReqOpt[OptCount].OptionStr = (UINT8 *) "windowsize";
+    AsciiSPrint ((CHAR8 *)WindowSizeBuf, sizeof (WindowSizeBuf), "%d", WindowSize);
+    ReqOpt[OptCount].ValueStr  = WindowSizeBuf;
+    OptCount++;
+  }
 
-    Mtftp4Token.OptionCount = 1;
-    Mtftp4Token.OptionList  = &ReqOpt;
+  if (OptCount != 0) {
+    Mtftp4Token.OptionCount = OptCount;
+    Mtftp4Token.OptionList  = ReqOpt;
   }
 
   ShellPrintHiiEx (
@@ -970,6 +1054,43 @@ Error :
   return EFI_SUCCESS;
 }
 
+/**
+  Get the largest TFTP block size that fits in a single Ethernet frame of the
+  network interface, so that every DATA packet travels unfragmented.
+
+  @param[in]  ControllerHandle  Controller handle.
+
+  @return  The block size derived from the media MTU, or MTFTP_DEFAULT_BLKSIZE
+           if the MTU of the interface cannot be retrieved.
+
+**/
+STATIC
+UINT16
+GetNicBlockSize (
+  IN  EFI_HANDLE  ControllerHandle
+  )
+{
+  EFI_STATUS                   Status;
+  EFI_SIMPLE_NETWORK_PROTOCOL  *Snp;
+  UINT32                       MaxPacketSize;
+
+  Status = gBS->HandleProtocol (
+                  ControllerHandle,
+                  &gEfiSimpleNetworkProtocolGuid,
+                  (VOID **) &Snp
+                  );
+  if (EFI_ERROR (Status) || (Snp->Mode == NULL)) {
+    return MTFTP_DEFAULT_BLKSIZE;
+  }
+
+  MaxPacketSize = Snp->Mode->MaxPacketSize;
+  if (MaxPacketSize <= MTFTP_BLKSIZE_OVERHEAD + MTFTP_DEFAULT_BLKSIZE) {
+    return MTFTP_DEFAULT_BLKSIZE;
+  }
+
+  return (UINT16) MIN (MaxPacketSize - MTFTP_BLKSIZE_OVERHEAD, MTFTP_MAX_BLKSIZE);
+}
+
 /**
   Update the progress of a file download
   This procedure is called each time a new TFTP packet is received.
@@ -23,6 +23,7 @@
 
 #include <Protocol/ServiceBinding.h>
 #include <Protocol/Mtftp4.h>
+#include <Protocol/SimpleNetwork.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>